@@ -49,7 +49,17 @@
 #include "zmserver.h"
 
 // the version of the protocol we understand
-#define ZM_PROTOCOL_VERSION "11"
+#define ZM_PROTOCOL_VERSION "12"
+
+// live frames are delta encoded in tiles of this size, must match the client
+#define ZM_LIVE_TILE_SIZE 16
+
+// tiles whose mean difference per colour channel is no more than
+// ZM_LIVE_NOISE_LEVEL, and that have no channel differing by more than
+// ZM_LIVE_NOISE_PEAK, are considered unchanged, so sensor noise does not
+// defeat the delta encoding but small moving details are still sent
+#define ZM_LIVE_NOISE_LEVEL 2
+#define ZM_LIVE_NOISE_PEAK  48
 
 #define ADD_STR(list,s)  list += (s); (list) += "[]:[]";
 #define ADD_INT(list,n)  (list) += std::to_string(n); (list) += "[]:[]";
@@ -1396,13 +1406,26 @@ void ZMServer::handleGetLiveFrame(std::vector<std::string> tokens)
     // will timeout
     kickDatabase(m_debug);
 
-    if (tokens.size() != 2)
+    static std::vector<uint8_t> s_delta {};
+
+    // GET_LIVE_FRAME <monitor> [<max width> <max height> [RGB|DELTA]]
+    if (tokens.size() != 2 && tokens.size() != 4 && tokens.size() != 5)
     {
         sendError(ERROR_TOKEN_COUNT);
         return;
     }
 
     int monitorID = atoi(tokens[1].c_str());
+    int maxWidth  = 0;
+    int maxHeight = 0;
+    if (tokens.size() >= 4)
+    {
+        maxWidth  = atoi(tokens[2].c_str());
+        maxHeight = atoi(tokens[3].c_str());
+    }
+
+    // the client only asks for a delta when it has the last frame we sent
+    bool wantDelta = (tokens.size() == 5 && tokens[4] == "DELTA");
 
     if (m_debug)
         std::cout << "Getting live frame from monitor: " << monitorID << std::endl;
@@ -1430,13 +1453,15 @@ void ZMServer::handleGetLiveFrame(std::vector<std::string> tokens)
     }
 
     // read a frame from the shared memory
+    // N.B. getFrame only returns a frame when it has changed since this
+    // client last read one, so unchanged frames are never resent
     int dataSize = getFrame(s_buffer, monitor);
 
-    if (m_debug)
-        std::cout << "Frame size: " <<  dataSize << std::endl;
-
     if (dataSize == 0)
     {
+        if (m_debug)
+            std::cout << "Frame size: " <<  dataSize << std::endl;
+
         // not really an error
         outStr = "";
         ADD_STR(outStr, "WARNING - No new frame available");
@@ -1444,14 +1469,57 @@ void ZMServer::handleGetLiveFrame(std::vector<std::string> tokens)
         return;
     }
 
+    // scale the frame down to the size the client will display it at
+    int width  = monitor->m_width;
+    int height = monitor->m_height;
+    dataSize = scaleFrame(s_buffer, width, height, maxWidth, maxHeight);
+
+    // only send the parts of the frame that have changed, unless that
+    // saves too little to be worth it
+    std::string encoding = "RGB";
+    const uint8_t *data = s_buffer.data();
+    if (wantDelta && monitor->m_liveWidth == width && monitor->m_liveHeight == height &&
+        deltaFrame(s_buffer, width, height, monitor->m_liveFrame, s_delta) < dataSize / 2)
+    {
+        if (s_delta.empty())
+        {
+            if (m_debug)
+                std::cout << "Frame unchanged" << std::endl;
+
+            // not really an error
+            outStr = "";
+            ADD_STR(outStr, "WARNING - No new frame available");
+            send(outStr);
+            return;
+        }
+
+        encoding = "DELTA";
+        data = s_delta.data();
+        dataSize = static_cast<int>(s_delta.size());
+    }
+    else
+    {
+        monitor->m_liveFrame.assign(s_buffer.begin(), s_buffer.begin() + dataSize);
+        monitor->m_liveWidth  = width;
+        monitor->m_liveHeight = height;
+    }
+
+    if (m_debug)
+        std::cout << "Frame size: " <<  dataSize << " (" << width << "x" << height << " " << encoding << ")" << std::endl;
+
     // add status
     ADD_STR(outStr, monitor->m_status)
 
     // send the data size
     ADD_INT(outStr, dataSize)
 
+    // send the frame dimensions and encoding
+    ADD_INT(outStr, width)
+    ADD_INT(outStr, height)
+    ADD_STR(outStr, encoding)
+
     // send the data
-    send(outStr, s_buffer.data(), dataSize);
+    send(outStr, data, dataSize);
 }
 
 void ZMServer::handleGetFrameList(std::vector<std::string> tokens)
@@ -1907,6 +1975,125 @@ int ZMServer::getFrame(FrameData &buffer, MONITOR *monitor)
     return monitor->m_width * monitor->m_height * 3;
 }
 
+/*
+ * Scale an RGB24 frame down, in place, so that it fits within maxWidth x maxHeight.
+ *
+ * An integer box filter is used - it is cheap and, as the client displays
+ * the result at (or close to) the requested size, good enough. A width or
+ * height of 0 means there is no limit in that dimension. The width and height
+ * are updated to the new frame dimensions and the new frame size is returned.
+ */
+int ZMServer::scaleFrame(FrameData &buffer, int &width, int &height,
+                         int maxWidth, int maxHeight)
+{
+    int factor = 1;
+    while (((maxWidth  > 0) && (width  / factor > maxWidth)) ||
+           ((maxHeight > 0) && (height / factor > maxHeight)))
+    {
+        factor++;
+    }
+
+    if (factor == 1)
+        return width * height * 3;
+
+    int newWidth  = width  / factor;
+    int newHeight = height / factor;
+    int area      = factor * factor;
+
+    // N.B. Scaling in place is safe as each output pixel is written no later
+    // in the buffer than the first input pixel it is calculated from.
+    uint8_t *out = buffer.data();
+    for (int y = 0; y < newHeight; y++)
+    {
+        for (int x = 0; x < newWidth; x++)
+        {
+            int r = 0;
+            int g = 0;
+            int b = 0;
+            for (int dy = 0; dy < factor; dy++)
+            {
+                const uint8_t *in = buffer.data() + ((((y * factor) + dy) * width) + (x * factor)) * 3;
+                for (int dx = 0; dx < factor; dx++, in += 3)
+                {
+                    r += in[0];
+                    g += in[1];
+                    b += in[2];
+                }
+            }
+            *out++ = r / area;
+            *out++ = g / area;
+            *out++ = b / area;
+        }
+    }
+
+    width  = newWidth;
+    height = newHeight;
+    return width * height * 3;
+}
+
+/*
+ * Encode an RGB24 frame as the tiles that differ from the client's frame.
+ *
+ * The frame is split into ZM_LIVE_TILE_SIZE square tiles, the ones at the
+ * right and bottom edges may be smaller. Each tile that has changed by more
+ * than the noise level is written to delta as its index, 4 bytes little
+ * endian, followed by its pixels row by row, and copied into reference so
+ * that reference stays what the client will show. The size of the delta is
+ * returned.
+ */
+int ZMServer::deltaFrame(const FrameData &buffer, int width, int height,
+                         std::vector<uint8_t> &reference,
+                         std::vector<uint8_t> &delta)
+{
+    delta.clear();
+
+    int tilesX = (width  + ZM_LIVE_TILE_SIZE - 1) / ZM_LIVE_TILE_SIZE;
+    int tilesY = (height + ZM_LIVE_TILE_SIZE - 1) / ZM_LIVE_TILE_SIZE;
+
+    for (int ty = 0; ty < tilesY; ty++)
+    {
+        for (int tx = 0; tx < tilesX; tx++)
+        {
+            int x0 = tx * ZM_LIVE_TILE_SIZE;
+            int y0 = ty * ZM_LIVE_TILE_SIZE;
+            int rowBytes = std::min(ZM_LIVE_TILE_SIZE, width - x0) * 3;
+            int rows = std::min(ZM_LIVE_TILE_SIZE, height - y0);
+
+            long diff = 0;
+            int peak = 0;
+            for (int y = y0; y < y0 + rows; y++)
+            {
+                const uint8_t *in  = buffer.data() + (((y * width) + x0) * 3);
+                const uint8_t *ref = reference.data() + (((y * width) + x0) * 3);
+                for (int i = 0; i < rowBytes; i++)
+                {
+                    int d = std::abs(in[i] - ref[i]);
+                    diff += d;
+                    peak = std::max(peak, d);
+                }
+            }
+
+            if (peak <= ZM_LIVE_NOISE_PEAK &&
+                diff <= static_cast<long>(ZM_LIVE_NOISE_LEVEL) * rowBytes * rows)
+                continue;
+
+            uint32_t index = (ty * tilesX) + tx;
+            for (int i = 0; i < 4; i++)
+                delta.push_back((index >> (8 * i)) & 0xff);
+
+            for (int y = y0; y < y0 + rows; y++)
+            {
+                const uint8_t *in  = buffer.data() + (((y * width) + x0) * 3);
+                uint8_t *ref = reference.data() + (((y * width) + x0) * 3);
+                delta.insert(delta.end(), in, in + rowBytes);
+                std::copy(in, in + rowBytes, ref);
+            }
+        }
+    }
+
+    return delta.size();
+}
+
 std::string ZMServer::getZMSetting(const std::string &setting) const
 {
     std::string result;
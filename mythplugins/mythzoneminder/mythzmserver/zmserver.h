@@ -285,6 +285,10 @@ class MONITOR
     int            m_monId              {0};
     unsigned char *m_sharedImages       {nullptr};
     int            m_lastRead           {0};
+    // the live frame this client has, delta frames are encoded against it
+    std::vector<uint8_t> m_liveFrame    {};
+    int            m_liveWidth          {0};
+    int            m_liveHeight         {0};
     std::string    m_status             {};
     int            m_palette            {0};
     int            m_controllable       {0};
@@ -314,6 +318,11 @@ class ZMServer
     void sendError(const std::string &error);
     void getMonitorList(void);
     static int  getFrame(FrameData &buffer, MONITOR *monitor);
+    static int  scaleFrame(FrameData &buffer, int &width, int &height,
+                           int maxWidth, int maxHeight);
+    static int  deltaFrame(const FrameData &buffer, int width, int height,
+                           std::vector<uint8_t> &reference,
+                           std::vector<uint8_t> &delta);
     static long long getDiskSpace(const std::string &filename, long long &total, long long &used);
     static void tokenize(const std::string &command, std::vector<std::string> &tokens);
     void handleHello(void);
@@ -4,6 +4,9 @@
 
 #include <unistd.h>
 
+// C++
+#include <algorithm>
+
 // qt
 #include <QTimer>
 
@@ -19,10 +22,13 @@
 #include "zmminiplayer.h"
 
 // the protocol version we understand
-#define ZM_PROTOCOL_VERSION "11"
+#define ZM_PROTOCOL_VERSION "12"
 
 #define BUFFER_SIZE  (2048*1536*3)
 
+// live frames are delta encoded in tiles of this size, must match the server
+#define ZM_LIVE_TILE_SIZE 16
+
 ZMClient::ZMClient()
     : QObject(nullptr),
       m_retryTimer(new QTimer(this))
@@ -637,6 +643,68 @@ bool ZMClient::readData(unsigned char *data, int dataSize)
     return true;
 }
 
+/// \brief Reads and throws away data, to keep the connection in step
+void ZMClient::discardData(size_t dataSize)
+{
+    std::vector<unsigned char> scratch(std::min<size_t>(dataSize, 64 * 1024));
+
+    while (dataSize > 0)
+    {
+        size_t chunk = std::min(dataSize, scratch.size());
+        if (!readData(scratch.data(), static_cast<int>(chunk)))
+            return;
+        dataSize -= chunk;
+    }
+}
+
+/** \brief Applies the changed tiles of a delta encoded live frame.
+ *
+ *  Each tile is its index, 4 bytes little endian, followed by its RGB24
+ *  pixels row by row. Tiles at the right and bottom edges of the frame
+ *  may be smaller than ZM_LIVE_TILE_SIZE.
+ *
+ *  \returns false if the delta does not fit the frame.
+ */
+static bool apply_live_delta(std::vector<uint8_t> &frame, QSize size,
+                             const std::vector<uint8_t> &delta)
+{
+    int width  = size.width();
+    int height = size.height();
+    int tilesX = (width  + ZM_LIVE_TILE_SIZE - 1) / ZM_LIVE_TILE_SIZE;
+    int tilesY = (height + ZM_LIVE_TILE_SIZE - 1) / ZM_LIVE_TILE_SIZE;
+
+    size_t pos = 0;
+    while (pos < delta.size())
+    {
+        if (delta.size() - pos < 4)
+            return false;
+
+        uint32_t index = static_cast<uint32_t>(delta[pos]) |
+                         (static_cast<uint32_t>(delta[pos + 1]) << 8) |
+                         (static_cast<uint32_t>(delta[pos + 2]) << 16) |
+                         (static_cast<uint32_t>(delta[pos + 3]) << 24);
+        pos += 4;
+        if (index >= static_cast<uint32_t>(tilesX * tilesY))
+            return false;
+
+        int x0 = static_cast<int>(index % tilesX) * ZM_LIVE_TILE_SIZE;
+        int y0 = static_cast<int>(index / tilesX) * ZM_LIVE_TILE_SIZE;
+        size_t rowBytes = std::min(ZM_LIVE_TILE_SIZE, width - x0) * 3;
+        int rows = std::min(ZM_LIVE_TILE_SIZE, height - y0);
+        if (delta.size() - pos < rowBytes * rows)
+            return false;
+
+        for (int y = y0; y < y0 + rows; y++)
+        {
+            std::copy_n(delta.data() + pos, rowBytes,
+                        frame.data() + (((y * width) + x0) * 3));
+            pos += rowBytes;
+        }
+    }
+
+    return true;
+}
+
 void ZMClient::getEventFrame(Event *event, int frameNo, MythImage **image)
 {
     QMutexLocker locker(&m_commandLock);
@@ -735,12 +803,29 @@ void ZMClient::getAnalyseFrame(Event *event, int frameNo, QImage &image)
     delete [] data;
 }
 
-int ZMClient::getLiveFrame(int monitorID, QString &status, FrameData& buffer)
+/** \brief Get the latest live frame from a monitor as RGB24 data.
+ *
+ *  If maxSize is valid the server will scale the frame down to fit within
+ *  it before sending. The actual dimensions of the frame are returned
+ *  in frameSize.
+ *
+ *  Once a frame of the monitor has been received the server is asked for
+ *  a delta, so that only the parts of the picture that changed are sent.
+ *
+ *  \returns The size of the frame data or 0 if no new frame is available.
+ */
+int ZMClient::getLiveFrame(int monitorID, QString &status, FrameData& buffer,
+                           QSize &frameSize, QSize maxSize)
 {
     QMutexLocker locker(&m_commandLock);
 
+    bool haveFrame = m_liveFrames.contains(monitorID);
+
     QStringList strList("GET_LIVE_FRAME");
     strList << QString::number(monitorID);
+    strList << QString::number(std::max(maxSize.width(), 0))
+            << QString::number(std::max(maxSize.height(), 0));
+    strList << (haveFrame ? "DELTA" : "RGB");
     if (!sendReceiveStringList(strList))
     {
         if (strList.empty())
@@ -760,7 +845,7 @@ int ZMClient::getLiveFrame(int monitorID, QString &status, FrameData& buffer)
     }
 
     // sanity check
-    if (strList.size() < 4)
+    if (strList.size() < 7)
     {
         LOG(VB_GENERAL, LOG_ERR, "ZMClient response too short");
         return 0;
@@ -769,13 +854,25 @@ int ZMClient::getLiveFrame(int monitorID, QString &status, FrameData& buffer)
     // get status
     status = strList[2];
 
-    // get frame length from data
-    size_t imageSize = strList[3].toInt();
+    // get data length, frame dimensions and encoding
+    size_t dataSize = strList[3].toInt();
+    frameSize = QSize(strList[4].toInt(), strList[5].toInt());
+    bool delta = (strList[6] == "DELTA");
+    size_t imageSize = static_cast<size_t>(frameSize.width()) * frameSize.height() * 3;
+
+    bool valid = (imageSize <= buffer.size());
+    if (delta)
+        valid = valid && haveFrame && m_liveFrames[monitorID].m_size == frameSize;
+    else
+        valid = valid && dataSize == imageSize;
 
-    if (buffer.size() < imageSize)
+    if (!valid)
     {
         LOG(VB_GENERAL, LOG_ERR,
-            "ZMClient::getLiveFrame(): Live frame buffer is too small!");
+            "ZMClient::getLiveFrame(): Unexpected frame size or encoding");
+        // the data is still on its way, don't let it corrupt the next reply
+        m_liveFrames.remove(monitorID);
+        discardData(dataSize);
         return 0;
     }
 
@@ -783,11 +880,31 @@ int ZMClient::getLiveFrame(int monitorID, QString &status, FrameData& buffer)
     if (imageSize == 0)
         return 0;
 
-    if (!readData(buffer.data(), imageSize))
+    LiveFrame &frame = m_liveFrames[monitorID];
+    if (delta)
     {
-        LOG(VB_GENERAL, LOG_ERR,
-            "ZMClient::getLiveFrame(): Failed to get image data");
-        return 0;
+        std::vector<uint8_t> tiles(dataSize);
+        if (!readData(tiles.data(), static_cast<int>(dataSize)) ||
+            !apply_live_delta(frame.m_data, frameSize, tiles))
+        {
+            LOG(VB_GENERAL, LOG_ERR,
+                "ZMClient::getLiveFrame(): Failed to get image data");
+            m_liveFrames.remove(monitorID);
+            return 0;
+        }
+        std::copy(frame.m_data.cbegin(), frame.m_data.cend(), buffer.begin());
+    }
+    else
+    {
+        if (!readData(buffer.data(), static_cast<int>(imageSize)))
+        {
+            LOG(VB_GENERAL, LOG_ERR,
+                "ZMClient::getLiveFrame(): Failed to get image data");
+            m_liveFrames.remove(monitorID);
+            return 0;
+        }
+        frame.m_size = frameSize;
+        frame.m_data.assign(buffer.cbegin(), buffer.cbegin() + imageSize);
     }
 
     return imageSize;
@@ -47,7 +47,8 @@ class MPUBLIC ZMClient : public QObject
                       const QString &date, bool includeContinuous, std::vector<Event*> *eventList);
     void getEventFrame(Event *event, int frameNo, MythImage **image);
     void getAnalyseFrame(Event *event, int frameNo, QImage &image);
-    int  getLiveFrame(int monitorID, QString &status, FrameData& buffer);
+    int  getLiveFrame(int monitorID, QString &status, FrameData& buffer,
+                      QSize &frameSize, QSize maxSize = QSize());
     void getFrameList(int eventID, std::vector<Frame*> *frameList);
     void deleteEvent(int eventID);
     void deleteEventList(std::vector<Event*> *eventList);
@@ -74,6 +75,7 @@ class MPUBLIC ZMClient : public QObject
   private:
     void doGetMonitorList(void);
     bool readData(unsigned char *data, int dataSize);
+    void discardData(size_t dataSize);
     bool sendReceiveStringList(QStringList &strList);
 
 #if QT_VERSION < QT_VERSION_CHECK(5,14,0)
@@ -86,6 +88,14 @@ class MPUBLIC ZMClient : public QObject
     QList<Monitor*>     m_monitorList;
     QMap<int, Monitor*> m_monitorMap;
 
+    // The last live frame of each monitor, delta frames are applied to it
+    struct LiveFrame
+    {
+        QSize                m_size;
+        std::vector<uint8_t> m_data;
+    };
+    QMap<int, LiveFrame> m_liveFrames;
+
     MythSocket       *m_socket              {nullptr};
 #if QT_VERSION < QT_VERSION_CHECK(5,14,0)
     QMutex            m_socketLock          {QMutex::Recursive};
@@ -357,8 +357,15 @@ void ZMLivePlayer::updateFrame()
 
     for (int x = 0; x < monList.count(); x++)
     {
+        // ask for the frame at the largest size any player will show it at
+        QSize maxSize;
+        for (auto *p : *m_players)
+            if (p->getMonitor()->id == monList[x])
+                maxSize = maxSize.expandedTo(p->getDisplaySize());
+
         QString status;
-        int frameSize = ZMClient::get()->getLiveFrame(monList[x], status, s_buffer);
+        QSize size;
+        int frameSize = ZMClient::get()->getLiveFrame(monList[x], status, s_buffer, size, maxSize);
 
         if (frameSize > 0 && !status.startsWith("ERROR"))
         {
@@ -372,7 +379,7 @@ void ZMLivePlayer::updateFrame()
                         p->getMonitor()->status = status;
                         p->updateStatus();
                     }
-                    p->updateFrame(s_buffer.data());
+                    p->updateFrame(s_buffer.data(), size);
                 }
             }
         }
@@ -492,9 +499,19 @@ void Player::setWidgets(MythUIImage *image, MythUIText *status, MythUIText  *cam
         m_cameraText->SetVisible(true);
 }
 
-void Player::updateFrame(const unsigned char* buffer)
+/// \brief The size the frame image widget is displayed at, if known.
+QSize Player::getDisplaySize(void) const
+{
+    if (!m_frameImage)
+        return {};
+    return m_frameImage->GetArea().size();
+}
+
+void Player::updateFrame(const unsigned char* buffer, QSize size)
 {
-    QImage image(buffer, m_monitor.width, m_monitor.height, QImage::Format_RGB888);
+    // rows are packed, scaled frames are often not a multiple of 4 bytes wide
+    QImage image(buffer, size.width(), size.height(), size.width() * 3,
+                 QImage::Format_RGB888);
 
     MythImage *img = GetMythMainWindow()->GetPainter()->GetFormatImage();
     img->Assign(image);
@@ -37,7 +37,8 @@ class Player
     Player(void) = default;
     ~Player(void);
 
-    void updateFrame(const uchar* buffer);
+    void updateFrame(const uchar* buffer, QSize size);
+    QSize getDisplaySize(void) const;
     void updateStatus(void);
     void updateCamera();
 
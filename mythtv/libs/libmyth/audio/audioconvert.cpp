@@ -21,6 +21,7 @@
  *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
  */
 
+#include <algorithm>
 #include <cinttypes>
 #include <cmath>
 #include <sys/types.h>
@@ -32,6 +33,7 @@
 
 extern "C" {
 #include "libavcodec/avcodec.h"
+#include "libavutil/cpu.h"
 #include "libswresample/swresample.h"
 }
 
@@ -70,6 +72,30 @@ static inline bool sse_check()
 }
 #endif //ARCH_x86
 
+#if ARCH_X86_64
+#include <emmintrin.h>
+#endif
+
+// The NEON code requires AArch64 for round to nearest float conversion
+#if HAVE_INTRINSICS_NEON && ARCH_AARCH64
+#include "libavutil/aarch64/cpu.h"
+#include <arm_neon.h>
+static const bool s_haveNEON = have_neon(av_get_cpu_flags());
+
+// Convert 8 integer samples to floats
+static inline void neon_s16_to_float(float* out, int16x8_t in, float32x4_t mult)
+{
+    vst1q_f32(out,     vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(in))), mult));
+    vst1q_f32(out + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(in))), mult));
+}
+
+// Convert 4 floats to rounded integers
+static inline int32x4_t neon_float_to_s32(const float* in, float32x4_t mult)
+{
+    return vcvtnq_s32_f32(vmulq_f32(vld1q_f32(in), mult));
+}
+#endif
+
 #if !HAVE_LRINTF
 static av_always_inline av_const long int lrintf(float x)
 {
@@ -85,7 +111,8 @@ static inline float clipcheck(float f)
 }
 
 /*
- The SSE code processes 16 bytes at a time and leaves any remainder for the C
+ The SSE and NEON code processes 16 samples at a time and leaves any remainder
+ for the C. The NEON code produces exactly the same output as the C.
  */
 
 static int toFloat8(float* out, const uchar* in, int len)
@@ -146,6 +173,21 @@ static int toFloat8(float* out, const uchar* in, int len)
                           :"xmm0","xmm1","xmm2","xmm3","xmm4","xmm5","xmm6","xmm7"
                           );
     }
+#elif HAVE_INTRINSICS_NEON && ARCH_AARCH64
+    if (s_haveNEON && len >= 16)
+    {
+        int loops = len >> 4;
+        i = loops << 4;
+        float32x4_t mult = vdupq_n_f32(f);
+        uint8x16_t  bias = vdupq_n_u8(0x80);
+
+        for (; loops > 0; loops--, in += 16, out += 16)
+        {
+            int8x16_t s = vreinterpretq_s8_u8(veorq_u8(vld1q_u8(in), bias));
+            neon_s16_to_float(out,     vmovl_s8(vget_low_s8(s)),  mult);
+            neon_s16_to_float(out + 8, vmovl_s8(vget_high_s8(s)), mult);
+        }
+    }
 #endif //ARCH_x86
     for (; i < len; i++)
         *out++ = (*in++ - 0x80) * f;
@@ -209,6 +251,25 @@ static int fromFloat8(uchar* out, const float* in, int len)
                           :"xmm0","xmm1","xmm2","xmm3","xmm4","xmm7"
                           );
     }
+#elif HAVE_INTRINSICS_NEON && ARCH_AARCH64
+    if (s_haveNEON && len >= 16)
+    {
+        int loops = len >> 4;
+        i = loops << 4;
+        float32x4_t mult = vdupq_n_f32(f);
+        int32x4_t   bias = vdupq_n_s32(0x80);
+
+        for (; loops > 0; loops--, in += 16, out += 16)
+        {
+            int32x4_t a = vqaddq_s32(neon_float_to_s32(in,      mult), bias);
+            int32x4_t b = vqaddq_s32(neon_float_to_s32(in + 4,  mult), bias);
+            int32x4_t c = vqaddq_s32(neon_float_to_s32(in + 8,  mult), bias);
+            int32x4_t d = vqaddq_s32(neon_float_to_s32(in + 12, mult), bias);
+            uint16x8_t ab = vcombine_u16(vqmovun_s32(a), vqmovun_s32(b));
+            uint16x8_t cd = vcombine_u16(vqmovun_s32(c), vqmovun_s32(d));
+            vst1q_u8(out, vcombine_u8(vqmovn_u16(ab), vqmovn_u16(cd)));
+        }
+    }
 #endif //ARCH_x86
     for (;i < len; i++)
         *out++ = clip_uchar(lrintf(*in++ * f) + 0x80);
@@ -264,6 +325,19 @@ static int toFloat16(float* out, const short* in, int len)
                           :"xmm1","xmm2","xmm3","xmm4","xmm5","xmm6","xmm7"
                           );
     }
+#elif HAVE_INTRINSICS_NEON && ARCH_AARCH64
+    if (s_haveNEON && len >= 16)
+    {
+        int loops = len >> 4;
+        i = loops << 4;
+        float32x4_t mult = vdupq_n_f32(f);
+
+        for (; loops > 0; loops--, in += 16, out += 16)
+        {
+            neon_s16_to_float(out,     vld1q_s16(in),     mult);
+            neon_s16_to_float(out + 8, vld1q_s16(in + 8), mult);
+        }
+    }
 #endif //ARCH_x86
     for (; i < len; i++)
         *out++ = *in++ * f;
@@ -318,6 +392,21 @@ static int fromFloat16(short* out, const float* in, int len)
                           :"xmm1","xmm2","xmm3","xmm4","xmm7"
                           );
     }
+#elif HAVE_INTRINSICS_NEON && ARCH_AARCH64
+    if (s_haveNEON && len >= 16)
+    {
+        int loops = len >> 4;
+        i = loops << 4;
+        float32x4_t mult = vdupq_n_f32(f);
+
+        for (; loops > 0; loops--, in += 16, out += 16)
+        {
+            vst1q_s16(out,     vcombine_s16(vqmovn_s32(neon_float_to_s32(in,      mult)),
+                                            vqmovn_s32(neon_float_to_s32(in + 4,  mult))));
+            vst1q_s16(out + 8, vcombine_s16(vqmovn_s32(neon_float_to_s32(in + 8,  mult)),
+                                            vqmovn_s32(neon_float_to_s32(in + 12, mult))));
+        }
+    }
 #endif //ARCH_x86
     for (;i < len;i++)
         *out++ = clip_short(lrintf(*in++ * f));
@@ -375,6 +464,23 @@ static int toFloat32(AudioFormat format, float* out, const int* in, int len)
                           :"xmm1","xmm2","xmm3","xmm4","xmm6","xmm7"
                           );
     }
+#elif HAVE_INTRINSICS_NEON && ARCH_AARCH64
+    if (s_haveNEON && len >= 16)
+    {
+        int loops = len >> 4;
+        i = loops << 4;
+        float32x4_t mult  = vdupq_n_f32(f);
+        int32x4_t   right = vdupq_n_s32(-shift);
+
+        for (; loops > 0; loops--, in += 16, out += 16)
+        {
+            for (int j = 0; j < 16; j += 4)
+            {
+                int32x4_t v = vshlq_s32(vld1q_s32(in + j), right);
+                vst1q_f32(out + j, vmulq_f32(vcvtq_f32_s32(v), mult));
+            }
+        }
+    }
 #endif //ARCH_x86
     for (; i < len; i++)
         *out++ = (*in++ >> shift) * f;
@@ -394,7 +500,8 @@ static int fromFloat32(AudioFormat format, int* out, const float* in, int len)
 #if ARCH_X86
     if (sse_check() && len >= 16)
     {
-        float o = 0.99999995;
+        // Clip to the same maximum as the C code, (range - 128) << shift
+        float o = 1.0F - (128.0F / f);
         float mo = -1;
         int loops = len >> 4;
         i = loops << 4;
@@ -448,6 +555,34 @@ static int fromFloat32(AudioFormat format, int* out, const float* in, int len)
                           :"xmm0","xmm1","xmm2","xmm3","xmm4","xmm5","xmm6","xmm7"
                           );
     }
+#elif HAVE_INTRINSICS_NEON && ARCH_AARCH64
+    if (s_haveNEON && len >= 16)
+    {
+        int loops = len >> 4;
+        i = loops << 4;
+        uint range = 1<<(bits-1);
+        float32x4_t mult  = vdupq_n_f32(f);
+        float32x4_t one   = vdupq_n_f32(1.0F);
+        float32x4_t mone  = vdupq_n_f32(-1.0F);
+        int32x4_t   left  = vdupq_n_s32(shift);
+        int32x4_t   top   = vdupq_n_s32((int)(range - 128));
+        int32x4_t   max   = vdupq_n_s32((int)((range - 128) << shift));
+        int32x4_t   min   = vdupq_n_s32((int)((-range) << shift));
+
+        // Clip exactly as the C code does
+        for (; loops > 0; loops--, in += 16, out += 16)
+        {
+            for (int j = 0; j < 16; j += 4)
+            {
+                float32x4_t v = vld1q_f32(in + j);
+                int32x4_t   r = vminq_s32(vcvtnq_s32_f32(vmulq_f32(v, mult)), top);
+                r = vshlq_s32(r, left);
+                r = vbslq_s32(vcleq_f32(v, mone), min, r);
+                r = vbslq_s32(vcgeq_f32(v, one), max, r);
+                vst1q_s32(out + j, r);
+            }
+        }
+    }
 #endif //ARCH_x86
     uint range = 1<<(bits-1);
     for (; i < len; i++)
@@ -464,7 +599,9 @@ static int fromFloat32(AudioFormat format, int* out, const float* in, int len)
             *out++ = (-range) << shift;
             continue;
         }
-        *out++ = lrintf(valf * f) << shift;
+        // Values just below 1.0 round up to range, which would wrap once
+        // shifted. Clip them as the SSE code does.
+        *out++ = std::min(lrintf(valf * f), static_cast<long>(range - 128)) << shift;
     }
     return len << 2;
 }
@@ -514,6 +651,20 @@ static int fromFloatFLT(float* out, const float* in, int len)
                           :"xmm1","xmm2","xmm3","xmm4","xmm6","xmm7"
                           );
     }
+#elif HAVE_INTRINSICS_NEON && ARCH_AARCH64
+    if (s_haveNEON && len >= 16)
+    {
+        int loops = len >> 4;
+        i = loops << 4;
+        float32x4_t one  = vdupq_n_f32(1.0F);
+        float32x4_t mone = vdupq_n_f32(-1.0F);
+
+        for (; loops > 0; loops--, in += 16, out += 16)
+        {
+            for (int j = 0; j < 16; j += 4)
+                vst1q_f32(out + j, vmaxq_f32(vminq_f32(vld1q_f32(in + j), one), mone));
+        }
+    }
 #endif //ARCH_x86
     for (;i < len;i++)
         *out++ = clipcheck(*in++);
@@ -730,13 +881,183 @@ void AudioConvert::MonoToStereo(void* dst, const void* src, int samples)
 {
     auto* d = (float*)dst;
     auto* s = (float*)src;
-    for (int i = 0; i < samples; i++)
+    int i = 0;
+
+#if ARCH_X86_64
+    if (sse_check() && samples >= 4)
+    {
+        for (; i + 4 <= samples; i += 4, s += 4, d += 8)
+        {
+            __m128 v = _mm_loadu_ps(s);
+            _mm_storeu_ps(d,     _mm_unpacklo_ps(v, v));
+            _mm_storeu_ps(d + 4, _mm_unpackhi_ps(v, v));
+        }
+    }
+#elif HAVE_INTRINSICS_NEON && ARCH_AARCH64
+    if (s_haveNEON && samples >= 4)
+    {
+        for (; i + 4 <= samples; i += 4, s += 4, d += 8)
+        {
+            float32x4_t v = vld1q_f32(s);
+            vst2q_f32(d, float32x4x2_t { { v, v } });
+        }
+    }
+#endif
+    for (; i < samples; i++)
     {
         *d++ = *s;
         *d++ = *s++;
     }
 }
 
+/*
+ Stereo is (de)interleaved with SIMD code for 16 and 32 bits samples. Other
+ common channel counts use loops with a fixed number of channels, which the
+ compiler unrolls.
+ The SIMD helpers return the number of frames processed, leaving any remainder
+ for the C.
+ */
+template <class AudioDataType>
+static int SIMDInterleaveStereo(AudioDataType* /*out*/, const AudioDataType* /*left*/,
+                                const AudioDataType* /*right*/, int /*frames*/)
+{
+    return 0;
+}
+
+template <class AudioDataType>
+static int SIMDDeinterleaveStereo(AudioDataType* /*left*/, AudioDataType* /*right*/,
+                                  const AudioDataType* /*in*/, int /*frames*/)
+{
+    return 0;
+}
+
+#if ARCH_X86_64
+template <>
+int SIMDInterleaveStereo(short* out, const short* left, const short* right, int frames)
+{
+    if (!sse_check())
+        return 0;
+    int i = 0;
+    for (; i + 8 <= frames; i += 8, out += 16)
+    {
+        __m128i l = _mm_loadu_si128((const __m128i*)(left + i));
+        __m128i r = _mm_loadu_si128((const __m128i*)(right + i));
+        _mm_storeu_si128((__m128i*)out,       _mm_unpacklo_epi16(l, r));
+        _mm_storeu_si128((__m128i*)(out + 8), _mm_unpackhi_epi16(l, r));
+    }
+    return i;
+}
+
+template <>
+int SIMDInterleaveStereo(int* out, const int* left, const int* right, int frames)
+{
+    if (!sse_check())
+        return 0;
+    int i = 0;
+    for (; i + 4 <= frames; i += 4, out += 8)
+    {
+        __m128i l = _mm_loadu_si128((const __m128i*)(left + i));
+        __m128i r = _mm_loadu_si128((const __m128i*)(right + i));
+        _mm_storeu_si128((__m128i*)out,       _mm_unpacklo_epi32(l, r));
+        _mm_storeu_si128((__m128i*)(out + 4), _mm_unpackhi_epi32(l, r));
+    }
+    return i;
+}
+
+template <>
+int SIMDDeinterleaveStereo(int* left, int* right, const int* in, int frames)
+{
+    if (!sse_check())
+        return 0;
+    int i = 0;
+    for (; i + 4 <= frames; i += 4, in += 8)
+    {
+        __m128 a = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)in));
+        __m128 b = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(in + 4)));
+        _mm_storeu_si128((__m128i*)(left + i),
+                         _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))));
+        _mm_storeu_si128((__m128i*)(right + i),
+                         _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))));
+    }
+    return i;
+}
+#elif HAVE_INTRINSICS_NEON && ARCH_AARCH64
+template <>
+int SIMDInterleaveStereo(short* out, const short* left, const short* right, int frames)
+{
+    if (!s_haveNEON)
+        return 0;
+    int i = 0;
+    for (; i + 8 <= frames; i += 8, out += 16)
+        vst2q_s16(out, int16x8x2_t { { vld1q_s16(left + i), vld1q_s16(right + i) } });
+    return i;
+}
+
+template <>
+int SIMDInterleaveStereo(int* out, const int* left, const int* right, int frames)
+{
+    if (!s_haveNEON)
+        return 0;
+    int i = 0;
+    for (; i + 4 <= frames; i += 4, out += 8)
+        vst2q_s32(out, int32x4x2_t { { vld1q_s32(left + i), vld1q_s32(right + i) } });
+    return i;
+}
+
+template <>
+int SIMDDeinterleaveStereo(short* left, short* right, const short* in, int frames)
+{
+    if (!s_haveNEON)
+        return 0;
+    int i = 0;
+    for (; i + 8 <= frames; i += 8, in += 16)
+    {
+        int16x8x2_t v = vld2q_s16(in);
+        vst1q_s16(left + i,  v.val[0]);
+        vst1q_s16(right + i, v.val[1]);
+    }
+    return i;
+}
+
+template <>
+int SIMDDeinterleaveStereo(int* left, int* right, const int* in, int frames)
+{
+    if (!s_haveNEON)
+        return 0;
+    int i = 0;
+    for (; i + 4 <= frames; i += 4, in += 8)
+    {
+        int32x4x2_t v = vld2q_s32(in);
+        vst1q_s32(left + i,  v.val[0]);
+        vst1q_s32(right + i, v.val[1]);
+    }
+    return i;
+}
+#endif
+
+template <class AudioDataType, int Channels>
+static void tDeinterleaveChannels(const std::array<AudioDataType*,8>& outp,
+                                  const AudioDataType* in, int start, int frames)
+{
+    for (int i = start; i < frames; i++)
+    {
+        for (int j = 0; j < Channels; j++)
+            outp[j][i] = *(in++);
+    }
+}
+
+template <class AudioDataType, int Channels>
+static void tInterleaveChannels(AudioDataType* out,
+                                const std::array<const AudioDataType*,8>& inp,
+                                int start, int frames)
+{
+    for (int i = start; i < frames; i++)
+    {
+        for (int j = 0; j < Channels; j++)
+            *(out++) = inp[j][i];
+    }
+}
+
 template <class AudioDataType>
 void tDeinterleaveSample(AudioDataType* out, const AudioDataType* in, int channels, int frames)
 {
@@ -747,6 +1068,24 @@ void tDeinterleaveSample(AudioDataType* out, const AudioDataType* in, int channe
         outp[i] = out + (i * frames);
     }
 
+    switch (channels)
+    {
+        case 2:
+        {
+            int done = SIMDDeinterleaveStereo(outp[0], outp[1], in, frames);
+            tDeinterleaveChannels<AudioDataType, 2>(outp, in + (2 * done), done, frames);
+            return;
+        }
+        case 6:
+            tDeinterleaveChannels<AudioDataType, 6>(outp, in, 0, frames);
+            return;
+        case 8:
+            tDeinterleaveChannels<AudioDataType, 8>(outp, in, 0, frames);
+            return;
+        default:
+            break;
+    }
+
     for (int i = 0; i < frames; i++)
     {
         for (int j = 0; j < channels; j++)
@@ -815,6 +1154,24 @@ void tInterleaveSample(AudioDataType* out, const AudioDataType* in, int channels
         }
     }
 
+    switch (channels)
+    {
+        case 2:
+        {
+            int done = SIMDInterleaveStereo(out, my_inp[0], my_inp[1], frames);
+            tInterleaveChannels<AudioDataType, 2>(out + (2 * done), my_inp, done, frames);
+            return;
+        }
+        case 6:
+            tInterleaveChannels<AudioDataType, 6>(out, my_inp, 0, frames);
+            return;
+        case 8:
+            tInterleaveChannels<AudioDataType, 8>(out, my_inp, 0, frames);
+            return;
+        default:
+            break;
+    }
+
     for (int i = 0; i < frames; i++)
     {
         for (int j = 0; j < channels; j++)
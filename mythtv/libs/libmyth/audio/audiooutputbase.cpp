@@ -811,10 +811,14 @@ void AudioOutputBase::Reconfigure(const AudioSettings &orig_settings)
     if (m_needsUpmix && m_configuredChannels > 2)
     {
         m_surroundMode = gCoreContext->GetNumSetting("AudioUpmixType", QUALITY_HIGH);
+        uint blocksize = gCoreContext->GetNumSetting("AudioUpmixBlockSize",
+                                                     SURROUND_BUFSIZE);
         m_upmixer = new FreeSurround(m_sampleRate, m_source == AUDIOOUTPUT_VIDEO,
-                                   (FreeSurround::SurroundMode)m_surroundMode);
-        VBAUDIO(QString("Create %1 quality upmixer done")
-                .arg(quality_string(m_surroundMode)));
+                                   (FreeSurround::SurroundMode)m_surroundMode,
+                                   blocksize);
+        VBAUDIO(QString("Create %1 quality upmixer done, %2 frames per block")
+                .arg(quality_string(m_surroundMode))
+                .arg(m_upmixer->framesPerBlock()));
     }
 
     VBAUDIO(QString("Audio Stretch Factor: %1").arg(m_stretchFactor));
@@ -11,6 +11,7 @@
 
 extern "C" {
 #include "libavcodec/avcodec.h"
+#include "libavutil/cpu.h"
 }
 #include "pink.h"
 
@@ -49,6 +50,14 @@ static inline bool sse_check()
 }
 #endif //ARCH_x86
 
+#if ARCH_X86_64
+#include <emmintrin.h>
+#elif HAVE_INTRINSICS_NEON && ARCH_AARCH64
+#include "libavutil/aarch64/cpu.h"
+#include <arm_neon.h>
+static const bool s_haveNEON = have_neon(av_get_cpu_flags());
+#endif
+
 /**
  * Returns true if platform has an FPU.
  * for the time being, this test is limited to testing if SSE2 is supported
@@ -151,14 +160,115 @@ void AudioOutputUtil::AdjustVolume(void *buf, int len, int volume,
             :"xmm0","xmm1","xmm2","xmm3","xmm4"
         );
     }
+#elif HAVE_INTRINSICS_NEON && ARCH_AARCH64
+    if (s_haveNEON && samples >= 16)
+    {
+        int loops = samples >> 4;
+        i = loops << 4;
+
+        for (; loops > 0; loops--, fptr += 16)
+        {
+            vst1q_f32(fptr,      vmulq_n_f32(vld1q_f32(fptr),      g));
+            vst1q_f32(fptr + 4,  vmulq_n_f32(vld1q_f32(fptr + 4),  g));
+            vst1q_f32(fptr + 8,  vmulq_n_f32(vld1q_f32(fptr + 8),  g));
+            vst1q_f32(fptr + 12, vmulq_n_f32(vld1q_f32(fptr + 12), g));
+        }
+    }
 #endif //ARCH_X86
     for (; i < samples; i++)
         *fptr++ *= g;
 }
 
+/*
+ Muting a stereo channel is done with SIMD code for 16 and 32 bits samples.
+ The SIMD helpers return the number of frames processed.
+ */
+template <class AudioDataType>
+static int SIMDMuteStereo(AudioDataType* /*buffer*/, int /*ch*/, int /*frames*/)
+{
+    return 0;
+}
+
+#if ARCH_X86_64
+template <>
+int SIMDMuteStereo(short *buffer, int ch, int frames)
+{
+    if (!sse_check())
+        return 0;
+    int i = 0;
+    for (; i + 4 <= frames; i += 4, buffer += 8)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)buffer);
+        if (ch == 0)
+            v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 3, 1, 1)),
+                                    _MM_SHUFFLE(3, 3, 1, 1));
+        else
+            v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 2, 0, 0)),
+                                    _MM_SHUFFLE(2, 2, 0, 0));
+        _mm_storeu_si128((__m128i*)buffer, v);
+    }
+    return i;
+}
+
+template <>
+int SIMDMuteStereo(int *buffer, int ch, int frames)
+{
+    if (!sse_check())
+        return 0;
+    int i = 0;
+    for (; i + 2 <= frames; i += 2, buffer += 4)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)buffer);
+        if (ch == 0)
+            v = _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 1, 1));
+        else
+            v = _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 2, 0, 0));
+        _mm_storeu_si128((__m128i*)buffer, v);
+    }
+    return i;
+}
+#elif HAVE_INTRINSICS_NEON && ARCH_AARCH64
+template <>
+int SIMDMuteStereo(short *buffer, int ch, int frames)
+{
+    if (!s_haveNEON)
+        return 0;
+    int i = 0;
+    for (; i + 8 <= frames; i += 8, buffer += 16)
+    {
+        int16x8x2_t v = vld2q_s16(buffer);
+        v.val[ch] = v.val[1 - ch];
+        vst2q_s16(buffer, v);
+    }
+    return i;
+}
+
+template <>
+int SIMDMuteStereo(int *buffer, int ch, int frames)
+{
+    if (!s_haveNEON)
+        return 0;
+    int i = 0;
+    for (; i + 4 <= frames; i += 4, buffer += 8)
+    {
+        int32x4x2_t v = vld2q_s32(buffer);
+        v.val[ch] = v.val[1 - ch];
+        vst2q_s32(buffer, v);
+    }
+    return i;
+}
+#endif
+
 template <class AudioDataType>
 void tMuteChannel(AudioDataType *buffer, int channels, int ch, int frames)
 {
+    if (channels == 2 && (ch == 0 || ch == 1))
+    {
+        int done = SIMDMuteStereo(buffer, ch, frames);
+        buffer += done * 2;
+        frames -= done;
+    }
+
     AudioDataType *s1 = buffer + ch;
     AudioDataType *s2 = buffer - ch + 1;
 
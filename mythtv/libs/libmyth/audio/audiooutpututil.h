@@ -5,9 +5,9 @@
 
 
 /**
- * All toFloat variants require 16 byte aligned input and output buffers on x86 for SSE optimised operation
- * The SSE code processes 16 bytes at a time and leaves any remainder for the C
- * - there is no remainder in practice
+ * The conversion, volume and (de)interleaving routines use SSE2 on x86 and
+ * NEON on AArch64 when available, with the C code processing any remainder.
+ * The NEON code produces exactly the same output as the C.
  */
 class MPUBLIC AudioOutputUtil
 {
@@ -7,6 +7,8 @@
 
 // C++ headers
 #include <algorithm>
+#include <array>
+#include <cstring>
 using std::max;
 using std::min;
 
@@ -16,6 +18,7 @@ using std::min;
 #include <QFile>
 #include <QFileInfo>
 #include <QDir>
+#include <QtEndian>
 
 // MythTV headers
 #include "programinfoupdater.h"
@@ -1463,6 +1466,374 @@ bool ProgramInfo::FromStringList(QStringList::const_iterator &it,
     return true;
 }
 
+namespace {
+
+/// Appends the fields of one binary ProgramInfo record, see ToBinary()
+class BinaryRecordWriter
+{
+  public:
+    explicit BinaryRecordWriter(QByteArray &data)
+      : m_data(data), m_start(data.size())
+    {
+        // record length and field bitmap, filled in by Finish()
+        m_data.append(static_cast<int>(sizeof(quint32) + sizeof(quint64)), '\0');
+    }
+
+    template <typename T>
+    void Int(uint field, T value)
+    {
+        if (value != 0)
+            Number(field, value);
+    }
+
+    void Float(uint field, float value)
+    {
+        if (value == 0.0F)
+            return;
+        m_fields |= 1ULL << field;
+        quint32 bits = 0;
+        memcpy(&bits, &value, sizeof(bits));
+        Put(bits);
+    }
+
+    void DateTime(uint field, const QDateTime &value)
+    {
+        if (value.isValid())
+            Number(field, static_cast<qint64>(value.toSecsSinceEpoch()));
+    }
+
+    void Date(uint field, const QDate &value)
+    {
+        if (value.isValid())
+            Number(field, static_cast<qint64>(value.toJulianDay()));
+    }
+
+    void Str(uint field, const QString &value)
+    {
+        if (value.isEmpty())
+            return;
+        m_fields |= 1ULL << field;
+        QByteArray utf8 = value.toUtf8();
+        Put(static_cast<quint32>(utf8.size()));
+        m_data.append(utf8);
+    }
+
+    void Finish(void)
+    {
+        auto length = static_cast<quint32>(m_data.size() - m_start - sizeof(quint32));
+        qToLittleEndian(length, m_data.data() + m_start);
+        qToLittleEndian(m_fields, m_data.data() + m_start + sizeof(quint32));
+    }
+
+  private:
+    template <typename T>
+    void Number(uint field, T value)
+    {
+        m_fields |= 1ULL << field;
+        if (sizeof(T) > sizeof(quint32))
+            Put(static_cast<quint64>(value));
+        else
+            Put(static_cast<quint32>(value));
+    }
+
+    template <typename T>
+    void Put(T value)
+    {
+        std::array<char, sizeof(T)> bytes {};
+        qToLittleEndian(value, bytes.data());
+        m_data.append(bytes.data(), static_cast<int>(bytes.size()));
+    }
+
+    QByteArray &m_data;
+    int         m_start;
+    quint64     m_fields {0};
+};
+
+/// Reads the fields of one binary ProgramInfo record, see ToBinary()
+class BinaryRecordReader
+{
+  public:
+    BinaryRecordReader(const char *data, const char *end)
+      : m_data(data)
+    {
+        quint32 length = 0;
+        m_end = end;
+        if (!Get(length) || length < sizeof(quint64) ||
+            length > static_cast<quint64>(end - m_data))
+        {
+            m_ok = false;
+            return;
+        }
+        m_end = m_data + length;
+        Get(m_fields);
+    }
+
+    bool IsOK(void) const { return m_ok; }
+    /// End of the record, including any fields added by later versions
+    const char *End(void) const { return m_end; }
+
+    template <typename T>
+    void Int(uint field, T &value)
+    {
+        qint64 raw = 0;
+        if (Has(field))
+        {
+            if (sizeof(T) > sizeof(quint32))
+            {
+                quint64 wide = 0;
+                Get(wide);
+                raw = static_cast<qint64>(wide);
+            }
+            else
+            {
+                quint32 narrow = 0;
+                Get(narrow);
+                raw = static_cast<qint32>(narrow);
+            }
+        }
+        value = static_cast<T>(raw);
+    }
+
+    void Float(uint field, float &value)
+    {
+        quint32 bits = 0;
+        if (Has(field))
+            Get(bits);
+        memcpy(&value, &bits, sizeof(value));
+    }
+
+    void DateTime(uint field, QDateTime &value)
+    {
+        qint64 secs = 0;
+        Int(field, secs);
+        value = Has(field) ? QDateTime::fromSecsSinceEpoch(secs, Qt::UTC)
+                           : QDateTime();
+    }
+
+    void Date(uint field, QDate &value)
+    {
+        qint64 day = 0;
+        Int(field, day);
+        value = Has(field) ? QDate::fromJulianDay(day) : QDate();
+    }
+
+    void Str(uint field, QString &value)
+    {
+        quint32 length = 0;
+        if (!Has(field) || !Get(length) ||
+            length > static_cast<quint64>(m_end - m_data))
+        {
+            m_ok = m_ok && !Has(field);
+            value = QString();
+            return;
+        }
+        value = QString::fromUtf8(m_data, static_cast<int>(length));
+        m_data += length;
+    }
+
+  private:
+    bool Has(uint field) const { return ((m_fields >> field) & 1) != 0U; }
+
+    template <typename T>
+    bool Get(T &value)
+    {
+        if (!m_ok || static_cast<size_t>(m_end - m_data) < sizeof(T))
+        {
+            m_ok = false;
+            return false;
+        }
+        value = qFromLittleEndian<T>(m_data);
+        m_data += sizeof(T);
+        return true;
+    }
+
+    const char *m_data;
+    const char *m_end;
+    quint64     m_fields {0};
+    bool        m_ok     {true};
+};
+
+} // namespace
+
+/** \fn ProgramInfo::ToBinary(QByteArray&) const
+ *  \brief Serializes ProgramInfo into a binary record which can be passed
+ *         over a socket.
+ *
+ *  This carries the same fields as ToStringList(), numbered the same, to
+ *  clients that negotiated MYTH_PROTO_BINARY_PROGINFO. A record starts with
+ *  its length and a bitmap of the fields that are present, all little
+ *  endian. Fields that are empty, zero or invalid are left out. Numbers are
+ *  4 bytes, or 8 for the file size and times, and strings are UTF-8 after a
+ *  4 byte length. Fields added later must take new field numbers, decoders
+ *  skip what they do not know using the record length.
+ *
+ *  \sa FromBinary(const char*&,const char*)
+ */
+void ProgramInfo::ToBinary(QByteArray &data) const
+{
+    BinaryRecordWriter record(data);
+
+    record.Str(0, m_title);
+    record.Str(1, m_subtitle);
+    record.Str(2, m_description);
+    record.Int(3, m_season);
+    record.Int(4, m_episode);
+    record.Int(5, m_totalEpisodes);
+    record.Str(6, m_syndicatedEpisode);
+    record.Str(7, m_category);
+    record.Int(8, m_chanId);
+    record.Str(9, m_chanStr);
+    record.Str(10, m_chanSign);
+    record.Str(11, m_chanName);
+    record.Str(12, m_pathname);
+    record.Int(13, m_fileSize);
+
+    record.DateTime(14, m_startTs);
+    record.DateTime(15, m_endTs);
+    record.Int(16, m_findId);
+    record.Str(17, m_hostname);
+    record.Int(18, m_sourceId);
+    // 19 was the cardid
+    record.Int(20, m_inputId);
+    record.Int(21, m_recPriority);
+    record.Int(22, m_recStatus);
+    record.Int(23, m_recordId);
+
+    record.Int(24, m_recType);
+    record.Int(25, m_dupIn);
+    record.Int(26, m_dupMethod);
+    record.DateTime(27, m_recStartTs);
+    record.DateTime(28, m_recEndTs);
+    record.Int(29, m_programFlags);
+    record.Str(30, !m_recGroup.isEmpty() ? m_recGroup : "Default");
+    record.Str(31, m_chanPlaybackFilters);
+    record.Str(32, m_seriesId);
+    record.Str(33, m_programId);
+    record.Str(34, m_inetRef);
+
+    record.DateTime(35, m_lastModified);
+    record.Float(36, m_stars);
+    record.Date(37, m_originalAirDate);
+    record.Str(38, (!m_playGroup.isEmpty()) ? m_playGroup : "Default");
+    record.Int(39, m_recPriority2);
+    record.Int(40, m_parentId);
+    record.Str(41, (!m_storageGroup.isEmpty()) ? m_storageGroup : "Default");
+    record.Int(42, m_audioProperties);
+    record.Int(43, m_videoProperties);
+    record.Int(44, m_subtitleProperties);
+
+    record.Int(45, m_year);
+    record.Int(46, m_partNumber);
+    record.Int(47, m_partTotal);
+    record.Int(48, m_catType);
+
+    record.Int(49, m_recordedId);
+    record.Str(50, m_inputName);
+    record.DateTime(51, m_bookmarkUpdate);
+
+    record.Finish();
+}
+
+/** \fn ProgramInfo::FromBinary(const char*&,const char*)
+ *  \brief Uses a binary record to initialize this ProgramInfo instance.
+ *  \param data   Start of the record, moved to the end of it on success.
+ *  \param end    End of the data, the record must not extend past it.
+ *  \return true if it succeeds, false if it fails.
+ *  \sa ToBinary(QByteArray&) const
+ */
+bool ProgramInfo::FromBinary(const char *&data, const char *end)
+{
+    BinaryRecordReader record(data, end);
+    if (!record.IsOK())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "FromBinary, truncated record.");
+        clear();
+        return false;
+    }
+
+    uint      origChanid     = m_chanId;
+    QDateTime origRecstartts = m_recStartTs;
+
+    record.Str(0, m_title);
+    record.Str(1, m_subtitle);
+    record.Str(2, m_description);
+    record.Int(3, m_season);
+    record.Int(4, m_episode);
+    record.Int(5, m_totalEpisodes);
+    record.Str(6, m_syndicatedEpisode);
+    record.Str(7, m_category);
+    record.Int(8, m_chanId);
+    record.Str(9, m_chanStr);
+    record.Str(10, m_chanSign);
+    record.Str(11, m_chanName);
+    record.Str(12, m_pathname);
+    record.Int(13, m_fileSize);
+
+    record.DateTime(14, m_startTs);
+    record.DateTime(15, m_endTs);
+    record.Int(16, m_findId);
+    record.Str(17, m_hostname);
+    record.Int(18, m_sourceId);
+    record.Int(20, m_inputId);
+    record.Int(21, m_recPriority);
+    record.Int(22, m_recStatus);
+    record.Int(23, m_recordId);
+
+    record.Int(24, m_recType);
+    record.Int(25, m_dupIn);
+    record.Int(26, m_dupMethod);
+    record.DateTime(27, m_recStartTs);
+    record.DateTime(28, m_recEndTs);
+    record.Int(29, m_programFlags);
+    record.Str(30, m_recGroup);
+    record.Str(31, m_chanPlaybackFilters);
+    record.Str(32, m_seriesId);
+    record.Str(33, m_programId);
+    record.Str(34, m_inetRef);
+
+    record.DateTime(35, m_lastModified);
+    record.Float(36, m_stars);
+    record.Date(37, m_originalAirDate);
+    record.Str(38, m_playGroup);
+    record.Int(39, m_recPriority2);
+    record.Int(40, m_parentId);
+    record.Str(41, m_storageGroup);
+    record.Int(42, m_audioProperties);
+    record.Int(43, m_videoProperties);
+    record.Int(44, m_subtitleProperties);
+
+    record.Int(45, m_year);
+    record.Int(46, m_partNumber);
+    record.Int(47, m_partTotal);
+    record.Int(48, m_catType);
+
+    record.Int(49, m_recordedId);
+    record.Str(50, m_inputName);
+    record.DateTime(51, m_bookmarkUpdate);
+
+    if (!record.IsOK())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "FromBinary, truncated record.");
+        clear();
+        return false;
+    }
+    data = record.End();
+
+    if (!origChanid || !origRecstartts.isValid() ||
+        (origChanid != m_chanId) || (origRecstartts != m_recStartTs))
+    {
+        m_availableStatus = asAvailable;
+        m_spread = -1;
+        m_startCol = -1;
+        m_inUseForWhat = QString();
+        m_positionMapDBReplacement = nullptr;
+    }
+
+    ensureSortFields();
+
+    return true;
+}
+
 template <typename T>
 QString propsValueToString (const QString& name, QMap<T,QString> propNames,
                             T props)
@@ -8,6 +8,7 @@
 #include <utility>
 #include <vector> // for GetNextRecordingList
 
+#include <QByteArray>
 #include <QStringList>
 #include <QDateTime>
 
@@ -308,6 +309,8 @@ class MPUBLIC ProgramInfo
 
     // Serializers
     void ToStringList(QStringList &list) const;
+    void ToBinary(QByteArray &data) const;
+    bool FromBinary(const char *&data, const char *end);
     virtual void ToMap(InfoMap &progMap,
                        bool showrerecord = false,
                        uint star_range = 10,
@@ -553,6 +556,7 @@ class MPUBLIC ProgramInfo
         m_programFlags &= ~FL_COMMFLAG;
         m_programFlags |= (flagging) ? FL_COMMFLAG : 0;
     }
+    void SetProgramFlags(uint32_t flags)            { m_programFlags = flags; }
     /// \brief If "ignore" is true GetBookmark() will return 0, otherwise
     ///        GetBookmark() will return the bookmark position if it exists.
     void SetIgnoreBookmark(bool ignore)
@@ -12,6 +12,32 @@
 #include "storagegroup.h"
 #include "mythevent.h"
 #include "mythsocket.h"
+#include "mythversion.h"
+
+/// Decodes the programs of a reply in the MYTH_PROTO_BINARY_PROGINFO format,
+/// nothing is added to programs if the reply is truncated
+static bool binary_to_programs(const QString &encoded, int count,
+                               vector<ProgramInfo *> &programs)
+{
+    QByteArray records = QByteArray::fromBase64(encoded.toLatin1());
+    const char *data = records.constData();
+    const char *end  = data + records.size();
+    size_t initial_size = programs.size();
+    for (int i = 0; i < count; i++)
+    {
+        auto *pginfo = new ProgramInfo();
+        if (!pginfo->FromBinary(data, end))
+        {
+            delete pginfo;
+            for (size_t j = initial_size; j < programs.size(); j++)
+                delete programs[j];
+            programs.resize(initial_size);
+            return false;
+        }
+        programs.push_back(pginfo);
+    }
+    return true;
+}
 
 vector<ProgramInfo *> *RemoteGetRecordedList(int sort)
 {
@@ -36,6 +62,76 @@ vector<ProgramInfo *> *RemoteGetRecordedList(int sort)
     return info;
 }
 
+/**
+ * \brief Gets the recordings that changed since a version of the list
+ *
+ * On return \p generation and \p version identify the backend's current
+ * list. When this returns false the caller must reload the whole list with
+ * RemoteGetRecordedList(), after this call so that no change is missed.
+ *
+ * \param generation Generation of the caller's list, empty for none
+ * \param version    Version of the caller's list
+ * \param changed    Filled with the recordings added or updated since,
+ *                   which the caller must delete
+ * \param deleted    Filled with the recordedids deleted since
+ * \return true iff \p changed and \p deleted bring the list up to date
+ */
+bool RemoteGetRecordingChanges(QString &generation, uint64_t &version,
+                               vector<ProgramInfo *> &changed,
+                               vector<uint> &deleted)
+{
+    QStringList strlist(QString("QUERY_RECORDING_CHANGES %1 %2")
+                        .arg(generation.isEmpty() ? "-" : generation)
+                        .arg(version));
+
+    if (!gCoreContext->SendReceiveStringList(strlist) || strlist.size() < 3 ||
+        (strlist[2] != "RESET" && strlist[2] != "DELTA"))
+    {
+        // Not supported by the backend
+        generation.clear();
+        version = 0;
+        return false;
+    }
+
+    generation = strlist[0];
+    version    = strlist[1].toULongLong();
+    if (strlist[2] == "RESET")
+        return false;
+
+    QStringList::const_iterator it = strlist.cbegin() + 3;
+    int numdeleted = (it != strlist.cend()) ? (*it++).toInt() : -1;
+    if (numdeleted < 0 || numdeleted >= strlist.cend() - it)
+    {
+        LOG(VB_GENERAL, LOG_ERR,
+            "RemoteGetRecordingChanges() list size appears to be incorrect.");
+        generation.clear();
+        return false;
+    }
+    for (int i = 0; i < numdeleted; i++)
+        deleted.push_back((*it++).toUInt());
+
+    int numchanged = (*it++).toInt();
+    bool binary = (strlist.cend() - it == 2) &&
+        (*it == MYTH_PROTO_BINARY_PROGINFO);
+    if (numchanged < 0 ||
+        (!binary && numchanged * NUMPROGRAMLINES > strlist.cend() - it) ||
+        (binary && !binary_to_programs(*(it + 1), numchanged, changed)))
+    {
+        LOG(VB_GENERAL, LOG_ERR,
+            "RemoteGetRecordingChanges() list size appears to be incorrect.");
+        for (auto *pginfo : changed)
+            delete pginfo;
+        changed.clear();
+        generation.clear();
+        deleted.clear();
+        return false;
+    }
+    for (int i = 0; !binary && i < numchanged; i++)
+        changed.push_back(new ProgramInfo(it, strlist.cend()));
+
+    return true;
+}
+
 bool RemoteGetLoad(system_load_array& load)
 {
     QStringList strlist(QString("QUERY_LOAD"));
@@ -181,6 +277,18 @@ uint RemoteGetRecordingList(
     if (numrecordings <= 0)
         return 0;
 
+    if (strList.size() == 3 && strList[1] == MYTH_PROTO_BINARY_PROGINFO)
+    {
+        uint reclist_initial_size = (uint) reclist.size();
+        if (!binary_to_programs(strList[2], numrecordings, reclist))
+        {
+            LOG(VB_GENERAL, LOG_ERR,
+                "RemoteGetRecordingList() binary list appears to be truncated.");
+            return 0;
+        }
+        return ((uint) reclist.size()) - reclist_initial_size;
+    }
+
     if (numrecordings * NUMPROGRAMLINES + 1 > strList.size())
     {
         LOG(VB_GENERAL, LOG_ERR,
@@ -1,6 +1,7 @@
 #ifndef REMOTEUTIL_H_
 #define REMOTEUTIL_H_
 
+#include <cstdint>
 #include <ctime>
 
 #include <QStringList>
@@ -17,6 +18,9 @@ class MythEvent;
 using system_load_array = std::array<double,3>;
 
 MPUBLIC vector<ProgramInfo *> *RemoteGetRecordedList(int sort);
+MPUBLIC bool RemoteGetRecordingChanges(QString &generation, uint64_t &version,
+                                       vector<ProgramInfo *> &changed,
+                                       vector<uint> &deleted);
 MPUBLIC bool RemoteGetLoad(system_load_array &load);
 MPUBLIC bool RemoteGetUptime(std::chrono::seconds &uptime);
 MPUBLIC
@@ -18,7 +18,11 @@
  *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
  */
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <random>
+#include <vector>
 
 #include <QtTest/QtTest>
 
@@ -30,6 +34,69 @@
 
 #define ISIZEOF(type) ((int)sizeof(type))
 
+// Sample counts that exercise both the SIMD loops and the C remainder
+#define SIMDSAMPLES 4099
+
+static inline void addSIMDFormats(void)
+{
+    QTest::addColumn<int>("FORMAT");
+    QTest::newRow("U8")     << (int)FORMAT_U8;
+    QTest::newRow("S16")    << (int)FORMAT_S16;
+    QTest::newRow("S24LSB") << (int)FORMAT_S24LSB;
+    QTest::newRow("S24")    << (int)FORMAT_S24;
+    QTest::newRow("S32")    << (int)FORMAT_S32;
+}
+
+// Reference C conversions, which the SIMD code must match exactly
+static inline void refToFloat(AudioFormat format, float *out, const void *in, int samples)
+{
+    int bits = AudioOutputSettings::FormatToBits(format);
+    int shift = (format == FORMAT_S24LSB) ? 0 : 32 - bits;
+    for (int i = 0; i < samples; i++)
+    {
+        if (format == FORMAT_U8)
+            out[i] = (((const uint8_t*)in)[i] - 0x80) * (1.0F / (1<<7));
+        else if (format == FORMAT_S16)
+            out[i] = ((const int16_t*)in)[i] * (1.0F / (1<<15));
+        else
+            out[i] = (((const int32_t*)in)[i] >> shift) * (1.0F / ((uint)(1<<(bits-1))));
+    }
+}
+
+static inline void refFromFloat(AudioFormat format, void *out, const float *in, int samples)
+{
+    int bits = AudioOutputSettings::FormatToBits(format);
+    int shift = (format == FORMAT_S24LSB) ? 0 : 32 - bits;
+    uint range = 1<<(bits-1);
+    for (int i = 0; i < samples; i++)
+    {
+        float v = in[i];
+        if (format == FORMAT_U8)
+        {
+            ((uint8_t*)out)[i] = std::clamp(lrintf(v * (1<<7)) + 0x80, 0L, 255L);
+        }
+        else if (format == FORMAT_S16)
+        {
+            ((int16_t*)out)[i] = std::clamp(lrintf(v * (1<<15)), -32768L, 32767L);
+        }
+        else if (format == FORMAT_FLT)
+        {
+            ((float*)out)[i] = std::clamp(v, -1.0F, 1.0F);
+        }
+        else
+        {
+            int32_t r = 0;
+            if (v >= 1.0F)
+                r = (range - 128) << shift;
+            else if (v <= -1.0F)
+                r = (-range) << shift;
+            else
+                r = std::min(lrintf(v * (float)range), (long)(range - 128)) << shift;
+            ((int32_t*)out)[i] = r;
+        }
+    }
+}
+
 class TestAudioUtils: public QObject
 {
     Q_OBJECT
@@ -976,4 +1043,239 @@ class TestAudioUtils: public QObject
         QCOMPARE(output[1022], expected_end[14]);
         QCOMPARE(output[1023], expected_end[15]);
     }
+
+    // test integer -> float conversion matches the C code exactly
+    static void ToFloatSIMDvsC_data(void)
+    {
+        addSIMDFormats();
+    }
+
+    static void ToFloatSIMDvsC(void)
+    {
+        QFETCH(int, FORMAT);
+        auto format = (AudioFormat)FORMAT;
+        int  size   = AudioOutputSettings::SampleSize(format);
+
+        std::mt19937 gen(format);
+        std::vector<uint8_t> in(SIMDSAMPLES * size);
+        for (auto & byte : in)
+            byte = gen();
+        if (format == FORMAT_S24LSB)
+        {
+            // Only the low 24 bits are significant
+            for (int i = 0; i < SIMDSAMPLES; i++)
+            {
+                auto *sample = (int32_t*)in.data() + i;
+                *sample = (int32_t)((uint32_t)*sample << 8) >> 8;
+            }
+        }
+
+        std::vector<float> ref(SIMDSAMPLES);
+        std::vector<float> out(SIMDSAMPLES);
+        refToFloat(format, ref.data(), in.data(), SIMDSAMPLES);
+        int val = AudioOutputUtil::toFloat(format, out.data(), in.data(), SIMDSAMPLES * size);
+        QCOMPARE(val, SIMDSAMPLES * ISIZEOF(float));
+        for (int i = 0; i < SIMDSAMPLES; i++)
+            QCOMPARE(out[i], ref[i]);
+    }
+
+    // test float -> integer conversion and clipping matches the C code exactly
+    static void FromFloatSIMDvsC_data(void)
+    {
+        addSIMDFormats();
+        QTest::newRow("FLT")    << (int)FORMAT_FLT;
+    }
+    static void FromFloatSIMDvsC(void)
+    {
+        QFETCH(int, FORMAT);
+        auto format = (AudioFormat)FORMAT;
+        int  size   = AudioOutputSettings::SampleSize(format);
+
+        // Values out of range must be clipped. The largest float below 1.0
+        // rounds to full scale for 24 bits samples, which must clip too.
+        std::mt19937 gen(format);
+        std::uniform_real_distribution<float> dist(-1.0F, 1.0F);
+        std::vector<float> in(SIMDSAMPLES);
+        for (auto & sample : in)
+            sample = dist(gen);
+        const std::array<float,11> special {
+            0.0F, -0.0F, 1.0F, -1.0F, 1.5F, -1.5F, 100.0F, -100.0F, 0.5F,
+            0.99999994F, -0.99999994F };
+        for (size_t i = 0; i < special.size(); i++)
+            in[i * 13] = special[i];
+
+        std::vector<uint8_t> ref(SIMDSAMPLES * size);
+        std::vector<uint8_t> out(SIMDSAMPLES * size);
+        refFromFloat(format, ref.data(), in.data(), SIMDSAMPLES);
+        int val = AudioOutputUtil::fromFloat(format, out.data(), in.data(), SIMDSAMPLES * ISIZEOF(float));
+        QCOMPARE(val, SIMDSAMPLES * size);
+        for (int i = 0; i < SIMDSAMPLES * size; i++)
+            QCOMPARE(out[i], ref[i]);
+    }
+
+    // test volume adjustment matches the C code exactly
+    static void AdjustVolumeSIMDvsC(void)
+    {
+        std::mt19937 gen(1);
+        std::uniform_real_distribution<float> dist(-1.0F, 1.0F);
+        std::vector<float> buf(SIMDSAMPLES);
+        for (auto & sample : buf)
+            sample = dist(gen);
+        std::vector<float> ref = buf;
+
+        float g = 0.8F * 0.8F * 1.5F;
+        for (auto & sample : ref)
+            sample *= g;
+        AudioOutputUtil::AdjustVolume(buf.data(), SIMDSAMPLES * ISIZEOF(float), 80, false, true);
+        for (int i = 0; i < SIMDSAMPLES; i++)
+            QCOMPARE(buf[i], ref[i]);
+    }
+
+    // test mono -> stereo duplicates every sample
+    static void MonoToStereoSIMD(void)
+    {
+        std::vector<float> in(SIMDSAMPLES);
+        std::vector<float> out(SIMDSAMPLES * 2);
+        for (int i = 0; i < SIMDSAMPLES; i++)
+            in[i] = i;
+        AudioOutputUtil::MonoToStereo(out.data(), in.data(), SIMDSAMPLES);
+        for (int i = 0; i < SIMDSAMPLES; i++)
+        {
+            QCOMPARE(out[(i * 2)], in[i]);
+            QCOMPARE(out[(i * 2) + 1], in[i]);
+        }
+    }
+
+    static void MuteChannelSIMD_data(void)
+    {
+        QTest::addColumn<int>("BITS");
+        QTest::addColumn<int>("CHANNEL");
+        QTest::newRow("8 bits left")   << 8  << 0;
+        QTest::newRow("16 bits left")  << 16 << 0;
+        QTest::newRow("16 bits right") << 16 << 1;
+        QTest::newRow("32 bits left")  << 32 << 0;
+        QTest::newRow("32 bits right") << 32 << 1;
+    }
+
+    // test muting a stereo channel copies the other one over it
+    static void MuteChannelSIMD(void)
+    {
+        QFETCH(int, BITS);
+        QFETCH(int, CHANNEL);
+        int size = BITS >> 3;
+
+        std::mt19937 gen(BITS);
+        std::vector<uint8_t> buf(SIMDSAMPLES * 2 * size);
+        for (auto & byte : buf)
+            byte = gen();
+        std::vector<uint8_t> orig = buf;
+
+        AudioOutputUtil::MuteChannel(BITS, 2, CHANNEL, buf.data(), buf.size());
+        for (int i = 0; i < SIMDSAMPLES; i++)
+        {
+            const uint8_t *kept = &orig[((i * 2) + 1 - CHANNEL) * size];
+            QVERIFY(memcmp(&buf[((i * 2) + 1 - CHANNEL) * size], kept, size) == 0);
+            QVERIFY(memcmp(&buf[((i * 2) + CHANNEL) * size], kept, size) == 0);
+        }
+    }
+
+    static void InterleaveSIMD_data(void)
+    {
+        QTest::addColumn<int>("FORMAT");
+        QTest::addColumn<int>("CHANNELS");
+        QTest::newRow("U8 stereo")   << (int)FORMAT_U8  << 2;
+        QTest::newRow("S16 stereo")  << (int)FORMAT_S16 << 2;
+        QTest::newRow("FLT stereo")  << (int)FORMAT_FLT << 2;
+        QTest::newRow("S16 3.0")     << (int)FORMAT_S16 << 3;
+        QTest::newRow("FLT 5.1")     << (int)FORMAT_FLT << 6;
+        QTest::newRow("S16 7.1")     << (int)FORMAT_S16 << 8;
+        QTest::newRow("FLT 7.1")     << (int)FORMAT_FLT << 8;
+    }
+
+    // test planar <-> interleaved conversions against each other and by hand
+    static void InterleaveSIMD(void)
+    {
+        QFETCH(int, FORMAT);
+        QFETCH(int, CHANNELS);
+        auto format = (AudioFormat)FORMAT;
+        int size    = AudioOutputSettings::SampleSize(format);
+        int bytes   = SIMDSAMPLES * CHANNELS * size;
+
+        std::mt19937 gen(CHANNELS);
+        std::vector<uint8_t> in(bytes);
+        for (auto & byte : in)
+            byte = gen();
+        std::vector<uint8_t> planar(bytes);
+        std::vector<uint8_t> out(bytes);
+
+        AudioOutputUtil::DeinterleaveSamples(format, CHANNELS, planar.data(), in.data(), bytes);
+        for (int i = 0; i < SIMDSAMPLES; i++)
+        {
+            for (int j = 0; j < CHANNELS; j++)
+            {
+                QVERIFY(memcmp(&planar[((j * SIMDSAMPLES) + i) * size],
+                               &in[((i * CHANNELS) + j) * size], size) == 0);
+            }
+        }
+
+        AudioOutputUtil::InterleaveSamples(format, CHANNELS, out.data(), planar.data(), bytes);
+        QVERIFY(out == in);
+
+        std::array<const uint8_t*,8> planes {};
+        for (int j = 0; j < CHANNELS; j++)
+            planes[j] = planar.data() + (j * SIMDSAMPLES * size);
+        out.assign(bytes, 0);
+        AudioOutputUtil::InterleaveSamples(format, CHANNELS, out.data(), planes.data(), bytes);
+        QVERIFY(out == in);
+    }
+
+    static void ConversionChain_data(void)
+    {
+        QTest::addColumn<int>("FORMAT");
+        QTest::addColumn<int>("CHANNELS");
+        QTest::addColumn<bool>("PLANAR");
+        QTest::addColumn<int>("OUTPUT");
+        QTest::newRow("S16 stereo -> S16")        << (int)FORMAT_S16 << 2 << false << (int)FORMAT_S16;
+        QTest::newRow("S16 stereo -> FLT")        << (int)FORMAT_S16 << 2 << false << (int)FORMAT_FLT;
+        QTest::newRow("S24 5.1 -> S32")           << (int)FORMAT_S24 << 6 << false << (int)FORMAT_S32;
+        QTest::newRow("Planar FLT 5.1 -> S16")    << (int)FORMAT_FLT << 6 << true  << (int)FORMAT_S16;
+        QTest::newRow("Planar FLT 7.1 -> FLT")    << (int)FORMAT_FLT << 8 << true  << (int)FORMAT_FLT;
+        QTest::newRow("Planar FLT 7.1 -> S16")    << (int)FORMAT_FLT << 8 << true  << (int)FORMAT_S16;
+    }
+
+    // benchmark the per buffer processing of AudioOutputBase: interleaving of
+    // decoded planar audio, conversion to float, volume and output conversion
+    static void ConversionChain(void)
+    {
+        QFETCH(int, FORMAT);
+        QFETCH(int, CHANNELS);
+        QFETCH(bool, PLANAR);
+        QFETCH(int, OUTPUT);
+        auto format = (AudioFormat)FORMAT;
+        auto output = (AudioFormat)OUTPUT;
+        int  frames = 1536; // one AC-3 frame
+        int  bytes  = frames * CHANNELS * AudioOutputSettings::SampleSize(format);
+
+        std::vector<uint8_t> decoded(bytes);
+        std::mt19937 gen(1);
+        for (auto & byte : decoded)
+            byte = gen() & 0x3f;
+        std::vector<uint8_t> in(bytes);
+        std::vector<float>   floats(frames * CHANNELS);
+        std::vector<uint8_t> out(frames * CHANNELS * ISIZEOF(float));
+
+        QBENCHMARK
+        {
+            for (int i = 0; i < 64; i++)
+            {
+                if (PLANAR)
+                    AudioOutputUtil::InterleaveSamples(format, CHANNELS, in.data(), decoded.data(), bytes);
+                else
+                    memcpy(in.data(), decoded.data(), bytes);
+                int len = AudioOutputUtil::toFloat(format, floats.data(), in.data(), bytes);
+                AudioOutputUtil::AdjustVolume(floats.data(), len, 80, false, CHANNELS > 2);
+                AudioOutputUtil::fromFloat(output, out.data(), floats.data(), len);
+            }
+        }
+    }
 };
@@ -19,6 +19,8 @@
  */
 
 #include <iostream>
+#include <QRandomGenerator>
+#include <QtEndian>
 #include <QtTest/QtTest>
 
 #include "mythcorecontext.h"
@@ -491,6 +493,233 @@ class TestProgramInfo : public QObject
         QVERIFY(m_supergirl23 == lrigrepus23c);
     }
 
+    void programToBinary_test(void)
+    {
+        QByteArray records;
+        m_dracula.ToBinary(records);
+        m_flash34.ToBinary(records);
+        m_supergirl23.ToBinary(records);
+
+        const char *data = records.constData();
+        const char *end  = data + records.size();
+        for (const auto *expected : { &m_dracula, &m_flash34, &m_supergirl23 })
+        {
+            ProgramInfo decoded;
+            QVERIFY(decoded.FromBinary(data, end));
+            QVERIFY(decoded == *expected);
+
+            QStringList expected_list;
+            QStringList decoded_list;
+            expected->ToStringList(expected_list);
+            decoded.ToStringList(decoded_list);
+            QCOMPARE(decoded_list, expected_list);
+        }
+        QVERIFY(data == end);
+
+        // Fields added by later versions are skipped
+        records.clear();
+        m_flash34.ToBinary(records);
+        quint32 length = qFromLittleEndian<quint32>(records.constData());
+        qToLittleEndian(length + 3, records.data());
+        records.insert(4 + length, "new");
+        m_dracula.ToBinary(records);
+        data = records.constData();
+        end  = data + records.size();
+        ProgramInfo hsalf34;
+        QVERIFY(hsalf34.FromBinary(data, end));
+        QVERIFY(m_flash34 == hsalf34);
+        ProgramInfo alucard;
+        QVERIFY(alucard.FromBinary(data, end));
+        QVERIFY(m_dracula == alucard);
+        QVERIFY(data == end);
+
+        // Times before 1970 are negative
+        ProgramInfo premiere
+            (0,
+             "Dracula", "",
+             "", "",
+             "Its a movie.",
+             0, 0, 0, "", "",
+             1514, "514", "WNUVDT", "WNUBDT (WNUV-DT)", "",
+             QString("Default"), QString("Default"),
+             "/recordings/1514_19580508195800.ts",
+             "localhost", "Default",
+             "", "tt0051554", "11868",
+             ProgramInfo::kCategoryMovie, 0, 0,
+             MythDate::fromString("1958-05-08 20:00:00"),
+             MythDate::fromString("1958-05-08 21:22:00"),
+             MythDate::fromString("1958-05-08 19:58:00"),
+             MythDate::fromString("1958-05-08 21:24:00"),
+             0.0F, 1958, 0, 0, QDate(1958,5,8),
+             MythDate::fromString("1969-12-31 23:59:59"),
+             RecStatus::Unknown, 0,
+             kDupsUnset, kDupCheckUnset,
+             0,
+             0, 0, 0, 0,
+             "",
+             QDateTime());
+        records.clear();
+        premiere.ToBinary(records);
+        data = records.constData();
+        end  = data + records.size();
+        ProgramInfo ereimerp;
+        QVERIFY(ereimerp.FromBinary(data, end));
+        QVERIFY(premiere == ereimerp);
+        QCOMPARE(ereimerp.GetScheduledStartTime(),
+                 MythDate::fromString("1958-05-08 20:00:00"));
+        QCOMPARE(ereimerp.GetScheduledEndTime(),
+                 MythDate::fromString("1958-05-08 21:22:00"));
+        QCOMPARE(ereimerp.GetOriginalAirDate(), QDate(1958,5,8));
+        QCOMPARE(ereimerp.GetLastModifiedTime(),
+                 MythDate::fromString("1969-12-31 23:59:59"));
+        QVERIFY(data == end);
+
+        // Test a truncated record
+        records.clear();
+        m_supergirl23.ToBinary(records);
+        records.chop(1);
+        data = records.constData();
+        end  = data + records.size();
+        ProgramInfo lrigrepus23;
+        QVERIFY(!lrigrepus23.FromBinary(data, end));
+        QVERIFY(data == records.constData());
+    }
+
+    /**
+     * Round trips programs with random fields, then decodes random
+     * corruptions of their records, which must fail cleanly.
+     */
+    static void programBinaryFuzz_test(void)
+    {
+        static const QSet<int> s_strings
+            { 0, 1, 2, 6, 7, 9, 10, 11, 12, 17, 30, 31, 32, 33, 34, 38, 41, 50 };
+        static const QSet<int> s_datetimes { 14, 15, 27, 28, 35, 51 };
+        static const QStringList s_words
+            { "", "Default", "The Flash", "Ünïcödé", "日本語", "a[]:[]b", " " };
+
+        QRandomGenerator random(42);
+        for (int i = 0; i < 500; i++)
+        {
+            QStringList fields;
+            for (int field = 0; field < NUMPROGRAMLINES; field++)
+            {
+                bool empty = random.bounded(4) == 0;
+                if (s_strings.contains(field))
+                {
+                    fields << (empty ? QString() : s_words[random.bounded(s_words.size())] +
+                               QString::number(random.generate()));
+                }
+                else if (s_datetimes.contains(field))
+                {
+                    fields << (empty ? QString("4294967295") :
+                               QString::number(random.bounded(4000000000U)));
+                }
+                else if (field == 36)
+                {
+                    fields << (empty ? QString("0") :
+                               QString::number(random.generateDouble()));
+                }
+                else if (field == 37)
+                {
+                    fields << (empty ? QString() :
+                               QDate(1900 + random.bounded(200), 1 + random.bounded(12),
+                                     1 + random.bounded(28)).toString(Qt::ISODate));
+                }
+                else if (field == 48)
+                {
+                    fields << QString::number(random.bounded(ProgramInfo::kCategoryTVShow + 1));
+                }
+                else
+                {
+                    fields << (empty ? QString("0") :
+                               QString::number(static_cast<qint32>(random.generate())));
+                }
+            }
+
+            ProgramInfo program(fields);
+            QByteArray records;
+            program.ToBinary(records);
+
+            const char *data = records.constData();
+            const char *end  = data + records.size();
+            ProgramInfo decoded;
+            QVERIFY(decoded.FromBinary(data, end));
+            QVERIFY(data == end);
+
+            QStringList expected;
+            QStringList actual;
+            program.ToStringList(expected);
+            decoded.ToStringList(actual);
+            QCOMPARE(actual, expected);
+
+            // Corrupt the record, decoding must stay inside it
+            QByteArray corrupt = records;
+            int changes = 1 + random.bounded(4);
+            for (int j = 0; j < changes; j++)
+                corrupt[random.bounded(corrupt.size())] = static_cast<char>(random.generate());
+            corrupt.truncate(random.bounded(corrupt.size() + 1));
+            data = corrupt.constData();
+            end  = data + corrupt.size();
+            ProgramInfo garbage;
+            if (garbage.FromBinary(data, end))
+                QVERIFY(data > corrupt.constData() && data <= end);
+            else
+                QVERIFY(data == corrupt.constData());
+        }
+    }
+
+    static void programSerialize_benchmark_data(void)
+    {
+        QTest::addColumn<bool>("binary");
+        QTest::newRow("stringlist") << false;
+        QTest::newRow("binary") << true;
+    }
+
+    /**
+     * Encodes and decodes a list of programs the way that MythSocket sends
+     * them, either as strings or as base64 binary records.
+     */
+    void programSerialize_benchmark(void)
+    {
+        QFETCH(bool, binary);
+        const int count = 1000;
+
+        if (binary)
+        {
+            QBENCHMARK
+            {
+                QByteArray records;
+                for (int i = 0; i < count; i++)
+                    m_flash34.ToBinary(records);
+                QByteArray wire = QString::fromLatin1(records.toBase64()).toUtf8();
+
+                QByteArray received = QByteArray::fromBase64(wire);
+                const char *data = received.constData();
+                const char *end  = data + received.size();
+                for (int i = 0; i < count; i++)
+                {
+                    ProgramInfo program;
+                    program.FromBinary(data, end);
+                }
+            }
+        }
+        else
+        {
+            QBENCHMARK
+            {
+                QStringList list;
+                for (int i = 0; i < count; i++)
+                    m_flash34.ToStringList(list);
+                QByteArray wire = list.join("[]:[]").toUtf8();
+
+                QStringList received = QString::fromUtf8(wire).split("[]:[]");
+                QStringList::const_iterator it = received.cbegin();
+                for (int i = 0; i < count; i++)
+                    ProgramInfo program(it, received.cend());
+            }
+        }
+    }
+
     void printList (const QStringList& list)
     {
         Q_UNUSED(list);
@@ -1685,9 +1685,11 @@ bool MythCoreContext::CheckProtoVersion(MythSocket *socket,
     if (!socket)
         return false;
 
-    QStringList strlist(QString("MYTH_PROTO_VERSION %1 %2")
+    // Program lists are decoded by remoteutil, which accepts both formats
+    QStringList strlist(QString("MYTH_PROTO_VERSION %1 %2 %3")
                         .arg(MYTH_PROTO_VERSION)
-                        .arg(QString::fromUtf8(MYTH_PROTO_TOKEN)));
+                        .arg(QString::fromUtf8(MYTH_PROTO_TOKEN))
+                        .arg(MYTH_PROTO_BINARY_PROGINFO));
     socket->WriteStringList(strlist);
 
     if (!socket->ReadStringList(strlist, timeout) || strlist.empty())
@@ -1718,6 +1720,7 @@ bool MythCoreContext::CheckProtoVersion(MythSocket *socket,
     }
     if (strlist[0] == "ACCEPT")
     {
+        socket->SetCapabilities(strlist.mid(2));
         if (!d->m_announcedProtocol)
         {
             d->m_announcedProtocol = true;
@@ -46,6 +46,12 @@ class MBASE_PUBLIC MythSocket : public QObject, public ReferenceCounter
     void SetAnnounce(const QStringList &new_announce);
     bool IsAnnounced(void) const { return m_isAnnounced; }
 
+    /// Optional protocol features enabled by the MYTH_PROTO_VERSION exchange
+    void SetCapabilities(const QStringList &capabilities)
+        { m_capabilities = capabilities; }
+    bool HasCapability(const QString &name) const
+        { return m_capabilities.contains(name); }
+
     void SetReadyReadCallbackEnabled(bool enabled)
         { m_disableReadyReadCallback.fetchAndStoreOrdered((enabled) ? 0 : 1); }
 
@@ -112,6 +118,7 @@ class MBASE_PUBLIC MythSocket : public QObject, public ReferenceCounter
     bool            m_isValidated      {false}; // only set in thread using MythSocket
     bool            m_isAnnounced      {false}; // only set in thread using MythSocket
     QStringList     m_announce; // only set in thread using MythSocket
+    QStringList     m_capabilities; // only set in thread using MythSocket
 
     static const int kSocketReceiveBufferSize;
 
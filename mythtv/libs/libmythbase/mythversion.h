@@ -44,8 +44,17 @@
  *       http://www.mythtv.org/wiki/Category:Myth_Protocol_Commands
  *       http://www.mythtv.org/wiki/Category:Myth_Protocol
  */
-#define MYTH_PROTO_VERSION "91"
-#define MYTH_PROTO_TOKEN "BuzzOff"
+#define MYTH_PROTO_VERSION "92"
+#define MYTH_PROTO_TOKEN "KeepTrack"
+/*
+ *  Optional capabilities that a client may list after the protocol token.
+ *  The backend lists those it enables for the connection after its ACCEPT.
+ *
+ *  MYTH_PROTO_BINARY_PROGINFO: lists of programs are sent as the count, this
+ *    name and the base64 of the ProgramInfo::ToBinary() records, rather than
+ *    NUMPROGRAMLINES strings for each program.
+ */
+#define MYTH_PROTO_BINARY_PROGINFO "BINARY_PROGINFO"
 /*
  *  Protocol cleanups needed:
  *
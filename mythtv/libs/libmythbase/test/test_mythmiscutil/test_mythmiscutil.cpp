@@ -18,6 +18,9 @@
  *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
  */
 #include <iostream>
+#include <QBuffer>
+#include <QDataStream>
+#include <QTemporaryFile>
 #include "test_mythmiscutil.h"
 
 void TestMiscUtil::test_parse_cmdline_data(void)
@@ -95,5 +98,53 @@ void TestMiscUtil::test_parse_cmdline(void)
     QCOMPARE(output, expectedOutput);
 }
 
+void TestMiscUtil::test_file_hash_data(void)
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("tiny")         << 5;
+    QTest::newRow("partial word") << 1001;
+    QTest::newRow("one block")    << 65536;
+    QTest::newRow("odd size")     << 65541;
+    QTest::newRow("large")        << 200003;
+}
+
+// The hash must not change as it is stored in the database
+void TestMiscUtil::test_file_hash(void)
+{
+    QFETCH(int, size);
+
+    QByteArray data(size, '\0');
+    for (int i = 0; i < size; ++i)
+        data[i] = static_cast<char>((i * 31 + 7) & 0xff);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(data), static_cast<qint64>(size));
+    file.flush();
+
+    // The original implementation read the file through a QDataStream
+    quint64 expected = size;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    QDataStream stream(&buffer);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    for (quint64 tmp = 0, i = 0; i < 65536/sizeof(tmp); i++)
+    {
+        stream >> tmp;
+        expected += tmp;
+    }
+    if (buffer.seek(size - 65536))
+    {
+        stream.resetStatus();
+        for (quint64 tmp = 0, i = 0; i < 65536/sizeof(tmp); i++)
+        {
+            stream >> tmp;
+            expected += tmp;
+        }
+    }
+
+    QCOMPARE(FileHash(file.fileName()), QString::number(expected, 16));
+}
 
 QTEST_APPLESS_MAIN(TestMiscUtil)
@@ -30,4 +30,6 @@ class TestMiscUtil : public QObject
 private slots:
     static void test_parse_cmdline_data(void);
     static void test_parse_cmdline(void);
+    static void test_file_hash_data(void);
+    static void test_file_hash(void);
 };
@@ -23,16 +23,28 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <cstdlib>
 #include <cstring>
 #include <vector>
+#include "mythconfig.h"
 #ifdef USE_FFTW3
 #include "fftw3.h"
 #else
 extern "C" {
 #include "libavcodec/avfft.h"
-#include "libavcodec/fft.h"
+#include "libavutil/mem.h"
 }
 using FFTComplexArray = FFTSample[2];
 #endif
 
+#if ARCH_X86_64
+#include <emmintrin.h>
+#elif HAVE_INTRINSICS_NEON && ARCH_AARCH64
+extern "C" {
+#include "libavutil/cpu.h"
+}
+#include "libavutil/aarch64/cpu.h"
+#include <arm_neon.h>
+static const bool s_haveNEON = have_neon(av_get_cpu_flags());
+#endif
+
 
 #if defined(_WIN32) && defined(USE_FFTW3)
 #pragma comment (lib,"libfftw3f-3.lib")
@@ -46,11 +58,54 @@ static const float PI = 3.141592654;
 static const float epsilon = 0.000001;
 static const float center_level = 0.5*sqrt(0.5);
 
+// amplitudes of the left and right DFT bins, and the product of each left bin with the
+// complex conjugate of its right bin; the argument of which is their phase difference
+static void bin_features(const float (*l)[2], const float (*r)[2], float *ampL, float *ampR,
+                         float *dot, float *cross, unsigned n)
+{
+    unsigned f = 0;
+#if ARCH_X86_64
+    const __m128 sign = _mm_set1_ps(-0.0F);
+    for (; f + 4 <= n; f += 4) {
+        __m128 l0 = _mm_loadu_ps(l[f]);
+        __m128 l1 = _mm_loadu_ps(l[f+2]);
+        __m128 r0 = _mm_loadu_ps(r[f]);
+        __m128 r1 = _mm_loadu_ps(r[f+2]);
+        __m128 lre = _mm_shuffle_ps(l0, l1, _MM_SHUFFLE(2,0,2,0));
+        __m128 lim = _mm_shuffle_ps(l0, l1, _MM_SHUFFLE(3,1,3,1));
+        __m128 rre = _mm_shuffle_ps(r0, r1, _MM_SHUFFLE(2,0,2,0));
+        __m128 rim = _mm_shuffle_ps(r0, r1, _MM_SHUFFLE(3,1,3,1));
+        _mm_storeu_ps(ampL + f, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(lre, lre), _mm_mul_ps(lim, lim))));
+        _mm_storeu_ps(ampR + f, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(rre, rre), _mm_mul_ps(rim, rim))));
+        _mm_storeu_ps(dot + f, _mm_add_ps(_mm_mul_ps(lre, rre), _mm_mul_ps(lim, rim)));
+        _mm_storeu_ps(cross + f, _mm_andnot_ps(sign, _mm_sub_ps(_mm_mul_ps(lim, rre), _mm_mul_ps(lre, rim))));
+    }
+#elif HAVE_INTRINSICS_NEON && ARCH_AARCH64
+    if (s_haveNEON) {
+        for (; f + 4 <= n; f += 4) {
+            float32x4x2_t lv = vld2q_f32(l[f]);
+            float32x4x2_t rv = vld2q_f32(r[f]);
+            vst1q_f32(ampL + f, vsqrtq_f32(vmlaq_f32(vmulq_f32(lv.val[0], lv.val[0]), lv.val[1], lv.val[1])));
+            vst1q_f32(ampR + f, vsqrtq_f32(vmlaq_f32(vmulq_f32(rv.val[0], rv.val[0]), rv.val[1], rv.val[1])));
+            vst1q_f32(dot + f, vmlaq_f32(vmulq_f32(lv.val[0], rv.val[0]), lv.val[1], rv.val[1]));
+            vst1q_f32(cross + f, vabsq_f32(vmlsq_f32(vmulq_f32(lv.val[1], rv.val[0]), lv.val[0], rv.val[1])));
+        }
+    }
+#endif
+    for (; f < n; f++) {
+        ampL[f] = std::sqrt(l[f][0]*l[f][0] + l[f][1]*l[f][1]);
+        ampR[f] = std::sqrt(r[f][0]*r[f][0] + r[f][1]*r[f][1]);
+        dot[f] = l[f][0]*r[f][0] + l[f][1]*r[f][1];
+        cross[f] = std::abs(l[f][1]*r[f][0] - l[f][0]*r[f][1]);
+    }
+}
+
 // private implementation of the surround decoder
 class decoder_impl {
 public:
     // create an instance of the decoder
     //  blocksize is fixed over the lifetime of this object for performance reasons
+    //  and must be a power of two
     explicit decoder_impl(unsigned blocksize=8192): m_n(blocksize), m_halfN(blocksize/2) {
 #ifdef USE_FFTW3
         // create FFTW buffers
@@ -64,18 +119,17 @@ public:
         m_loadR = fftwf_plan_dft_r2c_1d(m_n, m_rt, m_dftR,FFTW_MEASURE);
         m_store = fftwf_plan_dft_c2r_1d(m_n, m_src, m_dst,FFTW_MEASURE);
 #else
-        // create lavc fft buffers
-        m_lt = (float*)av_malloc(sizeof(FFTSample)*m_n);
-        m_rt = (float*)av_malloc(sizeof(FFTSample)*m_n);
-        m_dftL = (FFTComplexArray*)av_malloc(sizeof(FFTComplex)*m_n*2);
-        m_dftR = (FFTComplexArray*)av_malloc(sizeof(FFTComplex)*m_n*2);
-        m_src = (FFTComplexArray*)av_malloc(sizeof(FFTComplex)*m_n*2);
-        m_fftContextForward = (FFTContext*)av_malloc(sizeof(FFTContext));
-        memset(m_fftContextForward, 0, sizeof(FFTContext));
-        m_fftContextReverse = (FFTContext*)av_malloc(sizeof(FFTContext));
-        memset(m_fftContextReverse, 0, sizeof(FFTContext));
-        ff_fft_init(m_fftContextForward, 13, 0);
-        ff_fft_init(m_fftContextReverse, 13, 1);
+        // create lavc real fft buffers, the transforms are done in place
+        int bits = 0;
+        while ((1U << bits) < m_n)
+            bits++;
+        m_lt = (FFTSample*)av_malloc(sizeof(FFTSample)*m_n);
+        m_rt = (FFTSample*)av_malloc(sizeof(FFTSample)*m_n);
+        m_src = (FFTComplexArray*)av_malloc(sizeof(FFTSample)*m_n);
+        m_dftL = (FFTComplexArray*)m_lt;
+        m_dftR = (FFTComplexArray*)m_rt;
+        m_rdftForward = av_rdft_init(bits, DFT_R2C);
+        m_rdftReverse = av_rdft_init(bits, IDFT_C2R);
 #endif
         // resize our own buffers
         m_frontR.resize(m_n);
@@ -86,6 +140,10 @@ public:
         m_trueavg.resize(m_n);
         m_xFs.resize(m_n);
         m_yFs.resize(m_n);
+        m_ampL.resize(m_halfN);
+        m_ampR.resize(m_halfN);
+        m_dot.resize(m_halfN);
+        m_cross.resize(m_halfN);
         m_inbuf[0].resize(m_n);
         m_inbuf[1].resize(m_n);
         for (unsigned c=0;c<6;c++) {
@@ -121,15 +179,11 @@ public:
         fftwf_free(m_rt);
         fftwf_free(m_lt);
 #else
-        ff_fft_end(m_fftContextForward);
-        ff_fft_end(m_fftContextReverse);
+        av_rdft_end(m_rdftForward);
+        av_rdft_end(m_rdftReverse);
         av_free(m_src);
-        av_free(m_dftR);
-        av_free(m_dftL);
         av_free(m_rt);
         av_free(m_lt);
-        av_free(m_fftContextForward);
-        av_free(m_fftContextReverse);
 #endif
     }
 
@@ -165,7 +219,7 @@ public:
         add_output(in_first,in_second,center_width,dimension,adaption_rate,true);
         // shift last half of input buffer to the beginning
     }
-    
+
     // flush the internal buffers
     void flush() {
         for (unsigned k=0;k<m_n;k++) {
@@ -178,10 +232,9 @@ public:
 
     // set lfe filter params
     void sample_rate(unsigned int srate) {
-        // lfe filter is just straight through band limited
-        unsigned int cutoff = (30*m_n)/srate;
+        // lfe filter is just straight through band limited to the bins below 30Hz
         for (unsigned f=0;f<=m_halfN;f++) {
-            if (f<cutoff)
+            if (f*srate < 30*m_n)
                 m_filter[5][f] = 0.5*sqrt(0.5);
             else
                 m_filter[5][f] = 0.0;
@@ -208,8 +261,8 @@ public:
     // set the phase shifting mode
     void phase_mode(unsigned mode) {
         const std::array<std::array<float,2>,4> modes {{ {0,0}, {0,PI}, {PI,0}, {-PI/2,PI/2} }};
-        m_phaseOffsetL = modes[mode][0];
-        m_phaseOffsetR = modes[mode][1];
+        m_phaseOffsetL = std::polar(1.0F, modes[mode][0]);
+        m_phaseOffsetR = std::polar(1.0F, modes[mode][1]);
     }
 
     // what steering mode should be chosen
@@ -222,10 +275,6 @@ public:
     }
 
 private:
-    // polar <-> cartesian coodinates conversion
-    static inline float amplitude(const float *cf) { return std::sqrt(cf[0]*cf[0] + cf[1]*cf[1]); }
-    static inline float phase(const float *cf) { return std::atan2(cf[1],cf[0]); }
-    static inline cfloat polar(float a, float p) { return {static_cast<float>(a*std::cos(p)),static_cast<float>(a*std::sin(p))}; }
     static inline float sqr(float x) { return x*x; }
     // the dreaded min/max
     static inline float min(float a, float b) { return a<b?a:b; }
@@ -240,25 +289,26 @@ private:
     }
 
     // CORE FUNCTION: decode a block of data
+    //  the per bin work is split into passes, so that all but the transcendental
+    //  feature space mapping can be vectorized
     void block_decode(InputBufs input1, InputBufs input2, OutputBufs output, float center_width, float dimension, float adaption_rate) {
         // 1. scale the input by the window function; this serves a dual purpose:
         // - first it improves the FFT resolution b/c boundary discontinuities (and their frequencies) get removed
         // - second it allows for smooth blending of varying filters between the blocks
         {
-            float* pWnd = &m_wnd[0];
-            float* pLt =  &m_lt[0];
-            float* pRt =  &m_rt[0];
-            float* pIn0 = input1[0];
-            float* pIn1 = input1[1];
+            const float* pWnd = &m_wnd[0];
+            const float* pIn0 = input1[0];
+            const float* pIn1 = input1[1];
             for (unsigned k=0;k<m_halfN;k++) {
-                *pLt++ = *pIn0++ * *pWnd;
-                *pRt++ = *pIn1++ * *pWnd++;
+                m_lt[k] = pIn0[k] * pWnd[k];
+                m_rt[k] = pIn1[k] * pWnd[k];
             }
+            pWnd += m_halfN;
             pIn0 = input2[0];
             pIn1 = input2[1];
             for (unsigned k=0;k<m_halfN;k++) {
-                *pLt++ = *pIn0++ * *pWnd;
-                *pRt++ = *pIn1++ * *pWnd++;
+                m_lt[m_halfN+k] = pIn0[k] * pWnd[k];
+                m_rt[m_halfN+k] = pIn1[k] * pWnd[k];
             }
         }
 
@@ -267,30 +317,24 @@ private:
         fftwf_execute(m_loadL);
         fftwf_execute(m_loadR);
 #else
-        ff_fft_permuteRC(m_fftContextForward, m_lt, (FFTComplex*)&m_dftL[0]);
-        av_fft_calc(m_fftContextForward, (FFTComplex*)&m_dftL[0]);
-
-        ff_fft_permuteRC(m_fftContextForward, m_rt, (FFTComplex*)&m_dftR[0]);
-        av_fft_calc(m_fftContextForward, (FFTComplex*)&m_dftR[0]);
+        // ... and tranform it into the frequency domain; the real N/2 component
+        // is packed into the imaginary part of the DC component, and is not used
+        av_rdft_calc(m_rdftForward, m_lt);
+        av_rdft_calc(m_rdftForward, m_rt);
+        m_lt[1] = 0;
+        m_rt[1] = 0;
 #endif
 
         // 2. compare amplitude and phase of each DFT bin and produce the X/Y coordinates in the sound field
         //    but dont do DC or N/2 component
+        bin_features(m_dftL, m_dftR, &m_ampL[0], &m_ampR[0], &m_dot[0], &m_cross[0], m_halfN);
         for (unsigned f=0;f<m_halfN;f++) {
-            // get left/right amplitudes/phases
-            float ampL = amplitude(m_dftL[f]);
-            float ampR = amplitude(m_dftR[f]);
-            float phaseL = phase(m_dftL[f]);
-            float phaseR = phase(m_dftR[f]);
-//          if (ampL+ampR < epsilon)
-//              continue;       
+            float ampL = m_ampL[f];
+            float ampR = m_ampR[f];
 
             // calculate the amplitude/phase difference
             float ampDiff = clamp((ampL+ampR < epsilon) ? 0 : (ampR-ampL) / (ampR+ampL));
-            float phaseDiff = phaseL - phaseR;
-            if (phaseDiff < -PI) phaseDiff += 2*PI;
-            if (phaseDiff > PI) phaseDiff -= 2*PI;
-            phaseDiff = abs(phaseDiff);
+            float phaseDiff = std::atan2(m_cross[f], m_dot[f]);
 
             if (m_linearSteering) {
                 // --- this is the fancy new linear mode ---
@@ -298,84 +342,75 @@ private:
                 // get sound field x/y position
                 m_yFs[f] = get_yfs(ampDiff,phaseDiff);
                 m_xFs[f] = get_xfs(ampDiff,m_yFs[f]);
-
-                // add dimension control
-                m_yFs[f] = clamp(m_yFs[f] - dimension);
-
-                // add crossfeed control
-                m_xFs[f] = clamp(m_xFs[f] * (m_frontSeparation*(1+m_yFs[f])/2 + m_rearSeparation*(1-m_yFs[f])/2));
-
-                // 3. generate frequency filters for each output channel
-                float left = (1-m_xFs[f])/2;
-                float right = (1+m_xFs[f])/2;
-                float front = (1+m_yFs[f])/2;
-                float back = (1-m_yFs[f])/2;
-                std::array<float,5> volume {
-                    front * (left * center_width + max(0,-m_xFs[f]) * (1-center_width)),  // left
-                    front * center_level*((1-abs(m_xFs[f])) * (1-center_width)),          // center
-                    front * (right * center_width + max(0, m_xFs[f]) * (1-center_width)), // right
-                    back * m_surroundLevel * left,                                        // left surround
-                    back * m_surroundLevel * right                                        // right surround
-                };
-
-                // adapt the prior filter
-                for (unsigned c=0;c<5;c++)
-                    m_filter[c][f] = (1-adaption_rate)*m_filter[c][f] + adaption_rate*volume[c];
-
             } else {
                 // --- this is the old & simple steering mode ---
 
-                // calculate the amplitude/phase difference
-                float ampDiff = clamp((ampL+ampR < epsilon) ? 0 : (ampR-ampL) / (ampR+ampL));
-                float phaseDiff = phaseL - phaseR;
-                if (phaseDiff < -PI) phaseDiff += 2*PI;
-                if (phaseDiff > PI) phaseDiff -= 2*PI;
-                phaseDiff = abs(phaseDiff);
-
                 // determine sound field x-position
                 m_xFs[f] = ampDiff;
 
                 // determine preliminary sound field y-position from phase difference
                 m_yFs[f] = 1 - (phaseDiff/PI)*2;
 
-                if (abs(m_xFs[f]) > m_surroundBalance) {
+                if (std::abs(m_xFs[f]) > m_surroundBalance) {
                     // blend linearly between the surrounds and the fronts if the balance exceeds the surround encoding balance
                     // this is necessary because the sound field is trapezoidal and will be stretched behind the listener
-                    float frontness = (abs(m_xFs[f]) - m_surroundBalance)/(1-m_surroundBalance);
+                    float frontness = (std::abs(m_xFs[f]) - m_surroundBalance)/(1-m_surroundBalance);
                     m_yFs[f]  = (1-frontness) * m_yFs[f] + frontness * 1;
                 }
+            }
+        }
 
-                // add dimension control
-                m_yFs[f] = clamp(m_yFs[f] - dimension);
-
-                // add crossfeed control
-                m_xFs[f] = clamp(m_xFs[f] * (m_frontSeparation*(1+m_yFs[f])/2 + m_rearSeparation*(1-m_yFs[f])/2));
-
-                // 3. generate frequency filters for each output channel, according to the signal position
-                // the sum of all channel volumes must be 1.0
-                float left = (1-m_xFs[f])/2;
-                float right = (1+m_xFs[f])/2;
-                float front = (1+m_yFs[f])/2;
-                float back = (1-m_yFs[f])/2;
-                std::array<float,5> volume {
-                    front * (left * center_width + max(0,-m_xFs[f]) * (1-center_width)),      // left
-                    front * center_level*((1-abs(m_xFs[f])) * (1-center_width)),              // center
-                    front * (right * center_width + max(0, m_xFs[f]) * (1-center_width)),     // right
-                    back * m_surroundLevel*max(0,min(1,((1-(m_xFs[f]/m_surroundBalance))/2))),// left surround
-                    back * m_surroundLevel*max(0,min(1,((1+(m_xFs[f]/m_surroundBalance))/2))) // right surround
-                };
-
-                // adapt the prior filter
-                for (unsigned c=0;c<5;c++)
-                    m_filter[c][f] = (1-adaption_rate)*m_filter[c][f] + adaption_rate*volume[c];
+        // 3. generate frequency filters for each output channel, according to the signal position
+        // the sum of all channel volumes must be 1.0
+        for (unsigned f=0;f<m_halfN;f++) {
+            // add dimension control
+            float yFs = clamp(m_yFs[f] - dimension);
+
+            // add crossfeed control
+            float xFs = clamp(m_xFs[f] * (m_frontSeparation*(1+yFs)/2 + m_rearSeparation*(1-yFs)/2));
+
+            float left = (1-xFs)/2;
+            float right = (1+xFs)/2;
+            float front = (1+yFs)/2;
+            float back = (1-yFs)/2;
+            float surLeft = left;
+            float surRight = right;
+            if (!m_linearSteering) {
+                surLeft = max(0,min(1,((1-(xFs/m_surroundBalance))/2)));
+                surRight = max(0,min(1,((1+(xFs/m_surroundBalance))/2)));
             }
+            std::array<float,5> volume {
+                front * (left * center_width + max(0,-xFs) * (1-center_width)),  // left
+                front * center_level*((1-std::abs(xFs)) * (1-center_width)),          // center
+                front * (right * center_width + max(0, xFs) * (1-center_width)), // right
+                back * m_surroundLevel * surLeft,                                // left surround
+                back * m_surroundLevel * surRight                                // right surround
+            };
+
+            // adapt the prior filter
+            for (unsigned c=0;c<5;c++)
+                m_filter[c][f] = (1-adaption_rate)*m_filter[c][f] + adaption_rate*volume[c];
+        }
 
-            // ... and build the signal which we want to position
-            m_frontL[f] = polar(ampL+ampR,phaseL);
-            m_frontR[f] = polar(ampL+ampR,phaseR);
-            m_avg[f] = m_frontL[f] + m_frontR[f];
-            m_surL[f] = polar(ampL+ampR,phaseL+m_phaseOffsetL);
-            m_surR[f] = polar(ampL+ampR,phaseR+m_phaseOffsetR);
+        // ... and build the signal which we want to position; each bin keeps its phase,
+        // which is taken from the bin itself rather than recomputed from its angle
+        for (unsigned f=0;f<m_halfN;f++) {
+            float ampL = m_ampL[f];
+            float ampR = m_ampR[f];
+            float amp = ampL+ampR;
+            float cosL = ampL > 0 ? m_dftL[f][0]/ampL : 1;
+            float sinL = ampL > 0 ? m_dftL[f][1]/ampL : 0;
+            float cosR = ampR > 0 ? m_dftR[f][0]/ampR : 1;
+            float sinR = ampR > 0 ? m_dftR[f][1]/ampR : 0;
+            cfloat frontL(amp*cosL, amp*sinL);
+            cfloat frontR(amp*cosR, amp*sinR);
+            m_frontL[f] = frontL;
+            m_frontR[f] = frontR;
+            m_avg[f] = cfloat(frontL.real() + frontR.real(), frontL.imag() + frontR.imag());
+            m_surL[f] = cfloat(frontL.real()*m_phaseOffsetL.real() - frontL.imag()*m_phaseOffsetL.imag(),
+                               frontL.real()*m_phaseOffsetL.imag() + frontL.imag()*m_phaseOffsetL.real());
+            m_surR[f] = cfloat(frontR.real()*m_phaseOffsetR.real() - frontR.imag()*m_phaseOffsetR.imag(),
+                               frontR.real()*m_phaseOffsetR.imag() + frontR.imag()*m_phaseOffsetR.real());
             m_trueavg[f] = cfloat(m_dftL[f][0] + m_dftR[f][0], m_dftL[f][1] + m_dftR[f][1]);
         }
 
@@ -415,119 +450,63 @@ private:
         double x3 = x*x*x;
         double y2 = y*y;
         double y3 = y*y2;
-        return 2.464833559224702*x - 423.52131153259404*x*y + 
-            67.8557858606918*x3*y + 788.2429425544392*x*y2 - 
-            79.97650354902909*x3*y2 - 513.8966153850349*x*y3 + 
-            35.68117670186306*x3*y3 + 13867.406173420834*y*asinX - 
-            2075.8237075786396*y2*asinX - 908.2722068360281*y3*asinX - 
-            12934.654772878019*asinX*sinY - 13216.736529661162*y*tanX + 
-            1288.6463247741938*y2*tanX + 1384.372969378453*y3*tanX + 
-            12699.231471126128*sinY*tanX + 95.37131275594336*sinX*tanY - 
+        return 2.464833559224702*x - 423.52131153259404*x*y +
+            67.8557858606918*x3*y + 788.2429425544392*x*y2 -
+            79.97650354902909*x3*y2 - 513.8966153850349*x*y3 +
+            35.68117670186306*x3*y3 + 13867.406173420834*y*asinX -
+            2075.8237075786396*y2*asinX - 908.2722068360281*y3*asinX -
+            12934.654772878019*asinX*sinY - 13216.736529661162*y*tanX +
+            1288.6463247741938*y2*tanX + 1384.372969378453*y3*tanX +
+            12699.231471126128*sinY*tanX + 95.37131275594336*sinX*tanY -
             91.21223198407546*tanX*tanY;
 #else
-        return 2.464833559224702*x - 423.52131153259404*x*y + 
-            67.8557858606918*x*x*x*y + 788.2429425544392*x*y*y - 
-            79.97650354902909*x*x*x*y*y - 513.8966153850349*x*y*y*y + 
-            35.68117670186306*x*x*x*y*y*y + 13867.406173420834*y*asin(x) - 
-            2075.8237075786396*y*y*asin(x) - 908.2722068360281*y*y*y*asin(x) - 
-            12934.654772878019*asin(x)*sin(y) - 13216.736529661162*y*tan(x) + 
-            1288.6463247741938*y*y*tan(x) + 1384.372969378453*y*y*y*tan(x) + 
-            12699.231471126128*sin(y)*tan(x) + 95.37131275594336*sin(x)*tan(y) - 
+        return 2.464833559224702*x - 423.52131153259404*x*y +
+            67.8557858606918*x*x*x*y + 788.2429425544392*x*y*y -
+            79.97650354902909*x*x*x*y*y - 513.8966153850349*x*y*y*y +
+            35.68117670186306*x*x*x*y*y*y + 13867.406173420834*y*asin(x) -
+            2075.8237075786396*y*y*asin(x) - 908.2722068360281*y*y*y*asin(x) -
+            12934.654772878019*asin(x)*sin(y) - 13216.736529661162*y*tan(x) +
+            1288.6463247741938*y*y*tan(x) + 1384.372969378453*y*y*y*tan(x) +
+            12699.231471126128*sin(y)*tan(x) + 95.37131275594336*sin(x)*tan(y) -
             91.21223198407546*tan(x)*tan(y);
 #endif
     }
 
     // filter the complex source signal and add it to target
-    void apply_filter(cfloat *signal, const float *flt, float *target) {
+    void apply_filter(const cfloat *signal, const float *flt, float *target) {
+#ifdef USE_FFTW3
         // filter the signal
         for (unsigned f=0;f<=m_halfN;f++) {
             m_src[f][0] = signal[f].real() * flt[f];
             m_src[f][1] = signal[f].imag() * flt[f];
         }
-#ifdef USE_FFTW3
         // transform into time domain
         fftwf_execute(m_store);
-
-        float* pT1   = &target[m_currentBuf*m_halfN];
-        float* pWnd1 = &m_wnd[0];
-        float* pDst1 = &m_dst[0];
-        float* pT2   = &target[(m_currentBuf^1)*m_halfN];
-        float* pWnd2 = &m_wnd[m_halfN];
-        float* pDst2 = &m_dst[m_halfN];
-        // add the result to target, windowed
-        for (unsigned int k=0;k<m_halfN;k++)
-        {
-            // 1st part is overlap add
-            *pT1++ += *pWnd1++ * *pDst1++;
-            // 2nd part is set as has no history
-            *pT2++  = *pWnd2++ * *pDst2++;
-        }
+        const float* pDst = &m_dst[0];
 #else
-        // enforce odd symmetry
-        for (unsigned f=1;f<m_halfN;f++) {
-            m_src[m_n-f][0] = m_src[f][0];
-            m_src[m_n-f][1] = -m_src[f][1];   // complex conjugate
-        }
-        av_fft_permute(m_fftContextReverse, (FFTComplex*)&m_src[0]);
-        av_fft_calc(m_fftContextReverse, (FFTComplex*)&m_src[0]);
-
-        float* pT1   = &target[m_currentBuf*m_halfN];
-        float* pWnd1 = &m_wnd[0];
-        float* pDst1 = &m_src[0][0];
-        float* pT2   = &target[(m_currentBuf^1)*m_halfN];
-        float* pWnd2 = &m_wnd[m_halfN];
-        float* pDst2 = &m_src[m_halfN][0];
-        // add the result to target, windowed
-        for (unsigned int k=0;k<m_halfN;k++)
-        {
-            // 1st part is overlap add
-            *pT1++ += *pWnd1++ * *pDst1; pDst1 += 2;
-            // 2nd part is set as has no history
-            *pT2++  = *pWnd2++ * *pDst2; pDst2 += 2;
+        // filter the signal, the inverse real transform is scaled by N/2 rather than N
+        for (unsigned f=0;f<m_halfN;f++) {
+            m_src[f][0] = signal[f].real() * flt[f] * 2;
+            m_src[f][1] = signal[f].imag() * flt[f] * 2;
         }
+        // the (real) N/2 component is packed into the imaginary part of the DC component
+        m_src[0][1] = 0;
+        // transform into time domain
+        av_rdft_calc(m_rdftReverse, &m_src[0][0]);
+        const float* pDst = &m_src[0][0];
 #endif
-    }
 
-#ifndef USE_FFTW3
-    /**
-     *  * Do the permutation needed BEFORE calling ff_fft_calc()
-     *  special for freesurround that also copies
-     *   */
-    void ff_fft_permuteRC(FFTContext *s, FFTSample *r, FFTComplex *z)
-    {
-        int j, k, np;
-        const uint16_t *revtab = s->revtab;
-
-        /* reverse */
-        np = 1 << s->nbits;
-        for(j=0;j<np;j++) {
-            k = revtab[j];
-            z[k].re = r[j];
-            z[k].im = 0.0;
-        }
-    }
-
-    /**
-     *  * Do the permutation needed BEFORE calling ff_fft_calc()
-     *  special for freesurround that also copies and 
-     *  discards im component as it should be 0
-     *   */
-    void ff_fft_permuteCR(FFTContext *s, FFTComplex *z, FFTSample *r)
-    {
-        int j, k, np;
-        const uint16_t *revtab = s->revtab;
-
-        /* reverse */
-        np = 1 << s->nbits;
-        for(j=0;j<np;j++) {
-            k = revtab[j];
-            if (k < j) {
-                r[k] = z[j].re;
-                r[j] = z[k].re;
-            }
-        }
+        float* pT1 = &target[m_currentBuf*m_halfN];
+        float* pT2 = &target[(m_currentBuf^1)*m_halfN];
+        const float* pWnd = &m_wnd[0];
+        // add the result to target, windowed
+        // 1st part is overlap add
+        for (unsigned int k=0;k<m_halfN;k++)
+            pT1[k] += pWnd[k] * pDst[k];
+        // 2nd part is set as has no history
+        for (unsigned int k=0;k<m_halfN;k++)
+            pT2[k] = pWnd[m_halfN+k] * pDst[m_halfN+k];
     }
-#endif
 
     unsigned int m_n;                    // the block size
     unsigned int m_halfN;                // half block size precalculated
@@ -537,14 +516,16 @@ private:
     fftwf_complex *m_dftL,*m_dftR,*m_src;  // intermediate arrays (FFTs of lt & rt, processing source)
     fftwf_plan m_loadL,m_loadR,m_store;    // plans for loading the data into the intermediate format and back
 #else
-    FFTContext *m_fftContextForward, *m_fftContextReverse;
-    FFTSample *m_lt,*m_rt;                 // left total, right total (source arrays), destination array
-    FFTComplexArray *m_dftL,*m_dftR,*m_src;// intermediate arrays (FFTs of lt & rt, processing source)
+    RDFTContext *m_rdftForward, *m_rdftReverse;
+    FFTSample *m_lt,*m_rt;                 // left total, right total (source arrays)
+    FFTComplexArray *m_dftL,*m_dftR,*m_src;// intermediate arrays (FFTs of lt & rt in place, processing source and destination)
 #endif
     // buffers
     std::vector<cfloat> m_frontL,m_frontR,m_avg,m_surL,m_surR; // the signal (phase-corrected) in the frequency domain
     std::vector<cfloat> m_trueavg;       // for lfe generation
     std::vector<float> m_xFs,m_yFs;      // the feature space positions for each frequency bin
+    std::vector<float> m_ampL,m_ampR;    // the amplitudes of each frequency bin
+    std::vector<float> m_dot,m_cross;    // left times conjugate right for each frequency bin, cross is absolute
     std::vector<float> m_wnd;            // the window function, precalculated
     std::array<std::vector<float>,6> m_filter;      // a frequency filter for each output channel
     std::array<std::vector<float>,2> m_inbuf;       // the sliding input buffers
@@ -554,8 +535,8 @@ private:
     float m_surroundLow     {0.0F};      // low surround mixing coefficient (e.g. 0.8165/0.5774)
     float m_surroundBalance {0.0F};      // the xfs balance that follows from the coeffs
     float m_surroundLevel   {0.0F};      // gain for the surround channels (follows from the coeffs
-    float m_phaseOffsetL    {0.0F};      // phase shifts to be applied to the rear channels
-    float m_phaseOffsetR    {0.0F};      // phase shifts to be applied to the rear channels
+    cfloat m_phaseOffsetL   {1.0F};      // phase shifts to be applied to the rear channels
+    cfloat m_phaseOffsetR   {1.0F};      // phase shifts to be applied to the rear channels
     float m_frontSeparation {0.0F};      // front stereo separation
     float m_rearSeparation  {0.0F};      // rear stereo separation
     bool  m_linearSteering  {false};     // whether the steering should be linear or not
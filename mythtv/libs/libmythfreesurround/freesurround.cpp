@@ -36,16 +36,12 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <QString>
 #include <QDateTime>
 
-// our default internal block size, in floats
-static const unsigned default_block_size = SURROUND_BUFSIZE;
 // Gain of center and lfe channels in passive mode (sqrt 0.5)
 //static const float center_level = 0.707107;
 static const float m3db = 0.7071067811865476F;           // 3dB  = SQRT(2)
 static const float m6db = 0.5;                           // 6dB  = SQRT(4)
 //static const float m7db = 0.44721359549996;            // 7dB  = SQRT(5)
 
-unsigned int block_size = default_block_size;
-
 struct buffers
 {
     explicit buffers(unsigned int s):
@@ -71,13 +67,19 @@ struct buffers
 int channel_select = -1;
 #endif
 
-FreeSurround::FreeSurround(uint srate, bool moviemode, SurroundMode smode) :
+FreeSurround::FreeSurround(uint srate, bool moviemode, SurroundMode smode,
+                           uint blocksize) :
     m_srate(srate),
     m_surroundMode(smode)
 {
+    // The decoder needs a power of two. Smaller blocks lower the latency at
+    // the cost of frequency resolution, and so of steering accuracy.
+    while (m_blockSize > SURROUND_MINBUFSIZE && m_blockSize > blocksize)
+        m_blockSize /= 2;
+
     LOG(VB_AUDIO, LOG_DEBUG,
-        QString("FreeSurround::FreeSurround rate %1 moviemode %2")
-            .arg(srate).arg(moviemode));
+        QString("FreeSurround::FreeSurround rate %1 moviemode %2 blocksize %3")
+            .arg(srate).arg(moviemode).arg(m_blockSize));
 
     if (moviemode)
     {
@@ -97,13 +99,13 @@ FreeSurround::FreeSurround(uint srate, bool moviemode, SurroundMode smode) :
             break;
         case SurroundModeActiveLinear:
             m_params.steering = 1;
-            m_latencyFrames = block_size/2;
+            m_latencyFrames = m_blockSize/2;
             break;
         default:
             break;
     }
 
-    m_bufs = new buffers(block_size/2);
+    m_bufs = new buffers(m_blockSize/2);
     open();
 #ifdef SPEAKERTEST
     channel_select++;
@@ -147,7 +149,7 @@ uint FreeSurround::putFrames(void* buffer, uint numFrames, uint numChannels)
 {
     uint i = 0;
     uint ic = m_inCount;
-    uint bs = block_size/2;
+    uint bs = m_blockSize/2;
     bool process = true;
     auto *samples = (float *)buffer;
     // demultiplex
@@ -290,7 +292,7 @@ uint FreeSurround::putFrames(void* buffer, uint numFrames, uint numChannels)
             m_inCount = 0;
             m_outCount = bs;
             m_processedSize = bs;
-            m_latencyFrames = block_size/2;
+            m_latencyFrames = m_blockSize/2;
         }
     }
     else
@@ -424,7 +426,7 @@ void FreeSurround::open()
 {
     if (!m_decoder)
     {
-        m_decoder = new fsurround_decoder(block_size);
+        m_decoder = new fsurround_decoder(m_blockSize);
         m_decoder->flush();
         if (m_bufs)
             m_bufs->clear();
@@ -452,12 +454,12 @@ uint FreeSurround::numFrames() const
 uint FreeSurround::frameLatency() const
 {
     if (m_processed)
-        return m_inCount + m_outCount + (block_size/2);
+        return m_inCount + m_outCount + (m_blockSize/2);
     return m_inCount + m_outCount;
 }
 
-uint FreeSurround::framesPerBlock()
+uint FreeSurround::framesPerBlock() const
 {
-    return block_size/2;
+    return m_blockSize/2;
 }
 
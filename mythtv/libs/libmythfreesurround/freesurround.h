@@ -22,6 +22,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "compat.h"  // instead of sys/types.h, for MinGW compatibility
 
 #define SURROUND_BUFSIZE 8192
+#define SURROUND_MINBUFSIZE 1024
 
 class FreeSurround
 {
@@ -34,7 +35,8 @@ public:
         SurroundModePassiveHall
     };
 public:
-    FreeSurround(uint srate, bool moviemode, SurroundMode mode);
+    FreeSurround(uint srate, bool moviemode, SurroundMode mode,
+                 uint blocksize = SURROUND_BUFSIZE);
     ~FreeSurround();
 
     // put frames in buffer, returns number of frames used
@@ -49,7 +51,7 @@ public:
     long long getLatency();
     uint frameLatency() const;
 
-    static uint framesPerBlock();
+    uint framesPerBlock() const;
 
 protected:
     void process_block();
@@ -75,6 +77,7 @@ private:
 
     // additional settings
     uint m_srate;
+    uint m_blockSize                   {SURROUND_BUFSIZE}; // decoder block size, in frames
 
     // info about the current setup
     struct buffers          *m_bufs    {nullptr}; // our buffers
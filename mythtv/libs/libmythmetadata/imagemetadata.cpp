@@ -269,6 +269,7 @@ public:
     int         GetOrientation(bool *exists = nullptr) override; // ImageMetaData
     QDateTime   GetOriginalDateTime(bool *exists = nullptr) override; // ImageMetaData
     QString     GetComment(bool *exists = nullptr) override; // ImageMetaData
+    QImage      GetThumbnail() override; // ImageMetaData
 
 protected:
     static QString DecodeComment(std::string rawValue);
@@ -461,6 +462,32 @@ QString PictureMetaData::GetComment(bool *exists)
 }
 
 
+/*!
+   \brief Read the thumbnail embedded in the Exif metadata
+   \details Cameras embed a small preview, typically 160x120, which is unrotated.
+   \return The thumbnail or a null image if there isn't one
+ */
+QImage PictureMetaData::GetThumbnail()
+{
+    QImage thumbnail;
+    if (!IsValid())
+        return thumbnail;
+
+    try
+    {
+        Exiv2::ExifThumbC exifThumb(m_exifData);
+        Exiv2::DataBuf buf = exifThumb.copy();
+        if (buf.size_ > 0)
+            thumbnail.loadFromData(buf.cbegin(), static_cast<int>(buf.size_));
+    }
+    catch (Exiv2::Error &e)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Exiv2 exception %1").arg(e.what()));
+    }
+    return thumbnail;
+}
+
+
 /*!
    \brief Decodes charset of UserComment
    \param rawValue Metadata value with optional "[charset=...]" prefix
@@ -493,6 +520,8 @@ public:
     int         GetOrientation(bool *exists = nullptr) override; // ImageMetaData
     QDateTime   GetOriginalDateTime(bool *exists = nullptr) override; // ImageMetaData
     QString     GetComment(bool *exists = nullptr) override; // ImageMetaData
+    QImage      GetThumbnail() override // ImageMetaData
+        { return QImage(); }
 
 protected:
     QString GetTag(const QString &key, bool *exists = nullptr);
@@ -14,6 +14,7 @@
 // Qt headers
 #include <QCoreApplication> // for tr()
 #include <QDateTime>
+#include <QImage>
 #include <QStringBuilder>
 #include <QStringList>
 
@@ -124,6 +125,7 @@ public:
     virtual int         GetOrientation(bool *exists = nullptr)      = 0;
     virtual QDateTime   GetOriginalDateTime(bool *exists = nullptr) = 0;
     virtual QString     GetComment(bool *exists = nullptr)          = 0;
+    virtual QImage      GetThumbnail()                           = 0;
 
 protected:
     explicit ImageMetaData(QString filePath)
@@ -1,9 +1,12 @@
 #include "imagescanner.h"
 
+#include <algorithm>
+
 #include "mythlogging.h"
 #include "mythcorecontext.h"  // for events
 
 #include "imagemetadata.h"
+#include "mediawatcher.h"
 
 /*!
  \brief Constructor
@@ -165,13 +168,26 @@ void ImageScanThread<DBFS>::run()
 
             bool firstScan = m_dbFileMap.isEmpty();
 
+            // The backend journals changes to its storage group so that only
+            // changed dirs need to be synced
+            QStringList changedDirs;
+            bool watched = gCoreContext->IsBackend();
+            bool journalled = watched
+                    && MediaWatcher::TakeJournal("Gallery", changedDirs);
+            m_incremental = journalled && !firstScan;
+            m_changedDirs.clear();
+            for (const auto & changed : qAsConst(changedDirs))
+                m_changedDirs.insert(changed);
+            m_retainTrees.clear();
+            m_retainFiles.clear();
+
             // Pause thumb generator so that scans are fast as possible
             m_thumb.PauseBackground(true);
 
             // Adapter determines list of dirs to scan
             StringMap paths = m_dbfs.GetScanDirs();
 
-            CountFiles(paths.values());
+            CountFiles(m_incremental ? changedDirs : paths.values());
 
             // Now start the actual syncronization
             m_seenFile.clear();
@@ -186,6 +202,9 @@ void ImageScanThread<DBFS>::run()
             // Release thumb generator asap
             m_thumb.PauseBackground(false);
 
+            // Unchanged subtrees were not scanned but still exist
+            RetainUnchanged();
+
             // Adding or updating directories has been completed.
             // The maps now only contain old directories & files that are not
             // in the filesystem anymore. Remove them from the database
@@ -218,6 +237,12 @@ void ImageScanThread<DBFS>::run()
             // Notify clients of completion with removed & changed images
             m_dbfs.Notify("IMAGE_DB_CHANGED", mesg);
 
+            // Journal is no longer needed if the scan wasn't interrupted.
+            // Full scans must commit too, as that records the time of the
+            // scan that later journals are checked against.
+            if (watched && IsScanning())
+                MediaWatcher::CommitJournal("Gallery", !m_incremental);
+
             ChangeState(false);
         }
     }
@@ -257,6 +282,28 @@ void ImageScanThread<DBFS>::SyncSubTree(const QFileInfo &dirInfo, int parentId,
         return;
     }
 
+    // Incremental scans only sync the files of changed and new dirs
+    bool changed = true;
+    if (m_incremental && !m_changedDirs.contains(dirInfo.absoluteFilePath()))
+    {
+        ImagePtr item(m_dbfs.CreateItem(dirInfo, parentId, devId, base));
+        if (item->IsDevice() || m_dbDirMap.contains(item->m_filePath))
+        {
+            if (!HasChangedSubDir(dirInfo.absoluteFilePath()))
+            {
+                // Nothing has changed in this subtree
+                m_retainTrees.insert(item->m_filePath);
+                return;
+            }
+
+            // Only visit subdirs to reach the changed ones
+            changed = false;
+            m_retainFiles.insert(item->m_filePath);
+            dir.setFilter(QDir::AllDirs | QDir::Readable |
+                          QDir::NoDotAndDotDot | QDir::NoSymLinks);
+        }
+    }
+
     // Create directory node
     int id = SyncDirectory(dirInfo, devId, base, parentId);
     if (id == -1)
@@ -282,13 +329,18 @@ void ImageScanThread<DBFS>::SyncSubTree(const QFileInfo &dirInfo, int parentId,
             // Scan this directory
             SyncSubTree(fileInfo, id, devId, base);
         }
-        else
+        else if (changed)
         {
             SyncFile(fileInfo, devId, base, id);
 
             QMutexLocker locker(&m_mutexProgress);
             ++m_progressCount;
 
+            // Incremental totals only count files in the changed dirs, not
+            // in any new subdirs. (count == total) signals scan end.
+            if (m_progressCount >= m_progressTotalCount)
+                m_progressTotalCount = m_progressCount + 1;
+
             // Throttle updates
             if (m_bcastTimer.elapsed() > 250)
                 Broadcast(m_progressCount);
@@ -297,6 +349,65 @@ void ImageScanThread<DBFS>::SyncSubTree(const QFileInfo &dirInfo, int parentId,
 }
 
 
+/*!
+ \brief Determine whether any dir below a dir has changed
+ \param path Absolute path of dir
+ \return bool True if a descendant is in the changed dirs journal
+*/
+template <class DBFS>
+bool ImageScanThread<DBFS>::HasChangedSubDir(const QString &path) const
+{
+    QString prefix = path + '/';
+    return std::any_of(m_changedDirs.cbegin(), m_changedDirs.cend(),
+                       [&prefix](const QString &dir){ return dir.startsWith(prefix); });
+}
+
+
+/*!
+ \brief Keeps Db images in unchanged dirs that an incremental scan skipped
+ \details Removes them from the maps of images that were not found, so that
+ they are not deleted from the Db.
+*/
+template <class DBFS>
+void ImageScanThread<DBFS>::RetainUnchanged()
+{
+    if (!m_incremental)
+        return;
+
+    auto retained = [this](const QString &filePath, bool isFile)
+    {
+        QString dir = isFile ? filePath.section('/', 0, -2) : filePath;
+        if (isFile && m_retainFiles.contains(dir))
+            return true;
+        while (!m_retainTrees.contains(dir))
+        {
+            if (dir.isEmpty())
+                return false;
+            dir = dir.section('/', 0, -2);
+        }
+        return true;
+    };
+
+    auto it = m_dbFileMap.begin();
+    while (it != m_dbFileMap.end())
+    {
+        if (retained(it.key(), true))
+            it = m_dbFileMap.erase(it);
+        else
+            ++it;
+    }
+
+    it = m_dbDirMap.begin();
+    while (it != m_dbDirMap.end())
+    {
+        if (retained(it.key(), false))
+            it = m_dbDirMap.erase(it);
+        else
+            ++it;
+    }
+}
+
+
 /*!
  \brief Updates/populates db for a dir
  \details Db is updated if dir modified time has changed since last scan.
@@ -592,8 +703,20 @@ void ImageScanThread<DBFS>::CountFiles(const QStringList &paths)
     for (const auto& sgDir : qAsConst(paths))
     {
         // Ignore missing dirs
-        if (dir.cd(sgDir))
+        if (!dir.cd(sgDir))
+            continue;
+
+        // Changed dirs are synced but their subdirs generally aren't
+        if (!m_incremental)
+        {
             CountTree(dir);
+            continue;
+        }
+
+        QFileInfoList entries = dir.entryInfoList();
+        for (const auto & fileInfo : qAsConst(entries))
+            if (fileInfo.isFile() && !MATCHES(m_exclusions, fileInfo.fileName()))
+                ++m_progressTotalCount;
     }
     // 0 signifies a scan start
     Broadcast(0);
@@ -15,6 +15,7 @@
 #include <QFileInfo>
 #include <QDir>
 #include <QElapsedTimer>
+#include <QSet>
 
 #include <QRegularExpression>
 #define REGEXP QRegularExpression
@@ -55,6 +56,8 @@ private:
                   const QString &base, int parentId);
     void CountTree(QDir &dir);
     void CountFiles(const QStringList &paths);
+    bool HasChangedSubDir(const QString &path) const;
+    void RetainUnchanged();
     void Broadcast(int progress);
 
     using ClearTask = QPair<int, QString>;
@@ -77,6 +80,15 @@ private:
     //! Ids of dirs/files that have been updates/modified.
     QStringList m_changedImages;
 
+    //! True if only the dirs journalled by the MediaWatcher are to be synced
+    bool          m_incremental {false};
+    //! Absolute paths of dirs that have changed since the last scan
+    QSet<QString> m_changedDirs;
+    //! Db filepaths of unchanged dirs whose subtrees were not scanned
+    QSet<QString> m_retainTrees;
+    //! Db filepaths of unchanged dirs whose files were not scanned
+    QSet<QString> m_retainFiles;
+
     //! Elapsed time since last progress event generated
     QElapsedTimer m_bcastTimer;
     int           m_progressCount      {0}; //!< Number of images scanned
@@ -1,7 +1,14 @@
 #include "imagethumbs.h"
 
+// C++ headers
+#include <algorithm>
+
+// Qt headers
 #include <QDir>
+#include <QElapsedTimer>
+#include <QImageReader>
 #include <QStringList>
+#include <QThread>
 
 #include "mythlogging.h"
 #include "mythcorecontext.h"  // for events
@@ -12,6 +19,24 @@
 
 #include "imagemetadata.h"
 
+//! Size of picture thumbnails
+static const QSize kThumbSize { 240, 180 };
+
+/*!
+ \brief Constructor
+ \details Background tasks are limited to all but one of the workers so that
+ display requests never wait for a background task to complete.
+*/
+template <class DBFS>
+ThumbThread<DBFS>::ThumbThread(const QString &name, DBFS *const dbfs, int threads)
+    : m_dbfs(*dbfs),
+      m_maxBackground(std::max(threads - 1, 1))
+{
+    for (int i = 0; i < std::max(threads, 1); ++i)
+        m_workers.append(new Worker(i ? QString("%1%2").arg(name).arg(i) : name, this));
+}
+
+
 /*!
  \brief Destructor
 */
@@ -19,7 +44,7 @@ template <class DBFS>
 ThumbThread<DBFS>::~ThumbThread()
 {
     cancel();
-    wait();
+    qDeleteAll(m_workers);
 }
 
 
@@ -53,9 +78,41 @@ void ThumbThread<DBFS>::Enqueue(const TaskPtr &task)
         else
             m_requestQ.insert(task->m_priority, task);
 
-        // restart if not already running
-        if ((m_doBackground || !background) && !this->isRunning())
-            this->start();
+        StartWorkers();
+    }
+}
+
+
+/*!
+ \brief Starts enough idle workers to process the queued tasks
+ \note Must be called with the queue mutex held
+*/
+template <class DBFS>
+void ThumbThread<DBFS>::StartWorkers()
+{
+    int needed = m_requestQ.size()
+            + (m_doBackground ? std::min(m_backgroundQ.size(),
+                                         m_maxBackground - m_activeBackground) : 0);
+
+    // Workers busy with a background task are not available to display
+    // requests until it completes, so only the others count towards them
+    for (auto *worker : qAsConst(m_workers))
+        if (worker->m_busy)
+            --needed;
+    needed += m_activeBackground;
+
+    for (auto *worker : qAsConst(m_workers))
+    {
+        if (needed <= 0)
+            break;
+        if (worker->m_busy)
+            continue;
+
+        // An idle worker may still be exiting, having left the queues
+        worker->wait();
+        worker->m_busy = true;
+        worker->start();
+        --needed;
     }
 }
 
@@ -85,9 +142,12 @@ void ThumbThread<DBFS>::AbortDevice(int devId, const QString &action)
     QMutexLocker locker(&m_mutex);
     RemoveTasks(m_requestQ, devId);
     RemoveTasks(m_backgroundQ, devId);
-    if (isRunning())
-        // Wait until current task is complete - it may be using the device
-        m_taskDone.wait(&m_mutex, 3000);
+
+    // Wait until current tasks are complete - they may be using the device
+    QElapsedTimer timer;
+    timer.start();
+    while (m_active > 0 && timer.elapsed() < 3000)
+        m_taskDone.wait(&m_mutex, static_cast<unsigned long>(3000 - timer.elapsed()));
 }
 
 
@@ -117,116 +177,151 @@ void ThumbThread<DBFS>::RemoveTasks(ThumbQueue &queue, int devId)
 /*!
  \brief  Handles thumbnail requests by priority
  \details Repeatedly processes next request from highest priority queue until all
-  queues are empty, then quits. For Create requests an event is broadcast once the
-  thumbnail exists. Dirs are only deleted if empty
+  queues are empty, then quits. Create requests are processed by all workers
+  concurrently; Delete & Move requests are processed alone so that they never act
+  on a thumbnail that is being created.
+ \param worker The worker thread calling
 */
 template <class DBFS>
-void ThumbThread<DBFS>::run()
+void ThumbThread<DBFS>::Process(Worker *worker)
 {
-    RunProlog();
-
-    setPriority(QThread::LowestPriority);
-
+    QMutexLocker locker(&m_mutex);
     while (true)
     {
-        // Signal previous task is complete (its files have been closed)
-        m_taskDone.wakeAll();
+        // process next highest-priority task
+        ThumbQueue *queue = nullptr;
+        if (!m_requestQ.isEmpty())
+            queue = &m_requestQ;
+        else if (m_doBackground && !m_backgroundQ.isEmpty()
+                 && m_activeBackground < m_maxBackground)
+            queue = &m_backgroundQ;
+        else
+            // quit when there is nothing this worker can do
+            break;
+
+        TaskPtr next = queue->constBegin().value();
+        bool exclusive = next && next->m_action != "CREATE";
+        if (m_exclusive || (exclusive && m_active > 0))
+        {
+            // Wait for the other workers to finish
+            m_taskDone.wait(&m_mutex);
+            continue;
+        }
+
+        bool background = queue == &m_backgroundQ;
+        TaskPtr task = queue->take(queue->constBegin().key());
+        ++m_active;
+        if (background)
+            ++m_activeBackground;
+        m_exclusive = exclusive;
+
+        locker.unlock();
 
         // Do all we can to run in background
         QThread::yieldCurrentThread();
 
-        // process next highest-priority task
-        TaskPtr task;
-        {
-            QMutexLocker locker(&m_mutex);
-            if (!m_requestQ.isEmpty())
-                task = m_requestQ.take(m_requestQ.constBegin().key());
-            else if (m_doBackground && !m_backgroundQ.isEmpty())
-                task = m_backgroundQ.take(m_backgroundQ.constBegin().key());
-            else
-                // quit when both queues exhausted
-                break;
-        }
+        HandleTask(task);
 
-        // Shouldn't receive empty requests
-        if (task->m_images.isEmpty())
-            continue;
+        locker.relock();
 
-        if (task->m_action == "CREATE")
-        {
-            ImagePtrK im = task->m_images.at(0);
+        --m_active;
+        if (background)
+            --m_activeBackground;
+        m_exclusive = false;
 
-            QString err = CreateThumbnail(im, task->m_priority);
+        // Signal task is complete (its files have been closed)
+        m_taskDone.wakeAll();
+    }
 
-            if (!err.isEmpty())
-            {
-                LOG(VB_GENERAL, LOG_ERR,  QString("%1").arg(err));
-            }
-            else if (task->m_notify)
-            {
-                // notify clients when done
-                m_dbfs.Notify("THUMB_AVAILABLE",
-                              QStringList(QString::number(im->m_id)));
-            }
+    worker->m_busy = false;
+}
+
+
+/*!
+ \brief  Processes a thumbnail request
+ \details For Create requests an event is broadcast once the thumbnail exists.
+  Dirs are only deleted if empty
+ \param task The request
+*/
+template <class DBFS>
+void ThumbThread<DBFS>::HandleTask(const TaskPtr &task)
+{
+    // Shouldn't receive empty requests
+    if (!task || task->m_images.isEmpty())
+        return;
+
+    if (task->m_action == "CREATE")
+    {
+        ImagePtrK im = task->m_images.at(0);
+
+        QString err = CreateThumbnail(im, task->m_priority);
+
+        if (!err.isEmpty())
+        {
+            LOG(VB_GENERAL, LOG_ERR,  QString("%1").arg(err));
         }
-        else if (task->m_action == "DELETE")
+        else if (task->m_notify)
+        {
+            // notify clients when done
+            m_dbfs.Notify("THUMB_AVAILABLE",
+                          QStringList(QString::number(im->m_id)));
+        }
+    }
+    else if (task->m_action == "DELETE")
+    {
+        for (const auto& im : qAsConst(task->m_images))
         {
-            for (const auto& im : qAsConst(task->m_images))
+            QString thumbnail = im->m_thumbPath;
+            if (!QDir::root().remove(thumbnail))
             {
-                QString thumbnail = im->m_thumbPath;
-                if (!QDir::root().remove(thumbnail))
-                {
-                    LOG(VB_FILE, LOG_WARNING,
-                        QString("Failed to delete thumbnail %1").arg(thumbnail));
-                    continue;
-                }
-                LOG(VB_FILE, LOG_DEBUG,
-                    QString("Deleted thumbnail %1").arg(thumbnail));
-
-                // Clean up empty dirs
-                QString path = QFileInfo(thumbnail).path();
-                if (QDir::root().rmpath(path))
-                    LOG(VB_FILE, LOG_DEBUG,
-                        QString("Cleaned up path %1").arg(path));
+                LOG(VB_FILE, LOG_WARNING,
+                    QString("Failed to delete thumbnail %1").arg(thumbnail));
+                continue;
             }
+            LOG(VB_FILE, LOG_DEBUG,
+                QString("Deleted thumbnail %1").arg(thumbnail));
+
+            // Clean up empty dirs
+            QString path = QFileInfo(thumbnail).path();
+            if (QDir::root().rmpath(path))
+                LOG(VB_FILE, LOG_DEBUG,
+                    QString("Cleaned up path %1").arg(path));
         }
-        else if (task->m_action == "MOVE")
+    }
+    else if (task->m_action == "MOVE")
+    {
+        for (const auto& im : qAsConst(task->m_images))
         {
-            for (const auto& im : qAsConst(task->m_images))
+            // Build new thumb path
+            QString newThumbPath =
+                    m_dbfs.GetAbsThumbPath(m_dbfs.ThumbDir(im->m_device),
+                                           m_dbfs.ThumbPath(*im.data()));
+
+            // Ensure path exists
+            if (QDir::root().mkpath(QFileInfo(newThumbPath).path())
+                    && QFile::rename(im->m_thumbPath, newThumbPath))
+            {
+                LOG(VB_FILE, LOG_DEBUG, QString("Moved thumbnail %1 -> %2")
+                    .arg(im->m_thumbPath, newThumbPath));
+            }
+            else
             {
-                // Build new thumb path
-                QString newThumbPath =
-                        m_dbfs.GetAbsThumbPath(m_dbfs.ThumbDir(im->m_device),
-                                               m_dbfs.ThumbPath(*im.data()));
-
-                // Ensure path exists
-                if (QDir::root().mkpath(QFileInfo(newThumbPath).path())
-                        && QFile::rename(im->m_thumbPath, newThumbPath))
-                {
-                    LOG(VB_FILE, LOG_DEBUG, QString("Moved thumbnail %1 -> %2")
-                        .arg(im->m_thumbPath, newThumbPath));
-                }
-                else
-                {
-                    LOG(VB_FILE, LOG_WARNING,
-                        QString("Failed to rename thumbnail %1 -> %2")
-                        .arg(im->m_thumbPath, newThumbPath));
-                    continue;
-                }
-
-                // Clean up empty dirs
-                QString path = QFileInfo(im->m_thumbPath).path();
-                if (QDir::root().rmpath(path))
-                    LOG(VB_FILE, LOG_DEBUG,
-                        QString("Cleaned up path %1").arg(path));
+                LOG(VB_FILE, LOG_WARNING,
+                    QString("Failed to rename thumbnail %1 -> %2")
+                    .arg(im->m_thumbPath, newThumbPath));
+                continue;
             }
+
+            // Clean up empty dirs
+            QString path = QFileInfo(im->m_thumbPath).path();
+            if (QDir::root().rmpath(path))
+                LOG(VB_FILE, LOG_DEBUG,
+                    QString("Cleaned up path %1").arg(path));
         }
-        else
-            LOG(VB_GENERAL, LOG_ERR,
-                QString("Unknown task %1").arg(task->m_action));
     }
-
-    RunEpilog();
+    else
+        LOG(VB_GENERAL, LOG_ERR,
+            QString("Unknown task %1").arg(task->m_action));
 }
 
 
@@ -256,13 +351,15 @@ QString ThumbThread<DBFS>::CreateThumbnail(ImagePtrK im, int thumbPriority)
     QDir::root().mkpath(QFileInfo(im->m_thumbPath).path());
 
     QImage image;
+    bool embedded = false;
     if (im->m_type == kImageFile)
     {
-        if (!image.load(imagePath))
+        image = LoadPicture(imagePath, embedded);
+        if (image.isNull())
             return QString("Failed to open image %1").arg(imagePath);
 
         // Resize to optimise load/display time by FE's
-        image = image.scaled(QSize(240,180), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        image = image.scaled(kThumbSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
     }
     else if (im->m_type == kVideoFile)
     {
@@ -299,7 +396,7 @@ QString ThumbThread<DBFS>::CreateThumbnail(ImagePtrK im, int thumbPriority)
 
     // Compensate for any Qt auto-orientation
     int orientBy = Orientation(im->m_orientation)
-            .GetCurrent(im->m_type == kImageFile);
+            .GetCurrent(im->m_type == kImageFile && !embedded);
 
     // Orientate now to optimise load/display time - no orientation
     // is required when displaying thumbnails
@@ -315,6 +412,56 @@ QString ThumbThread<DBFS>::CreateThumbnail(ImagePtrK im, int thumbPriority)
 }
 
 
+/*!
+ \brief Load a picture at no more than the resolution needed for a thumbnail
+ \details The picture is decoded at reduced size when its format supports it,
+ which for JPEGs is done by libjpeg whilst decoding (DCT scaling), so 24 MP
+ photos are neither fully decoded nor held in memory. Other formats use the
+ thumbnail embedded in the Exif data instead, if it is large enough and has
+ the same aspect ratio as the picture. The orientation is already in the
+ database, so the metadata is only read for these.
+ \param path Picture path
+ \param[out] embedded True if the embedded thumbnail was used
+ \return The picture or a null image if it couldn't be read
+*/
+template <class DBFS>
+QImage ThumbThread<DBFS>::LoadPicture(const QString &path, bool &embedded)
+{
+    QImageReader reader(path);
+    QSize size = reader.size();
+
+    embedded = false;
+    if (size.isValid() && reader.supportsOption(QImageIOHandler::ScaledSize))
+    {
+        // Decode at twice the thumbnail size so that smooth scaling has data
+        QSize scaled = size.scaled(kThumbSize * 2, Qt::KeepAspectRatio);
+        if (scaled.width() < size.width())
+            reader.setScaledSize(scaled);
+    }
+    else if (size.isValid())
+    {
+        QScopedPointer<ImageMetaData> metadata(ImageMetaData::FromPicture(path));
+        QImage thumbnail = metadata->GetThumbnail();
+
+        QSize needed = size.scaled(kThumbSize, Qt::KeepAspectRatio);
+        if (!thumbnail.isNull()
+                && thumbnail.width() >= needed.width()
+                && thumbnail.height() >= needed.height()
+                && qAbs(thumbnail.width() * size.height()
+                        - thumbnail.height() * size.width())
+                   <= thumbnail.width() * size.height() / 100)
+        {
+            LOG(VB_FILE, LOG_DEBUG, QString("Using %1x%2 Exif thumbnail of %3")
+                .arg(thumbnail.width()).arg(thumbnail.height()).arg(path));
+            embedded = true;
+            return thumbnail;
+        }
+    }
+
+    return reader.read();
+}
+
+
 /*!
   \brief Pauses or restarts processing of background tasks (scanner requests)
  */
@@ -325,8 +472,7 @@ void ThumbThread<DBFS>::PauseBackground(bool pause)
     m_doBackground = !pause;
 
     // restart if not already running
-    if (m_doBackground && !this->isRunning())
-        this->start();
+    StartWorkers();
 }
 
 
@@ -336,7 +482,8 @@ void ThumbThread<DBFS>::PauseBackground(bool pause)
 template <class DBFS>
 ImageThumb<DBFS>::ImageThumb(DBFS *const dbfs)
     : m_dbfs(*dbfs),
-      m_imageThread(new ThumbThread<DBFS>("ImageThumbs", dbfs)),
+      m_imageThread(new ThumbThread<DBFS>("ImageThumbs", dbfs,
+                                          QThread::idealThreadCount())),
       m_videoThread(new ThumbThread<DBFS>("VideoThumbs", dbfs))
 {}
 
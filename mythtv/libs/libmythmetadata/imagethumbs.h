@@ -1,12 +1,13 @@
 //! \file
 //! \brief Creates and manages thumbnails
-//! \details Uses two worker threads to process thumbnail requests that are queued
+//! \details Uses two generators to process thumbnail requests that are queued
 //! from the scanner and UI.
-//! One thread generates picture thumbs; the other video thumbs, which are delegated
-//! to previewgenerator and time-consuming.
-//! Both background threads are low-priority to avoid recording issues.
+//! One generates picture thumbs using a thread per core; the other video thumbs,
+//! which are delegated to previewgenerator and time-consuming, using a single thread.
+//! All worker threads are low-priority to avoid recording issues.
 //! Requests are handled by client-assigned priority so that UI display requests
-//! are serviced before background scanner requests.
+//! are serviced before background scanner requests. Background requests never
+//! occupy every picture thread, so display requests are started immediately.
 //! When images are removed, their thumbnails are also deleted (thumbnail cache is
 //! synchronised to database). Obsolete images are broadcast to enable clients to
 //! also cleanup/synchronise their caches.
@@ -17,6 +18,8 @@
 #include <utility>
 
 // Qt headers
+#include <QImage>
+#include <QList>
 #include <QMap>
 #include <QMutex>
 #include <QWaitCondition>
@@ -82,40 +85,71 @@ public:
 using TaskPtr = QSharedPointer<ThumbTask>;
 
 
-//! A generator worker thread
+//! A generator that processes its queued requests on a set of worker threads
 template <class DBFS>
-class ThumbThread : public MThread
+class ThumbThread
 {
 public:
     /*!
      \brief Constructor
      \param name Thread name
      \param dbfs Filesystem/Database adapter
+     \param threads Number of worker threads
     */
-    ThumbThread(const QString &name, DBFS *const dbfs)
-        : MThread(name), m_dbfs(*dbfs) {}
-    ~ThumbThread() override;
+    ThumbThread(const QString &name, DBFS *const dbfs, int threads = 1);
+    ~ThumbThread();
 
     void cancel();
     void Enqueue(const TaskPtr &task);
     void AbortDevice(int devId, const QString &action);
     void PauseBackground(bool pause);
 
-protected:
-    void run() override; // MThread
-
 private:
     Q_DISABLE_COPY(ThumbThread)
 
+    //! A worker thread that processes the queues of its generator
+    class Worker : public MThread
+    {
+    public:
+        Worker(const QString &name, ThumbThread *parent)
+            : MThread(name), m_parent(parent) {}
+        ~Worker() override { wait(); }
+
+        //! Whether the worker is processing the queues. Protected by queue mutex
+        bool m_busy {false};
+
+    protected:
+        void run() override // MThread
+        {
+            RunProlog();
+            setPriority(QThread::LowestPriority);
+            m_parent->Process(this);
+            RunEpilog();
+        }
+
+    private:
+        ThumbThread *m_parent;
+    };
+
     //! A priority queue where 0 is highest priority
     using ThumbQueue = QMultiMap<int, TaskPtr>;
 
+    void Process(Worker *worker);
+    void HandleTask(const TaskPtr &task);
+    void StartWorkers();
     QString CreateThumbnail(ImagePtrK im, int thumbPriority);
+    static QImage LoadPicture(const QString &path, bool &embedded);
     static void RemoveTasks(ThumbQueue &queue, int devId);
 
     DBFS &m_dbfs;               //!< Database/filesystem adapter
     QWaitCondition m_taskDone;  //! Synchronises completed tasks
 
+    QList<Worker*> m_workers;    //!< Worker threads
+    int m_maxBackground {1};     //!< Max workers processing background tasks
+    int m_active {0};            //!< Number of tasks being processed
+    int m_activeBackground {0};  //!< Number of background tasks being processed
+    bool m_exclusive {false};    //!< A Delete/Move task is being processed alone
+
     ThumbQueue m_requestQ;   //!< Priority queue of requests
     ThumbQueue m_backgroundQ;   //!< Priority queue of background tasks
     bool m_doBackground {true}; //!< Whether to process background tasks
@@ -150,7 +184,7 @@ private:
 
     //! Db/filesystem adapter
     DBFS              &m_dbfs;
-    //! Thread generating picture thumbnails
+    //! Threads generating picture thumbnails
     ThumbThread<DBFS> *m_imageThread;
     //! Thread generating video previews
     ThumbThread<DBFS> *m_videoThread;
@@ -0,0 +1,383 @@
+#include "mediawatcher.h"
+
+// POSIX headers
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+
+// C++ headers
+#include <utility>
+
+// Qt headers
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QMutex>
+#include <QTextStream>
+#include <QTimer>
+
+// MythTV headers
+#include "mthread.h"
+#include "mythchrono.h"
+#include "mythcorecontext.h"
+#include "mythdate.h"
+#include "mythdirs.h"
+#include "mythlogging.h"
+
+#define LOC QString("MediaWatcher(%1): ").arg(m_name)
+
+// Journal header written by a watcher that is watching every directory
+static const QString kHeaderStart      { "start " };
+// Journal header written by a watcher that failed to watch some directories
+static const QString kHeaderIncomplete { "incomplete " };
+// Both headers are followed by the start time and the pid of the watcher
+
+/*!
+ \brief Whether the watcher that wrote a journal header is still running
+ \details A watcher deletes its journal when it stops, so this only fails
+ for a journal left by a watcher that did not stop cleanly.
+*/
+static bool WatcherIsLive(const QByteArray &header)
+{
+    QList<QByteArray> fields = header.trimmed().split(' ');
+    bool ok = false;
+    pid_t pid = (fields.size() >= 3) ? fields[2].toInt(&ok) : 0;
+    if (!ok || pid <= 0)
+        return false;
+    return kill(pid, 0) == 0 || errno == EPERM;
+}
+
+// Changes are batched as copying a single album generates many events
+static constexpr std::chrono::milliseconds kFlushDelay { 2s };
+
+// Times at which the journals taken by this process were taken
+static QMutex                   s_takenLock;
+static QHash<QString, QDateTime> s_taken;
+
+/*!
+ \brief Start watching a media library
+ \param name Journal name, shared with the scanner of this library
+ \param roots Root dirs of the library
+*/
+MediaWatcher::MediaWatcher(QString name, QStringList roots)
+  : m_name(std::move(name)),
+    m_roots(std::move(roots)),
+    m_thread(new MThread("MediaWatcher"))
+{
+    moveToThread(m_thread->qthread());
+    m_thread->start();
+
+    // The initial walk of the tree is done in the watcher thread
+    QMetaObject::invokeMethod(this, "Start", Qt::QueuedConnection);
+}
+
+MediaWatcher::~MediaWatcher()
+{
+    QMetaObject::invokeMethod(this, "Stop", Qt::BlockingQueuedConnection);
+    m_thread->quit();
+    m_thread->wait();
+    delete m_thread;
+}
+
+/// \brief Watch every dir of the library and start a new journal
+void MediaWatcher::Start(void)
+{
+    m_watcher = new QFileSystemWatcher(this);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged,
+            this, &MediaWatcher::DirectoryChanged);
+
+    m_flushTimer = new QTimer(this);
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(kFlushDelay);
+    connect(m_flushTimer, &QTimer::timeout, this, &MediaWatcher::Flush);
+
+    for (const auto & root : qAsConst(m_roots))
+        WatchTree(QDir::cleanPath(root));
+
+    // Dirs are only watched once the walk reaches them, so the journal only
+    // covers changes from now on.
+    m_started = MythDate::current();
+    WriteJournal({}, true);
+
+    LOG(VB_GENERAL, LOG_INFO, LOC + QString("Watching %1 directories%2")
+        .arg(m_watched.size())
+        .arg(m_complete ? "" : " (incomplete)"));
+}
+
+/*!
+ \brief Stop watching and close the journal
+ \details Changes made from now on are not journalled, so the journal is
+ deleted and the next scan walks the whole library. A journal already taken
+ by a scan is left for it.
+*/
+void MediaWatcher::Stop(void)
+{
+    delete m_flushTimer;
+    m_flushTimer = nullptr;
+    delete m_watcher;
+    m_watcher = nullptr;
+    m_pending.clear();
+
+    QFile::remove(JournalPath(m_name));
+}
+
+/*!
+ \brief Watch a dir and all of its subdirs
+ \param path Dir to watch
+*/
+void MediaWatcher::WatchTree(const QString &path)
+{
+    if (m_watched.contains(path))
+        return;
+
+    if (!m_watcher->addPath(path))
+    {
+        if (m_complete)
+        {
+            LOG(VB_GENERAL, LOG_WARNING, LOC +
+                QString("Failed to watch %1. Increase the "
+                        "fs.inotify.max_user_watches sysctl to avoid full scans.")
+                .arg(path));
+        }
+        m_complete = false;
+        return;
+    }
+    m_watched.insert(path);
+
+    QDir dir(path);
+    dir.setFilter(QDir::AllDirs | QDir::NoDotAndDotDot | QDir::NoSymLinks);
+    QStringList subdirs = dir.entryList();
+    for (const auto & subdir : qAsConst(subdirs))
+        WatchTree(dir.absoluteFilePath(subdir));
+}
+
+/*!
+ \brief Notes a dir whose entries have changed
+ \details New subdirs are watched immediately and removed ones forgotten.
+ \param path The changed dir
+*/
+void MediaWatcher::DirectoryChanged(const QString &path)
+{
+    LOG(VB_FILE, LOG_DEBUG, LOC + QString("Changed %1").arg(path));
+
+    m_pending.insert(path);
+
+    QDir dir(path);
+    if (dir.exists())
+    {
+        dir.setFilter(QDir::AllDirs | QDir::NoDotAndDotDot | QDir::NoSymLinks);
+        QStringList subdirs = dir.entryList();
+        for (const auto & subdir : qAsConst(subdirs))
+            WatchTree(dir.absoluteFilePath(subdir));
+    }
+    else
+    {
+        // The dir has been removed or moved away. Stop watching its subtree
+        // so that the paths can be watched again if they reappear.
+        QStringList gone { path };
+        QString prefix = path + '/';
+        for (const auto & watched : qAsConst(m_watched))
+            if (watched.startsWith(prefix))
+                gone << watched;
+        for (const auto & watched : qAsConst(gone))
+            m_watched.remove(watched);
+        m_watcher->removePaths(gone);
+    }
+
+    if (!m_flushTimer->isActive())
+        m_flushTimer->start();
+}
+
+/// \brief Appends the changed dirs to the journal
+void MediaWatcher::Flush(void)
+{
+    if (m_pending.isEmpty())
+        return;
+
+    if (WriteJournal(m_pending.values(), false))
+        m_pending.clear();
+}
+
+/*!
+ \brief Writes to the journal
+ \param dirs Changed dirs to append
+ \param create If true the journal is restarted, otherwise it is appended to
+ \return bool True if the journal was written
+*/
+bool MediaWatcher::WriteJournal(const QStringList &dirs, bool create)
+{
+    QFile file(JournalPath(m_name));
+    QIODevice::OpenMode mode = QIODevice::WriteOnly | QIODevice::Text;
+    mode |= create ? QIODevice::Truncate : QIODevice::Append;
+    if (!file.open(mode))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Failed to write %1").arg(file.fileName()));
+        return false;
+    }
+
+    QTextStream stream(&file);
+
+    // A scanner takes the journal by renaming it, so it may need a new header
+    if (file.size() == 0)
+    {
+        stream << (m_complete ? kHeaderStart : kHeaderIncomplete)
+               << m_started.toString(Qt::ISODate) << ' '
+               << QCoreApplication::applicationPid() << '\n';
+    }
+
+    for (const auto & dir : qAsConst(dirs))
+        stream << dir << '\n';
+
+    return true;
+}
+
+/*!
+ \brief Path of a journal file
+ \param name Journal name
+*/
+QString MediaWatcher::JournalPath(const QString &name)
+{
+    QDir confDir(GetConfDir());
+    confDir.mkdir("mediawatch");
+    return confDir.absoluteFilePath(QString("mediawatch/%1.journal").arg(name));
+}
+
+/*!
+ \brief Takes the journal of changes made since the last scan
+ \details The journal is moved aside so that the watcher starts a new one.
+ It is deleted by CommitJournal() once the scan completes; if the scan fails it
+ is merged into the journal taken by the next scan. Only a running watcher
+ keeps a journal, so without one a full scan is always needed.
+ \param name Journal name
+ \param[out] dirs Dirs that have changed since the last scan
+ \return bool True if the dirs are a complete record of the changes since the
+ last scan. False if a full scan is needed.
+*/
+bool MediaWatcher::TakeJournal(const QString &name, QStringList &dirs)
+{
+    QDateTime now = MythDate::current();
+    {
+        QMutexLocker locker(&s_takenLock);
+        s_taken.insert(name, now);
+    }
+
+    QString journal = JournalPath(name);
+    QString taken   = journal + ".scan";
+    QString moved   = journal + ".tmp";
+
+    // Add the current journal to any left by a failed scan
+    bool live = false;
+    if (QFile::exists(journal) && QFile::rename(journal, moved))
+    {
+        QFile in(moved);
+        QFile out(taken);
+        if (in.open(QIODevice::ReadOnly) && out.open(QIODevice::Append))
+        {
+            QByteArray data = in.readAll();
+            out.write(data);
+
+            // Restart the journal with the same header, unless the watcher
+            // has already done so, as it only writes one when it has changes.
+            // A journal left by a watcher that is no longer running is not
+            // restarted, as nothing would add to it.
+            QByteArray header = data.left(data.indexOf('\n') + 1);
+            live = WatcherIsLive(header);
+            int fd = live ? open(journal.toLocal8Bit().constData(),
+                                 O_WRONLY | O_CREAT | O_EXCL, 0644) : -1;
+            if (fd >= 0)
+            {
+                if (write(fd, header.constData(), header.size()) < 0)
+                    LOG(VB_GENERAL, LOG_ERR, QString("MediaWatcher(%1): Failed "
+                        "to restart journal: ").arg(name) + ENO);
+                close(fd);
+            }
+        }
+        in.close();
+        in.remove();
+    }
+
+    QFile file(taken);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        LOG(VB_GENERAL, LOG_INFO,
+            QString("MediaWatcher(%1): No journal, full scan required").arg(name));
+        return false;
+    }
+
+    QString host      = gCoreContext->GetHostName();
+    QDateTime lastScan = MythDate::fromString(
+        gCoreContext->GetSettingOnHost(QString("MediaWatch%1LastScan").arg(name), host));
+    QDateTime lastFull = MythDate::fromString(
+        gCoreContext->GetSettingOnHost(QString("MediaWatch%1LastFullScan").arg(name), host));
+    int fullDays = gCoreContext->GetNumSetting("MediaWatchFullScanDays", 7);
+
+    QString reason;
+    if (!live)
+        reason = "the watcher is not running";
+    else if (!lastScan.isValid() || !lastFull.isValid())
+        reason = "no previous scan";
+    else if (fullDays > 0 && lastFull.addDays(fullDays) < now)
+        reason = "periodic verification";
+
+    QSet<QString> changed;
+    QTextStream stream(&file);
+    while (!stream.atEnd())
+    {
+        QString line = stream.readLine();
+        if (line.startsWith(kHeaderIncomplete))
+        {
+            reason = "not all directories are watched";
+        }
+        else if (line.startsWith(kHeaderStart))
+        {
+            QDateTime started = MythDate::fromString(
+                line.mid(kHeaderStart.size()).section(' ', 0, 0));
+            if (!started.isValid() || !lastScan.isValid() || started > lastScan)
+                reason = "changes since the last scan were not watched";
+        }
+        else if (!line.isEmpty())
+        {
+            changed.insert(line);
+        }
+    }
+
+    if (!reason.isEmpty())
+    {
+        LOG(VB_GENERAL, LOG_INFO, QString("MediaWatcher(%1): Full scan required, %2")
+            .arg(name, reason));
+        return false;
+    }
+
+    dirs = changed.values();
+    LOG(VB_GENERAL, LOG_INFO, QString("MediaWatcher(%1): %2 changed directories")
+        .arg(name).arg(dirs.size()));
+    return true;
+}
+
+/*!
+ \brief Discards the journal taken by a successful scan
+ \param name Journal name
+ \param fullScan True if the scan walked the entire library
+*/
+void MediaWatcher::CommitJournal(const QString &name, bool fullScan)
+{
+    QDateTime taken;
+    {
+        QMutexLocker locker(&s_takenLock);
+        taken = s_taken.take(name);
+    }
+    if (!taken.isValid())
+        return;
+
+    QFile::remove(JournalPath(name) + ".scan");
+
+    QString host = gCoreContext->GetHostName();
+    QString time = taken.toString(Qt::ISODate);
+    gCoreContext->SaveSettingOnHost(QString("MediaWatch%1LastScan").arg(name), time, host);
+    if (fullScan)
+        gCoreContext->SaveSettingOnHost(QString("MediaWatch%1LastFullScan").arg(name), time, host);
+}
@@ -0,0 +1,67 @@
+//! \file
+//! \brief Journals changes to media directory trees
+//! \details A MediaWatcher runs in the backend and watches every directory of a
+//! media library (eg. the Music or Photographs storage groups) for entries being
+//! added, removed or renamed. Changed directories are appended to a journal in the
+//! config dir, which is shared with scanners running in the backend itself or in
+//! processes it launches (mythutil --scanmusic).
+//!
+//! Scanners take the journal at the start of a scan and only revisit the
+//! directories it lists. A full scan is still required when there is no journal,
+//! when the watcher was not running for the whole period since the last scan, when
+//! the watcher could not watch every directory, and periodically, as in-place file
+//! modifications and changes made by other hosts on network mounts are not reported.
+
+#ifndef MEDIAWATCHER_H
+#define MEDIAWATCHER_H
+
+// Qt headers
+#include <QDateTime>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+
+// MythTV headers
+#include "mythmetaexp.h"
+
+class MThread;
+class QFileSystemWatcher;
+class QTimer;
+
+class META_PUBLIC MediaWatcher : public QObject
+{
+    Q_OBJECT
+
+  public:
+    MediaWatcher(QString name, QStringList roots);
+    ~MediaWatcher() override;
+
+    static bool TakeJournal(const QString &name, QStringList &dirs);
+    static void CommitJournal(const QString &name, bool fullScan);
+
+  private slots:
+    void Start(void);
+    void Stop(void);
+    void DirectoryChanged(const QString &path);
+    void Flush(void);
+
+  private:
+    Q_DISABLE_COPY(MediaWatcher)
+
+    void WatchTree(const QString &path);
+    bool WriteJournal(const QStringList &dirs, bool create);
+
+    static QString JournalPath(const QString &name);
+
+    QString             m_name;
+    QStringList         m_roots;
+    MThread            *m_thread   {nullptr};
+    QFileSystemWatcher *m_watcher  {nullptr};
+    QTimer             *m_flushTimer {nullptr};
+    QSet<QString>       m_watched;        //!< Dirs being watched
+    QSet<QString>       m_pending;        //!< Changed dirs not yet journalled
+    QDateTime           m_started;        //!< Time from which all changes are journalled
+    bool                m_complete {true}; //!< False if any dir could not be watched
+};
+
+#endif // MEDIAWATCHER_H
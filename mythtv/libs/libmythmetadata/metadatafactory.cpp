@@ -290,6 +290,7 @@ void MetadataFactory::VideoScan(const QStringList& hosts)
         return;
 
     m_scanning = true;
+    m_scanAdditions.clear();
 
     m_videoscanner->SetHosts(hosts);
     m_videoscanner->SetDirs(GetVideoDirs());
@@ -600,6 +601,25 @@ void MetadataFactory::customEvent(QEvent *levent)
             QCoreApplication::postEvent(parent(),
                             new ImageDLFailureEvent(lookup));
     }
+    else if (levent->type() == VideoScanAdditions::kEventType)
+    {
+        auto *vsa = dynamic_cast<VideoScanAdditions *>(levent);
+        if (!vsa || !m_scanning)
+            return;
+
+        // Start looking up new videos while the rest are still being added
+        for (int id : qAsConst(vsa->m_additions))
+        {
+            VideoMetadataListManager::VideoMetadataPtr metadata =
+                VideoMetadataListManager::loadOneFromDatabase(id);
+
+            if (metadata)
+            {
+                m_scanAdditions.insert(id, metadata);
+                Lookup(metadata.get(), true, true);
+            }
+        }
+    }
     else if (levent->type() == VideoScanChanges::kEventType)
     {
         auto *vsc = dynamic_cast<VideoScanChanges *>(levent);
@@ -631,16 +651,27 @@ void MetadataFactory::customEvent(QEvent *levent)
                 .arg(additions.count()).arg(moves.count())
                 .arg(deletions.count()));
 
-            VideoMetadataListManager::metadata_list ml;
-            VideoMetadataListManager::loadAllFromDatabase(ml);
-            m_mlm->setList(ml);
-
+            // Most additions were looked up as the scan progressed
+            QList<int> remaining;
             for (int id : qAsConst(additions))
             {
-                VideoMetadata *metadata = m_mlm->byID(id).get();
+                if (!m_scanAdditions.contains(id))
+                    remaining << id;
+            }
+
+            if (!remaining.isEmpty())
+            {
+                VideoMetadataListManager::metadata_list ml;
+                VideoMetadataListManager::loadAllFromDatabase(ml);
+                m_mlm->setList(ml);
+
+                for (int id : qAsConst(remaining))
+                {
+                    VideoMetadata *metadata = m_mlm->byID(id).get();
 
-                if (metadata)
-                    Lookup(metadata, true, true);
+                    if (metadata)
+                        Lookup(metadata, true, true);
+                }
             }
         }
         m_videoscanner->ResetCounts();
@@ -3,6 +3,8 @@
 
 #include <utility>
 
+#include <QMap>
+
 // Needed to perform a lookup
 #include "metadatacommon.h"
 #include "metadataimagedownload.h"
@@ -10,6 +12,7 @@
 
 // Needed to perform scans
 #include "videoscan.h"
+#include "videometadatalistmanager.h"
 
 // Symbol visibility
 #include "mythmetaexp.h"
@@ -132,6 +135,8 @@ class META_PUBLIC MetadataFactory : public QObject
 
     VideoScannerThread *m_videoscanner     {nullptr};
     VideoMetadataListManager *m_mlm        {nullptr};
+    // New videos looked up during the scan, which their lookups refer to
+    QMap<int, VideoMetadataListManager::VideoMetadataPtr> m_scanAdditions;
     bool m_scanning                        {false};
 
     // Variables used in synchronous mode
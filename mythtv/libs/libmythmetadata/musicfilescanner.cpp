@@ -2,8 +2,18 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+// C++ headers
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
 // Qt headers
 #include <QDir>
+#include <QElapsedTimer>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
 
 // MythTV headers
 #include <mythdate.h>
@@ -12,6 +22,71 @@
 #include <musicmetadata.h>
 #include <metaio.h>
 #include <musicfilescanner.h>
+#include <mediawatcher.h>
+#include <mthreadpool.h>
+
+// Number of tracks read and written to the database at a time
+static constexpr int kTrackBatchSize { 100 };
+
+/*!
+ * \brief Reads the tags of a track on a worker thread
+ */
+class MusicTagReader : public QRunnable
+{
+  public:
+    MusicTagReader(QString filename, QString startDir, bool readAlbumArt, QSemaphore &done)
+      : m_filename(std::move(filename)),
+        m_startDir(std::move(startDir)),
+        m_readAlbumArt(readAlbumArt),
+        m_done(done)
+    {
+        setAutoDelete(false);
+    }
+
+    ~MusicTagReader() override
+    {
+        delete m_data;
+        qDeleteAll(m_albumArt);
+    }
+
+    void run() override
+    {
+        LOG(VB_FILE, LOG_INFO, QString("Reading metadata from %1").arg(m_filename));
+        m_data = MetaIO::readMetadata(m_filename);
+        if (m_data)
+        {
+            m_data->setFileSize((quint64)QFileInfo(m_filename).size());
+
+            // read any embedded images from the tag
+            MetaIO *tagger = m_readAlbumArt ? MetaIO::createTagger(m_filename) : nullptr;
+            if (tagger)
+            {
+                if (tagger->supportsEmbeddedImages())
+                    m_albumArt = tagger->getAlbumArtList(m_filename);
+                delete tagger;
+            }
+        }
+        m_done.release();
+    }
+
+    QString        m_filename;
+    QString        m_startDir;
+    bool           m_readAlbumArt {false};
+    MusicMetadata *m_data {nullptr};
+    AlbumArtList   m_albumArt;
+    QSemaphore    &m_done;
+};
+
+/*!
+ * \brief A batch of tracks whose tags are being read
+ */
+struct MusicTagBatch
+{
+    ~MusicTagBatch() { qDeleteAll(m_readers); }
+
+    QList<MusicTagReader*> m_readers;
+    QSemaphore             m_done;
+};
 
 MusicFileScanner::MusicFileScanner(bool force) : m_forceupdate{force}
 {
@@ -67,11 +142,16 @@ MusicFileScanner::MusicFileScanner(bool force) : m_forceupdate{force}
  * \param art_files   A pointer to the MusicLoadedMap to store the results
  * \param parentid The id of the parent directory in the music_directories
  *                 table. The root directory should have an id of 0
+ * \param recurse If false only subdirectories that are not yet in the
+ *                database are descended into
  *
  * \returns Nothing.
  */
-void MusicFileScanner::BuildFileList(QString &directory, MusicLoadedMap &music_files, MusicLoadedMap &art_files, int parentid)
+void MusicFileScanner::BuildFileList(QString &directory, MusicLoadedMap &music_files,
+                                     MusicLoadedMap &art_files, int parentid, bool recurse)
 {
+    m_scannedDirs.insert(QDir::cleanPath(directory));
+
     QDir d(directory);
 
     if (!d.exists())
@@ -96,6 +176,10 @@ void MusicFileScanner::BuildFileList(QString &directory, MusicLoadedMap &music_f
 
             newparentid = m_directoryid[dir];
 
+            // Known dirs are only rescanned if they have changed themselves
+            if (!recurse && newparentid != 0)
+                continue;
+
             if (newparentid == 0)
             {
                 int id = GetDirectoryId(dir, parentid);
@@ -233,12 +317,7 @@ bool MusicFileScanner::HasFileChanged(
 }
 
 /*!
- * \brief Insert file details into database.
- *        If it is an audio file, read the metadata and insert
- *        that information at the same time.
- *
- *        If it is an image file, just insert the filename and
- *        type.
+ * \brief Insert album art file details into database.
  *
  * \param filename Full path to file.
  * \param startDir The starting directory fir the search. This will be
@@ -277,86 +356,115 @@ void MusicFileScanner::AddFileToDB(const QString &filename, const QString &start
         }
 
         ++m_coverartAdded;
-
-        return;
     }
+}
 
-    if (extension.isEmpty() || !MetaIO::kValidFileExtensions.contains(extension.toLower()))
+/*!
+ * \brief Insert tracks into the database.
+ *        The tracks are inserted with a single statement, along with any
+ *        album art embedded in their tags. The ids of new artists, albums
+ *        and genres are cached as they are created, so later tracks in the
+ *        batch don't look them up again.
+ *
+ * \param tracks Tracks whose tags have been read.
+ *
+ * \returns Nothing.
+ */
+void MusicFileScanner::AddTracksToDB(const QList<MusicTagReader*> &tracks)
+{
+    QList<MusicMetadata*> newTracks;
+    for (auto *track : qAsConst(tracks))
     {
-        LOG(VB_GENERAL, LOG_WARNING, QString("Ignoring filename with unsupported filename: '%1'").arg(filename));
-        return;
+        if (!track->m_data)
+            continue;
+
+        track->m_data->setHostname(gCoreContext->GetHostName());
+        SetIdsFromCache(track->m_data, track->m_filename, track->m_startDir);
+        track->m_data->createIds();
+        UpdateIdCache(track->m_data);
+        newTracks << track->m_data;
     }
 
-    LOG(VB_FILE, LOG_INFO, QString("Reading metadata from %1").arg(filename));
-    MusicMetadata *data = MetaIO::readMetadata(filename);
-    if (data)
-    {
-        data->setFileSize((quint64)QFileInfo(filename).size());
-        data->setHostname(gCoreContext->GetHostName());
-
-        QString album_cache_string;
+    // Commit track info to database
+    MusicMetadata::insertToDatabase(newTracks);
 
-        // Set values from cache
-        int did = m_directoryid[directory];
-        if (did >= 0)
-            data->setDirectoryId(did);
+    for (auto *track : qAsConst(tracks))
+    {
+        MusicMetadata *data = track->m_data;
+        if (!data || data->ID() == 0)
+            continue;
 
-        int aid = m_artistid[data->Artist().toLower()];
-        if (aid > 0)
+        if (!track->m_albumArt.isEmpty())
         {
-            data->setArtistId(aid);
-
-            // The album cache depends on the artist id
-            album_cache_string = QString::number(data->getArtistId()) + "#"
-                + data->Album().toLower();
-
-            if (m_albumid[album_cache_string] > 0)
-                data->setAlbumId(m_albumid[album_cache_string]);
+            data->setEmbeddedAlbumArt(track->m_albumArt);
+            track->m_albumArt.clear();
+            data->getAlbumArtImages()->dumpToDatabase();
         }
 
-        int caid = m_artistid[data->CompilationArtist().toLower()];
-        if (caid > 0)
-            data->setCompilationArtistId(caid);
-
-        int gid = m_genreid[data->Genre().toLower()];
-        if (gid > 0)
-            data->setGenreId(gid);
-
-        // Commit track info to database
-        data->dumpToDatabase();
+        ++m_tracksAdded;
+    }
+}
 
-        // Update the cache
-        m_artistid[data->Artist().toLower()] =
-            data->getArtistId();
+/*!
+ * \brief Set a track's directory, artist, album and genre ids from the
+ *        caches, so that they only need to be looked up in the database
+ *        the first time they are seen.
+ *
+ * \param data The track.
+ * \param filename Full path to file.
+ * \param startDir The starting directory for the search.
+ *
+ * \returns Nothing.
+ */
+void MusicFileScanner::SetIdsFromCache(MusicMetadata *data, const QString &filename,
+                                       const QString &startDir)
+{
+    QString directory = filename;
+    directory.remove(0, startDir.length());
+    directory = directory.section( '/', 0, -2);
 
-        m_artistid[data->CompilationArtist().toLower()] =
-            data->getCompilationArtistId();
+    int did = m_directoryid[directory];
+    if (did > 0)
+        data->setDirectoryId(did);
 
-        m_genreid[data->Genre().toLower()] =
-            data->getGenreId();
+    int aid = m_artistid[data->Artist().toLower()];
+    if (aid > 0)
+    {
+        data->setArtistId(aid);
 
-        album_cache_string = QString::number(data->getArtistId()) + "#"
+        // The album cache depends on the artist id
+        QString album_cache_string = QString::number(data->getArtistId()) + "#"
             + data->Album().toLower();
-        m_albumid[album_cache_string] = data->getAlbumId();
 
-        // read any embedded images from the tag
-        MetaIO *tagger = MetaIO::createTagger(filename);
+        if (m_albumid[album_cache_string] > 0)
+            data->setAlbumId(m_albumid[album_cache_string]);
+    }
 
-        if (tagger)
-        {
-            if (tagger->supportsEmbeddedImages())
-            {
-                AlbumArtList artList = tagger->getAlbumArtList(data->Filename());
-                data->setEmbeddedAlbumArt(artList);
-                data->getAlbumArtImages()->dumpToDatabase();
-            }
-            delete tagger;
-        }
+    int caid = m_artistid[data->CompilationArtist().toLower()];
+    if (caid > 0)
+        data->setCompilationArtistId(caid);
 
-        delete data;
+    int gid = m_genreid[data->Genre().toLower()];
+    if (gid > 0)
+        data->setGenreId(gid);
+}
 
-        ++m_tracksAdded;
-    }
+/*!
+ * \brief Add the ids of a track written to the database to the caches.
+ *
+ * \param data The track.
+ *
+ * \returns Nothing.
+ */
+void MusicFileScanner::UpdateIdCache(MusicMetadata *data)
+{
+    m_artistid[data->Artist().toLower()] = data->getArtistId();
+    m_artistid[data->CompilationArtist().toLower()] = data->getCompilationArtistId();
+    m_genreid[data->Genre().toLower()] = data->getGenreId();
+
+    QString album_cache_string = QString::number(data->getArtistId()) + "#"
+        + data->Album().toLower();
+    m_albumid[album_cache_string] = data->getAlbumId();
 }
 
 /*!
@@ -544,26 +652,19 @@ void MusicFileScanner::RemoveFileFromDB(const QString &filename, const QString &
 }
 
 /*!
- * \brief Updates a file in the database.
+ * \brief Updates a track in the database.
  *
- * \param filename Full path to file.
- * \param startDir The starting directory fir the search. This will be
- *                 removed making the stored name relative to the
- *                 storage directory where it was found.
+ * \param track The track, whose tags have been read.
  *
  * \returns Nothing.
  */
-void MusicFileScanner::UpdateFileInDB(const QString &filename, const QString &startDir)
+void MusicFileScanner::UpdateFileInDB(MusicTagReader *track)
 {
-    QString dbFilename = filename;
-    dbFilename.remove(0, startDir.length());
-
-    QString directory = filename;
-    directory.remove(0, startDir.length());
-    directory = directory.section( '/', 0, -2);
+    QString dbFilename = track->m_filename;
+    dbFilename.remove(0, track->m_startDir.length());
 
     MusicMetadata *db_meta   = MetaIO::getMetadata(dbFilename);
-    MusicMetadata *disk_meta = MetaIO::readMetadata(filename);
+    MusicMetadata *disk_meta = track->m_data;
 
     if (db_meta && disk_meta)
     {
@@ -572,7 +673,6 @@ void MusicFileScanner::UpdateFileInDB(const QString &filename, const QString &st
             LOG(VB_GENERAL, LOG_ERR, QString("Asked to update track with "
                                                 "invalid ID - %1")
                                             .arg(db_meta->ID()));
-            delete disk_meta;
             delete db_meta;
             return;
         }
@@ -582,55 +682,90 @@ void MusicFileScanner::UpdateFileInDB(const QString &filename, const QString &st
         if (db_meta->PlayCount() > disk_meta->PlayCount())
             disk_meta->setPlaycount(db_meta->Playcount());
 
-        QString album_cache_string;
-
         // Set values from cache
-        int did = m_directoryid[directory];
-        if (did > 0)
-            disk_meta->setDirectoryId(did);
+        SetIdsFromCache(disk_meta, track->m_filename, track->m_startDir);
 
-        int aid = m_artistid[disk_meta->Artist().toLower()];
-        if (aid > 0)
-        {
-            disk_meta->setArtistId(aid);
+        disk_meta->setHostname(gCoreContext->GetHostName());
+
+        // Commit track info to database
+        disk_meta->dumpToDatabase();
 
-            // The album cache depends on the artist id
-            album_cache_string = QString::number(disk_meta->getArtistId()) + "#" +
-                disk_meta->Album().toLower();
+        // Update the cache
+        UpdateIdCache(disk_meta);
 
-            if (m_albumid[album_cache_string] > 0)
-                disk_meta->setAlbumId(m_albumid[album_cache_string]);
-        }
+        ++m_tracksUpdated;
+    }
+
+    delete db_meta;
+}
+
+/*!
+ * \brief Reads the tags of tracks in parallel and writes them to the
+ *        database in batches. The tags of the next batch are read while the
+ *        current one is written.
+ *
+ * \param tracks Tracks to add or update.
+ * \param update True if the tracks are already in the database.
+ *
+ * \returns Nothing.
+ */
+void MusicFileScanner::ProcessTracks(const MusicLoadedMap &tracks, bool update)
+{
+    if (tracks.isEmpty())
+        return;
 
-        int caid = m_artistid[disk_meta->CompilationArtist().toLower()];
-        if (caid > 0)
-            disk_meta->setCompilationArtistId(caid);
+    MThreadPool pool("MusicTagReader");
+    pool.setMaxThreadCount(std::max(QThread::idealThreadCount(), 2));
 
-        int gid = m_genreid[disk_meta->Genre().toLower()];
-        if (gid > 0)
-            disk_meta->setGenreId(gid);
+    auto iter = tracks.cbegin();
+    auto readBatch = [&]()
+    {
+        auto batch = std::make_unique<MusicTagBatch>();
+        for (; iter != tracks.cend() && batch->m_readers.size() < kTrackBatchSize; ++iter)
+        {
+            auto *reader = new MusicTagReader(iter.key(), (*iter).startDir, !update,
+                                              batch->m_done);
+            batch->m_readers << reader;
+            pool.start(reader, "MusicTagReader");
+        }
+        return batch;
+    };
 
-        disk_meta->setFileSize((quint64)QFileInfo(filename).size());
+    QElapsedTimer timer;
+    timer.start();
+    int done = 0;
 
-        disk_meta->setHostname(gCoreContext->GetHostName());
+    std::unique_ptr<MusicTagBatch> next = readBatch();
+    while (next)
+    {
+        std::unique_ptr<MusicTagBatch> current = std::move(next);
+        if (iter != tracks.cend())
+            next = readBatch();
 
-        // Commit track info to database
-        disk_meta->dumpToDatabase();
+        current->m_done.acquire(current->m_readers.size());
 
-        // Update the cache
-        m_artistid[disk_meta->Artist().toLower()]
-            = disk_meta->getArtistId();
-        m_artistid[disk_meta->CompilationArtist().toLower()]
-            = disk_meta->getCompilationArtistId();
-        m_genreid[disk_meta->Genre().toLower()]
-            = disk_meta->getGenreId();
-        album_cache_string = QString::number(disk_meta->getArtistId()) + "#" +
-            disk_meta->Album().toLower();
-        m_albumid[album_cache_string] = disk_meta->getAlbumId();
+        if (update)
+        {
+            for (auto *track : qAsConst(current->m_readers))
+                UpdateFileInDB(track);
+        }
+        else
+        {
+            AddTracksToDB(current->m_readers);
+        }
+
+        done += current->m_readers.size();
+        double rate = done * 1000.0 / std::max(timer.elapsed(), qint64(1));
+        QString status = QString("running - %1 %2 of %3 tracks (%4 tracks/s)")
+                             .arg(update ? "updating" : "adding")
+                             .arg(done).arg(tracks.size()).arg(rate, 0, 'f', 1);
+        updateLastRunStatus(status);
     }
 
-    delete disk_meta;
-    delete db_meta;
+    LOG(VB_GENERAL, LOG_INFO, QString("%1 %2 tracks in %3s (%4 tracks/s)")
+        .arg(update ? "Updated" : "Added").arg(tracks.size())
+        .arg(timer.elapsed() / 1000.0, 0, 'f', 1)
+        .arg(tracks.size() * 1000.0 / std::max(timer.elapsed(), qint64(1)), 0, 'f', 1));
 }
 
 /*!
@@ -690,13 +825,44 @@ void MusicFileScanner::SearchDirs(const QStringList &dirList)
     MusicLoadedMap art_files;
     MusicLoadedMap::Iterator iter;
 
+    // Find what has changed since the last scan
+    QStringList changedDirs;
+    m_incremental = MediaWatcher::TakeJournal("Music", changedDirs) && !m_forceupdate;
+    m_changedDirs.clear();
+    m_scannedDirs.clear();
+    m_dirExists.clear();
+
     for (int x = 0; x < dirList.count(); x++)
     {
         QString startDir = dirList[x];
         m_startDirs.append(startDir + '/');
-        LOG(VB_GENERAL, LOG_INFO, QString("Searching '%1' for music files").arg(startDir));
 
-        BuildFileList(startDir, music_files, art_files, 0);
+        if (!m_incremental)
+        {
+            LOG(VB_GENERAL, LOG_INFO, QString("Searching '%1' for music files").arg(startDir));
+
+            BuildFileList(startDir, music_files, art_files, 0);
+            continue;
+        }
+
+        QString root = QDir::cleanPath(startDir);
+        for (const auto & changed : qAsConst(changedDirs))
+        {
+            if (changed != root && !changed.startsWith(root + '/'))
+                continue;
+
+            // New dirs are found when their (changed) parent is scanned
+            QString dir = changed.mid(root.length() + 1);
+            if (!dir.isEmpty() && m_directoryid.value(dir) == 0)
+                continue;
+
+            LOG(VB_GENERAL, LOG_INFO, QString("Searching changed directory '%1' for music files")
+                .arg(changed));
+
+            m_changedDirs.append(changed);
+            QString directory = changed;
+            BuildFileList(directory, music_files, art_files, m_directoryid.value(dir), false);
+        }
     }
 
     m_tracksTotal = music_files.count();
@@ -707,32 +873,22 @@ void MusicFileScanner::SearchDirs(const QStringList &dirList)
 
     LOG(VB_GENERAL, LOG_INFO, "Updating database");
 
-        /*
-        This can be optimised quite a bit by consolidating all commands
-        via a lot of refactoring.
-
-        1) group all files of the same decoder type, and don't
-        create/delete a Decoder pr. AddFileToDB. Or make Decoders be
-        singletons, it should be a fairly simple change.
-
-        2) RemoveFileFromDB should group the remove into one big SQL.
-
-        3) UpdateFileInDB, same as 1.
-        */
+    MusicLoadedMap new_tracks;
+    MusicLoadedMap changed_tracks;
 
     for (iter = music_files.begin(); iter != music_files.end(); iter++)
     {
         if ((*iter).location == MusicFileScanner::kFileSystem)
-            AddFileToDB(iter.key(), (*iter).startDir);
+            new_tracks.insert(iter.key(), *iter);
         else if ((*iter).location == MusicFileScanner::kDatabase)
             RemoveFileFromDB(iter.key(), (*iter).startDir);
         else if ((*iter).location == MusicFileScanner::kNeedUpdate)
-        {
-            UpdateFileInDB(iter.key(), (*iter).startDir);
-            ++m_tracksUpdated;
-        }
+            changed_tracks.insert(iter.key(), *iter);
     }
 
+    ProcessTracks(new_tracks, false);
+    ProcessTracks(changed_tracks, true);
+
     for (iter = art_files.begin(); iter != art_files.end(); iter++)
     {
         if ((*iter).location == MusicFileScanner::kFileSystem)
@@ -740,10 +896,7 @@ void MusicFileScanner::SearchDirs(const QStringList &dirList)
         else if ((*iter).location == MusicFileScanner::kDatabase)
             RemoveFileFromDB(iter.key(), (*iter).startDir);
         else if ((*iter).location == MusicFileScanner::kNeedUpdate)
-        {
-            UpdateFileInDB(iter.key(), (*iter).startDir);
             ++m_coverartUpdated;
-        }
     }
 
     // Cleanup orphaned entries from the database
@@ -765,6 +918,10 @@ void MusicFileScanner::SearchDirs(const QStringList &dirList)
                                       .arg(host).arg(m_tracksTotal).arg(m_tracksAdded)
                                       .arg(m_coverartTotal).arg(m_coverartAdded));
 
+    // Commit after full scans as well as incremental ones, as that records
+    // the time of the scan that later journals are checked against
+    MediaWatcher::CommitJournal("Music", !m_incremental);
+
     updateLastRunEnd();
     status = QString("success - %1 - %2").arg(trackStatus).arg(coverartStatus);
     updateLastRunStatus(status);
@@ -820,7 +977,7 @@ void MusicFileScanner::ScanMusic(MusicLoadedMap &music_files)
                     music_files.erase(iter);
                 }
             }
-            else
+            else if (IsInScope(query.value(0).toString()))
                 music_files[name].location = MusicFileScanner::kDatabase;
         }
     }
@@ -871,7 +1028,7 @@ void MusicFileScanner::ScanArtwork(MusicLoadedMap &music_files)
                 ++m_coverartUnchanged;
                 music_files.erase(iter);
             }
-            else
+            else if (IsInScope(query.value(0).toString()))
             {
                 music_files[name].location = MusicFileScanner::kDatabase;
             }
@@ -879,10 +1036,51 @@ void MusicFileScanner::ScanArtwork(MusicLoadedMap &music_files)
     }
 }
 
+/*!
+ * \brief Check whether a file in the database was covered by this scan
+ *
+ *        Files not found by a full scan have been removed. An incremental
+ *        scan only knows about the files in the directories it has visited
+ *        and in changed directories that no longer exist.
+ *
+ * \param filename Path of the file relative to its storage group directory
+ *
+ * \returns True if the file should be removed when it was not found.
+ */
+bool MusicFileScanner::IsInScope(const QString &filename)
+{
+    if (!m_incremental)
+        return true;
+
+    QString directory = filename.section('/', 0, -2);
+    for (const auto & startDir : qAsConst(m_startDirs))
+    {
+        QString path = QDir::cleanPath(startDir + directory);
+        if (m_scannedDirs.contains(path))
+            return true;
+
+        for (const auto & changed : qAsConst(m_changedDirs))
+        {
+            if (!path.startsWith(changed + '/'))
+                continue;
+
+            auto it = m_dirExists.find(path);
+            if (it == m_dirExists.end())
+                it = m_dirExists.insert(path, QDir(path).exists());
+            if (!it.value())
+                return true;
+            break;
+        }
+    }
+
+    return false;
+}
+
 // static
 bool MusicFileScanner::IsRunning(void)
 {
-   return gCoreContext->GetSetting("MusicScannerLastRunStatus", "") == "running";
+   // N.B. a running scan reports its progress after "running"
+   return gCoreContext->GetSetting("MusicScannerLastRunStatus", "").startsWith("running");
 }
 
 void MusicFileScanner::updateLastRunEnd(void)
@@ -6,9 +6,14 @@
 
 // Qt headers
 #include <QCoreApplication>
+#include <QHash>
+#include <QSet>
 
 using IdCache = QMap<QString, int>;
 
+class MusicMetadata;
+class MusicTagReader;
+
 class META_PUBLIC MusicFileScanner
 {
     Q_DECLARE_TR_FUNCTIONS(MusicFileScanner)
@@ -37,12 +42,18 @@ class META_PUBLIC MusicFileScanner
         static bool IsRunning(void);
 
     private:
-        void BuildFileList(QString &directory, MusicLoadedMap &music_files, MusicLoadedMap &art_files, int parentid);
+        void BuildFileList(QString &directory, MusicLoadedMap &music_files, MusicLoadedMap &art_files,
+                           int parentid, bool recurse = true);
+        bool IsInScope(const QString &filename);
         static int  GetDirectoryId(const QString &directory, int parentid);
         static bool HasFileChanged(const QString &filename, const QString &date_modified);
         void AddFileToDB(const QString &filename, const QString &startDir);
+        void AddTracksToDB(const QList<MusicTagReader*> &tracks);
         void RemoveFileFromDB (const QString &filename, const QString &startDir);
-        void UpdateFileInDB(const QString &filename, const QString &startDir);
+        void UpdateFileInDB(MusicTagReader *track);
+        void ProcessTracks(const MusicLoadedMap &tracks, bool update);
+        void SetIdsFromCache(MusicMetadata *data, const QString &filename, const QString &startDir);
+        void UpdateIdCache(MusicMetadata *data);
         void ScanMusic(MusicLoadedMap &music_files);
         void ScanArtwork(MusicLoadedMap &music_files);
         static void cleanDB();
@@ -59,6 +70,13 @@ class META_PUBLIC MusicFileScanner
         IdCache  m_genreid;
         IdCache  m_albumid;
 
+        // Incremental scans only visit the dirs that the MediaWatcher has
+        // journalled as changed, and any new dirs found in them
+        bool           m_incremental {false};
+        QStringList    m_changedDirs;
+        QSet<QString>  m_scannedDirs;
+        QHash<QString, bool> m_dirExists;
+
         uint m_tracksTotal       {0};
         uint m_tracksUnchanged   {0};
         uint m_tracksAdded       {0};
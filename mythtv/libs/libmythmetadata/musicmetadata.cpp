@@ -668,7 +668,11 @@ QString MusicMetadata::Url(uint index)
     return QString();
 }
 
-void MusicMetadata::dumpToDatabase()
+/*!
+ * \brief Look up the directory, artist, album and genre ids of the track,
+ *        adding any that are not in the database yet.
+ */
+void MusicMetadata::createIds(void)
 {
     checkEmptyFields();
 
@@ -686,6 +690,11 @@ void MusicMetadata::dumpToDatabase()
 
     if (m_genreId < 0)
         getGenreId();
+}
+
+void MusicMetadata::dumpToDatabase()
+{
+    createIds();
 
     // We have all the id's now. We can insert it.
     QString strQuery;
@@ -789,6 +798,151 @@ void MusicMetadata::dumpToDatabase()
     }
 }
 
+/*!
+ * \brief Insert a batch of new tracks into the database
+ *
+ *  This is equivalent to calling dumpToDatabase() for each track but the
+ *  tracks are inserted with a single statement, and each album they belong to
+ *  is only updated once. The new ids are set on the tracks. If the statement
+ *  fails, the tracks are written one at a time instead.
+ *
+ * \param tracks The tracks to insert. All must be new and from the same host.
+ */
+void MusicMetadata::insertToDatabase(const QList<MusicMetadata*> &tracks)
+{
+    if (tracks.isEmpty())
+        return;
+
+    QStringList rows;
+    for (int i = 0; i < tracks.size(); ++i)
+    {
+        tracks[i]->createIds();
+
+        rows << QString("( :DIRECTORY%1,"
+                        " :ARTIST%1,   :ALBUM%1,      :TITLE%1,       :GENRE%1,"
+                        " :YEAR%1,     :TRACKNUM%1,   :LENGTH%1,      :FILENAME%1,"
+                        " :RATING%1,   :FORMAT%1,     :DATE_ADD%1,    :DATE_MOD%1,"
+                        " :PLAYCOUNT%1,:TRACKCOUNT%1, :DISC_NUMBER%1, :DISC_COUNT%1,"
+                        " :SIZE%1,     :HOSTNAME%1 )").arg(i);
+    }
+
+    MSqlQuery query(MSqlQuery::InitCon());
+
+    query.prepare("INSERT INTO music_songs ( directory_id,"
+                  " artist_id, album_id,    name,         genre_id,"
+                  " year,      track,       length,       filename,"
+                  " rating,    format,      date_entered, date_modified,"
+                  " numplays,  track_count, disc_number,  disc_count,"
+                  " size,      hostname) "
+                  "VALUES " + rows.join(", ") + ";");
+
+    QDateTime now = MythDate::current();
+    for (int i = 0; i < tracks.size(); ++i)
+    {
+        const MusicMetadata *track = tracks[i];
+        QString n = QString::number(i);
+
+        query.bindValue(":DIRECTORY" + n, track->m_directoryId);
+        query.bindValue(":ARTIST" + n, track->m_artistId);
+        query.bindValue(":ALBUM" + n, track->m_albumId);
+        query.bindValue(":TITLE" + n, track->m_title);
+        query.bindValue(":GENRE" + n, track->m_genreId);
+        query.bindValue(":YEAR" + n, track->m_year);
+        query.bindValue(":TRACKNUM" + n, track->m_trackNum);
+        query.bindValue(":LENGTH" + n, static_cast<qint64>(track->m_length.count()));
+        query.bindValue(":FILENAME" + n, track->m_filename.section('/', -1));
+        query.bindValue(":RATING" + n, track->m_rating);
+        query.bindValueNoNull(":FORMAT" + n, track->m_format);
+        query.bindValue(":DATE_ADD" + n, now);
+        query.bindValue(":DATE_MOD" + n, now);
+        query.bindValue(":PLAYCOUNT" + n, track->m_playCount);
+        query.bindValue(":TRACKCOUNT" + n, track->m_trackCount);
+        query.bindValue(":DISC_NUMBER" + n, track->m_discNum);
+        query.bindValue(":DISC_COUNT" + n, track->m_discCount);
+        query.bindValue(":SIZE" + n, (quint64)track->m_fileSize);
+        query.bindValue(":HOSTNAME" + n, track->m_hostname);
+    }
+
+    if (!query.exec())
+    {
+        MythDB::DBError("MusicMetadata::insertToDatabase - inserting music_songs",
+                        query);
+        LOG(VB_GENERAL, LOG_WARNING,
+            QString("Inserting %1 tracks one at a time").arg(tracks.size()));
+
+        // The music tables are MyISAM, so the rows before the one that failed
+        // may have been inserted. Update those instead of adding them again.
+        MSqlQuery lookup(MSqlQuery::InitCon());
+        lookup.prepare("SELECT song_id FROM music_songs "
+                       "WHERE directory_id = :DIRECTORY AND filename = :FILENAME "
+                       "AND hostname = :HOSTNAME;");
+        for (auto *track : qAsConst(tracks))
+        {
+            lookup.bindValue(":DIRECTORY", track->m_directoryId);
+            lookup.bindValue(":FILENAME", track->m_filename.section('/', -1));
+            lookup.bindValue(":HOSTNAME", track->m_hostname);
+            if (lookup.exec() && lookup.next())
+                track->m_id = lookup.value(0).toInt();
+
+            track->dumpToDatabase();
+        }
+        return;
+    }
+
+    // The rows of a multi-row insert get ids from the first one onwards, but
+    // they may not be consecutive so look them up.
+    int firstId = query.lastInsertId().toInt();
+    query.prepare("SELECT song_id, directory_id, filename FROM music_songs "
+                  "WHERE song_id >= :FIRSTID AND hostname = :HOSTNAME;");
+    query.bindValue(":FIRSTID", firstId);
+    query.bindValue(":HOSTNAME", tracks.first()->m_hostname);
+
+    if (!query.exec())
+    {
+        MythDB::DBError("MusicMetadata::insertToDatabase - finding new ids",
+                        query);
+        return;
+    }
+
+    QHash<QString, IdType> ids;
+    while (query.next())
+    {
+        ids.insert(query.value(1).toString() + '/' + query.value(2).toString(),
+                   query.value(0).toInt());
+    }
+
+    QMap<int, MusicMetadata*> albums;
+    for (auto *track : qAsConst(tracks))
+    {
+        track->m_id = ids.value(QString::number(track->m_directoryId) + '/' +
+                                track->m_filename.section('/', -1));
+
+        // save the albumart to the db
+        if (track->m_albumArt && track->m_id > 0)
+            track->m_albumArt->dumpToDatabase();
+
+        // the last track of each album determines its details
+        albums.insert(track->m_albumId, track);
+    }
+
+    // update the albums
+    for (auto *track : qAsConst(albums))
+    {
+        query.prepare("UPDATE music_albums SET album_name = :ALBUM_NAME, "
+                      "artist_id = :COMP_ARTIST_ID, compilation = :COMPILATION, "
+                      "year = :YEAR "
+                      "WHERE music_albums.album_id = :ALBUMID");
+        query.bindValue(":ALBUMID", track->m_albumId);
+        query.bindValue(":ALBUM_NAME", track->m_album);
+        query.bindValue(":COMP_ARTIST_ID", track->m_compartistId);
+        query.bindValue(":COMPILATION", track->m_compilation);
+        query.bindValue(":YEAR", track->m_year);
+
+        if (!query.exec() || !query.isActive())
+            MythDB::DBError("music compilation update", query);
+    }
+}
+
 // Default values for formats
 // NB These will eventually be customizable....
 QString MusicMetadata::s_formatNormalFileArtist      = "ARTIST";
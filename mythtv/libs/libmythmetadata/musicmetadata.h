@@ -288,6 +288,8 @@ class META_PUBLIC MusicMetadata
 
     void reloadMetadata(void);
     void dumpToDatabase(void);
+    void createIds(void);
+    static void insertToDatabase(const QList<MusicMetadata*> &tracks);
     void setField(const QString &field, const QString &data);
     void getField(const QString& field, QString *data);
     void toMap(InfoMap &metadataMap, const QString &prefix = "");
@@ -1,8 +1,11 @@
 #include <cmath> // for isnan()
 
+#include <QDateTime>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QHash>
+#include <QMutex>
 #include <QRegularExpression>
 
 #include "mythcorecontext.h"
@@ -1052,18 +1055,60 @@ int VideoMetadata::UpdateHashedDBRecord(const QString &hash,
     return intid;
 }
 
+namespace
+{
+    struct CachedHash
+    {
+        qint64    size {0};
+        QDateTime modified;
+        QString   hash;
+    };
+
+    QMutex                     s_hashCacheLock;
+    QHash<QString, CachedHash> s_hashCache;
+
+    /// \brief FileHash() of a local file, reusing the last result while the
+    ///        size and modification time of the file are unchanged
+    QString CachedFileHash(const QString &path)
+    {
+        QFileInfo info(path);
+        qint64 size = info.size();
+        QDateTime modified = info.lastModified();
+
+        {
+            QMutexLocker locker(&s_hashCacheLock);
+            auto it = s_hashCache.constFind(path);
+            if (it != s_hashCache.constEnd() && it->size == size &&
+                it->modified == modified)
+                return it->hash;
+        }
+
+        QString hash = FileHash(path);
+        if (hash != "NULL")
+        {
+            QMutexLocker locker(&s_hashCacheLock);
+            s_hashCache.insert(path, { size, modified, hash });
+        }
+        return hash;
+    }
+}
+
+/*!
+ * \brief Hash of a video file
+ * \note This is thread safe so that the scanner can hash files in parallel.
+ */
 QString VideoMetadata::VideoFileHash(const QString &file_name,
                            const QString &host)
 {
     if (host.isEmpty())
-        return FileHash(file_name);
+        return CachedFileHash(file_name);
 
     if (gCoreContext->IsMasterBackend() && gCoreContext->IsThisHost(host))
     {
         StorageGroup sgroup("Videos", host);
         QString fullname = sgroup.FindFile(file_name);
 
-        return FileHash(fullname);
+        return CachedFileHash(fullname);
     }
 
     QString url = generate_file_url("Videos", host, file_name);
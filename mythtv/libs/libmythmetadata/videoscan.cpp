@@ -3,13 +3,19 @@
 
 #include <QApplication>
 #include <QImageReader>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QSet>
 #include <QUrl>
+#include <memory>
 #include <utility>
 
 // libmythbase
 #include "mythevent.h"
 #include "mythlogging.h"
 #include "mythdate.h"
+#include "mythdb.h"
+#include "mthreadpool.h"
 
 // libmyth
 #include "mythcontext.h"
@@ -31,6 +37,55 @@
 QEvent::Type VideoScanChanges::kEventType =
     (QEvent::Type) QEvent::registerEventType();
 
+QEvent::Type VideoScanAdditions::kEventType =
+    (QEvent::Type) QEvent::registerEventType();
+
+// Number of new files hashed and added to the DB at a time
+static constexpr int kHashBatchSize { 50 };
+
+// Hashing waits on I/O rather than the CPU, but too many concurrent reads
+// just thrash the disk or share
+static constexpr int kHashThreads { 4 };
+
+/*!
+ * \brief Hashes a new video file on a worker thread
+ */
+class VideoHasher : public QRunnable
+{
+  public:
+    VideoHasher(QString filename, QString host, QSemaphore &done)
+      : m_filename(std::move(filename)),
+        m_host(std::move(host)),
+        m_done(done)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override
+    {
+        m_hash = VideoMetadata::VideoFileHash(m_filename, m_host);
+        m_done.release();
+    }
+
+    QString     m_filename;
+    QString     m_host;
+    QString     m_hash;
+
+  private:
+    QSemaphore &m_done;
+};
+
+/*!
+ * \brief A batch of files being hashed
+ */
+struct VideoHashBatch
+{
+    ~VideoHashBatch() { qDeleteAll(m_hashers); }
+
+    QList<VideoHasher*> m_hashers;
+    QSemaphore          m_done;
+};
+
 namespace
 {
     template <typename DirListType>
@@ -317,61 +372,54 @@ bool VideoScannerThread::updateDB(const FileCheckList &add, const PurgeList &rem
         SendProgressEvent(counter, (uint)(add.size() + remove.size()),
                           tr("Updating video database"));
 
+    // add files not already in the DB
+    std::vector<FileCheckList::const_iterator> newFiles;
     for (auto p = add.cbegin(); p != add.cend(); ++p)
     {
-        // add files not already in the DB
         if (!p->second.check)
-        {
-            int id = -1;
+            newFiles.push_back(p);
+        else if (m_hasGUI)
+            SendProgressEvent(++counter);
+    }
 
-            // Are we sure this needs adding?  Let's check our Hash list.
-            QString hash = VideoMetadata::VideoFileHash(p->first, p->second.host);
-            if (hash != "NULL" && !hash.isEmpty())
-            {
-                id = VideoMetadata::UpdateHashedDBRecord(hash, p->first, p->second.host);
-                if (id != -1)
-                {
-                    // Whew, that was close.  Let's remove that thing from
-                    // our purge list, too.
-                    LOG(VB_GENERAL, LOG_ERR,
-                        QString("Hash %1 already exists in the "
-                                "database, updating record %2 "
-                                "with new filename %3")
-                            .arg(hash).arg(id).arg(p->first));
-                    m_movList.append(id);
-                }
-            }
-            if (id == -1)
-            {
-                VideoMetadata newFile(
-                    p->first, QString(), hash,
-                    VIDEO_TRAILER_DEFAULT,
-                    VIDEO_COVERFILE_DEFAULT,
-                    VIDEO_SCREENSHOT_DEFAULT,
-                    VIDEO_BANNER_DEFAULT,
-                    VIDEO_FANART_DEFAULT,
-                    QString(), QString(), QString(), QString(),
-                    QString(),
-                    VIDEO_YEAR_DEFAULT,
-                    QDate::fromString("0000-00-00","YYYY-MM-DD"),
-                    VIDEO_INETREF_DEFAULT, 0, QString(),
-                    VIDEO_DIRECTOR_DEFAULT, QString(), VIDEO_PLOT_DEFAULT,
-                    0.0, VIDEO_RATING_DEFAULT, 0, 0,
-                    0, 0,
-                    MythDate::current().date(),
-                    0, ParentalLevel::plLowest);
-
-                LOG(VB_GENERAL, LOG_INFO, QString("Adding : %1 : %2 : %3")
-                        .arg(newFile.GetHost()).arg(newFile.GetFilename())
-                        .arg(hash));
-                newFile.SetHost(p->second.host);
-                newFile.SaveToDatabase();
-                m_addList << newFile.GetID();
-            }
-            ret += 1;
+    // Hashing is dominated by I/O latency, particularly on network shares, so
+    // the files are hashed in parallel. The next batch is hashed while the
+    // current one is added to the DB.
+    MThreadPool pool("VideoHasher");
+    pool.setMaxThreadCount(kHashThreads);
+
+    auto next = newFiles.cbegin();
+    auto hashBatch = [&]()
+    {
+        auto batch = std::make_unique<VideoHashBatch>();
+        for (; next != newFiles.cend() && batch->m_hashers.size() < kHashBatchSize; ++next)
+        {
+            auto *hasher = new VideoHasher((*next)->first, (*next)->second.host,
+                                           batch->m_done);
+            batch->m_hashers << hasher;
+            pool.start(hasher, "VideoHasher");
         }
+        return batch;
+    };
+
+    std::unique_ptr<VideoHashBatch> batch;
+    if (!newFiles.empty())
+        batch = hashBatch();
+    while (batch)
+    {
+        std::unique_ptr<VideoHashBatch> current = std::move(batch);
+        if (next != newFiles.cend())
+            batch = hashBatch();
+
+        current->m_done.acquire(current->m_hashers.size());
+        addFiles(current->m_hashers);
+
+        ret += current->m_hashers.size();
         if (m_hasGUI)
-            SendProgressEvent(++counter);
+        {
+            counter += current->m_hashers.size();
+            SendProgressEvent(counter);
+        }
     }
 
     // When prompting is restored, account for the answer here.
@@ -390,6 +438,92 @@ bool VideoScannerThread::updateDB(const FileCheckList &add, const PurgeList &rem
     return ret > 0;
 }
 
+/*!
+ * \brief Adds a batch of hashed files to the DB
+ * \details Files whose hash is already in the DB have been moved, so their
+ *          existing records are updated instead. The new files are announced
+ *          so that their metadata can be looked up while the scan continues.
+ */
+void VideoScannerThread::addFiles(const QList<VideoHasher*> &files)
+{
+    // Find the hashes that are already known with a single query
+    QSet<QString> known;
+    QStringList placeholders;
+    for (int i = 0; i < files.size(); ++i)
+        placeholders << QString(":HASH%1").arg(i);
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare("SELECT hash FROM videometadata WHERE hash IN (" +
+                  placeholders.join(", ") + ")");
+    for (int i = 0; i < files.size(); ++i)
+        query.bindValue(placeholders[i], files[i]->m_hash);
+
+    if (!query.exec())
+        MythDB::DBError("VideoScannerThread::addFiles - finding hashes", query);
+    while (query.next())
+        known.insert(query.value(0).toString());
+
+    QList<int> added;
+    for (const auto *file : qAsConst(files))
+    {
+        int id = -1;
+        const QString &hash = file->m_hash;
+
+        // Are we sure this needs adding?  Let's check our Hash list.
+        if (hash != "NULL" && !hash.isEmpty() && known.contains(hash))
+        {
+            id = VideoMetadata::UpdateHashedDBRecord(hash, file->m_filename,
+                                                     file->m_host);
+            if (id != -1)
+            {
+                // Whew, that was close.  Let's remove that thing from
+                // our purge list, too.
+                LOG(VB_GENERAL, LOG_ERR,
+                    QString("Hash %1 already exists in the "
+                            "database, updating record %2 "
+                            "with new filename %3")
+                        .arg(hash).arg(id).arg(file->m_filename));
+                m_movList.append(id);
+            }
+        }
+        if (id == -1)
+        {
+            VideoMetadata newFile(
+                file->m_filename, QString(), hash,
+                VIDEO_TRAILER_DEFAULT,
+                VIDEO_COVERFILE_DEFAULT,
+                VIDEO_SCREENSHOT_DEFAULT,
+                VIDEO_BANNER_DEFAULT,
+                VIDEO_FANART_DEFAULT,
+                QString(), QString(), QString(), QString(),
+                QString(),
+                VIDEO_YEAR_DEFAULT,
+                QDate::fromString("0000-00-00","YYYY-MM-DD"),
+                VIDEO_INETREF_DEFAULT, 0, QString(),
+                VIDEO_DIRECTOR_DEFAULT, QString(), VIDEO_PLOT_DEFAULT,
+                0.0, VIDEO_RATING_DEFAULT, 0, 0,
+                0, 0,
+                MythDate::current().date(),
+                0, ParentalLevel::plLowest);
+
+            LOG(VB_GENERAL, LOG_INFO, QString("Adding : %1 : %2 : %3")
+                    .arg(newFile.GetHost()).arg(newFile.GetFilename())
+                    .arg(hash));
+            newFile.SetHost(file->m_host);
+            newFile.SaveToDatabase();
+            m_addList << newFile.GetID();
+            added << newFile.GetID();
+
+            // A copy later in the batch is treated as a move, as it
+            // would be if the files were added one at a time
+            known.insert(newFile.GetHash());
+        }
+    }
+
+    if (!added.isEmpty())
+        QCoreApplication::postEvent(m_parent, new VideoScanAdditions(added));
+}
+
 bool VideoScannerThread::buildFileList(const QString &directory,
                                        const QStringList &imageExtensions,
                                        FileCheckList &filelist) const
@@ -18,6 +18,7 @@
 #include "mythprogressdialog.h"
 
 class VideoMetadataListManager;
+class VideoHasher;
 
 class META_PUBLIC VideoScanner : public QObject
 {
@@ -57,6 +58,19 @@ class META_PUBLIC VideoScanChanges : public QEvent
     static Type kEventType;
 };
 
+/// \brief Videos added by the scan so far, sent while it is still running
+class META_PUBLIC VideoScanAdditions : public QEvent
+{
+  public:
+    explicit VideoScanAdditions(QList<int> adds) : QEvent(kEventType),
+                     m_additions(std::move(adds)) {}
+    ~VideoScanAdditions() override = default;
+
+    QList<int> m_additions; // newly added intids
+
+    static Type kEventType;
+};
+
 class META_PUBLIC VideoScannerThread : public MThread
 {
     Q_DECLARE_TR_FUNCTIONS(VideoScannerThread);
@@ -89,6 +103,7 @@ class META_PUBLIC VideoScannerThread : public MThread
 
     void verifyFiles(FileCheckList &files, PurgeList &remove);
     bool updateDB(const FileCheckList &add, const PurgeList &remove);
+    void addFiles(const QList<VideoHasher*> &files);
     bool buildFileList(const QString &directory,
                                         const QStringList &imageExtensions,
                                         FileCheckList &filelist) const;
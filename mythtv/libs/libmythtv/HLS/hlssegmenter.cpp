@@ -0,0 +1,672 @@
+/*  -*- Mode: c++ -*-
+ *
+ *   Class HLSSegmenter
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+// C++ headers
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// Qt headers
+#include <QRunnable>
+
+#include "mythdate.h"
+#include "mythlogging.h"
+#include "mthreadpool.h"
+#include "httplivestream.h"
+#include "hlssegmenter.h"
+
+extern "C" {
+#include "libavutil/dict.h"
+}
+
+#define LOC QString("HLSSegmenter(%1): ").arg(m_filename)
+
+// Number of segments generated ahead of the one a client asked for
+static constexpr uint kReadAhead { 2 };
+// Number of segments kept in memory when the stream does not set a maximum
+static constexpr uint kDefaultRingSize { 8 };
+// Upper bound on the segments kept in memory for one stream
+static constexpr uint kMaxRingSize { 16 };
+// Size of the buffer the muxer writes through
+static constexpr int kIOBufferSize { 64 * 1024 };
+// Segmenters that have not been used for this long are closed
+static constexpr int64_t kIdleTimeout { 5 * 60 };
+// Keyframes and packets read at most to measure the keyframe interval
+static constexpr int kScanKeyframes { 4 };
+static constexpr int kScanPackets { 10000 };
+
+QMutex HLSSegmenter::s_lock;
+QMap<int, std::shared_ptr<HLSSegmenter> > HLSSegmenter::s_segmenters;
+
+/** \class HLSPrefetchThread
+ *  \brief QRunnable class for generating the segments ahead of a client
+ */
+class HLSPrefetchThread : public QRunnable
+{
+  public:
+    explicit HLSPrefetchThread(std::shared_ptr<HLSSegmenter> segmenter)
+      : m_segmenter(std::move(segmenter)) {}
+
+    void run(void) override // QRunnable
+    {
+        m_segmenter->Prefetch();
+    }
+
+  private:
+    std::shared_ptr<HLSSegmenter> m_segmenter;
+};
+
+/// \brief Returns true if HLS clients can play this video codec as is
+static bool is_hls_video_codec(AVCodecID codec)
+{
+    return codec == AV_CODEC_ID_H264;
+}
+
+/// \brief Returns true if HLS clients can play this audio codec as is
+static bool is_hls_audio_codec(AVCodecID codec)
+{
+    switch (codec)
+    {
+        case AV_CODEC_ID_AAC:
+        case AV_CODEC_ID_MP3:
+        case AV_CODEC_ID_AC3:
+        case AV_CODEC_ID_EAC3:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ *  \brief Opens a segmenter for a stream
+ *
+ *  \return nullptr if the source can not be transmuxed, the stream then
+ *          has to be transcoded instead
+ */
+std::shared_ptr<HLSSegmenter> HLSSegmenter::Open(int streamid,
+                                                 const QString &filename,
+                                                 uint segmentSize,
+                                                 uint ringSize,
+                                                 const QString &urlPrefix)
+{
+    auto segmenter = std::make_shared<HLSSegmenter>(
+        filename, segmentSize, ringSize, QString("%1%2_").arg(urlPrefix).arg(streamid));
+    if (!segmenter->Init())
+        return nullptr;
+
+    QMutexLocker locker(&s_lock);
+    ExpireIdle();
+    s_segmenters[streamid] = segmenter;
+    return segmenter;
+}
+
+/**
+ *  \brief Gets the segmenter of a stream
+ *
+ *  The segmenter is reopened from the stream's database entry when it is
+ *  not open, e.g. after it was idle or after a backend restart.
+ */
+std::shared_ptr<HLSSegmenter> HLSSegmenter::Get(int streamid)
+{
+    {
+        QMutexLocker locker(&s_lock);
+        ExpireIdle();
+        auto it = s_segmenters.constFind(streamid);
+        if (it != s_segmenters.constEnd())
+            return *it;
+    }
+
+    HTTPLiveStream hls(streamid);
+    if (!hls.IsTransmuxed() || (hls.GetDBStatus() != kHLSStatusCompleted))
+        return nullptr;
+
+    return Open(streamid, hls.GetSourceFile(), hls.GetSegmentSize(),
+                hls.GetMaxSegments(), hls.GetTransmuxPrefix());
+}
+
+void HLSSegmenter::Release(int streamid)
+{
+    QMutexLocker locker(&s_lock);
+    s_segmenters.remove(streamid);
+}
+
+/// \brief Closes the segmenters nobody asked for a segment for a while
+void HLSSegmenter::ExpireIdle(void)
+{
+    QDateTime cutoff = MythDate::current().addSecs(-kIdleTimeout);
+
+    auto it = s_segmenters.begin();
+    while (it != s_segmenters.end())
+    {
+        QMutexLocker locker(&(*it)->m_ringLock);
+        if ((*it)->m_lastUsed < cutoff)
+        {
+            locker.unlock();
+            it = s_segmenters.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+HLSSegmenter::HLSSegmenter(QString filename, uint segmentSize, uint ringSize,
+                           QString segmentPrefix)
+  : m_filename(std::move(filename)),
+    m_segmentPrefix(std::move(segmentPrefix)),
+    m_segmentSize(std::max(segmentSize, 1U)),
+    m_ringSize(std::clamp(ringSize ? ringSize : kDefaultRingSize,
+                          kReadAhead + 1, kMaxRingSize)),
+    m_lastUsed(MythDate::current())
+{
+}
+
+HLSSegmenter::~HLSSegmenter()
+{
+    av_packet_free(&m_pending);
+    avformat_close_input(&m_ic);
+}
+
+/**
+ *  \brief Probes the source and checks that it can be transmuxed
+ */
+bool HLSSegmenter::Init(void)
+{
+    QByteArray fname = m_filename.toLocal8Bit();
+    if (avformat_open_input(&m_ic, fname.constData(), nullptr, nullptr) < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Unable to open source");
+        return false;
+    }
+
+    if (avformat_find_stream_info(m_ic, nullptr) < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Unable to find stream info");
+        return false;
+    }
+
+    m_videoIndex = av_find_best_stream(m_ic, AVMEDIA_TYPE_VIDEO,
+                                       -1, -1, nullptr, 0);
+    m_audioIndex = av_find_best_stream(m_ic, AVMEDIA_TYPE_AUDIO,
+                                       -1, m_videoIndex, nullptr, 0);
+    m_videoIndex = std::max(m_videoIndex, -1);
+    m_audioIndex = std::max(m_audioIndex, -1);
+
+    if ((m_videoIndex < 0) && (m_audioIndex < 0))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "No audio or video stream found");
+        return false;
+    }
+
+    if ((m_videoIndex >= 0) &&
+        !is_hls_video_codec(m_ic->streams[m_videoIndex]->codecpar->codec_id))
+    {
+        LOG(VB_RECORD, LOG_INFO, LOC + "Video codec needs transcoding");
+        return false;
+    }
+
+    if ((m_audioIndex >= 0) &&
+        !is_hls_audio_codec(m_ic->streams[m_audioIndex]->codecpar->codec_id))
+    {
+        LOG(VB_RECORD, LOG_INFO, LOC + "Audio codec needs transcoding");
+        return false;
+    }
+
+    if ((m_ic->duration == AV_NOPTS_VALUE) || (m_ic->duration <= 0))
+    {
+        LOG(VB_RECORD, LOG_INFO, LOC + "Unknown duration");
+        return false;
+    }
+
+    m_startTime = (m_ic->start_time == AV_NOPTS_VALUE) ? 0 : m_ic->start_time;
+    m_duration  = m_ic->duration;
+
+    int64_t segment = int64_t(m_segmentSize) * AV_TIME_BASE;
+    m_segmentCount = static_cast<uint>((m_duration + segment - 1) / segment);
+    m_bitrate = static_cast<uint32_t>(std::max<int64_t>(m_ic->bit_rate, 0));
+
+    if (m_videoIndex >= 0)
+    {
+        AVCodecParameters *par = m_ic->streams[m_videoIndex]->codecpar;
+        m_width  = static_cast<uint16_t>(par->width);
+        m_height = static_cast<uint16_t>(par->height);
+    }
+
+    m_pending = av_packet_alloc();
+    if (!m_pending)
+        return false;
+
+    ScanKeyframes();
+
+    LOG(VB_RECORD, LOG_INFO, LOC +
+        QString("Transmuxing %1 segments of %2 seconds")
+            .arg(m_segmentCount).arg(m_segmentSize));
+
+    return true;
+}
+
+/**
+ *  \brief Measures the keyframe interval at the start of the source
+ *
+ *  A segment runs on past its nominal end to the next keyframe, so this
+ *  bounds the length of the segments that have not been generated yet.
+ *  Leaves the demuxer where it stopped, the first segment seeks back.
+ */
+void HLSSegmenter::ScanKeyframes(void)
+{
+    AVPacket *pkt = av_packet_alloc();
+    if (!pkt)
+        return;
+
+    int64_t lastKey = AV_NOPTS_VALUE;
+    int keyframes = 0;
+    for (int packets = 0;
+         (keyframes < kScanKeyframes) && (packets < kScanPackets); ++packets)
+    {
+        if (av_read_frame(m_ic, pkt) < 0)
+            break;
+
+        int64_t ts = (pkt->pts != AV_NOPTS_VALUE) ? pkt->pts : pkt->dts;
+        if ((ts != AV_NOPTS_VALUE) && IsCut(pkt))
+        {
+            ts = av_rescale_q(ts, m_ic->streams[pkt->stream_index]->time_base,
+                              AV_TIME_BASE_Q);
+            if ((lastKey != AV_NOPTS_VALUE) && (ts - lastKey > m_keyframeGap))
+                m_keyframeGap = ts - lastKey;
+            lastKey = ts;
+            ++keyframes;
+        }
+        av_packet_unref(pkt);
+    }
+    av_packet_free(&pkt);
+
+    LOG(VB_RECORD, LOG_DEBUG, LOC + QString("Keyframe interval %1 ms")
+        .arg(m_keyframeGap / 1000));
+}
+
+/// \brief Start of a segment, in AV_TIME_BASE units
+int64_t HLSSegmenter::Boundary(uint segment) const
+{
+    return m_startTime + (int64_t(segment) * m_segmentSize * AV_TIME_BASE);
+}
+
+/// \brief Returns true if a segment may start with this packet
+bool HLSSegmenter::IsCut(const AVPacket *pkt) const
+{
+    if (m_videoIndex >= 0)
+    {
+        return (pkt->stream_index == m_videoIndex) &&
+               ((pkt->flags & AV_PKT_FLAG_KEY) != 0);
+    }
+    return pkt->stream_index == m_audioIndex;
+}
+
+/**
+ *  \brief Builds the playlist of the stream
+ *
+ *  Lists the real length of the segments generated so far, and the nominal
+ *  length of the others. The target duration covers the longest segment,
+ *  allowing for segments not generated yet to run on to the next keyframe.
+ */
+QByteArray HLSSegmenter::GetPlaylist(void) const
+{
+    int64_t nominal = int64_t(m_segmentSize) * AV_TIME_BASE;
+    int64_t longest = 0;
+    QString segments;
+
+    QMutexLocker locker(&m_ringLock);
+    for (uint segment = 0; segment < m_segmentCount; ++segment)
+    {
+        int64_t duration = 0;
+        auto it = m_durations.constFind(segment);
+        if (it != m_durations.constEnd())
+        {
+            duration = *it;
+        }
+        else
+        {
+            duration = std::min(nominal, m_duration - (segment * nominal));
+            longest = std::max(longest, nominal + m_keyframeGap);
+        }
+        longest = std::max(longest, duration);
+
+        segments += QString(
+            "#EXTINF:%1,\n"
+            "%2%3.ts\n"
+            ).arg(static_cast<double>(duration) / AV_TIME_BASE, 0, 'f', 3)
+             .arg(m_segmentPrefix).arg(segment);
+    }
+    locker.unlock();
+
+    auto target = static_cast<int64_t>(
+        std::ceil(static_cast<double>(longest) / AV_TIME_BASE));
+
+    QString playlist = QString(
+        "#EXTM3U\n"
+        "#EXT-X-VERSION:3\n"
+        "#EXT-X-PLAYLIST-TYPE:VOD\n"
+        "#EXT-X-TARGETDURATION:%1\n"
+        "#EXT-X-MEDIA-SEQUENCE:0\n"
+        ).arg(std::max<int64_t>(target, 1));
+
+    playlist += segments;
+    playlist += "#EXT-X-ENDLIST\n";
+
+    return playlist.toLatin1();
+}
+
+/**
+ *  \brief Gets a segment, generating it if it is not in memory
+ *
+ *  Also starts generating the segments after it in the background, so
+ *  that they are ready when the client asks for them.
+ *
+ *  \return an empty array if the segment could not be generated
+ */
+QByteArray HLSSegmenter::GetSegment(uint segment)
+{
+    if (segment >= m_segmentCount)
+        return {};
+
+    QByteArray data;
+    if (!Lookup(segment, data))
+        data = GenerateIfMissing(segment);
+
+    StartPrefetch(segment + 1);
+
+    return data;
+}
+
+bool HLSSegmenter::Lookup(uint segment, QByteArray &data)
+{
+    QMutexLocker locker(&m_ringLock);
+    m_lastUsed = MythDate::current();
+
+    auto it = m_segments.constFind(segment);
+    if (it == m_segments.constEnd())
+        return false;
+
+    data = *it;
+
+    auto recent = std::find(m_recent.begin(), m_recent.end(), segment);
+    if (recent != m_recent.end())
+        m_recent.erase(recent);
+    m_recent.push_back(segment);
+
+    return true;
+}
+
+void HLSSegmenter::Store(uint segment, const QByteArray &data,
+                         int64_t duration)
+{
+    if (data.isEmpty())
+        return;
+
+    QMutexLocker locker(&m_ringLock);
+    m_segments[segment] = data;
+    m_durations[segment] = duration;
+    m_recent.push_back(segment);
+
+    while (m_recent.size() > m_ringSize)
+    {
+        m_segments.remove(m_recent.front());
+        m_recent.pop_front();
+    }
+}
+
+QByteArray HLSSegmenter::GenerateIfMissing(uint segment)
+{
+    QMutexLocker locker(&m_demuxLock);
+
+    // Another request may have generated it while we waited
+    QByteArray data;
+    if (Lookup(segment, data))
+        return data;
+
+    int64_t duration = 0;
+    data = Generate(segment, duration);
+    Store(segment, data, duration);
+
+    return data;
+}
+
+void HLSSegmenter::StartPrefetch(uint segment)
+{
+    m_prefetchFrom = segment;
+
+    if (m_prefetching.exchange(true))
+        return;
+
+    MThreadPool::globalInstance()->start(
+        new HLSPrefetchThread(shared_from_this()), "HLSPrefetch");
+}
+
+/**
+ *  \brief Generates the segments after the last one requested
+ *
+ *  Runs in the thread pool. When a client seeks while this runs, the read
+ *  ahead restarts from the new position.
+ */
+void HLSSegmenter::Prefetch(void)
+{
+    for (;;)
+    {
+        uint from = m_prefetchFrom;
+        uint last = std::min(from + kReadAhead, m_segmentCount);
+
+        for (uint segment = from; segment < last; ++segment)
+        {
+            if (m_prefetchFrom != from)
+                break;
+            GenerateIfMissing(segment);
+        }
+
+        m_prefetching = false;
+
+        // Pick up a request that came in after the loop above finished
+        if ((m_prefetchFrom == from) || m_prefetching.exchange(true))
+            break;
+    }
+}
+
+int HLSSegmenter::WritePacket(void *opaque, uint8_t *buf, int size)
+{
+    static_cast<QByteArray *>(opaque)->append(
+        reinterpret_cast<const char *>(buf), size);
+    return size;
+}
+
+/**
+ *  \brief Remuxes one segment of the source into MPEG-TS
+ *
+ *  Continues from the packet the previous segment stopped at when the
+ *  segments are generated in order, and seeks otherwise. m_demuxLock
+ *  must be held.
+ *
+ *  \param duration Set to the length of the segment, from its first
+ *                  keyframe to the first keyframe of the next one
+ */
+QByteArray HLSSegmenter::Generate(uint segment, int64_t &duration)
+{
+    int64_t start = Boundary(segment);
+    int64_t end   = Boundary(segment + 1);
+
+    if (m_nextSegment != int64_t(segment))
+    {
+        av_packet_unref(m_pending);
+        m_nextSegment = -1;
+
+        if (av_seek_frame(m_ic, -1, start, AVSEEK_FLAG_BACKWARD) < 0)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Unable to seek to segment %1").arg(segment));
+            return {};
+        }
+    }
+
+    AVFormatContext *oc = nullptr;
+    if (avformat_alloc_output_context2(&oc, nullptr, "mpegts", nullptr) < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Unable to create muxer");
+        return {};
+    }
+
+    int videoOut = -1;
+    int audioOut = -1;
+    for (int index : { m_videoIndex, m_audioIndex })
+    {
+        if (index < 0)
+            continue;
+
+        AVStream *in  = m_ic->streams[index];
+        AVStream *out = avformat_new_stream(oc, nullptr);
+        if (!out || avcodec_parameters_copy(out->codecpar, in->codecpar) < 0)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + "Unable to add output stream");
+            avformat_free_context(oc);
+            return {};
+        }
+        out->codecpar->codec_tag = 0;
+        out->time_base = in->time_base;
+
+        if (index == m_videoIndex)
+            videoOut = out->index;
+        else
+            audioOut = out->index;
+    }
+
+    QByteArray data;
+    auto *buffer = static_cast<unsigned char *>(av_malloc(kIOBufferSize));
+    oc->pb = avio_alloc_context(buffer, kIOBufferSize, 1, &data,
+                                nullptr, WritePacket, nullptr);
+    if (!oc->pb)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Unable to allocate muxer buffer");
+        av_free(buffer);
+        avformat_free_context(oc);
+        return {};
+    }
+
+    // Keep the source timestamps, so that the segments line up with each
+    // other however they were generated.
+    AVDictionary *opts = nullptr;
+    av_dict_set(&opts, "mpegts_copyts", "1", 0);
+    bool headerWritten = avformat_write_header(oc, &opts) >= 0;
+    bool ok = headerWritten;
+    av_dict_free(&opts);
+
+    bool started = false;
+    int64_t first = start;
+    int64_t last = m_startTime + m_duration;
+    int64_t lastKey = AV_NOPTS_VALUE;
+    AVPacket *pkt = av_packet_alloc();
+    if (!pkt)
+        ok = false;
+
+    while (ok)
+    {
+        if (m_nextSegment == int64_t(segment))
+        {
+            av_packet_move_ref(pkt, m_pending);
+            m_nextSegment = -1;
+        }
+        else if (av_read_frame(m_ic, pkt) < 0)
+        {
+            break; // end of the source
+        }
+
+        if ((pkt->stream_index != m_videoIndex) &&
+            (pkt->stream_index != m_audioIndex))
+        {
+            av_packet_unref(pkt);
+            continue;
+        }
+
+        AVStream *in = m_ic->streams[pkt->stream_index];
+        int64_t ts = (pkt->pts != AV_NOPTS_VALUE) ? pkt->pts : pkt->dts;
+        if ((ts != AV_NOPTS_VALUE) && IsCut(pkt))
+        {
+            ts = av_rescale_q(ts, in->time_base, AV_TIME_BASE_Q);
+            if ((lastKey != AV_NOPTS_VALUE) && (ts - lastKey > m_keyframeGap))
+                m_keyframeGap = ts - lastKey;
+            lastKey = ts;
+
+            if (!started && (ts >= start))
+            {
+                started = true;
+                first = ts;
+            }
+            else if (started && (ts >= end))
+            {
+                // This packet starts the next segment
+                av_packet_move_ref(m_pending, pkt);
+                m_nextSegment = segment + 1;
+                last = ts;
+                break;
+            }
+        }
+
+        // Skip what the seek left before the start of this segment
+        if (!started)
+        {
+            av_packet_unref(pkt);
+            continue;
+        }
+
+        int out = (pkt->stream_index == m_videoIndex) ? videoOut : audioOut;
+        av_packet_rescale_ts(pkt, in->time_base, oc->streams[out]->time_base);
+        pkt->stream_index = out;
+        pkt->pos = -1;
+
+        if (av_interleaved_write_frame(oc, pkt) < 0)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Unable to write segment %1").arg(segment));
+            ok = false;
+        }
+    }
+    av_packet_free(&pkt);
+
+    if (headerWritten && (av_write_trailer(oc) < 0))
+        ok = false;
+
+    avio_flush(oc->pb);
+    av_freep(&oc->pb->buffer);
+    avio_context_free(&oc->pb);
+    avformat_free_context(oc);
+
+    if (!ok)
+    {
+        // Don't trust the demuxer position after a failure
+        av_packet_unref(m_pending);
+        m_nextSegment = -1;
+        return {};
+    }
+
+    duration = std::max<int64_t>(last - first, 0);
+
+    LOG(VB_RECORD, LOG_DEBUG, LOC +
+        QString("Generated segment %1, %2 bytes, %3 ms").arg(segment)
+            .arg(data.size()).arg(duration / 1000));
+
+    return data;
+}
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
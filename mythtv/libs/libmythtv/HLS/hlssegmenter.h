@@ -0,0 +1,113 @@
+#ifndef HLSSEGMENTER_H
+#define HLSSEGMENTER_H
+
+// C++ headers
+#include <atomic>
+#include <deque>
+#include <memory>
+
+// Qt headers
+#include <QByteArray>
+#include <QDateTime>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+
+#include "mythtvexp.h"
+
+extern "C" {
+#include "libavformat/avformat.h"
+}
+
+/** \class HLSSegmenter
+ *  \brief Serves an HTTP Live Stream by transmuxing the source in-process
+ *
+ *  When the source is already in codecs that HLS clients can play, the
+ *  backend does not need to transcode it. HLSSegmenter remuxes the source
+ *  packets into MPEG-TS segments in memory instead of running mythtranscode,
+ *  so a stream can be played as soon as it has been probed.
+ *
+ *  Segment N covers the source from the first keyframe at or after
+ *  N * segmentSize seconds up to the first keyframe of segment N + 1. The
+ *  segments are generated on demand, with a few segments of read ahead,
+ *  and the most recently used ones are kept in a ring in memory. The
+ *  playlist lists the real length of each segment generated so far.
+ */
+class MTV_PUBLIC HLSSegmenter :
+    public std::enable_shared_from_this<HLSSegmenter>
+{
+  public:
+    static std::shared_ptr<HLSSegmenter> Open(int streamid,
+                                              const QString &filename,
+                                              uint segmentSize,
+                                              uint ringSize,
+                                              const QString &urlPrefix);
+    static std::shared_ptr<HLSSegmenter> Get(int streamid);
+    static void Release(int streamid);
+
+    HLSSegmenter(QString filename, uint segmentSize, uint ringSize,
+                 QString segmentPrefix);
+   ~HLSSegmenter();
+
+    uint       GetSegmentCount(void) const { return m_segmentCount; }
+    uint16_t   GetWidth(void) const        { return m_width; }
+    uint16_t   GetHeight(void) const       { return m_height; }
+    uint32_t   GetBitrate(void) const      { return m_bitrate; }
+    QByteArray GetPlaylist(void) const;
+    QByteArray GetSegment(uint segment);
+
+    void Prefetch(void);
+
+  private:
+    bool       Init(void);
+    QByteArray Generate(uint segment, int64_t &duration);
+    QByteArray GenerateIfMissing(uint segment);
+    bool       Lookup(uint segment, QByteArray &data);
+    void       Store(uint segment, const QByteArray &data, int64_t duration);
+    void       ScanKeyframes(void);
+    void       StartPrefetch(uint segment);
+    int64_t    Boundary(uint segment) const;
+    bool       IsCut(const AVPacket *pkt) const;
+    static int WritePacket(void *opaque, uint8_t *buf, int size);
+    static void ExpireIdle(void);
+
+    QString              m_filename;
+    QString              m_segmentPrefix;
+    uint                 m_segmentSize;
+    uint                 m_ringSize;
+    uint                 m_segmentCount   {0};
+    int64_t              m_duration       {0};
+    /// Longest distance between two keyframes seen so far
+    std::atomic<int64_t> m_keyframeGap    {0};
+    uint16_t             m_width          {0};
+    uint16_t             m_height         {0};
+    uint32_t             m_bitrate        {0};
+
+    /// Guards the demuxer, only one segment is generated at a time
+    QMutex               m_demuxLock;
+    AVFormatContext     *m_ic             {nullptr};
+    int                  m_videoIndex     {-1};
+    int                  m_audioIndex     {-1};
+    int64_t              m_startTime      {0};
+    /// The segment that starts with m_pending, -1 after a seek
+    int64_t              m_nextSegment    {-1};
+    AVPacket            *m_pending        {nullptr};
+
+    /// Guards the ring of generated segments
+    mutable QMutex       m_ringLock;
+    QMap<uint, QByteArray> m_segments;
+    /// Real length of every segment generated so far, in AV_TIME_BASE units
+    QMap<uint, int64_t>  m_durations;
+    std::deque<uint>     m_recent;
+    QDateTime            m_lastUsed;
+
+    std::atomic<uint>    m_prefetchFrom   {0};
+    std::atomic<bool>    m_prefetching    {false};
+
+    static QMutex        s_lock;
+    static QMap<int, std::shared_ptr<HLSSegmenter> > s_segmenters;
+};
+
+#endif // HLSSEGMENTER_H
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
@@ -42,6 +42,7 @@
 #include "exitcodes.h"
 #include "mythlogging.h"
 #include "storagegroup.h"
+#include "hlssegmenter.h"
 #include "httplivestream.h"
 
 #define LOC QString("HLS(%1): ").arg(m_sourceFile)
@@ -49,6 +50,12 @@
 #define SLOC QString("HLS(): ")
 #define SLOC_ERR QString("HLS() Error: ")
 
+// Interval (in microseconds) at which StartStream checks for transcode startup
+static constexpr useconds_t kStatusPollInterval { 100000 };
+
+// Path the backend serves transmuxed streams from, see HLSSegmenter
+static const QString kTransmuxPath { "/HLS/" };
+
 /** \class HTTPLiveStreamThread
  *  \brief QRunnable class for running mythtranscode for HTTP Live Streams
  *
@@ -813,24 +820,135 @@ bool HTTPLiveStream::CheckStop(void)
     return query.value(0).toInt() == (int)kHLSStatusStopping;
 }
 
+/**
+ *  \brief Returns true if this stream is served by an HLSSegmenter
+ */
+bool HTTPLiveStream::IsTransmuxed(void) const
+{
+    return m_relativeURL.startsWith(GetTransmuxPrefix(true));
+}
+
+/**
+ *  \brief Returns the URL prefix transmuxed streams are served at
+ *
+ *  Follows HTTPLiveStreamPrefix (or HTTPLiveStreamPrefixRel), with the
+ *  transmux path in place of the Streaming storage group, so that a stream
+ *  served through a proxy stays behind it. A prefix that does not name the
+ *  storage group is taken as the root of the backend's web server. Without
+ *  a prefix setting, streams are served by this backend, which holds the
+ *  segmenter.
+ */
+QString HTTPLiveStream::GetTransmuxPrefix(bool relative) const
+{
+    static const QString kStreamingPath { "/StorageGroup/Streaming/" };
+
+    if (!relative && gCoreContext->GetSetting("HTTPLiveStreamPrefix").isEmpty())
+    {
+        return QString("http://%1:%2%3")
+            .arg(gCoreContext->GetBackendServerIP())
+            .arg(gCoreContext->GetBackendStatusPort())
+            .arg(kTransmuxPath);
+    }
+
+    QString prefix = relative ? m_httpPrefixRel : m_httpPrefix;
+    int pos = prefix.lastIndexOf(kStreamingPath);
+    if (pos >= 0)
+        return prefix.left(pos) + kTransmuxPath;
+
+    if (prefix.isEmpty())
+        return kTransmuxPath;
+
+    if (!prefix.endsWith("/"))
+        prefix.append("/");
+    return prefix + kTransmuxPath.mid(1);
+}
+
+/**
+ *  \brief Serves the stream from an in-process HLSSegmenter
+ *
+ *  Used instead of running mythtranscode when the source is a local file
+ *  in codecs that HLS clients can play. The stream is then served at the
+ *  source's resolution and bitrate, the requested ones are not applied.
+ *  Segments are generated on demand, so the stream is complete as soon
+ *  as the source has been probed.
+ *
+ *  \return false if the stream has to be transcoded instead
+ */
+bool HTTPLiveStream::StartTransmux(void)
+{
+    if (!gCoreContext->GetBoolSetting("HTTPLiveStreamTransmux", true) ||
+        m_sourceFile.startsWith("myth://"))
+        return false;
+
+    auto segmenter = HLSSegmenter::Open(m_streamid, m_sourceFile,
+                                        m_segmentSize, m_maxSegments,
+                                        GetTransmuxPrefix());
+    if (!segmenter)
+        return false;
+
+    QString playlist = QString("%1.m3u8").arg(m_streamid);
+    QString fullURL = GetTransmuxPrefix() + playlist;
+    QString relativeURL = GetTransmuxPrefix(true) + playlist;
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare(
+        "UPDATE livestream "
+        "SET width = :WIDTH, height = :HEIGHT, bitrate = :BITRATE, "
+        "    sourcewidth = :SRCWIDTH, sourceheight = :SRCHEIGHT, "
+        "    fullurl = :FULLURL, relativeurl = :RELATIVEURL, "
+        "    startsegment = 0, currentsegment = 0, "
+        "    segmentcount = :COUNT, percentcomplete = 100, "
+        "    status = :STATUS, statusmessage = :MESSAGE "
+        "WHERE id = :STREAMID; ");
+    query.bindValue(":WIDTH", segmenter->GetWidth());
+    query.bindValue(":HEIGHT", segmenter->GetHeight());
+    query.bindValue(":BITRATE", segmenter->GetBitrate());
+    query.bindValue(":SRCWIDTH", segmenter->GetWidth());
+    query.bindValue(":SRCHEIGHT", segmenter->GetHeight());
+    query.bindValue(":FULLURL", fullURL);
+    query.bindValue(":RELATIVEURL", relativeURL);
+    query.bindValue(":COUNT", segmenter->GetSegmentCount());
+    query.bindValue(":STATUS", (int)kHLSStatusCompleted);
+    query.bindValue(":MESSAGE", "Transmuxing");
+    query.bindValue(":STREAMID", m_streamid);
+
+    if (!query.exec())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Unable to update transmux info for streamid %1")
+                    .arg(m_streamid));
+        HLSSegmenter::Release(m_streamid);
+        return false;
+    }
+
+    LoadFromDB();
+
+    return true;
+}
+
 DTC::LiveStreamInfo *HTTPLiveStream::StartStream(void)
 {
     if (GetDBStatus() != kHLSStatusQueued)
         return GetLiveStreamInfo();
 
+    if (StartTransmux())
+        return GetLiveStreamInfo();
+
     auto *streamThread = new HTTPLiveStreamThread(GetStreamID());
     MThreadPool::globalInstance()->startReserved(streamThread,
                                                  "HTTPLiveStream");
     MythTimer statusTimer;
-    int       delay = 250000;
     statusTimer.start();
 
+    // Poll at a short, fixed interval. mythtranscode usually leaves the
+    // queued state within a second or so and the client is waiting on this
+    // reply - a growing backoff would add up to a second of extra latency
+    // to every stream start for the sake of a few trivial queries.
     HTTPLiveStreamStatus status = GetDBStatus();
     while ((status == kHLSStatusQueued) &&
            (statusTimer.elapsed() < 30s))
     {
-        delay = (int)(delay * 1.5);
-        usleep(delay);
+        usleep(kStatusPollInterval);
 
         status = GetDBStatus();
     }
@@ -863,40 +981,48 @@ bool HTTPLiveStream::RemoveStream(int id)
     int startSegment = query.value(0).toInt();
     int segmentCount = query.value(1).toInt();
 
-    for (int x = 0; x < segmentCount; ++x)
+    // Transmuxed streams never write anything to disk
+    if (hls->IsTransmuxed())
+    {
+        HLSSegmenter::Release(id);
+    }
+    else
     {
-        thisFile = hls->GetFilename(startSegment + x);
+        for (int x = 0; x < segmentCount; ++x)
+        {
+            thisFile = hls->GetFilename(startSegment + x);
+
+            if (!thisFile.isEmpty() && !QFile::remove(thisFile))
+                LOG(VB_GENERAL, LOG_ERR, SLOC +
+                    QString("Unable to delete %1.").arg(thisFile));
+
+            thisFile = hls->GetFilename(startSegment + x, false, true);
+
+            if (!thisFile.isEmpty() && !QFile::remove(thisFile))
+                LOG(VB_GENERAL, LOG_ERR, SLOC +
+                    QString("Unable to delete %1.").arg(thisFile));
+        }
 
+        thisFile = hls->GetMetaPlaylistName();
         if (!thisFile.isEmpty() && !QFile::remove(thisFile))
             LOG(VB_GENERAL, LOG_ERR, SLOC +
                 QString("Unable to delete %1.").arg(thisFile));
 
-        thisFile = hls->GetFilename(startSegment + x, false, true);
-
+        thisFile = hls->GetPlaylistName();
         if (!thisFile.isEmpty() && !QFile::remove(thisFile))
             LOG(VB_GENERAL, LOG_ERR, SLOC +
                 QString("Unable to delete %1.").arg(thisFile));
-    }
-
-    thisFile = hls->GetMetaPlaylistName();
-    if (!thisFile.isEmpty() && !QFile::remove(thisFile))
-        LOG(VB_GENERAL, LOG_ERR, SLOC +
-            QString("Unable to delete %1.").arg(thisFile));
-
-    thisFile = hls->GetPlaylistName();
-    if (!thisFile.isEmpty() && !QFile::remove(thisFile))
-        LOG(VB_GENERAL, LOG_ERR, SLOC +
-            QString("Unable to delete %1.").arg(thisFile));
 
-    thisFile = hls->GetPlaylistName(true);
-    if (!thisFile.isEmpty() && !QFile::remove(thisFile))
-        LOG(VB_GENERAL, LOG_ERR, SLOC +
-            QString("Unable to delete %1.").arg(thisFile));
+        thisFile = hls->GetPlaylistName(true);
+        if (!thisFile.isEmpty() && !QFile::remove(thisFile))
+            LOG(VB_GENERAL, LOG_ERR, SLOC +
+                QString("Unable to delete %1.").arg(thisFile));
 
-    thisFile = hls->GetHTMLPageName();
-    if (!thisFile.isEmpty() && !QFile::remove(thisFile))
-        LOG(VB_GENERAL, LOG_ERR, SLOC +
-            QString("Unable to delete %1.").arg(thisFile));
+        thisFile = hls->GetHTMLPageName();
+        if (!thisFile.isEmpty() && !QFile::remove(thisFile))
+            LOG(VB_GENERAL, LOG_ERR, SLOC +
+                QString("Unable to delete %1.").arg(thisFile));
+    }
 
     query.prepare(
         "DELETE FROM livestream "
@@ -912,6 +1038,16 @@ bool HTTPLiveStream::RemoveStream(int id)
 
 DTC::LiveStreamInfo *HTTPLiveStream::StopStream(int id)
 {
+    {
+        HTTPLiveStream hls(id);
+        if (hls.IsTransmuxed())
+        {
+            HLSSegmenter::Release(id);
+            hls.UpdateStatus(kHLSStatusStopped);
+            return hls.GetLiveStreamInfo();
+        }
+    }
+
     MSqlQuery query(MSqlQuery::InitCon());
     query.prepare(
         "UPDATE livestream "
@@ -72,6 +72,9 @@ class MTV_PUBLIC HTTPLiveStream
 
     bool CheckStop(void);
 
+    bool IsTransmuxed(void) const;
+    QString GetTransmuxPrefix(bool relative = false) const;
+
            DTC::LiveStreamInfo     *StartStream(void);
     static DTC::LiveStreamInfo     *StopStream(int id);
     static bool                     RemoveStream(int id);
@@ -80,6 +83,8 @@ class MTV_PUBLIC HTTPLiveStream
     static DTC::LiveStreamInfoList *GetLiveStreamInfoList( const QString &FileName = "");
 
  protected:
+    bool StartTransmux(void);
+
     bool        m_writing          {false};
     int         m_streamid         {-1};
     QString     m_sourceFile;
@@ -0,0 +1,292 @@
+// -*- Mode: c++ -*-
+
+// C++ headers
+#include <algorithm>
+#include <utility>
+
+// Qt headers
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QRunnable>
+
+// MythTV headers
+#include "channelchangetrace.h"
+#include "mthreadpool.h"
+#include "mythcorecontext.h"
+#include "mythdirs.h"
+#include "mythevent.h"
+#include "mythlogging.h"
+
+#define LOC QString("ChannelChange(%1): ").arg(m_process)
+
+// Number of timelines of each process kept in the config dir
+static constexpr int kKeepTimelines { 20 };
+
+// Durations of the phases of all the channel changes reported to this process
+static QMutex                                  s_statsLock;
+static QList<ChannelChangeTrace::PhaseStats>   s_stats;
+
+static std::chrono::milliseconds to_ms(std::chrono::system_clock::duration d)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(d);
+}
+
+static double to_us(std::chrono::system_clock::duration d)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+}
+
+/// Writes a timeline file, and prunes the old ones, away from the UI thread
+class TimelineWriter : public QRunnable
+{
+  public:
+    TimelineWriter(QString process, QString name, QByteArray data)
+      : m_process(std::move(process)), m_name(std::move(name)),
+        m_data(std::move(data)) {}
+
+    void run(void) override // QRunnable
+    {
+        QDir dir(GetConfDir());
+        dir.mkdir("channelchange");
+        if (!dir.cd("channelchange"))
+            return;
+
+        QFile file(dir.absoluteFilePath(QString("%1-%2.json").arg(m_name, m_process)));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Failed to write %1").arg(file.fileName()));
+            return;
+        }
+        file.write(m_data);
+        file.close();
+
+        // Only keep the most recent timelines
+        QFileInfoList old = dir.entryInfoList(
+            { QString("*-%1.json").arg(m_process) }, QDir::Files, QDir::Time);
+        for (int i = kKeepTimelines; i < old.size(); ++i)
+            QFile::remove(old[i].absoluteFilePath());
+    }
+
+  private:
+    QString    m_process;
+    QString    m_name;
+    QByteArray m_data;
+};
+
+/*!
+ * \param process Name of the side of the change that this traces, one of
+ *                "backend" or "frontend".
+ */
+ChannelChangeTrace::ChannelChangeTrace(QString process)
+  : m_process(std::move(process))
+{
+}
+
+/*!
+ * \brief Starts timing a channel change
+ * \details An unfinished previous change is discarded, as it has been
+ *          superseded by this one.
+ * \param channel Channel being changed to, for the logs and timeline
+ * \param kind    Kind of change, if it is not a plain one. Such changes get
+ *                histograms of their own, so they can be compared.
+ */
+void ChannelChangeTrace::Start(const QString &channel, const QString &kind)
+{
+    QMutexLocker locker(&m_lock);
+    if (m_running)
+    {
+        LOG(VB_CHANNEL, LOG_DEBUG, LOC +
+            QString("Change to %1 superseded").arg(m_channel));
+    }
+    m_channel = channel;
+    m_kind    = kind;
+    m_id.clear();
+    m_steps.clear();
+    m_start   = Clock::now();
+    m_running = true;
+}
+
+/*!
+ * \brief Records the completion of a phase of the current change
+ * \details Only the first completion of each phase is recorded, so this
+ *          can be called from polling code.
+ */
+void ChannelChangeTrace::Mark(const QString &phase)
+{
+    QMutexLocker locker(&m_lock);
+    if (!m_running)
+        return;
+    auto seen = [&phase](const Step &step) { return step.m_phase == phase; };
+    if (std::any_of(m_steps.cbegin(), m_steps.cend(), seen))
+        return;
+    m_steps.push_back({ phase, Clock::now() });
+}
+
+/*!
+ * \brief Sets the ID shared by the backend and frontend timelines
+ * \param chainid ID of the LiveTV chain
+ * \param pos     Position in the chain of the program tuned by the change
+ */
+void ChannelChangeTrace::SetID(const QString &chainid, int pos)
+{
+    QMutexLocker locker(&m_lock);
+    if (m_running)
+        m_id = QString("%1#%2").arg(chainid).arg(pos);
+}
+
+bool ChannelChangeTrace::HasID(void) const
+{
+    QMutexLocker locker(&m_lock);
+    return m_running && !m_id.isEmpty();
+}
+
+bool ChannelChangeTrace::IsRunning(void) const
+{
+    QMutexLocker locker(&m_lock);
+    return m_running;
+}
+
+/// \brief Discards the current change, eg. when tuning failed
+void ChannelChangeTrace::Cancel(void)
+{
+    QMutexLocker locker(&m_lock);
+    if (m_running)
+    {
+        LOG(VB_CHANNEL, LOG_DEBUG, LOC +
+            QString("Change to %1 cancelled").arg(m_channel));
+    }
+    m_running = false;
+}
+
+/*!
+ * \brief Completes the current change
+ * \details The timeline is logged and, with channel logging enabled, written
+ *          to the config dir. The phase durations are added to the
+ *          histograms of the master backend.
+ */
+void ChannelChangeTrace::Finish(void)
+{
+    QMutexLocker locker(&m_lock);
+    if (!m_running)
+        return;
+    m_running = false;
+
+    std::vector<Step> steps = m_steps;
+    std::stable_sort(steps.begin(), steps.end(),
+                     [](const Step &a, const Step &b) { return a.m_time < b.m_time; });
+    QString id      = m_id;
+    QString channel = m_channel;
+    QString process = m_kind.isEmpty() ? m_process
+                                       : QString("%1 %2").arg(m_process, m_kind);
+    Clock::time_point start = m_start;
+    locker.unlock();
+
+    if (id.isEmpty())
+        id = QString("unmatched-%1").arg(to_ms(start.time_since_epoch()).count());
+
+    QStringList samples { process };
+    QStringList summary;
+    Clock::time_point prev = start;
+    for (const auto & step : steps)
+    {
+        qint64 ms = to_ms(step.m_time - prev).count();
+        samples << step.m_phase << QString::number(ms);
+        summary << QString("%1 %2").arg(step.m_phase).arg(ms);
+        prev = step.m_time;
+    }
+    qint64 total = to_ms(prev - start).count();
+    samples << "total" << QString::number(total);
+
+    LOG(VB_CHANNEL, LOG_INFO, LOC +
+        QString("Change to %1 (%2) took %3 ms: %4")
+        .arg(channel, id).arg(total).arg(summary.join(", ")));
+
+    if (VERBOSE_LEVEL_CHECK(VB_CHANNEL, LOG_INFO))
+        WriteTimeline(id, channel, start, steps);
+
+    if (gCoreContext->IsMasterBackend())
+        AddSamples(samples);
+    else
+        gCoreContext->SendEvent(MythEvent("CHANNEL_CHANGE_TRACE", samples));
+}
+
+/// \brief Writes a timeline in the Chrome trace event format, in the background
+void ChannelChangeTrace::WriteTimeline(const QString &id, const QString &channel,
+                                       Clock::time_point start,
+                                       const std::vector<Step> &steps) const
+{
+    const qint64 pid = QCoreApplication::applicationPid();
+    const QJsonObject args {{ "trace", id }, { "channel", channel }};
+
+    QJsonArray events;
+    events.append(QJsonObject {
+        { "name", "process_name" }, { "ph", "M" }, { "pid", pid },
+        { "args", QJsonObject {{ "name", QString("%1 %2")
+                  .arg(m_process, gCoreContext->GetHostName()) }} } });
+
+    Clock::time_point prev = start;
+    for (const auto & step : steps)
+    {
+        events.append(QJsonObject {
+            { "name", step.m_phase }, { "cat", "channelchange" }, { "ph", "X" },
+            { "ts", to_us(prev.time_since_epoch()) },
+            { "dur", to_us(step.m_time - prev) },
+            { "pid", pid }, { "tid", 0 }, { "args", args } });
+        prev = step.m_time;
+    }
+
+    QString name = id;
+    name.replace(QRegularExpression("[^A-Za-z0-9_#-]"), "_");
+    name.replace('#', '-');
+    QByteArray data = QJsonDocument(QJsonObject {{ "traceEvents", events }}).toJson();
+    MThreadPool::globalInstance()->start(
+        new TimelineWriter(m_process, name, data), "ChannelChangeTrace");
+}
+
+/*!
+ * \brief Adds the durations of the phases of a change to the histograms
+ * \param samples The process name followed by pairs of phase names and
+ *                durations in milliseconds
+ */
+void ChannelChangeTrace::AddSamples(const QStringList &samples)
+{
+    if (samples.size() < 3)
+        return;
+
+    QMutexLocker locker(&s_statsLock);
+    const QString &process = samples[0];
+    for (int i = 1; i + 1 < samples.size(); i += 2)
+    {
+        QString name = QString("%1: %2").arg(process, samples[i]);
+        std::chrono::milliseconds duration { samples[i + 1].toLongLong() };
+
+        auto it = std::find_if(s_stats.begin(), s_stats.end(),
+            [&name](const PhaseStats &stats) { return stats.m_name == name; });
+        if (it == s_stats.end())
+        {
+            s_stats.append(PhaseStats());
+            it = s_stats.end() - 1;
+            it->m_name = name;
+        }
+
+        it->m_count++;
+        it->m_total += duration;
+        it->m_max    = std::max(it->m_max, duration);
+        auto bucket  = std::lower_bound(kBucketLimits.cbegin(), kBucketLimits.cend(),
+                                        duration);
+        it->m_buckets[bucket - kBucketLimits.cbegin()]++;
+    }
+}
+
+/// \brief Durations of each phase, in the order they were first reported
+QList<ChannelChangeTrace::PhaseStats> ChannelChangeTrace::GetStats(void)
+{
+    QMutexLocker locker(&s_statsLock);
+    return s_stats;
+}
@@ -0,0 +1,89 @@
+// -*- Mode: c++ -*-
+#ifndef CHANNELCHANGETRACE_H
+#define CHANNELCHANGETRACE_H
+
+// C++ headers
+#include <array>
+#include <chrono>
+#include <vector>
+
+// Qt headers
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+// MythTV headers
+#include "mythtvexp.h"
+
+/*!
+ * \brief Timeline of a LiveTV channel change
+ *
+ * The recorder (TVRec) and the frontend (TV and its player) each keep one and
+ * mark the moments that the steps of a change complete. A phase lasts from
+ * the previous mark, or from Start(), to its own mark.
+ *
+ * Both sides identify the change by the LiveTV chain entry it creates, so the
+ * two timelines share a trace ID. With channel logging (-v channel) enabled,
+ * finished timelines are written to channelchange/ in the config dir in the
+ * Chrome trace event format, with wall clock timestamps so that the files
+ * from both hosts can be loaded together. The phase durations are always
+ * added to the histograms shown on the master backend's status page.
+ */
+class MTV_PUBLIC ChannelChangeTrace
+{
+  public:
+    /// Upper bounds of the histogram buckets, the last bucket is unbounded
+    static constexpr std::array<std::chrono::milliseconds, 9> kBucketLimits
+        { std::chrono::milliseconds(25),   std::chrono::milliseconds(50),
+          std::chrono::milliseconds(100),  std::chrono::milliseconds(250),
+          std::chrono::milliseconds(500),  std::chrono::milliseconds(1000),
+          std::chrono::milliseconds(2000), std::chrono::milliseconds(4000),
+          std::chrono::milliseconds(8000) };
+
+    struct PhaseStats
+    {
+        QString                   m_name;
+        uint                      m_count   {0};
+        std::chrono::milliseconds m_total   {0};
+        std::chrono::milliseconds m_max     {0};
+        std::array<uint, kBucketLimits.size() + 1> m_buckets {};
+    };
+
+    explicit ChannelChangeTrace(QString process);
+
+    void Start(const QString &channel, const QString &kind = QString());
+    void Mark(const QString &phase);
+    void SetID(const QString &chainid, int pos);
+    bool HasID(void) const;
+    bool IsRunning(void) const;
+    void Finish(void);
+    void Cancel(void);
+
+    static void AddSamples(const QStringList &samples);
+    static QList<PhaseStats> GetStats(void);
+
+  private:
+    using Clock = std::chrono::system_clock;
+
+    struct Step
+    {
+        QString           m_phase;
+        Clock::time_point m_time;
+    };
+
+    void WriteTimeline(const QString &id, const QString &channel,
+                       Clock::time_point start,
+                       const std::vector<Step> &steps) const;
+
+    mutable QMutex    m_lock;
+    QString           m_process;
+    QString           m_channel;
+    QString           m_kind;
+    QString           m_id;
+    Clock::time_point m_start;
+    std::vector<Step> m_steps;
+    bool              m_running {false};
+};
+
+#endif // CHANNELCHANGETRACE_H
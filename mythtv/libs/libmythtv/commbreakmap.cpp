@@ -94,6 +94,28 @@ void CommBreakMap::GetMap(frm_dir_map_t &map) const
     map = m_commBreakMap;
 }
 
+/**
+ * \brief Returns the end of the next commercial break that automatic
+ *        skipping will jump over, so that it can be prefetched.
+ */
+bool CommBreakMap::GetNextSkipTarget(uint64_t &jumpToFrame) const
+{
+    QMutexLocker locker(&m_commBreakMapLock);
+    if (!m_hascommbreaktable || (kCommSkipOn != m_autocommercialskip))
+        return false;
+
+    frm_dir_map_t::const_iterator it = m_commBreakIter;
+    for (; it != m_commBreakMap.constEnd(); ++it)
+    {
+        if (*it == MARK_COMM_END)
+        {
+            jumpToFrame = it.key();
+            return true;
+        }
+    }
+    return false;
+}
+
 bool CommBreakMap::IsInCommBreak(uint64_t frameNumber) const
 {
     QMutexLocker locker(&m_commBreakMapLock);
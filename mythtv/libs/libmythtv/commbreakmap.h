@@ -40,6 +40,7 @@ class CommBreakMap
     void LoadMap(PlayerContext *player_ctx, uint64_t framesPlayed);
 
     bool IsInCommBreak(uint64_t frameNumber) const;
+    bool GetNextSkipTarget(uint64_t &jumpToFrame) const;
     bool AutoCommercialSkip(uint64_t &jumpToFrame, uint64_t framesPlayed,
                             double video_frame_rate, uint64_t totalFrames,
                             QString &comm_msg);
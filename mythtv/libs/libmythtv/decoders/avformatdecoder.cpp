@@ -41,10 +41,13 @@ extern "C" {
 #include "mythplayer.h"
 #include "remoteencoder.h"
 #include "programinfo.h"
+#include "recordingfile.h"
 #include "mythcorecontext.h"
+#include "mythtimer.h"
 #include "mythdbcon.h"
 #include "iso639.h"
 #include "mpegtables.h"
+#include "bytereader.h"
 #include "atscdescriptors.h"
 #include "dvbdescriptors.h"
 #include "captions/cc608decoder.h"
@@ -95,10 +98,32 @@ static void cc608_build_parity_table(CC608Parity &parity_table);
 
 static bool silence_ffmpeg_logging = false;
 
+// Probe window used to check the streams of a recording against its metadata
+static constexpr int64_t kFastOpenProbeSize       { 2LL * 1024 * 1024 };
+static constexpr int64_t kFastOpenAnalyzeDuration { 2LL * AV_TIME_BASE };
+
+// Time taken to open the recordings tried with a fast probe, including the
+// full probes of those that then fell back
+static QMutex                    s_probeTimeLock;
+static std::chrono::milliseconds s_fastOpenTime      {0ms};
+static uint                      s_fastOpenCount     {0};
+static uint                      s_fastOpenFallbacks {0};
+
 static QSize get_video_dim(const AVCodecContext &ctx)
 {
     return {ctx.width >> ctx.lowres, ctx.height >> ctx.lowres};
 }
+static AVDiscard get_trick_play_discard(TrickPlayMode Mode)
+{
+    switch (Mode)
+    {
+        case kTrickPlayNonReference: return AVDISCARD_NONREF;
+        case kTrickPlayKeyframes:    return AVDISCARD_NONKEY;
+        default: break;
+    }
+    return AVDISCARD_DEFAULT;
+}
+
 static float get_aspect(const AVCodecContext &ctx)
 {
     float aspect_ratio = 0.0F;
@@ -665,6 +690,20 @@ bool AvFormatDecoder::DoFastForward(long long desiredFrame, bool discardFrames)
     return true;
 }
 
+/// \brief Has the video decoder discard the frames that trick play skips
+void AvFormatDecoder::SetTrickPlay(TrickPlayMode Mode)
+{
+    QMutexLocker locker(&m_avCodecLock);
+    DecoderBase::SetTrickPlay(Mode);
+
+    int stream = m_selectedTrack[kTrackTypeVideo].m_av_stream_index;
+    if (stream < 0 || !m_ic || stream >= static_cast<int>(m_ic->nb_streams))
+        return;
+    AVCodecContext *context = m_codecMap.FindCodecContext(m_ic->streams[stream]);
+    if (context)
+        context->skip_frame = get_trick_play_discard(m_trickPlay);
+}
+
 void AvFormatDecoder::SeekReset(long long newKey, uint skipFrames,
                                 bool doflush, bool discardFrames)
 {
@@ -764,6 +803,10 @@ void AvFormatDecoder::SeekReset(long long newKey, uint skipFrames,
     bool exactSeeks = GetSeekSnap() == 0U;
     static constexpr std::chrono::milliseconds maxSeekTimeMs { 200ms };
     int profileFrames = 0;
+    // Only keyframes come out of the decoder, so any skip would overshoot
+    if (m_trickPlay == kTrickPlayKeyframes)
+        skipFrames = 0;
+    long long skipTarget = m_framesPlayed + skipFrames;
     MythTimer begin(MythTimer::kStartRunning);
     for (; (skipFrames > 0 && !m_atEof &&
             (exactSeeks || begin.elapsed() < maxSeekTimeMs));
@@ -787,6 +830,9 @@ void AvFormatDecoder::SeekReset(long long newKey, uint skipFrames,
             m_parent->DiscardVideoFrame(m_decodedVideoFrame);
             m_decodedVideoFrame = nullptr;
         }
+        // Discarded non-reference frames also count towards the skip
+        if (m_trickPlay == kTrickPlayNonReference)
+            skipFrames = static_cast<uint>(std::max(skipTarget - m_framesPlayed + 1, 1LL));
         if (!exactSeeks && profileFrames >= 5 && profileFrames < 10)
         {
             const int giveUpPredictionMs = 400;
@@ -917,6 +963,85 @@ int AvFormatDecoder::FindStreamInfo(void)
     return retval;
 }
 
+/**
+ *  \brief Loads the stream layout the recorder stored for this recording.
+ *  \return true if it is complete enough to open the file with a minimal probe
+ */
+bool AvFormatDecoder::LoadKnownStreams(RecordingFile &Known) const
+{
+    if (!m_playbackInfo || !m_playbackInfo->GetRecordingID() || m_livetv ||
+        m_ringBuffer->IsDisc() ||
+        !gCoreContext->GetBoolSetting("DecoderFastOpen", true))
+    {
+        return false;
+    }
+
+    Known.m_recordingId = m_playbackInfo->GetRecordingID();
+    if (!Known.Load() || Known.m_videoCodec.isEmpty() ||
+        !Known.m_videoResolution.isValid() || Known.m_videoResolution.isEmpty())
+    {
+        return false;
+    }
+
+    LOG(VB_PLAYBACK, LOG_INFO, LOC +
+        QString("Fast open expecting %1 %2x%3 video, %4 audio")
+        .arg(Known.m_videoCodec).arg(Known.m_videoResolution.width())
+        .arg(Known.m_videoResolution.height()).arg(Known.m_audioCodec));
+    return true;
+}
+
+/**
+ *  \brief Checks that a minimal probe found the streams the recorder stored
+ *         and everything needed to decode them.
+ */
+bool AvFormatDecoder::KnownStreamsMatch(const RecordingFile &Known)
+{
+    bool videofound = false;
+    bool audiofound = Known.m_audioCodec.isEmpty();
+
+    for (uint i = 0; i < m_ic->nb_streams; i++)
+    {
+        AVStream *stream = m_ic->streams[i];
+        const AVCodecParameters *par = stream->codecpar;
+        QString codec = ff_codec_id_string(par->codec_id);
+
+        if (par->codec_type == AVMEDIA_TYPE_VIDEO && codec == Known.m_videoCodec &&
+            par->width == Known.m_videoResolution.width() &&
+            par->height == Known.m_videoResolution.height())
+        {
+            videofound = true;
+        }
+        else if (par->codec_type == AVMEDIA_TYPE_AUDIO && codec == Known.m_audioCodec)
+        {
+            audiofound = true;
+        }
+
+        if (!StreamHasRequiredParameters(m_codecMap.GetCodecContext(stream), stream))
+            return false;
+    }
+
+    return videofound && audiofound;
+}
+
+/**
+ *  \brief Fills in the stream parameters that a minimal probe may leave unset
+ */
+void AvFormatDecoder::SeedKnownStreams(const RecordingFile &Known)
+{
+    if (Known.m_videoFrameRate <= 0.0)
+        return;
+
+    for (uint i = 0; i < m_ic->nb_streams; i++)
+    {
+        AVStream *stream = m_ic->streams[i];
+        if (stream->codecpar->codec_type == AVMEDIA_TYPE_VIDEO &&
+            !stream->avg_frame_rate.num)
+        {
+            stream->avg_frame_rate = av_d2q(Known.m_videoFrameRate, 100000);
+        }
+    }
+}
+
 /**
  *  OpenFile opens a ringbuffer for playback.
  *
@@ -983,6 +1108,13 @@ int AvFormatDecoder::OpenFile(MythMediaBuffer *Buffer, bool novideo,
     bool scancomplete = false;
     int  remainingscans  = 5;
 
+    RecordingFile known;
+    bool fastopen = LoadKnownStreams(known);
+    bool logfastopen = fastopen;
+    bool fellback = false;
+    MythTimer opentimer;
+    opentimer.start();
+
     while (!scancomplete && remainingscans--)
     {
         bool found = false;
@@ -1059,8 +1191,64 @@ int AvFormatDecoder::OpenFile(MythMediaBuffer *Buffer, bool novideo,
         // it takes to complete the scan).
         m_ic->max_analyze_duration = 60 * AV_TIME_BASE;
 
+        // The streams of our own recordings are known from recordedfile, so
+        // only probe enough to confirm them.
+        if (fastopen)
+        {
+            m_ic->probesize = kFastOpenProbeSize;
+            m_ic->max_analyze_duration = kFastOpenAnalyzeDuration;
+            if (known.m_videoFrameRate > 0.0)
+                m_ic->fps_probe_size = 0;
+        }
+
+        MythTimer probetimer;
+        probetimer.start();
         m_avfRingBuffer->SetInInit(m_livetv);
         err = FindStreamInfo();
+        std::chrono::milliseconds probetime = probetimer.elapsed();
+
+        if (fastopen)
+        {
+            fastopen = false;
+            if (err < 0 || !KnownStreamsMatch(known))
+            {
+                LOG(VB_PLAYBACK, LOG_INFO, LOC +
+                    QString("Streams differ from the recording's metadata after %1 ms "
+                            "- probing fully").arg(probetime.count()));
+                fellback = true;
+                CloseContext();
+                scancomplete = false;
+                continue;
+            }
+
+            SeedKnownStreams(known);
+        }
+
+        if (logfastopen && err >= 0)
+        {
+            // Time the whole open, so a fallback also counts the failed fast
+            // probe and reopening the file
+            logfastopen = false;
+            std::chrono::milliseconds opentime = opentimer.elapsed();
+            QMutexLocker locker(&s_probeTimeLock);
+            s_fastOpenTime += opentime;
+            s_fastOpenCount++;
+            if (fellback)
+                s_fastOpenFallbacks++;
+            LOG(VB_PLAYBACK, LOG_INFO, LOC +
+                QString("%1 took %2 ms (fast opens average %3 ms, %4 of %5 fell back)")
+                .arg(fellback ? "Fast open with fallback" : "Fast open")
+                .arg(opentime.count())
+                .arg((s_fastOpenTime / s_fastOpenCount).count())
+                .arg(s_fastOpenFallbacks).arg(s_fastOpenCount));
+        }
+        else if (err >= 0 && m_playbackInfo && m_playbackInfo->GetRecordingID())
+        {
+            LOG(VB_PLAYBACK, LOG_INFO, LOC +
+                QString("Full probe took %1 ms, open took %2 ms")
+                .arg(probetime.count()).arg(opentimer.elapsed().count()));
+        }
+
         if (err < 0)
         {
             LOG(VB_GENERAL, LOG_ERR, LOC + QString("Could not find codec parameters for '%1'").arg(filename));
@@ -1541,6 +1729,8 @@ void AvFormatDecoder::InitVideoCodec(AVStream *stream, AVCodecContext *enc,
     if (FlagIsSet(kDecodeNoDecode))
         enc->skip_idct = AVDISCARD_ALL;
 
+    enc->skip_frame = get_trick_play_discard(m_trickPlay);
+
     if (selectedStream)
     {
         // m_fps is now set 'correctly' in ScanStreams so this additional call
@@ -2297,7 +2487,9 @@ int AvFormatDecoder::ScanStreams(bool novideo)
             }
 
             AVStream *stream = m_ic->streams[selTrack];
-            if (m_averrorCount > SEQ_PKT_ERR_MAX)
+            // A decoder cannot change its threading once opened
+            bool threadswitch = m_decodeFrameThreading && (m_decodeThreadType == FF_THREAD_SLICE);
+            if (m_averrorCount > SEQ_PKT_ERR_MAX || threadswitch)
                 m_codecMap.FreeCodecContext(stream);
             AVCodecContext *enc = m_codecMap.GetCodecContext(stream, codec);
             StreamInfo si(selTrack, 0, 0, 0, 0);
@@ -2336,6 +2528,7 @@ int AvFormatDecoder::ScanStreams(bool novideo)
             int height = std::max(dim.height(), 16);
             QString dec = "ffmpeg";
             uint thread_count = 1;
+            uint decode_ahead = 0;
             QString codecName;
             if (enc->codec)
                 codecName = enc->codec->name;
@@ -2379,6 +2572,7 @@ int AvFormatDecoder::ScanStreams(bool novideo)
                     m_videoDisplayProfile.SetInput(QSize(width, height), m_fps, codecName, unavailabledecoders);
                     dec = m_videoDisplayProfile.GetDecoder();
                     thread_count = m_videoDisplayProfile.GetMaxCPUs();
+                    decode_ahead = m_videoDisplayProfile.GetDecodeAhead();
                     bool skip_loop_filter = m_videoDisplayProfile.IsSkipLoopEnabled();
                     if  (!skip_loop_filter)
                         enc->skip_loop_filter = AVDISCARD_NONKEY;
@@ -2447,6 +2641,20 @@ int AvFormatDecoder::ScanStreams(bool novideo)
                     LOG(VB_PLAYBACK, LOG_INFO, LOC + QString("Using %1 CPUs for decoding")
                         .arg(HAVE_THREADS ? thread_count : 1));
                     enc->thread_count = static_cast<int>(thread_count);
+
+                    // With decode ahead, prefer the lower latency of slice
+                    // threading until it is seen to be too slow for this
+                    // stream (see UpdateDecodeStats). Frame threading adds a
+                    // frame of delay per thread but scales with any content.
+                    if (decode_ahead && thread_count > 1 && codec && !avcodec_is_open(enc))
+                    {
+                        bool slice = (codec->capabilities & AV_CODEC_CAP_SLICE_THREADS) != 0;
+                        bool frame = (codec->capabilities & AV_CODEC_CAP_FRAME_THREADS) != 0;
+                        if (slice && !(frame && m_decodeFrameThreading))
+                            enc->thread_type = FF_THREAD_SLICE;
+                        else if (frame)
+                            enc->thread_type = FF_THREAD_FRAME;
+                    }
                 }
             }
 
@@ -2462,6 +2670,20 @@ int AvFormatDecoder::ScanStreams(bool novideo)
                 scanerror = -1;
                 break;
             }
+
+            // Record the threading actually in use, FFmpeg may not honour
+            // the request (e.g. for streams with a single slice)
+            QMutexLocker locker(&m_decodeStatsLock);
+            m_decodeThreadType  = (decode_ahead && !foundgpudecoder) ? enc->active_thread_type : 0;
+            m_decodeTimePending = 0us;
+            m_decodeFrames      = 0;
+            m_decodeTimeTotal   = 0us;
+            m_decodeTimes.fill(0);
+            if (m_decodeThreadType)
+            {
+                LOG(VB_PLAYBACK, LOG_INFO, LOC + QString("Using %1 threading to decode %2 frames ahead")
+                    .arg(m_decodeThreadType == FF_THREAD_SLICE ? "slice" : "frame").arg(decode_ahead));
+            }
             break;
         }
     }
@@ -3118,7 +3340,7 @@ void AvFormatDecoder::MpegPreProcessPkt(AVStream *stream, AVPacket *pkt)
 
     while (bufptr < bufend)
     {
-        bufptr = avpriv_find_start_code(bufptr, bufend, &m_startCodeState);
+        bufptr = ByteReader::find_start_code(bufptr, bufend, &m_startCodeState);
 
         float aspect_override = -1.0F;
         if (m_ringBuffer->IsDVD())
@@ -3393,6 +3615,7 @@ bool AvFormatDecoder::ProcessVideoPacket(AVStream *curstream, AVPacket *pkt, boo
     bool sentPacket = false;
     int ret2 = 0;
 
+    auto decodestart = nowAsDuration<std::chrono::microseconds>();
     m_avCodecLock.lock();
     if (!m_useFrameTiming)
         context->reordered_opaque = pkt->pts;
@@ -3430,6 +3653,8 @@ bool AvFormatDecoder::ProcessVideoPacket(AVStream *curstream, AVPacket *pkt, boo
         }
     }
     m_avCodecLock.unlock();
+    UpdateDecodeStats(context, nowAsDuration<std::chrono::microseconds>() - decodestart,
+                      gotpicture != 0);
 
     if (ret < 0 || ret2 < 0)
     {
@@ -3767,6 +3992,12 @@ bool AvFormatDecoder::ProcessVideoFrame(AVStream *Stream, AVFrame *AvFrame)
     m_nextDecodedFrameIsKeyFrame = false;
     m_decodedVideoFrame = frame;
     m_gotVideoFrame = true;
+    // Count the frames that trick play had the decoder discard
+    if (m_trickPlay != kTrickPlayNone && m_lastVPts > 0ms && temppts > m_lastVPts)
+    {
+        auto gap = llround(static_cast<double>((temppts - m_lastVPts).count()) * m_fps / 1000.0);
+        m_framesPlayed += std::max(gap - 1, 0LL);
+    }
     if (++m_fpsSkip >= m_fpsMultiplier)
     {
         ++m_framesPlayed;
@@ -5168,6 +5399,79 @@ QString AvFormatDecoder::GetCodecDecoderName(void) const
     return get_decoder_name(m_videoCodecId);
 }
 
+/*! \brief Accumulates the time spent decoding each video frame
+ *
+ * The time taken by the calls that send packets to the decoder and receive
+ * pictures from it is added up until a picture is returned, which gives the
+ * cost of each frame to the decoding thread whatever the threading in use.
+ *
+ * When decode ahead chose slice threading and the average cost exceeds 80% of
+ * the frame interval, the decoder is reopened once with frame threading.
+*/
+void AvFormatDecoder::UpdateDecodeStats(const AVCodecContext *Context,
+                                        std::chrono::microseconds Elapsed, bool GotPicture)
+{
+    static constexpr uint kDecodeStatsMinFrames { 50 };
+
+    m_decodeTimePending += Elapsed;
+    if (!GotPicture)
+        return;
+
+    auto decodetime = m_decodeTimePending;
+    m_decodeTimePending = 0us;
+    float fps = (m_fps > 1.0F) ? m_fps : 25.0F;
+    auto interval = std::chrono::microseconds(static_cast<int64_t>(1000000.0F / fps));
+
+    QMutexLocker locker(&m_decodeStatsLock);
+    m_decodeFrames++;
+    m_decodeTimeTotal += decodetime;
+    auto bucket = static_cast<size_t>((decodetime * 4) / interval);
+    m_decodeTimes[std::min(bucket, kDecodeTimeBuckets - 1)]++;
+
+    if (m_decodeFrameThreading || (m_decodeThreadType != FF_THREAD_SLICE) ||
+        (m_decodeFrames < kDecodeStatsMinFrames) || !Context->codec ||
+        !(Context->codec->capabilities & AV_CODEC_CAP_FRAME_THREADS))
+    {
+        return;
+    }
+
+    auto average = m_decodeTimeTotal / m_decodeFrames;
+    if (average * 5 <= interval * 4)
+        return;
+    locker.unlock();
+
+    LOG(VB_GENERAL, LOG_INFO, LOC + QString("Slice threaded decoding takes %1ms per %2ms frame "
+        "- switching to frame threading")
+        .arg(static_cast<double>(average.count()) / 1000.0, 0, 'f', 1)
+        .arg(static_cast<double>(interval.count()) / 1000.0, 0, 'f', 1));
+    m_decodeFrameThreading = true;
+    m_streamsChanged = true;
+}
+
+/*! \brief Describes the video decode times for the playback debug OSD
+ *
+ * Gives the average time per frame, then the percentage of frames whose
+ * decode took up to a quarter, a half, three quarters, one and one and a
+ * quarter of the frame interval, and longer.
+*/
+QString AvFormatDecoder::GetDecodeStats(void) const
+{
+    QMutexLocker locker(&m_decodeStatsLock);
+    if (!m_decodeFrames)
+        return QString();
+
+    QStringList buckets;
+    for (uint count : m_decodeTimes)
+        buckets << QString::number(count * 100 / m_decodeFrames);
+    auto average = m_decodeTimeTotal / m_decodeFrames;
+    QString result = QString("%1ms %2%")
+        .arg(static_cast<double>(average.count()) / 1000.0, 0, 'f', 1)
+        .arg(buckets.join("/"));
+    if (m_decodeThreadType)
+        result += (m_decodeThreadType == FF_THREAD_SLICE) ? " slice" : " frame";
+    return result;
+}
+
 QString AvFormatDecoder::GetRawEncodingType(void)
 {
     int stream = m_selectedTrack[kTrackTypeVideo].m_av_stream_index;
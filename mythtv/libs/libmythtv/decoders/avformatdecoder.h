@@ -34,6 +34,7 @@ class SubtitleReader;
 class InteractiveTV;
 class ProgramInfo;
 class MythSqlDatabase;
+class RecordingFile;
 
 struct SwsContext;
 
@@ -138,6 +139,7 @@ class AvFormatDecoder : public DecoderBase
 
     QString      GetCodecDecoderName(void) const override; // DecoderBase
     QString      GetRawEncodingType(void) override; // DecoderBase
+    QString      GetDecodeStats(void) const override; // DecoderBase
     MythCodecID  GetVideoCodecID(void) const override { return m_videoCodecId; } // DecoderBase
 
     void SetDisablePassThrough(bool disable) override; // DecoderBase
@@ -156,6 +158,7 @@ class AvFormatDecoder : public DecoderBase
     long long GetChapter(int chapter) override; // DecoderBase
     bool DoRewind(long long desiredFrame, bool discardFrames = true) override; // DecoderBase
     bool DoFastForward(long long desiredFrame, bool discardFrames = true) override; // DecoderBase
+    void SetTrickPlay(TrickPlayMode Mode) override; // DecoderBase
     void SetIdrOnlyKeyframes(bool value) override // DecoderBase
         { m_avcParser->use_I_forKeyframes(!value); }
 
@@ -207,6 +210,9 @@ class AvFormatDecoder : public DecoderBase
     void DecodeDTVCC(const uint8_t *buf, uint buf_size, bool scte);
     void DecodeCCx08(const uint8_t *buf, uint buf_size, bool scte);
     void InitByteContext(bool forceseek = false);
+    bool LoadKnownStreams(RecordingFile &Known) const;
+    bool KnownStreamsMatch(const RecordingFile &Known);
+    void SeedKnownStreams(const RecordingFile &Known);
     void InitVideoCodec(AVStream *stream, AVCodecContext *enc,
                         bool selectedStream = false);
 
@@ -215,6 +221,8 @@ class AvFormatDecoder : public DecoderBase
     int  H264PreProcessPkt(AVStream *stream, AVPacket *pkt);
     bool PreProcessVideoPacket(AVStream *stream, AVPacket *pkt);
     virtual bool ProcessVideoPacket(AVStream *stream, AVPacket *pkt, bool &Retry);
+    void UpdateDecodeStats(const AVCodecContext *Context,
+                           std::chrono::microseconds Elapsed, bool GotPicture);
     virtual bool ProcessVideoFrame(AVStream *Stream, AVFrame *AvFrame);
     bool ProcessAudioPacket(AVStream *stream, AVPacket *pkt,
                             DecodeType decodetype);
@@ -364,6 +372,19 @@ class AvFormatDecoder : public DecoderBase
     bool               m_streamsChanged               { false };
     bool               m_resetHardwareDecoders        { false };
 
+    // Video decode times, in quarters of the frame interval with the last
+    // bucket holding everything slower. See UpdateDecodeStats.
+    static constexpr size_t kDecodeTimeBuckets        { 6 };
+    /// FF_THREAD_SLICE or FF_THREAD_FRAME when chosen for decode ahead
+    int                m_decodeThreadType             { 0 };
+    /// Slice threading was too slow, use frame threading from now on
+    bool               m_decodeFrameThreading         { false };
+    std::chrono::microseconds  m_decodeTimePending    { 0us };
+    mutable QMutex     m_decodeStatsLock;
+    uint               m_decodeFrames                 { 0 };
+    std::chrono::microseconds  m_decodeTimeTotal      { 0us };
+    std::array<uint,kDecodeTimeBuckets> m_decodeTimes {};
+
     // Value in milliseconds, from setting AudioReadAhead
     std::chrono::milliseconds  m_audioReadAhead       {100ms};
 
@@ -653,6 +653,116 @@ void DecoderBase::ResetPosMap(void)
     m_durToFrameMap.clear();
 }
 
+/// \brief Returns the byte position of the last keyframe at or before a
+///        frame, or -1 if it is not in the position map.
+long long DecoderBase::GetKeyframePosition(uint64_t frame) const
+{
+    QMutexLocker locker(&m_positionMapLock);
+    auto it = std::upper_bound(m_positionMap.cbegin(), m_positionMap.cend(), frame,
+        [this](uint64_t value, const PosMapEntry &entry)
+            { return static_cast<long long>(value) < GetKey(entry); });
+    if (it == m_positionMap.cbegin())
+        return -1;
+    return (--it)->pos;
+}
+
+/*! \brief Sets which frames are decoded during fast forward and rewind
+ *
+ * Keyframe only trick play seeks between the keyframes in the position map,
+ * so without one it falls back to skipping non-reference frames. Discs are
+ * left alone as their seeking is based on titles and cells.
+ */
+void DecoderBase::SetTrickPlay(TrickPlayMode Mode)
+{
+    if (m_ringBuffer && m_ringBuffer->IsDisc())
+        Mode = kTrickPlayNone;
+    else if ((Mode == kTrickPlayKeyframes) && !(m_recordingHasPositionMap || m_livetv))
+        Mode = kTrickPlayNonReference;
+
+    if (Mode == m_trickPlay)
+        return;
+
+    static const std::array<QString,3> kModes { "none", "non-reference frames", "keyframes only" };
+    LOG(VB_PLAYBACK, LOG_INFO, LOC + QString("Trick play: %1").arg(kModes[Mode]));
+    m_trickPlay = Mode;
+}
+
+/*! \brief Returns the frame to seek to for a fast forward or rewind step
+ *
+ * In keyframe only trick play this is the keyframe at or after Frame when
+ * going forward, or at or before it when going back, so that no frames have
+ * to be decoded to reach it. Otherwise, or when the position map does not
+ * cover Frame, Frame itself is returned.
+ */
+long long DecoderBase::GetTrickPlayTarget(long long Frame, bool Forward) const
+{
+    if (m_trickPlay != kTrickPlayKeyframes || Frame < 0)
+        return Frame;
+
+    QMutexLocker locker(&m_positionMapLock);
+    int index = FindTrickPlayKeyframe(Frame, Forward);
+    return (index < 0) ? Frame : GetKey(m_positionMap[index]);
+}
+
+/// \brief Returns the index in the position map of the keyframe that a trick
+///        play step to Frame seeks to, or -1 if the map does not cover it.
+int DecoderBase::FindTrickPlayKeyframe(long long Frame, bool Forward) const
+{
+    QMutexLocker locker(&m_positionMapLock);
+    if (Forward && m_trickPlay == kTrickPlayKeyframes)
+    {
+        auto it = std::lower_bound(m_positionMap.cbegin(), m_positionMap.cend(), Frame,
+            [this](const PosMapEntry &entry, long long value)
+                { return GetKey(entry) < value; });
+        if (it == m_positionMap.cend())
+            return -1;
+        return static_cast<int>(it - m_positionMap.cbegin());
+    }
+
+    auto it = std::upper_bound(m_positionMap.cbegin(), m_positionMap.cend(), Frame,
+        [this](long long value, const PosMapEntry &entry)
+            { return value < GetKey(entry); });
+    if (it == m_positionMap.cbegin() || (Forward && it == m_positionMap.cend()))
+        return -1;
+    return static_cast<int>(it - m_positionMap.cbegin()) - 1;
+}
+
+/*! \brief Prefetches the keyframes that the next fast forward or rewind
+ *         steps will land on.
+ * \param Frame Target of the current step
+ * \param Step  Frames per step, negative for rewind
+ * \param Count Number of steps to look ahead
+ */
+void DecoderBase::PrefetchKeyframes(long long Frame, long long Step, uint Count)
+{
+    // Enough for a keyframe of most streams, without reading whole GOPs
+    static constexpr long long kMaxKeyframeSize { 1024LL * 1024 };
+
+    if (!m_ringBuffer || !Step)
+        return;
+
+    std::vector<std::pair<long long,long long>> ranges;
+    {
+        QMutexLocker locker(&m_positionMapLock);
+        for (uint i = 1; i <= Count; ++i)
+        {
+            long long target = Frame + (Step * i);
+            int index = (target < 0) ? -1 : FindTrickPlayKeyframe(target, Step > 0);
+            if (index < 0)
+                break;
+            long long pos  = m_positionMap[index].pos;
+            long long size = kMaxKeyframeSize;
+            if (static_cast<size_t>(index) + 1 < m_positionMap.size())
+                size = std::clamp(m_positionMap[index + 1].pos - pos, 0LL, kMaxKeyframeSize);
+            if (pos >= 0 && size > 0 && (ranges.empty() || ranges.back().first != pos))
+                ranges.emplace_back(pos, size);
+        }
+    }
+
+    for (const auto & range : ranges)
+        m_ringBuffer->PrefetchRange(range.first, static_cast<uint>(range.second));
+}
+
 long long DecoderBase::GetLastFrameInPosMap(void) const
 {
     long long last_frame = 0;
@@ -71,6 +71,14 @@ enum EofState
     kEofStateImmediate // true eof
 };
 
+// Frames decoded during fast forward and rewind
+enum TrickPlayMode
+{
+    kTrickPlayNone,         // decode every frame
+    kTrickPlayNonReference, // skip frames that no other frame refers to
+    kTrickPlayKeyframes     // decode keyframes only, seeking from one to the next
+};
+
 class StreamInfo
 {
   public:
@@ -136,6 +144,8 @@ class DecoderBase
 
     void SetSeekSnap(uint64_t snap)  { m_seekSnap = snap; }
     uint64_t GetSeekSnap(void) const { return m_seekSnap;  }
+    virtual void SetTrickPlay(TrickPlayMode Mode);
+    TrickPlayMode GetTrickPlay(void) const { return m_trickPlay; }
     void SetLiveTVMode(bool live)  { m_livetv = live;      }
 
     // Must be done while player is paused.
@@ -206,6 +216,7 @@ class DecoderBase
 
     virtual QString GetCodecDecoderName(void) const = 0;
     virtual QString GetRawEncodingType(void) { return QString(); }
+    virtual QString GetDecodeStats(void) const { return QString(); }
     virtual MythCodecID GetVideoCodecID(void) const = 0;
 
     virtual void ResetPosMap(void);
@@ -225,6 +236,9 @@ class DecoderBase
     bool IsErrored() const { return m_errored; }
 
     bool HasPositionMap(void) const { return GetPositionMapSize() != 0U; }
+    long long GetKeyframePosition(uint64_t frame) const;
+    long long GetTrickPlayTarget(long long Frame, bool Forward) const;
+    void PrefetchKeyframes(long long Frame, long long Step, uint Count);
 
     void SetWaitForChange(void);
     bool GetWaitForChange(void) const;
@@ -282,6 +296,7 @@ class DecoderBase
         long long pos;      // position in stream
     };
     long long GetKey(const PosMapEntry &entry) const;
+    int FindTrickPlayKeyframe(long long Frame, bool Forward) const;
 
     MythPlayer          *m_parent                  {nullptr};
     ProgramInfo         *m_playbackInfo            {nullptr};
@@ -332,6 +347,7 @@ class DecoderBase
     mutable QDateTime    m_lastPositionMapUpdate; // guarded by m_positionMapLock
 
     uint64_t             m_seekSnap                {UINT64_MAX};
+    TrickPlayMode        m_trickPlay               {kTrickPlayNone};
     bool                 m_dontSyncPositionMap     {false};
     bool                 m_livetv                  {false};
     bool                 m_watchingRecording       {false};
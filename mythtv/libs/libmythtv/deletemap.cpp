@@ -848,6 +848,19 @@ bool DeleteMap::TrackerWantsToJump(uint64_t frame, uint64_t &to) const
     return true;
 }
 
+/**
+ * \brief Returns where the tracker will jump to when playback reaches the
+ *        next cut, without logging, so that it can be polled.
+ */
+bool DeleteMap::TrackerNextJump(uint64_t &to) const
+{
+    if (IsEmpty() || !m_nextCutStartIsValid)
+        return false;
+
+    to = GetNearestMark(m_nextCutStart, true);
+    return true;
+}
+
 /**
  * \brief Returns the number of the last frame in the video that is not in a
  *        cut sequence.
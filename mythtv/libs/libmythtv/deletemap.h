@@ -80,6 +80,7 @@ class MTV_PUBLIC DeleteMap
 
     void TrackerReset(uint64_t frame);
     bool TrackerWantsToJump(uint64_t frame, uint64_t &to) const;
+    bool TrackerNextJump(uint64_t &to) const;
 
     bool Undo(void);
     bool Redo(void);
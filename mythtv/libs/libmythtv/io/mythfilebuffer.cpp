@@ -832,3 +832,22 @@ long long MythFileBuffer::SeekInternal(long long Position, int Whence)
     m_generalWait.wakeAll();
     return ret;
 }
+
+/** \brief Asks the kernel to read ahead around an expected seek target.
+ *
+ *  Remote files are not prefetched, as the file transfer protocol has no
+ *  way to ask the backend to do so.
+ */
+void MythFileBuffer::Prefetch(long long Position, uint Size)
+{
+    if (m_remotefile || m_fd2 < 0)
+        return;
+
+#ifndef _MSC_VER
+    if (posix_fadvise(m_fd2, Position, Size, POSIX_FADV_WILLNEED) != 0)
+        LOG(VB_FILE, LOG_DEBUG, LOC + QString("Prefetch(): fadvise willneed failed: ") + ENO);
+#else
+    Q_UNUSED(Position);
+    Q_UNUSED(Size);
+#endif
+}
@@ -25,4 +25,5 @@ class MTV_PUBLIC MythFileBuffer : public MythMediaBuffer
     int       SafeRead        (RemoteFile *Remote, void *Buffer, uint Size);
     long long GetRealFileSizeInternal(void) const override;
     long long SeekInternal    (long long Position, int Whence) override;
+    void      Prefetch        (long long Position, uint Size) override;
 };
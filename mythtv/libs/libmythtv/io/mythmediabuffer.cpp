@@ -335,8 +335,14 @@ void MythMediaBuffer::SetBufferSizeFactors(bool EstBitrate, bool Matroska)
 }
 
 /** \fn MythMediaBuffer::CalcReadAheadThresh(void)
- *  \brief Calculates m_fillMin, m_fillThreshold, and m_readBlockSize
- *         from the estimated effective bitrate of the stream.
+ *  \brief Calculates m_fillMin, m_fillThreshold, m_readBlockSize and
+ *         m_bufferSizeTarget from the estimated effective bitrate of the
+ *         stream and the measured performance of the source.
+ *
+ *  A source with little headroom over the stream bitrate is read in larger
+ *  blocks and given a larger buffer, the minimum fill covers the time taken
+ *  by a couple of reads of the source and both grow after the reader has
+ *  stalled.
  *
  *  \warning Must be called with rwlock in write lock state.
  *
@@ -361,9 +367,19 @@ void MythMediaBuffer::CalcReadAheadThresh(void)
     const uint KB256 = 256*1024;
     const uint KB512 = 512*1024;
 
+    m_storageReadLock.lock();
+    uint64_t sourcerate = m_sourceRate;
+    floatmsecs latency = m_sourceLatency;
+    m_storageReadLock.unlock();
+    m_decoderReadLock.lock();
+    uint stalls = std::min(m_stalls, 2U);
+    m_decoderReadLock.unlock();
+
     estbitrate     = static_cast<uint>(std::max(abs(m_rawBitrate * m_playSpeed), 0.5F * m_rawBitrate));
     estbitrate     = std::min(m_rawBitrate * 3, estbitrate);
-    int const rbs  = (estbitrate > 18000) ? KB512 :
+    // how much faster than the stream the source can be read, 0 if unknown
+    double headroom = sourcerate ? static_cast<double>(sourcerate) / (estbitrate * 1000.0) : 0.0;
+    int rbs        = (estbitrate > 18000) ? KB512 :
                      (estbitrate >  9000) ? KB256 :
                      (estbitrate >  5000) ? KB128 :
                      (estbitrate >  2500) ? KB64  :
@@ -371,13 +387,18 @@ void MythMediaBuffer::CalcReadAheadThresh(void)
                      (estbitrate >=  500) ? KB16  :
                      (estbitrate >   250) ? KB8   :
                      (estbitrate >   125) ? KB4   : KB2;
+    // fewer, larger reads if much of each read is spent on the round trip
+    if (headroom > 0.0 && headroom < 4.0 && rbs >= DEFAULT_CHUNK_SIZE)
+        rbs = std::min(rbs * 2, static_cast<int>(KB512));
     if (rbs < DEFAULT_CHUNK_SIZE)
         m_readBlockSize = rbs;
     else
         m_readBlockSize = m_bitrateInitialized ? std::max(rbs, m_readBlockSize) : rbs;
 
-    // minimum seconds of buffering before allowing read
-    float secs_min = 0.3F;
+    // minimum seconds of buffering before allowing read, enough to cover
+    // a couple of reads of the source
+    float secs_min = std::max(0.3F, 2.0F * static_cast<float>(latency.count()) / 1000.0F);
+    secs_min *= static_cast<float>(1U << stalls);
     // set the minimum buffering before allowing ffmpeg read
     m_fillMin = static_cast<int>((estbitrate * 1000 * secs_min) * 0.125F);
     // make this a multiple of ffmpeg block size..
@@ -395,11 +416,21 @@ void MythMediaBuffer::CalcReadAheadThresh(void)
         LOG(VB_GENERAL, LOG_WARNING, "Enabling buffering optimisations for low bitrate stream.");
     }
 
+    // seconds of the stream to hold, at normal speed so that fast forward
+    // doesn't leave a huge buffer behind
+    float secs_buffer = 4.0F * static_cast<float>(1U << stalls);
+    if (headroom > 0.0 && headroom < 2.0)
+        secs_buffer *= 2.0F;
+    uint target = static_cast<uint>(m_rawBitrate * 125 * secs_buffer);
+    target = ((target >> 20) + 1) << 20;
+    m_bufferSizeTarget = std::min(target, static_cast<uint>(BUFFER_SIZE_MAXIMUM));
+
     LOG(VB_FILE, LOG_INFO, LOC +
-        QString("CalcReadAheadThresh(%1 Kb)\n\t\t\t -> "
-                "threshold(%2 KB) min read(%3 KB) blk size(%4 KB)")
-            .arg(estbitrate).arg(m_fillThreshold/1024)
-            .arg(m_fillMin/1024).arg(m_readBlockSize/1024));
+        QString("CalcReadAheadThresh(%1 Kb, source %2 Kb %3 ms, stall level %4)\n\t\t\t -> "
+                "threshold(%5 KB) min read(%6 KB) blk size(%7 KB) target(%8 MB)")
+            .arg(estbitrate).arg(sourcerate / 1000).arg(latency.count(), 0, 'f', 1).arg(stalls)
+            .arg(m_fillThreshold/1024).arg(m_fillMin/1024).arg(m_readBlockSize/1024)
+            .arg(m_bufferSizeTarget >> 20));
 }
 
 bool MythMediaBuffer::IsNearEnd(double /*Framerate*/, uint Frames) const
@@ -585,6 +616,8 @@ void MythMediaBuffer::ResetReadAhead(long long NewInternal)
     m_readsAllowed    = false;
     m_readsDesired    = false;
     m_recentSeek      = true;
+    m_stallArmed      = false;
+    m_atWriteEdge     = false;
     m_setSwitchToNext = false;
 
     m_generalWait.wakeAll();
@@ -782,6 +815,7 @@ void MythMediaBuffer::CreateReadAheadBuffer(void)
         if (m_unknownBitrate)
             newsize *= BUFFER_FACTOR_BITRATE;
     }
+    newsize = std::max(newsize, m_bufferSizeTarget);
 
     // N.B. Don't try and make it smaller - bad things happen...
     if (m_readAheadBuffer && (oldsize >= newsize))
@@ -824,6 +858,9 @@ void MythMediaBuffer::run(void)
     bool ignoreForReadTiming = true;
     int  eofreads = 0;
 
+    // Performance band of the source the read ahead was last calculated for
+    uint sourceband = 0;
+
     auto lastread = nowAsDuration<std::chrono::milliseconds>();
 
     CreateReadAheadBuffer();
@@ -976,6 +1013,10 @@ void MythMediaBuffer::run(void)
                 .arg(QString("(%1Mbps)").arg(static_cast<double>(bps) / 1000000.0))
                 .arg(readTimeAvg.count()));
             UpdateStorageRate(bps);
+            if (readResult == totfree)
+                UpdateSourceStats(readResult, std::chrono::milliseconds(sr_elapsed));
+            if (readResult > 0)
+                m_atWriteEdge = false;
 
             if (readResult >= 0)
             {
@@ -1025,6 +1066,8 @@ void MythMediaBuffer::run(void)
 
             m_readsAllowed = used >= 1 || m_ateof || m_setSwitchToNext || m_commsError;
             m_readsDesired = used >= m_fillMin || m_ateof || m_setSwitchToNext || m_commsError;
+            if (m_readsDesired)
+                m_stallArmed = true;
 
             if ((0 == readResult) && (oldreadposition == m_readPos))
             {
@@ -1046,15 +1089,21 @@ void MythMediaBuffer::run(void)
                         m_liveTVChain->SwitchToNext(true);
                         m_setSwitchToNext = true;
                     }
-                    else if (gCoreContext->IsRegisteredFileForWrite(m_filename))
+                    else
                     {
-                        LOG(VB_FILE, LOG_DEBUG, LOC +
-                            QString("EOF encountered, but %1 still being written to")
-                            .arg(m_filename));
-                        // We reached EOF, but file still open for writing and
-                        // no next program in livetvchain
-                        // wait a little bit (60ms same wait as typical safe_read)
-                        m_generalWait.wait(&m_rwLock, 60);
+                        // Caught up with the recorder
+                        m_atWriteEdge = true;
+
+                        if (gCoreContext->IsRegisteredFileForWrite(m_filename))
+                        {
+                            LOG(VB_FILE, LOG_DEBUG, LOC +
+                                QString("EOF encountered, but %1 still being written to")
+                                .arg(m_filename));
+                            // We reached EOF, but file still open for writing and
+                            // no next program in livetvchain
+                            // wait a little bit (60ms same wait as typical safe_read)
+                            m_generalWait.wait(&m_rwLock, 60);
+                        }
                     }
                 }
                 else if (gCoreContext->IsRegisteredFileForWrite(m_filename))
@@ -1067,12 +1116,14 @@ void MythMediaBuffer::run(void)
                     // wait a little bit (60ms same wait as typical safe_read)
                     m_generalWait.wait(&m_rwLock, 60);
                     m_beingWritten = true;
+                    m_atWriteEdge = true;
                 }
                 else
                 {
                     if (m_waitForWrite && !m_beingWritten)
                     {
                         LOG(VB_FILE, LOG_DEBUG, LOC + "Waiting for file to grow large enough to process.");
+                        m_atWriteEdge = true;
                         m_generalWait.wait(&m_rwLock, 300);
                     }
                     else
@@ -1092,6 +1143,34 @@ void MythMediaBuffer::run(void)
             eofreads = 0;
         }
 
+        // Warm up the source where the next skip is expected to land, once
+        // it is within 30 seconds
+        if ((m_seekTarget > m_internalReadPos) && !m_seekTargetFetched &&
+            (m_seekTarget - m_internalReadPos < m_rawBitrate * 125LL * 30))
+        {
+            LOG(VB_FILE, LOG_INFO, LOC + QString("Prefetching %1 KB at %2")
+                .arg(m_fillThreshold / 1024).arg(m_seekTarget));
+            Prefetch(m_seekTarget, static_cast<uint>(m_fillThreshold));
+            m_seekTargetFetched = true;
+        }
+
+        // Recalculate the read ahead, and grow the buffer, if the
+        // performance of the source has changed
+        uint band = GetSourceBand();
+        if (band != sourceband)
+        {
+            sourceband = band;
+            m_rwLock.unlock();
+            m_rwLock.lockForWrite();
+            CalcReadAheadThresh();
+            bool grow = m_bufferSizeTarget > m_bufferSize;
+            m_rwLock.unlock();
+            if (grow)
+                CreateReadAheadBuffer();
+            m_rwLock.lockForRead();
+            used = static_cast<int>(m_bufferSize) - ReadBufFree();
+        }
+
         LOG(VB_FILE, LOG_DEBUG, LOC + "@ end of read ahead loop");
 
         if (!m_readsAllowed || m_commsError || m_ateof || m_setSwitchToNext ||
@@ -1366,6 +1445,12 @@ int MythMediaBuffer::ReadPriv(void *Buffer, int Count, bool Peek)
     int available = ReadBufAvail();
     MythTimer timer(MythTimer::kStartRunning);
 
+    // Running out of data that had already been buffered is a stall, as
+    // opposed to waiting for the buffer to fill after a seek, or for the
+    // recorder to write more when reading at the live edge
+    bool stalled = m_stallArmed && !m_readInternalMode && !m_ateof &&
+                   !m_atWriteEdge && (available < Count);
+
     // Wait up to 10000 ms for any data
     std::chrono::milliseconds timeout_ms = 10s;
     while (!m_readInternalMode && !m_ateof && (timer.elapsed() < timeout_ms) && m_readAheadRunning &&
@@ -1386,6 +1471,16 @@ int MythMediaBuffer::ReadPriv(void *Buffer, int Count, bool Peek)
         LOG(VB_GENERAL, LOG_WARNING, LOC + desc + QString(" -- waited %1 ms for avail(%2) > count(%3)")
             .arg(timer.elapsed().count()).arg(available).arg(Count));
     }
+    if (stalled && !m_atWriteEdge)
+    {
+        m_stallArmed = false;
+        std::chrono::milliseconds elapsed = timer.elapsed();
+        m_decoderReadLock.lock();
+        m_stalls++;
+        m_stallTime += elapsed;
+        m_decoderReadLock.unlock();
+        LOG(VB_FILE, LOG_INFO, LOC + desc + QString(" -- stalled for %1 ms").arg(elapsed.count()));
+    }
 
     if (m_readInternalMode)
     {
@@ -1544,6 +1639,81 @@ uint MythMediaBuffer::GetBufferSize(void) const
     return m_bufferSize;
 }
 
+/// \brief Describes the reads of the source and the stalls of the reader
+QString MythMediaBuffer::GetReadAheadStats(void)
+{
+    if (m_type == kMythBufferDVD || m_type == kMythBufferBD)
+        return "N/A";
+
+    m_storageReadLock.lock();
+    floatmsecs latency = m_sourceLatency;
+    m_storageReadLock.unlock();
+    m_decoderReadLock.lock();
+    uint stalls = m_stalls;
+    std::chrono::milliseconds stalltime = m_stallTime;
+    m_decoderReadLock.unlock();
+
+    return QObject::tr("%1KB/%2ms reads, %n stall(s) %3ms", "", static_cast<int>(stalls))
+        .arg(m_readBlockSize / 1024).arg(latency.count(), 0, 'f', 1).arg(stalltime.count());
+}
+
+/** \brief Sets where the player expects to seek to next, e.g. the end of
+ *         the next commercial break or cut, so that it can be prefetched.
+ *  \param Position Byte offset of the target, or -1 for none
+ */
+void MythMediaBuffer::SetSeekTarget(long long Position)
+{
+    m_rwLock.lockForWrite();
+    if (Position != m_seekTarget)
+    {
+        m_seekTarget = Position;
+        m_seekTargetFetched = false;
+    }
+    m_rwLock.unlock();
+}
+
+/** \brief Asks the source to read ahead at a position that the player is
+ *         about to seek to, e.g. the keyframes shown in fast forward.
+ */
+void MythMediaBuffer::PrefetchRange(long long Position, uint Size)
+{
+    m_rwLock.lockForRead();
+    Prefetch(Position, Size);
+    m_rwLock.unlock();
+}
+
+/// \brief Updates the smoothed throughput and read time of the source
+void MythMediaBuffer::UpdateSourceStats(int Bytes, std::chrono::milliseconds Elapsed)
+{
+    // a read too quick to time is at least as fast as a 1 ms one
+    auto rate = static_cast<uint64_t>((Bytes * 8000.0) / static_cast<double>(std::max(Elapsed, 1ms).count()));
+
+    QMutexLocker locker(&m_storageReadLock);
+    m_sourceRate    = m_sourceRate ? ((m_sourceRate * 7) + rate) / 8 : rate;
+    m_sourceLatency = ((m_sourceLatency * 7) + floatmsecs(Elapsed)) / 8;
+}
+
+/** \brief Classifies the measured performance of the source, so that the
+ *         read ahead is only recalculated when it changes significantly.
+ */
+uint MythMediaBuffer::GetSourceBand(void)
+{
+    m_storageReadLock.lock();
+    uint64_t rate = m_sourceRate;
+    floatmsecs latency = m_sourceLatency;
+    m_storageReadLock.unlock();
+    m_decoderReadLock.lock();
+    uint stalls = std::min(m_stalls, 2U);
+    m_decoderReadLock.unlock();
+
+    if (!rate)
+        return 0;
+    double headroom = static_cast<double>(rate) / (m_rawBitrate * 1000.0);
+    uint ratio = (headroom < 2.0) ? 1 : (headroom < 4.0) ? 2 : 3;
+    auto slow = static_cast<uint>(std::min(latency / 100ms, 9.0));
+    return ratio + (4 * stalls) + (16 * slow);
+}
+
 uint64_t MythMediaBuffer::UpdateDecoderRate(uint64_t Latest)
 {
     if (!m_bitrateMonitorEnabled)
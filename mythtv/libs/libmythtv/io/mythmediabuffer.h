@@ -27,6 +27,8 @@ extern "C" {
 #define BUFFER_FACTOR_NETWORK  2
 #define BUFFER_FACTOR_BITRATE  2
 #define BUFFER_FACTOR_MATROSKA 2
+// upper limit when growing the buffer for a slow source
+#define BUFFER_SIZE_MAXIMUM (64 * 1024 * 1024)
 
 #define DEFAULT_CHUNK_SIZE 32768
 
@@ -80,6 +82,9 @@ class MTV_PUBLIC MythMediaBuffer : protected MThread
     QString   GetDecoderRate       (void);
     QString   GetStorageRate       (void);
     QString   GetAvailableBuffer   (void);
+    QString   GetReadAheadStats    (void);
+    void      SetSeekTarget        (long long Position);
+    void      PrefetchRange        (long long Position, uint Size);
     uint      GetBufferSize        (void) const;
     bool      IsNearEnd            (double Framerate, uint Frames) const;
     long long GetWritePosition     (void) const;
@@ -152,8 +157,11 @@ class MTV_PUBLIC MythMediaBuffer : protected MThread
     void     KillReadAheadThread   (void);
     uint64_t UpdateDecoderRate     (uint64_t Latest = 0);
     uint64_t UpdateStorageRate     (uint64_t Latest = 0);
+    void     UpdateSourceStats     (int Bytes, std::chrono::milliseconds Elapsed);
+    uint     GetSourceBand         (void);
 
     virtual int       SafeRead     (void *Buffer, uint Size) = 0;
+    virtual void      Prefetch     (long long /*Position*/, uint /*Size*/) { }
     virtual long long GetRealFileSizeInternal(void) const { return -1; }
     virtual long long SeekInternal (long long Position, int Whence) = 0;
 
@@ -204,6 +212,8 @@ class MTV_PUBLIC MythMediaBuffer : protected MThread
     bool                   m_readsAllowed     { false };
     bool                   m_readsDesired     { false };
     volatile bool          m_recentSeek       { true  }; // not protected by rwLock
+    volatile bool          m_stallArmed       { false }; // not protected by rwLock
+    volatile bool          m_atWriteEdge      { false }; // not protected by rwLock
     bool                   m_setSwitchToNext  { false };
     uint                   m_rawBitrate       { 8000  };
     float                  m_playSpeed        { 1.0F  };
@@ -219,13 +229,20 @@ class MTV_PUBLIC MythMediaBuffer : protected MThread
     long long              m_readAdjust       { 0 };
     int                    m_readOffset       { 0 };
     bool                   m_readInternalMode { false };
+    uint                   m_bufferSizeTarget { 0 };
+    long long              m_seekTarget       { -1 };
+    bool                   m_seekTargetFetched { false };
     // End of section protected by rwLock
 
     bool                   m_bitrateMonitorEnabled { false };
     QMutex                 m_decoderReadLock;
     QMap<std::chrono::milliseconds, uint64_t> m_decoderReads;
+    uint                   m_stalls           { 0 };   // guarded by m_decoderReadLock
+    std::chrono::milliseconds m_stallTime     { 0ms }; // guarded by m_decoderReadLock
     QMutex                 m_storageReadLock;
     QMap<std::chrono::milliseconds, uint64_t> m_storageReads;
+    uint64_t               m_sourceRate       { 0 };   // guarded by m_storageReadLock
+    floatmsecs             m_sourceLatency    { 0ms }; // guarded by m_storageReadLock
 
     // note 1: numfailures is modified with only a read lock in the
     // read ahead thread, but this is safe since all other places
@@ -142,6 +142,7 @@ HEADERS += captions/subtitlereader.h
 HEADERS += scheduledrecording.h
 HEADERS += signalmonitorvalue.h     signalmonitorlistener.h
 HEADERS += livetvchain.h            playgroup.h
+HEADERS += channelchangetrace.h
 HEADERS += channelsettings.h
 HEADERS += previewgenerator.h       previewgeneratorqueue.h
 HEADERS += transporteditor.h        listingsources.h
@@ -181,6 +182,7 @@ SOURCES += captions/subtitlereader.cpp
 SOURCES += scheduledrecording.cpp
 SOURCES += signalmonitorvalue.cpp
 SOURCES += livetvchain.cpp          playgroup.cpp
+SOURCES += channelchangetrace.cpp
 SOURCES += channelsettings.cpp
 SOURCES += previewgenerator.cpp     previewgeneratorqueue.cpp
 SOURCES += transporteditor.cpp
@@ -237,7 +239,9 @@ HEADERS += mpeg/freesat_huffman.h
 HEADERS += mpeg/iso6937tables.h
 HEADERS += mpeg/tsstats.h           mpeg/streamlisteners.h
 HEADERS += mpeg/H2645Parser.h mpeg/AVCParser.h mpeg/HEVCParser.h
+HEADERS += mpeg/bytereader.h
 HEADERS += mpeg/tablestatus.h
+HEADERS += mpeg/psicache.h
 HEADERS += mpeg/tsstreamdata.h
 
 SOURCES += mpeg/tspacket.cpp        mpeg/pespacket.cpp
@@ -254,7 +258,9 @@ SOURCES += mpeg/atsc_huffman.cpp    mpeg/freesat_tables.cpp
 SOURCES += mpeg/freesat_huffman.cpp
 SOURCES += mpeg/iso6937tables.cpp
 SOURCES += mpeg/H2645Parser.cpp mpeg/AVCParser.cpp mpeg/HEVCParser.cpp
+SOURCES += mpeg/bytereader.cpp
 SOURCES += mpeg/tablestatus.cpp
+SOURCES += mpeg/psicache.cpp
 SOURCES += mpeg/tsstreamdata.cpp
 
 # Channels, and the multiplexes that transmit them
@@ -373,6 +379,8 @@ HEADERS += HLS/httplivestreambuffer.h
 SOURCES += HLS/httplivestreambuffer.cpp
 HEADERS += HLS/m3u.h
 SOURCES += HLS/m3u.cpp
+HEADERS += HLS/hlssegmenter.h
+SOURCES += HLS/hlssegmenter.cpp
 using_libcrypto:DEFINES += USING_LIBCRYPTO
 using_libcrypto:LIBS    += -lcrypto
 
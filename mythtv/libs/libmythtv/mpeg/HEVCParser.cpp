@@ -3,6 +3,7 @@
 #include <iostream>
 
 #include "mythlogging.h"
+#include "bytereader.h"
 #include "recorders/dtvrecorder.h" // for FrameRate
 
 
@@ -158,9 +159,9 @@ uint32_t HEVCParser::addBytes(const uint8_t  *bytes,
 
     while (!m_onFrame && (startP < bytes + byte_count))
     {
-        const uint8_t *endP = avpriv_find_start_code(startP,
-                                                     bytes + byte_count,
-                                                     &m_syncAccumulator);
+        const uint8_t *endP = ByteReader::find_start_code(startP,
+                                                          bytes + byte_count,
+                                                          &m_syncAccumulator);
 
         // start_code_prefix_one_3bytes
         bool found_start_code = ((m_syncAccumulator & 0xffffff00) == 0x00000100);
@@ -0,0 +1,102 @@
+// -*- Mode: c++ -*-
+
+// C++ headers
+#include <cstring>
+
+// Qt headers
+#include <QtAlgorithms>
+
+// MythTV headers
+#include "config.h"
+#include "bytereader.h"
+
+#if (HAVE_SSE2 && ARCH_X86_64)
+#include <emmintrin.h>
+#endif
+
+static inline uint32_t read_be32(const uint8_t *p)
+{
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8)  |  static_cast<uint32_t>(p[3]);
+}
+
+static inline bool is_start_code(const uint8_t *p)
+{
+    return p[0] == 0x01 && p[-1] == 0x00 && p[-2] == 0x00;
+}
+
+/*!
+ * \brief Finds the 0x01 byte of the first 00 00 01 in [p, last)
+ * \note p must be preceded by at least two bytes.
+ * \return The 0x01 byte, or nullptr if there is none
+ */
+static const uint8_t *find_01(const uint8_t *p, const uint8_t *last)
+{
+#if (HAVE_SSE2 && ARCH_X86_64)
+    // Test 16 positions at a time, using loads offset by one and two bytes
+    // for the preceding zeros.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one  = _mm_set1_epi8(1);
+    for (; p + 16 <= last; p += 16)
+    {
+        __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p - 1));
+        __m128i b2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p - 2));
+        __m128i hit = _mm_and_si128(_mm_cmpeq_epi8(b0, one),
+                                    _mm_and_si128(_mm_cmpeq_epi8(b1, zero),
+                                                  _mm_cmpeq_epi8(b2, zero)));
+        auto mask = static_cast<unsigned int>(_mm_movemask_epi8(hit));
+        if (mask)
+            return p + qCountTrailingZeroBits(mask);
+    }
+#else
+    // A start code needs two zeros, so if the eight bytes from p - 2 have no
+    // zero byte there is no start code at p to p + 7.
+    for (; p + 6 <= last; )
+    {
+        uint64_t word = 0;
+        memcpy(&word, p - 2, sizeof(word));
+        if (((word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL) == 0)
+            p += 8;
+        else if (is_start_code(p))
+            return p;
+        else
+            ++p;
+    }
+#endif
+
+    for (; p < last; ++p)
+    {
+        if (is_start_code(p))
+            return p;
+    }
+    return nullptr;
+}
+
+const uint8_t *ByteReader::find_start_code(const uint8_t *p, const uint8_t *end,
+                                           uint32_t *state)
+{
+    if (p >= end)
+        return end;
+
+    // The first bytes may complete a start code begun in an earlier buffer
+    for (int i = 0; i < 3; ++i)
+    {
+        uint32_t tmp = *state << 8;
+        *state = tmp + *(p++);
+        if (tmp == 0x100 || p == end)
+            return p;
+    }
+
+    // The 0x01 must be followed by the start code value, so cannot be the
+    // last byte.
+    const uint8_t *found = find_01(p - 1, end - 1);
+    if (!found)
+    {
+        *state = read_be32(end - 4);
+        return end;
+    }
+
+    *state = read_be32(found - 2);
+    return found + 2;
+}
@@ -0,0 +1,29 @@
+// -*- Mode: c++ -*-
+#ifndef BYTEREADER_H
+#define BYTEREADER_H
+
+#include <cstdint>
+
+#include "mythtvexp.h"
+
+namespace ByteReader
+{
+/*!
+ * \brief Finds the next MPEG start code (00 00 01 xx) in a buffer
+ *
+ *  This is a drop in replacement for FFmpeg's avpriv_find_start_code(). The
+ *  last four bytes seen are kept in \p state, so a start code split between
+ *  buffers (eg. TS packets) is found when the next buffer is searched.
+ *
+ * \param p     Start of the data to search
+ * \param end   End of the data to search
+ * \param state In: the last bytes before \p p, 0xffffffff if there are none.
+ *              Out: 0x000001xx if a start code was found, otherwise the last
+ *              four bytes of the data.
+ * \return The byte after the start code value xx, or \p end if none was found
+ */
+MTV_PUBLIC const uint8_t *find_start_code(const uint8_t *p, const uint8_t *end,
+                                          uint32_t *state);
+}
+
+#endif // BYTEREADER_H
@@ -199,6 +199,17 @@ void DVBStreamData::Reset(uint desired_netid, uint desired_tsid,
     AddListeningPID(PID::DVB_TDT_PID);
 }
 
+/** \fn DVBStreamData::ForgetTableVersion(const PSIPTable&)
+ *  \brief Marks the version of a table as not seen
+ */
+void DVBStreamData::ForgetTableVersion(const PSIPTable &psip)
+{
+    if (TableID::SDT == psip.TableID())
+        SetVersionSDT(psip.TableIDExtension(), -1, 0);
+    else
+        MPEGStreamData::ForgetTableVersion(psip);
+}
+
 /** \fn DVBStreamData::HandleTables(uint pid, const PSIPTable&)
  *  \brief Process PSIP packets.
  */
@@ -260,6 +271,8 @@ bool DVBStreamData::HandleTables(uint pid, const PSIPTable &psip)
             m_sdtStatus.SetSectionSeen(tsid, psip.Version(), psip.Section(),
                                         psip.LastSection());
 
+            StoreTable(pid, psip);
+
             if (m_cacheTables)
             {
                 auto *sdt = new ServiceDescriptionTable(psip);
@@ -13,6 +13,7 @@
 #include "mpegstreamdata.h"
 #include "mpegtables.h"
 #include "mpegtables.h"
+#include "psicache.h"
 
 #include "atscstreamdata.h"
 #include "atsctables.h"
@@ -147,6 +148,9 @@ void MPEGStreamData::Reset(int desiredProgram)
 
     m_pmtStatus.clear();
 
+    m_psiCacheMplexId = 0;
+    m_primedTables.clear();
+
     {
         QMutexLocker locker(&m_cacheLock);
 
@@ -690,6 +694,8 @@ bool MPEGStreamData::HandleTables(uint pid, const PSIPTable &psip)
             if (m_cacheTables)
                 CachePAT(&pat);
 
+            StoreTable(pid, psip);
+
             ProcessPAT(&pat);
 
             return true;
@@ -718,6 +724,8 @@ bool MPEGStreamData::HandleTables(uint pid, const PSIPTable &psip)
             if (m_cacheTables)
                 CachePMT(&pmt);
 
+            StoreTable(pid, psip);
+
             ProcessPMT(&pmt);
 
             return true;
@@ -827,6 +835,105 @@ void MPEGStreamData::ProcessPMT(const ProgramMapTable *pmt)
     }
 }
 
+/** \fn MPEGStreamData::PrimeTables(uint)
+ *  \brief Processes the tables last seen on a multiplex as if they had
+ *         just been received.
+ *
+ *   This lets the signal monitor and the recorder go ahead with the cached
+ *   PAT, PMT and SDT of the desired program instead of waiting for them to
+ *   be broadcast again. Each live table is checked against the primed one
+ *   when it arrives; if they differ the live table is processed as usual, so
+ *   the listeners switch to it, and it replaces the cached one.
+ *
+ *   Call this after Reset() and after setting the desired program, before
+ *   any packets of the new tune are processed.
+ *
+ *  \param mplexid Multiplex being tuned, or 0 to not use the cache
+ */
+void MPEGStreamData::PrimeTables(uint mplexid)
+{
+    m_primedTables.clear();
+    m_psiCacheMplexId = 0;
+    if (!mplexid || m_haveCrcBug)
+        return;
+
+    if (m_desiredProgram >= 0)
+    {
+        PSICache::sections_t sections = PSICache::Get(mplexid);
+        for (const auto & section : sections)
+        {
+            PSIPTable psip(section.m_data);
+            if ((TableID::PMT == psip.TableID()) &&
+                (psip.TableIDExtension() != (uint)m_desiredProgram))
+            {
+                continue;
+            }
+
+            if (HandleTables(section.m_pid, psip))
+                m_primedTables.insert(PSICache::Key(psip), psip.CRC());
+        }
+
+        if (!m_primedTables.empty())
+        {
+            LOG(VB_RECORD, LOG_INFO, LOC +
+                QString("Primed %1 sections of multiplex %2 for program %3")
+                    .arg(m_primedTables.size()).arg(mplexid)
+                    .arg(m_desiredProgram));
+        }
+    }
+
+    // Only cache live tables from here on
+    m_psiCacheMplexId = mplexid;
+}
+
+/** \fn MPEGStreamData::StoreTable(uint, const PSIPTable&) const
+ *  \brief Keeps a live table in the PSICache for the next tune
+ */
+void MPEGStreamData::StoreTable(uint pid, const PSIPTable &psip) const
+{
+    if (m_psiCacheMplexId && !m_haveCrcBug)
+        PSICache::Store(m_psiCacheMplexId, pid, psip);
+}
+
+/** \fn MPEGStreamData::CheckPrimedTable(const PSIPTable&)
+ *  \brief Compares a live table with the one primed from the PSICache
+ *
+ *   If they differ the version seen is forgotten, so that the live table is
+ *   not treated as redundant.
+ */
+void MPEGStreamData::CheckPrimedTable(const PSIPTable &psip)
+{
+    auto it = m_primedTables.find(PSICache::Key(psip));
+    if (it == m_primedTables.end())
+        return;
+
+    if (*it == psip.CRC())
+    {
+        LOG(VB_RECORD, LOG_DEBUG, LOC +
+            QString("Cached table 0x%1 matches the live one")
+                .arg(psip.TableID(), 0, 16));
+    }
+    else
+    {
+        LOG(VB_RECORD, LOG_INFO, LOC +
+            QString("Cached table 0x%1 is stale, switching to the live one")
+                .arg(psip.TableID(), 0, 16));
+        ForgetTableVersion(psip);
+    }
+    m_primedTables.erase(it);
+}
+
+/** \fn MPEGStreamData::ForgetTableVersion(const PSIPTable&)
+ *  \brief Marks the version of a table as not seen
+ */
+void MPEGStreamData::ForgetTableVersion(const PSIPTable &psip)
+{
+    if (TableID::PAT == psip.TableID())
+        m_patStatus.SetVersion(psip.TableIDExtension(), -1, 0);
+    else if (TableID::PMT == psip.TableID())
+        m_pmtStatus.SetVersion(psip.TableIDExtension(), -1, 0);
+}
+
 double MPEGStreamData::TimeOffset(void) const
 {
     QMutexLocker locker(&m_siTimeLock);
@@ -925,6 +1032,9 @@ void MPEGStreamData::HandleTSTables(const TSPacket* tspacket)
         DONE_WITH_PSIP_PACKET();
     }
 
+    if (!m_primedTables.empty())
+        CheckPrimedTable(*psip);
+
     // Don't decode redundant packets,
     // but if it is a desired PAT or PMT emit a "heartbeat" signal.
     if (MPEGStreamData::IsRedundant(tspacket->PID(), *psip))
@@ -175,6 +175,7 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     bool HasAllPMTSections(uint prog_num) const;
 
     // Caching
+    void PrimeTables(uint mplexid);
     bool HasProgram(uint progNum) const;
 
     bool HasCachedAllPAT(uint tsid) const;
@@ -302,6 +303,9 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     void CachePAT(const ProgramAssociationTable *pat);
     void CacheCAT(const ConditionalAccessTable *_cat);
     void CachePMT(const ProgramMapTable *pmt);
+    void StoreTable(uint pid, const PSIPTable &psip) const;
+    void CheckPrimedTable(const PSIPTable &psip);
+    virtual void ForgetTableVersion(const PSIPTable &psip);
 
   protected:
     int                       m_cardId;
@@ -369,6 +373,10 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     mutable pmt_cache_t              m_cachedPmts;
     mutable psip_refcnt_map_t        m_cachedRefCnt;
     mutable psip_refcnt_map_t        m_cachedSlatedForDeletion;
+    /// Multiplex whose tables are kept in the PSICache, 0 for none
+    uint                             m_psiCacheMplexId      {0};
+    /// CRCs of the tables primed from the PSICache, not yet seen live
+    QMap<uint64_t, uint>             m_primedTables;
 
     // Single program variables
     int                       m_desiredProgram;
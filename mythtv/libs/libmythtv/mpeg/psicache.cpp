@@ -0,0 +1,52 @@
+// -*- Mode: c++ -*-
+
+// C++
+#include <utility>
+
+// Qt
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+
+#include "psicache.h"
+#include "mpegtables.h"
+
+// Sections of each multiplex, by table id, table id extension and section
+static QMutex                                        s_lock;
+static QHash<uint, QMap<uint64_t, PSICache::Section>> s_sections;
+
+/** \fn PSICache::Store(uint, uint, const PSIPTable&)
+ *  \brief Replaces the cached copy of a section
+ *  \param mplexid Multiplex the section was received on
+ *  \param pid     PID the section was received on
+ */
+void PSICache::Store(uint mplexid, uint pid, const PSIPTable &psip)
+{
+    const uint8_t *data = psip.pesdata();
+    Section section { pid, { data, data + psip.SectionLength() } };
+
+    QMutexLocker locker(&s_lock);
+    s_sections[mplexid].insert(Key(psip), std::move(section));
+}
+
+/** \fn PSICache::Get(uint)
+ *  \brief Returns the cached sections of a multiplex, the PAT first
+ */
+PSICache::sections_t PSICache::Get(uint mplexid)
+{
+    QMutexLocker locker(&s_lock);
+    auto it = s_sections.constFind(mplexid);
+    if (it == s_sections.constEnd())
+        return {};
+    return sections_t(it->cbegin(), it->cend());
+}
+
+/** \fn PSICache::Key(const PSIPTable&)
+ *  \brief Identifies a section within its multiplex
+ */
+uint64_t PSICache::Key(const PSIPTable &psip)
+{
+    return (static_cast<uint64_t>(psip.TableID()) << 32) |
+           (static_cast<uint64_t>(psip.TableIDExtension()) << 8) |
+           psip.Section();
+}
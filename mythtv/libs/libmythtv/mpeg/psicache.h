@@ -0,0 +1,37 @@
+// -*- Mode: c++ -*-
+#ifndef PSICACHE_H_
+#define PSICACHE_H_
+
+// C++
+#include <cstdint>
+#include <vector>
+
+#include "mythtvexp.h"
+
+class PSIPTable;
+
+/** \class PSICache
+ *  \brief The last PSI sections seen on each multiplex, shared by all the
+ *         recorders of the backend.
+ *
+ *   The tables cached by MPEGStreamData are lost whenever it is reset for a
+ *   new tune. This keeps the PAT, the PMTs and the DVB SDT of every multiplex
+ *   tuned since the backend started, so that a tune can go ahead on them
+ *   while the live tables are on their way. See MPEGStreamData::PrimeTables().
+ */
+class MTV_PUBLIC PSICache
+{
+  public:
+    struct Section
+    {
+        uint                 m_pid {0};
+        std::vector<uint8_t> m_data;
+    };
+    using sections_t = std::vector<Section>;
+
+    static void       Store(uint mplexid, uint pid, const PSIPTable &psip);
+    static sections_t Get(uint mplexid);
+    static uint64_t   Key(const PSIPTable &psip);
+};
+
+#endif // PSICACHE_H_
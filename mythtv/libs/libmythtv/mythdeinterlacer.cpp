@@ -1,10 +1,18 @@
+// Qt
+#include <QRunnable>
+
 // MythTV
 #include "config.h"
 #include "mythlogging.h"
 #include "mythavutil.h"
+#include "mthreadpool.h"
 #include "mythvideoprofile.h"
 #include "mythdeinterlacer.h"
 
+// Std
+#include <algorithm>
+#include <functional>
+
 extern "C" {
 #include "libavfilter/buffersrc.h"
 #include "libavfilter/buffersink.h"
@@ -37,7 +45,8 @@ bool MythDeinterlacer::s_haveSIMD = false;
  *
  * The following deinterlacers are used:
  * Basic - onefield/bob using libswcale
- * Medium - linearblend with custom code (SSE2 and Neon assisted where available)
+ * Medium - linearblend with custom code (SSE2 and Neon assisted where available
+ * and sliced across a small, persistent thread pool for larger frames)
  * High - libavfilter's yadif (with multithreading)
  *
  * \note libavfilter frame doubling filters expect frames to be presented
@@ -48,6 +57,13 @@ bool MythDeinterlacer::s_haveSIMD = false;
 MythDeinterlacer::~MythDeinterlacer()
 {
     Cleanup();
+    delete m_slicePool;
+}
+
+/// \brief Return the average time taken to deinterlace a frame (or field).
+std::chrono::microseconds MythDeinterlacer::GetAverageFilterTime() const
+{
+    return std::chrono::microseconds(m_averageTime.load());
 }
 
 /*! \brief Deinterlace Frame if needed
@@ -189,20 +205,26 @@ void MythDeinterlacer::Filter(MythVideoFrame *Frame, FrameScanType Scan,
     Frame->m_deinterlaceInuse = m_deintType | DEINT_CPU;
     Frame->m_deinterlaceInuse2x = m_doubleRate;
 
-    // onefield or bob
+    auto start = nowAsDuration<std::chrono::microseconds>();
     if (m_deintType == DEINT_BASIC)
-    {
         OneField(Frame, Scan);
-        return;
-    }
-
-    // linear blend
-    if (m_deintType == DEINT_MEDIUM)
-    {
+    else if (m_deintType == DEINT_MEDIUM)
         Blend(Frame, Scan);
-        return;
-    }
+    else
+        Yadif(Frame, Scan, Force);
+    UpdateTiming(nowAsDuration<std::chrono::microseconds>() - start);
+}
+
+/// \brief Maintain a running average of the time taken to filter each frame.
+void MythDeinterlacer::UpdateTiming(std::chrono::microseconds Elapsed)
+{
+    // Simple exponential moving average, weighted to the last ~16 frames
+    auto last = m_averageTime.load();
+    m_averageTime = last ? ((last * 15) + Elapsed.count()) / 16 : Elapsed.count();
+}
 
+void MythDeinterlacer::Yadif(MythVideoFrame *Frame, FrameScanType Scan, bool Force)
+{
     // We need a filter
     if (!m_graph)
         return;
@@ -291,6 +313,7 @@ void MythDeinterlacer::Cleanup()
     }
 
     m_deintType = DEINT_NONE;
+    m_averageTime = 0;
 }
 
 ///\brief Initialise deinterlacing using the given MythDeintType
@@ -325,8 +348,23 @@ bool MythDeinterlacer::Initialise(MythVideoFrame *Frame, MythDeintType Deinterla
                                                 nullptr, nullptr, nullptr);
             if (m_swsContext == nullptr)
                 return false;
+            LOG(VB_PLAYBACK, LOG_INFO, LOC + QString("Using deinterlacer '%1'").arg(name));
+        }
+        else
+        {
+            // Slicing only pays for itself on larger frames - thread wakeup
+            // latency dominates for SD.
+            m_sliceCount = 1;
+            if (Profile && (m_width * m_height) >= kMinSlicedArea)
+                m_sliceCount = std::clamp(Profile->GetMaxCPUs(), 1U, kMaxSlices);
+            if ((m_sliceCount > 1) && !m_slicePool)
+            {
+                m_slicePool = new MThreadPool("MythDeint");
+                m_slicePool->setMaxThreadCount(static_cast<int>(kMaxSlices) - 1);
+            }
+            LOG(VB_PLAYBACK, LOG_INFO, LOC + QString("Using deinterlacer '%1' (%2 slices)")
+                .arg(name).arg(m_sliceCount));
         }
-        LOG(VB_PLAYBACK, LOG_INFO, LOC + QString("Using deinterlacer '%1'").arg(name));
         return true;
     }
 
@@ -626,6 +664,34 @@ static inline void BlendSIMD8x4(unsigned char *Src, int Width, int FirstRow, int
 }
 #endif
 
+/// \brief Run the given function once for each slice, using the slice pool if available.
+void MythDeinterlacer::RunSliced(const std::function<void(uint,uint)>& Func)
+{
+    if (!m_slicePool || m_sliceCount < 2)
+    {
+        Func(0, 1);
+        return;
+    }
+
+    class MythDeintSlice : public QRunnable
+    {
+      public:
+        MythDeintSlice(const std::function<void(uint,uint)>& Func, uint Slice, uint Count)
+          : m_func(Func), m_slice(Slice), m_count(Count) {}
+        void run() override { m_func(m_slice, m_count); }
+      private:
+        const std::function<void(uint,uint)>& m_func;
+        uint m_slice { 0 };
+        uint m_count { 1 };
+    };
+
+    // Process the first slice in the calling thread
+    for (uint slice = 1; slice < m_sliceCount; ++slice)
+        m_slicePool->start(new MythDeintSlice(Func, slice, m_sliceCount), "DeintSlice");
+    Func(0, m_sliceCount);
+    m_slicePool->waitForDone();
+}
+
 void MythDeinterlacer::Blend(MythVideoFrame *Frame, FrameScanType Scan)
 {
     if (Frame->m_height < 16 || Frame->m_width < 16)
@@ -649,49 +715,67 @@ void MythDeinterlacer::Blend(MythVideoFrame *Frame, FrameScanType Scan)
     bool hidepth = MythVideoFrame::ColorDepth(src->m_type) > 8;
     bool top = second ? !m_topFirst : m_topFirst;
     uint count = MythVideoFrame::GetNumPlanes(src->m_type);
-    for (uint plane = 0; plane < count; plane++)
+
+    // Each slice blends a contiguous block of 4 row groups in every plane. Rows
+    // belonging to the field being written are never read, so slices can safely
+    // operate in place.
+    auto blendslice = [&](uint Slice, uint Slices)
     {
-        int  height  = MythVideoFrame::GetHeightForPlane(src->m_type, src->m_height, plane);
-        int firstrow = top ? 1 : 2;
-        bool height4 = (height % 4) == 0;
-        bool width4  = (src->m_pitches[plane] % 4) == 0;
-        // N.B. all frames allocated by MythTV should have 16 byte alignment
-        // for all planes
-#if (HAVE_SSE2 && ARCH_X86_64) || HAVE_INTRINSICS_NEON
-        bool width16 = (src->m_pitches[plane] % 16) == 0;
-        // profiling SSE2 suggests it is usually 4x faster - as expected
-        if (s_haveSIMD && height4 && width16)
+        for (uint plane = 0; plane < count; plane++)
         {
-            if (hidepth)
+            int  height  = MythVideoFrame::GetHeightForPlane(src->m_type, src->m_height, plane);
+            int firstrow = top ? 1 : 2;
+            bool height4 = (height % 4) == 0;
+            bool width4  = (src->m_pitches[plane] % 4) == 0;
+
+            // Split the 4 row groups between the slices
+            int groups   = (height - firstrow) / 4;
+            int start    = firstrow + 4 * ((groups * static_cast<int>(Slice)) / static_cast<int>(Slices));
+            int end      = firstrow + 4 * ((groups * static_cast<int>(Slice + 1)) / static_cast<int>(Slices));
+            int lastrow  = (Slice + 1 == Slices) ? height : end + 3;
+            if (start >= end)
+                continue;
+
+            // N.B. all frames allocated by MythTV should have 16 byte alignment
+            // for all planes
+#if (HAVE_SSE2 && ARCH_X86_64) || HAVE_INTRINSICS_NEON
+            bool width16 = (src->m_pitches[plane] % 16) == 0;
+            // profiling SSE2 suggests it is usually 4x faster - as expected
+            if (s_haveSIMD && height4 && width16)
             {
-                BlendSIMD8x4(src->m_buffer + src->m_offsets[plane],
-                             MythVideoFrame::GetPitchForPlane(src->m_type, src->m_width, plane),
-                             firstrow, height, src->m_pitches[plane],
-                             Frame->m_buffer + Frame->m_offsets[plane], Frame->m_pitches[plane],
-                             second);
+                if (hidepth)
+                {
+                    BlendSIMD8x4(src->m_buffer + src->m_offsets[plane],
+                                 MythVideoFrame::GetPitchForPlane(src->m_type, src->m_width, plane),
+                                 start, lastrow, src->m_pitches[plane],
+                                 Frame->m_buffer + Frame->m_offsets[plane], Frame->m_pitches[plane],
+                                 second);
+                }
+                else
+                {
+                    BlendSIMD16x4(src->m_buffer + src->m_offsets[plane],
+                                  MythVideoFrame::GetWidthForPlane(src->m_type, src->m_width, plane),
+                                  start, lastrow, src->m_pitches[plane],
+                                  Frame->m_buffer + Frame->m_offsets[plane], Frame->m_pitches[plane],
+                                  second);
+                }
             }
             else
+#endif
+            // N.B. There is no 10bit support here - but it shouldn't be necessary
+            // as everything should be 16byte aligned and 10/12bit interlaced video
+            // is virtually unheard of.
+            if (width4 && height4 && !hidepth)
             {
-                BlendSIMD16x4(src->m_buffer + src->m_offsets[plane],
-                              MythVideoFrame::GetWidthForPlane(src->m_type, src->m_width, plane),
-                              firstrow, height, src->m_pitches[plane],
-                              Frame->m_buffer + Frame->m_offsets[plane], Frame->m_pitches[plane],
-                              second);
+                BlendC4x4(src->m_buffer + src->m_offsets[plane],
+                          MythVideoFrame::GetWidthForPlane(src->m_type, src->m_width, plane),
+                          start, lastrow, src->m_pitches[plane],
+                          Frame->m_buffer + Frame->m_offsets[plane], Frame->m_pitches[plane],
+                          second);
             }
         }
-        else
-#endif
-        // N.B. There is no 10bit support here - but it shouldn't be necessary
-        // as everything should be 16byte aligned and 10/12bit interlaced video
-        // is virtually unheard of.
-        if (width4 && height4 && !hidepth)
-        {
-            BlendC4x4(src->m_buffer + src->m_offsets[plane],
-                      MythVideoFrame::GetWidthForPlane(src->m_type, src->m_width, plane),
-                      firstrow, height, src->m_pitches[plane],
-                      Frame->m_buffer + Frame->m_offsets[plane], Frame->m_pitches[plane],
-                      second);
-        }
-    }
+    };
+
+    RunSliced(blendslice);
     Frame->m_alreadyDeinterlaced = true;
 }
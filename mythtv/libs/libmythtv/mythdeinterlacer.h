@@ -1,6 +1,10 @@
 #ifndef MYTHDEINTERLACER_H
 #define MYTHDEINTERLACER_H
 
+// Std
+#include <atomic>
+#include <functional>
+
 // MythTV
 #include "videoouttypes.h"
 #include "mythavutil.h"
@@ -11,6 +15,7 @@ extern "C" {
 }
 
 class MythVideoProfile;
+class MThreadPool;
 
 class MythDeinterlacer
 {
@@ -20,6 +25,7 @@ class MythDeinterlacer
 
     void             Filter       (MythVideoFrame *Frame, FrameScanType Scan,
                                    MythVideoProfile *Profile, bool Force = false);
+    std::chrono::microseconds GetAverageFilterTime() const;
 
   private:
     Q_DISABLE_COPY(MythDeinterlacer)
@@ -29,7 +35,13 @@ class MythDeinterlacer
     inline void      Cleanup      ();
     void             OneField     (MythVideoFrame *Frame, FrameScanType Scan);
     void             Blend        (MythVideoFrame *Frame, FrameScanType Scan);
+    void             Yadif        (MythVideoFrame *Frame, FrameScanType Scan, bool Force);
     bool             SetUpCache   (MythVideoFrame *Frame);
+    void             RunSliced    (const std::function<void(uint,uint)>& Func);
+    void             UpdateTiming (std::chrono::microseconds Elapsed);
+
+    static constexpr uint kMaxSlices     { 8 };
+    static constexpr int  kMinSlicedArea { 1280 * 720 };
 
     VideoFrameType   m_inputType  { FMT_NONE };
     AVPixelFormat    m_inputFmt   { AV_PIX_FMT_NONE };
@@ -47,6 +59,9 @@ class MythDeinterlacer
     uint64_t         m_discontinuityCounter { 0 };
     bool             m_autoFieldOrder  { false };
     uint64_t         m_lastFieldChange { 0 };
+    MThreadPool*     m_slicePool  { nullptr };
+    uint             m_sliceCount { 1 };
+    std::atomic<int64_t> m_averageTime { 0 };
     static bool      s_haveSIMD;
 };
 
@@ -1,4 +1,5 @@
 // MythTV
+#include "config.h"
 #include "mythlogging.h"
 #include "mythvideoprofile.h"
 #include "mythframe.h"
@@ -6,8 +7,20 @@
 // FFmpeg - for av_malloc/av_free
 extern "C" {
 #include "libavcodec/avcodec.h"
+#include "libavutil/cpu.h"
 }
 
+#if (HAVE_SSE2 && ARCH_X86_64)
+#include <emmintrin.h>
+bool MythVideoFrame::s_haveNTCopy = av_get_cpu_flags() & AV_CPU_FLAG_SSE2;
+#else
+bool MythVideoFrame::s_haveNTCopy = false;
+#endif
+
+/// Planes smaller than this are left to memcpy - they will fit in the cache
+/// and the destination is likely to be read again very soon.
+static constexpr size_t kNTCopyThreshold { 1024 * 1024 };
+
 #define LOC QString("VideoFrame: ")
 
 /*! \class MythVideoFrame
@@ -185,9 +198,60 @@ void MythVideoFrame::ClearMetadata()
     m_deinterlaceInuse2x  = false;
 }
 
+#if (HAVE_SSE2 && ARCH_X86_64)
+/*! \brief Copy a single row using non-temporal (streaming) stores.
+ *
+ * The destination must be 16 byte aligned. Any tail that is not a multiple of
+ * 64 bytes is copied with memcpy.
+*/
+static inline void CopyRowNT(uint8_t* To, const uint8_t* From, int Width)
+{
+    int blocks = Width & ~63;
+    for (int col = 0; col < blocks; col += 64)
+    {
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(From + col));
+        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(From + col + 16));
+        __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(From + col + 32));
+        __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(From + col + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(To + col), v0);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(To + col + 16), v1);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(To + col + 32), v2);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(To + col + 48), v3);
+    }
+    if (blocks < Width)
+        memcpy(To + blocks, From + blocks, static_cast<size_t>(Width - blocks));
+}
+#endif
+
+/*! \brief Copy a single plane of video data.
+ *
+ * Large planes (e.g. 4K luma) are copied with non-temporal stores where available,
+ * which avoids evicting the source (and everything else) from the cache when
+ * the copy is larger than the cache itself. The destination rows must be 16 byte
+ * aligned for the streaming path - which is always the case for our own buffers
+ * but not necessarily for those supplied by a driver - otherwise we fall back
+ * to memcpy.
+*/
 void MythVideoFrame::CopyPlane(uint8_t *To, int ToPitch, const uint8_t *From, int FromPitch,
                                int PlaneWidth, int PlaneHeight)
 {
+#if (HAVE_SSE2 && ARCH_X86_64)
+    if (s_haveNTCopy && (static_cast<size_t>(PlaneWidth) * static_cast<size_t>(PlaneHeight) >= kNTCopyThreshold) &&
+        !(reinterpret_cast<uintptr_t>(To) & 15) && !(ToPitch & 15))
+    {
+        for (int y = 0; y < PlaneHeight; y++)
+        {
+            CopyRowNT(To, From, PlaneWidth);
+            From += FromPitch;
+            To += ToPitch;
+        }
+        // Streaming stores are weakly ordered - ensure they are visible before
+        // the frame is handed to another thread.
+        _mm_sfence();
+        return;
+    }
+#endif
+
     if ((ToPitch == PlaneWidth) && (FromPitch == PlaneWidth))
     {
         memcpy(To, From, static_cast<size_t>(PlaneWidth * PlaneHeight));
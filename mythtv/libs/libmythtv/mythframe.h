@@ -477,6 +477,7 @@ class MTV_PUBLIC MythVideoFrame
 
   private:
     static MythDeintType GetDeinterlacer(MythDeintType Option);
+    static bool s_haveNTCopy;
 };
 
 #endif
@@ -82,6 +82,13 @@ const double MythPlayer::kInaccuracyEditor = 0.5;
 // keyframe that is closest to the target.
 const double MythPlayer::kInaccuracyFull = -1.0;
 
+// From this fast forward or rewind speed only keyframes are decoded. Below
+// it, frames that are not used as a reference by others are skipped.
+const float MythPlayer::kTrickPlayKeyframeSpeed = 8.0F;
+
+// Number of fast forward or rewind steps whose keyframes are prefetched
+const uint MythPlayer::kTrickPlayPrefetch = 4;
+
 MythPlayer::MythPlayer(PlayerContext* Context, PlayerFlags Flags)
   : m_playerCtx(Context),
     m_playerFlags(Flags),
@@ -1153,7 +1160,8 @@ bool MythPlayer::DecoderGetFrameFFREW(void)
         long long target_frame = m_decoder->GetFramesRead() + real_skip;
         if (real_skip >= 0)
         {
-            m_decoder->DoFastForward(target_frame, false);
+            m_decoder->DoFastForward(m_decoder->GetTrickPlayTarget(target_frame, true), false);
+            m_decoder->PrefetchKeyframes(target_frame, m_ffrewSkip, kTrickPlayPrefetch);
         }
         long long seek_frame  = m_decoder->GetFramesRead();
         m_ffrewAdjust = seek_frame - target_frame;
@@ -1171,7 +1179,9 @@ bool MythPlayer::DecoderGetFrameREW(void)
     bool      toBegin      = -cur_frame > m_ffrewSkip + m_ffrewAdjust;
     long long real_skip    = (toBegin) ? -cur_frame : m_ffrewSkip + m_ffrewAdjust;
     long long target_frame = cur_frame + real_skip;
-    bool ret = m_decoder->DoRewind(target_frame, false);
+    bool ret = m_decoder->DoRewind(m_decoder->GetTrickPlayTarget(target_frame, false), false);
+    if (!toBegin)
+        m_decoder->PrefetchKeyframes(target_frame, m_ffrewSkip, kTrickPlayPrefetch);
     long long seek_frame  = m_decoder->GetFramesPlayed();
     m_ffrewAdjust = target_frame - seek_frame;
     return ret;
@@ -1214,6 +1224,7 @@ bool MythPlayer::DecoderGetFrame(DecodeType decodetype, bool unsafe)
         return false;
     }
 
+    m_decoder->SetTrickPlay(m_decodeOneFrame ? kTrickPlayNone : GetTrickPlayMode());
     if (m_ffrewSkip == 1 || m_decodeOneFrame)
         ret = DoGetFrame(decodetype);
     else if (m_ffrewSkip != 0)
@@ -1334,6 +1345,16 @@ bool MythPlayer::UpdateFFRewSkip(void)
     return skip_changed;
 }
 
+/// \brief Returns which frames the decoder needs at the current play speed
+TrickPlayMode MythPlayer::GetTrickPlayMode(void) const
+{
+    if (m_ffrewSkip == 0 || m_ffrewSkip == 1)
+        return kTrickPlayNone;
+    if (fabs(m_playSpeed) >= kTrickPlayKeyframeSpeed)
+        return kTrickPlayKeyframes;
+    return kTrickPlayNonReference;
+}
+
 void MythPlayer::ChangeSpeed(void)
 {
     float last_speed = m_playSpeed;
@@ -1343,6 +1364,11 @@ void MythPlayer::ChangeSpeed(void)
 
     bool skip_changed = UpdateFFRewSkip();
 
+    // Set this before the seek below, so that a return to normal speed
+    // decodes every frame again
+    if (m_decoder)
+        m_decoder->SetTrickPlay(GetTrickPlayMode());
+
     if (skip_changed && m_videoOutput)
     {
         m_videoOutput->SetPrebuffering(m_ffrewSkip == 1);
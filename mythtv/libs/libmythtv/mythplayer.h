@@ -245,6 +245,8 @@ class MTV_PUBLIC MythPlayer : public QObject
     static const double kInaccuracyDefault;
     static const double kInaccuracyEditor;
     static const double kInaccuracyFull;
+    static const float  kTrickPlayKeyframeSpeed;
+    static const uint   kTrickPlayPrefetch;
 
     void SaveTotalFrames(void);
     void SetErrored(const QString &reason);
@@ -343,6 +345,7 @@ class MTV_PUBLIC MythPlayer : public QObject
 
     // These actually execute commands requested by public members
     bool UpdateFFRewSkip(void);
+    TrickPlayMode GetTrickPlayMode(void) const;
     virtual void ChangeSpeed(void);
     // The "inaccuracy" argument is generally one of the kInaccuracy* values.
     bool DoFastForward(uint64_t frames, double inaccuracy);
@@ -353,6 +353,21 @@ void MythPlayerUI::EventLoop()
             DoJumpToFrame(jumpto, kInaccuracyNone);
         }
     }
+
+    // Let the buffer prefetch where the next skip will land
+    uint64_t prefetch = 0;
+    if ((m_ffrewSkip != 1) ||
+        !(m_deleteMap.TrackerNextJump(prefetch) ||
+          (m_deleteMap.IsEmpty() && m_commBreakMap.GetNextSkipTarget(prefetch))) ||
+        (prefetch >= m_totalFrames))
+    {
+        prefetch = 0;
+    }
+    if ((prefetch != m_prefetchFrame) && m_decoder)
+    {
+        m_prefetchFrame = prefetch;
+        m_playerCtx->m_buffer->SetSeekTarget(prefetch ? m_decoder->GetKeyframePosition(prefetch) : -1);
+    }
 }
 
 void MythPlayerUI::PreProcessNormalFrame()
@@ -685,6 +700,13 @@ void MythPlayerUI::DisplayNormalFrame(bool CheckPrebuffer)
     DoDisplayVideoFrame(frame, due);
     m_videoOutput->DoneDisplayingFrame(frame);
     m_outputJmeter.RecordCycleTime();
+
+    // First frame of the new channel after a LiveTV channel change
+    if (m_playerCtx->m_changeTrace.HasID())
+    {
+        m_playerCtx->m_changeTrace.Mark("first_frame");
+        m_playerCtx->m_changeTrace.Finish();
+    }
 }
 
 void MythPlayerUI::SetVideoParams(int Width, int Height, double FrameRate, float Aspect,
@@ -791,6 +813,7 @@ void MythPlayerUI::GetPlaybackData(InfoMap& Map)
     Map.insert("storagerate", m_playerCtx->m_buffer->GetStorageRate());
     Map.insert("bufferavail", m_playerCtx->m_buffer->GetAvailableBuffer());
     Map.insert("buffersize",  QString::number(m_playerCtx->m_buffer->GetBufferSize() >> 20));
+    Map.insert("readahead",   m_playerCtx->m_buffer->GetReadAheadStats());
     m_avSync.GetAVSyncData(Map);
 
     if (m_videoOutput)
@@ -800,7 +823,10 @@ void MythPlayerUI::GetPlaybackData(InfoMap& Map)
         Map.insert("videoframes", frames);
     }
     if (m_decoder)
+    {
         Map["videodecoder"] = m_decoder->GetCodecDecoderName();
+        Map["decodetime"]   = m_decoder->GetDecodeStats();
+    }
 
     Map["framerate"] = QString("%1%2%3")
             .arg(static_cast<double>(m_outputJmeter.GetLastFPS()), 0, 'f', 2).arg(QChar(0xB1, 0))
@@ -808,6 +834,17 @@ void MythPlayerUI::GetPlaybackData(InfoMap& Map)
     Map["load"] = m_outputJmeter.GetLastCPUStats();
 
     GetCodecDescription(Map);
+
+    // Append the cost of software deinterlacing, if in use
+    if (m_videoOutput)
+    {
+        auto deinttime = m_videoOutput->GetCPUDeinterlaceTime();
+        if (deinttime > 0us)
+        {
+            Map["deinterlacer"] += QString(" (%1ms)")
+                .arg(static_cast<double>(deinttime.count()) / 1000.0, 0, 'f', 2);
+        }
+    }
 }
 
 void MythPlayerUI::GetCodecDescription(InfoMap& Map)
@@ -1096,6 +1133,11 @@ void MythPlayerUI::JumpToProgram()
     m_inJumpToProgramPause = true;
 
     bool newIsDummy = m_playerCtx->m_tvchain->GetInputType(newid) == "DUMMY";
+    if (!newIsDummy)
+    {
+        m_playerCtx->m_changeTrace.SetID(m_playerCtx->m_tvchain->GetID(), newid);
+        m_playerCtx->m_changeTrace.Mark("program");
+    }
     SetPlayingInfo(*pginfo);
 
     Pause();
@@ -1137,10 +1179,12 @@ void MythPlayerUI::JumpToProgram()
         LOG(VB_GENERAL, LOG_ERR, m_playerCtx->m_tvchain->toString());
         SetEof(kEofStateImmediate);
         SetErrored(tr("Error opening jump program file buffer"));
+        m_playerCtx->m_changeTrace.Cancel();
         delete pginfo;
         m_inJumpToProgramPause = false;
         return;
     }
+    m_playerCtx->m_changeTrace.Mark("buffer");
 
     LoadExternalSubtitles();
 
@@ -1158,10 +1202,12 @@ void MythPlayerUI::JumpToProgram()
         LOG(VB_GENERAL, LOG_ERR, LOC + "JumpToProgram failed.");
         if (!IsErrored())
             SetErrored(tr("Error reopening video decoder"));
+        m_playerCtx->m_changeTrace.Cancel();
         delete pginfo;
         m_inJumpToProgramPause = false;
         return;
     }
+    m_playerCtx->m_changeTrace.Mark("decoder");
 
     SetEof(kEofStateNone);
 
@@ -64,6 +64,7 @@ class MTV_PUBLIC MythPlayerUI : public MythPlayerEditorUI, public MythVideoScanT
 
     bool    m_osdDebug { false };
     QTimer  m_osdDebugTimer;
+    uint64_t m_prefetchFrame { 0 };
 };
 
 #endif
@@ -84,6 +84,7 @@ class MythVideoOutput : public MythVideoBounds
     PictureAttributeSupported GetSupportedPictureAttributes();
     virtual void InitPictureAttributes () { }
     bool         HasSoftwareFrames     () const { return codec_sw_copy(m_videoCodecID); }
+    std::chrono::microseconds GetCPUDeinterlaceTime() const { return m_deinterlacer.GetAverageFilterTime(); }
     virtual void UpdatePauseFrame      (std::chrono::milliseconds& /*DisplayTimecode*/,
                                         FrameScanType /*Scan*/ = kScan_Progressive) {}
 
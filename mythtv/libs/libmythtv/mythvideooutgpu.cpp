@@ -412,9 +412,24 @@ bool MythVideoOutputGPU::CreateBuffers(MythCodecID CodecID, QSize Size)
     if (codec_is_v4l2(CodecID) || codec_is_drmprime(CodecID))
         return m_videoBuffers.CreateBuffers(FMT_DRMPRIME, m_renderFormats, Size, 2, 1, 4);
 
+    SetDecodeAhead();
     return m_videoBuffers.CreateBuffers(FMT_YV12, m_renderFormats, Size, 1, 8, 4, m_maxReferenceFrames);
 }
 
+/*! \brief Enlarges the software frame pool when the profile allows decode ahead
+ *
+ * The decoder thread only waits when there are not enough free frames, so the
+ * extra frames let it run further ahead of the display. Frame threading also
+ * keeps up to one frame per decode thread in flight, so those are added too.
+*/
+void MythVideoOutputGPU::SetDecodeAhead()
+{
+    uint ahead = m_videoProfile ? m_videoProfile->GetDecodeAhead() : 0;
+    if (ahead)
+        ahead += m_videoProfile->GetMaxCPUs();
+    m_videoBuffers.SetDecodeAhead(ahead);
+}
+
 void MythVideoOutputGPU::DestroyBuffers()
 {
     MythVideoOutputGPU::DiscardFrames(true, true);
@@ -473,6 +488,7 @@ bool MythVideoOutputGPU::InputChanged(QSize VideoDim, QSize VideoDispDim,
 
     // delete and recreate the buffers and flag that the input has changed
     m_maxReferenceFrames = ReferenceFrames;
+    SetDecodeAhead();
     m_buffersCreated = m_videoBuffers.DiscardAndRecreate(CodecId, VideoDim, m_maxReferenceFrames);
     if (!m_buffersCreated)
         return false;
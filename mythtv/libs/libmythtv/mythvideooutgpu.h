@@ -60,6 +60,7 @@ class MythVideoOutputGPU : public MythVideoOutput
     void            PrepareFrame          (MythVideoFrame* Frame, FrameScanType Scan) override;
     void            RenderFrame           (MythVideoFrame* Frame, FrameScanType Scan) override;
     bool            CreateBuffers         (MythCodecID CodecID, QSize Size);
+    void            SetDecodeAhead        ();
     void            DestroyBuffers        ();
     bool            ProcessInputChange    ();
     void            InitDisplayMeasurements();
@@ -270,6 +270,7 @@ QString MythVideoProfileItem::toString() const
     QString deint0    = Get(PREF_DEINT1X);
     QString deint1    = Get(PREF_DEINT2X);
     QString upscale   = Get(PREF_UPSCALE);
+    uint    ahead     = Get(PREF_AHEAD).toUInt();
 
     QString cond = QString("w(%1) h(%2) framerate(%3) codecs(%4)")
         .arg(width).arg(height).arg(framerate).arg(codecs);
@@ -277,7 +278,7 @@ QString MythVideoProfileItem::toString() const
         .arg(cmp0).arg(QString(cmp1.isEmpty() ? "" : ",") + cmp1)
         .arg(decoder).arg(max_cpus).arg((skiploop) ? "enabled" : "disabled").arg(renderer)
         .arg(cond);
-    str += QString("deint(%1,%2) upscale(%3)").arg(deint0).arg(deint1).arg(upscale);
+    str += QString("deint(%1,%2) upscale(%3) ahead(%4)").arg(deint0).arg(deint1).arg(upscale).arg(ahead);
     return str;
 }
 
@@ -376,6 +377,16 @@ bool MythVideoProfile::IsSkipLoopEnabled() const
     return GetPreference(PREF_LOOP).toInt() != 0;
 }
 
+/*! \brief Number of frames that a software decoder may run ahead of display
+ *
+ * Zero (the default) keeps the standard buffer pool and leaves the choice of
+ * frame or slice threading to FFmpeg.
+*/
+uint MythVideoProfile::GetDecodeAhead() const
+{
+    return std::min(GetPreference(PREF_AHEAD).toUInt(), VIDEO_MAX_AHEAD);
+}
+
 QString MythVideoProfile::GetVideoRenderer() const
 {
     return GetPreference(PREF_RENDER);
@@ -1291,8 +1302,9 @@ QString MythVideoProfile::toString() const
     auto deint1   = GetPreference(PREF_DEINT2X);
     auto cpus     = GetPreference(PREF_CPUS);
     auto upscale  = GetPreference(PREF_UPSCALE);
-    return QString("rend:%1 deint:%2/%3 CPUs: %4 Upscale: %5")
-        .arg(renderer).arg(deint0).arg(deint1).arg(cpus).arg(upscale);
+    auto ahead    = GetDecodeAhead();
+    return QString("rend:%1 deint:%2/%3 CPUs: %4 Upscale: %5 Ahead: %6")
+        .arg(renderer).arg(deint0).arg(deint1).arg(cpus).arg(upscale).arg(ahead);
 }
 
 const QList<QPair<QString, QString> >& MythVideoProfile::GetDeinterlacers()
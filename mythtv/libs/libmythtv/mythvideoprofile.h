@@ -39,8 +39,10 @@
 #define PREF_DEINT2X  "pref_deint1"
 #define PREF_PRIORITY "pref_priority"
 #define PREF_UPSCALE  "pref_upscale"
+#define PREF_AHEAD    "pref_decode_ahead"
 
 #define VIDEO_MAX_CPUS (16U)
+#define VIDEO_MAX_AHEAD (64U)
 
 struct RenderOptions
 {
@@ -105,6 +107,7 @@ class MTV_PUBLIC MythVideoProfile : public QObject
     bool    IsDecoderCompatible(const QString &Decoder) const;
     uint    GetMaxCPUs() const ;
     bool    IsSkipLoopEnabled() const;
+    uint    GetDecodeAhead() const;
     QString GetVideoRenderer() const;
     QString toString() const;
     QString GetSingleRatePreferences() const;
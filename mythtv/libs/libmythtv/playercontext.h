@@ -24,6 +24,7 @@
 #include "mythdate.h"
 #include "mythtypes.h"
 #include "tv.h"
+#include "channelchangetrace.h"
 
 class TV;
 class RemoteEncoder;
@@ -116,6 +117,7 @@ class MTV_PUBLIC PlayerContext
     volatile bool       m_playerUnsafe       {false};
     RemoteEncoder      *m_recorder           {nullptr};
     LiveTVChain        *m_tvchain            {nullptr};
+    ChannelChangeTrace  m_changeTrace        {"frontend"};
     MythMediaBuffer    *m_buffer             {nullptr};
     ProgramInfo        *m_playingInfo        {nullptr}; ///< Currently playing info
     std::chrono::seconds m_playingLen        {0s};  ///< Initial CalculateLength()
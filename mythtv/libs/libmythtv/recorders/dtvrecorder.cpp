@@ -25,6 +25,7 @@
 #include "programinfo.h"
 #include "mythlogging.h"
 #include "mpegtables.h"
+#include "bytereader.h"
 #include "io/mythmediabuffer.h"
 #include "tv_rec.h"
 #include "mythsystemevent.h"
@@ -437,7 +438,7 @@ bool DTVRecorder::FindMPEG2Keyframes(const TSPacket* tspacket)
 
     while (bufptr < bufend)
     {
-        bufptr = avpriv_find_start_code(bufptr, bufend, &m_startCode);
+        bufptr = ByteReader::find_start_code(bufptr, bufend, &m_startCode);
         int bytes_left = bufend - bufptr;
         if ((m_startCode & 0xffffff00) == 0x00000100)
         {
@@ -1091,7 +1092,7 @@ void DTVRecorder::FindPSKeyFrames(const uint8_t *buffer, uint len)
 
         const uint8_t *tmp = bufptr;
         bufptr =
-            avpriv_find_start_code(bufptr + skip, bufend, &m_startCode);
+            ByteReader::find_start_code(bufptr + skip, bufend, &m_startCode);
         m_audioBytesRemaining = 0;
         m_otherBytesRemaining = 0;
         m_videoBytesRemaining -= std::min(
@@ -489,6 +489,31 @@ void RemoteEncoder::SetChannel(const QString& channel)
  *                        the frontend using this recorder.
  *  \return Previous update rate
  */
+/**
+ *  \brief Asks the master backend to tune idle inputs to the channels
+ *         this LiveTV recorder is likely to change to next.
+ *
+ *   Any pre-tunes from an earlier call that are not in chanids are released.
+ *
+ *  \param chanids The channels to pre-tune, in order of preference
+ *  \return The inputs that were pre-tuned, by channel ID
+ */
+QMap<uint, uint> RemoteEncoder::PreTune(const QList<uint> &chanids)
+{
+    QStringList strlist( QString("QUERY_RECORDER %1").arg(m_recordernum) );
+    strlist << "PRE_TUNE";
+    for (uint chanid : chanids)
+        strlist << QString::number(chanid);
+
+    QMap<uint, uint> inputs;
+    if (!SendReceiveStringList(strlist))
+        return inputs;
+
+    for (int i = 0; i + 1 < strlist.size(); i += 2)
+        inputs[strlist[i].toUInt()] = strlist[i + 1].toUInt();
+    return inputs;
+}
+
 std::chrono::milliseconds RemoteEncoder::SetSignalMonitoringRate(std::chrono::milliseconds rate, int notifyFrontend)
 {
     QStringList strlist( QString("QUERY_RECORDER %1").arg(m_recordernum) );
@@ -64,6 +64,7 @@ class MTV_PUBLIC RemoteEncoder
     void ChangeDeinterlacer(int deint_mode);
     void ToggleChannelFavorite(const QString &changroupname);
     void SetChannel(const QString& channel);
+    QMap<uint, uint> PreTune(const QList<uint> &chanids);
     std::chrono::milliseconds SetSignalMonitoringRate(std::chrono::milliseconds rate, int notifyFrontend = 1);
     uint GetSignalLockTimeout(const QString& input);
     bool CheckChannel(const QString& channel);
@@ -0,0 +1,212 @@
+/*
+ *  Class TestByteReader
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <algorithm>
+
+#include <QRandomGenerator>
+
+#include "mpeg/bytereader.h"
+#include "test_bytereader.h"
+
+// The implementation in FFmpeg that ByteReader::find_start_code() replaces
+extern "C" const uint8_t *avpriv_find_start_code(const uint8_t *p,
+                                                 const uint8_t *end,
+                                                 uint32_t *state);
+
+using FindStartCode = const uint8_t *(*)(const uint8_t *, const uint8_t *, uint32_t *);
+
+// Payload bytes of a TS packet
+static constexpr int kTSPayloadSize { 184 };
+
+static const uint8_t *bytes(const QByteArray &data)
+{
+    return reinterpret_cast<const uint8_t *>(data.constData());
+}
+
+/*!
+ * \brief Random data in which zeros and ones are the given proportion of bytes
+ */
+static QByteArray RandomData(int size, int zeroPercent, quint32 seed)
+{
+    QRandomGenerator random(seed);
+    QByteArray data(size, '\0');
+    for (char & byte : data)
+    {
+        auto roll = static_cast<int>(random.bounded(100));
+        if (roll < zeroPercent)
+            byte = 0x00;
+        else if (roll < zeroPercent * 2)
+            byte = 0x01;
+        else
+            byte = static_cast<char>(random.bounded(256));
+    }
+    return data;
+}
+
+void TestByteReader::TestFindStartCode_data()
+{
+    QTest::addColumn<QByteArray>("Data");
+    QTest::addColumn<int>("Offset");
+    QTest::addColumn<uint>("State");
+
+    QTest::newRow("empty")
+        << QByteArray() << 0 << 0xffffffffU;
+    QTest::newRow("no start code")
+        << QByteArray::fromHex("123456789a") << 5 << 0x3456789aU;
+    QTest::newRow("at start")
+        << QByteArray::fromHex("000001b311") << 4 << 0x000001b3U;
+    QTest::newRow("after data")
+        << QByteArray::fromHex("ff0000010022") << 5 << 0x00000100U;
+    QTest::newRow("after zeros")
+        << QByteArray::fromHex("0000000000" "01e0") << 7 << 0x000001e0U;
+    QTest::newRow("no value")
+        << QByteArray::fromHex("1122000001") << 5 << 0x22000001U;
+    QTest::newRow("in long buffer")
+        << (QByteArray(40, '\xff') + QByteArray::fromHex("000001b8") + QByteArray(40, '\x02'))
+        << 44 << 0x000001b8U;
+    QTest::newRow("near end of long buffer")
+        << (QByteArray(100, '\x10') + QByteArray::fromHex("000001e0"))
+        << 104 << 0x000001e0U;
+    QTest::newRow("last of long buffer")
+        << (QByteArray(100, '\x10') + QByteArray::fromHex("000001"))
+        << 103 << 0x10000001U;
+}
+
+/// \brief Start codes within a buffer are found, and the state is updated
+void TestByteReader::TestFindStartCode()
+{
+    QFETCH(QByteArray, Data);
+    QFETCH(int, Offset);
+    QFETCH(uint, State);
+
+    uint32_t state = 0xffffffff;
+    const uint8_t *found =
+        ByteReader::find_start_code(bytes(Data), bytes(Data) + Data.size(), &state);
+    QCOMPARE(static_cast<int>(found - bytes(Data)), Offset);
+    QCOMPARE(state, State);
+}
+
+/// \brief Start codes split between buffers, as between TS packets, are found
+void TestByteReader::TestSplitStartCode()
+{
+    QByteArray data = QByteArray(100, '\x55') + QByteArray::fromHex("000001b3") +
+                      QByteArray(100, '\x55');
+    const uint8_t *begin = bytes(data);
+    const uint8_t *end   = begin + data.size();
+
+    for (int split = 0; split <= data.size(); ++split)
+    {
+        uint32_t state = 0xffffffff;
+        const uint8_t *found = ByteReader::find_start_code(begin, begin + split, &state);
+        if (found == begin + split && (state & 0xffffff00) != 0x00000100)
+            found = ByteReader::find_start_code(begin + split, end, &state);
+
+        QCOMPARE(static_cast<int>(found - begin), 104);
+        QCOMPARE(state, 0x000001b3U);
+    }
+}
+
+void TestByteReader::TestMatchesFFmpeg_data()
+{
+    QTest::addColumn<QByteArray>("Data");
+    QTest::addColumn<bool>("TSPackets");
+
+    QTest::newRow("random")       << RandomData(1 << 20, 1, 1)  << false;
+    QTest::newRow("sparse zeros") << RandomData(1 << 20, 5, 2)  << false;
+    QTest::newRow("dense zeros")  << RandomData(1 << 20, 30, 3) << false;
+    QTest::newRow("TS packets")   << RandomData(1 << 20, 10, 4) << true;
+}
+
+/*!
+ * \brief The recorders and parsers get identical results to FFmpeg's search
+ *
+ *  The keyframe search of the recorders, and the H.264 and HEVC parsers, only
+ *  see the returned position and state, so identical results mean identical
+ *  keyframes and position maps.
+ */
+void TestByteReader::TestMatchesFFmpeg()
+{
+    QFETCH(QByteArray, Data);
+    QFETCH(bool, TSPackets);
+
+    QRandomGenerator random(5);
+    const uint8_t *begin = bytes(Data);
+    const uint8_t *end   = begin + Data.size();
+    const uint8_t *ours  = begin;
+    const uint8_t *ffmpegs = begin;
+    uint32_t ourState    = 0xffffffff;
+    uint32_t ffmpegState = 0xffffffff;
+    int found = 0;
+
+    while (ours < end)
+    {
+        // Search to the end of the packet, or of a random length buffer
+        const uint8_t *stop = TSPackets
+            ? begin + ((ours - begin) / kTSPayloadSize + 1) * kTSPayloadSize
+            : ours + random.bounded(1024);
+        stop = std::min(stop, end);
+
+        ours    = ByteReader::find_start_code(ours, stop, &ourState);
+        ffmpegs = avpriv_find_start_code(ffmpegs, stop, &ffmpegState);
+
+        QCOMPARE(static_cast<long>(ours - begin), static_cast<long>(ffmpegs - begin));
+        QCOMPARE(ourState, ffmpegState);
+        if ((ourState & 0xffffff00) == 0x00000100)
+            ++found;
+    }
+    QVERIFY(found > 0);
+}
+
+void TestByteReader::TestBenchmark_data()
+{
+    QTest::addColumn<bool>("FFmpeg");
+
+    QTest::newRow("ByteReader") << false;
+    QTest::newRow("FFmpeg")     << true;
+}
+
+/// \brief Start code search throughput over 16MB of TS packet payloads
+void TestByteReader::TestBenchmark()
+{
+    QFETCH(bool, FFmpeg);
+    FindStartCode find = FFmpeg ? avpriv_find_start_code : ByteReader::find_start_code;
+
+    QByteArray data = RandomData(16 << 20, 1, 6);
+    const uint8_t *begin = bytes(data);
+    const uint8_t *end   = begin + data.size();
+    int found = 0;
+
+    QBENCHMARK
+    {
+        found = 0;
+        uint32_t state = 0xffffffff;
+        for (const uint8_t *packet = begin; packet < end; packet += kTSPayloadSize)
+        {
+            const uint8_t *stop = std::min(packet + kTSPayloadSize, end);
+            for (const uint8_t *ptr = packet; ptr < stop; )
+            {
+                ptr = find(ptr, stop, &state);
+                if ((state & 0xffffff00) == 0x00000100)
+                    ++found;
+            }
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+QTEST_APPLESS_MAIN(TestByteReader)
@@ -251,4 +251,108 @@ void TestCopyFrames::TestCopy()
     }
 }
 
+// All software formats that can be created and copied by MythVideoFrame
+static const std::vector<VideoFrameType> s_softwareFormats =
+{
+    FMT_YV12, FMT_YUV420P9, FMT_YUV420P10, FMT_YUV420P12, FMT_YUV420P14, FMT_YUV420P16,
+    FMT_RGB24, FMT_BGRA, FMT_RGB32, FMT_ARGB32, FMT_RGBA32,
+    FMT_YUV422P, FMT_YUV422P9, FMT_YUV422P10, FMT_YUV422P12, FMT_YUV422P14, FMT_YUV422P16,
+    FMT_YUV444P, FMT_YUV444P9, FMT_YUV444P10, FMT_YUV444P12, FMT_YUV444P14, FMT_YUV444P16,
+    FMT_YUY2, FMT_NV12, FMT_P010, FMT_P016
+};
+
+static void FillAllRandom(MythVideoFrame* Frame)
+{
+    for (size_t i = 0; i < Frame->m_bufferSize; ++i)
+        Frame->m_buffer[i] = MythRandom() & 0xFF;
+}
+
+static bool PlanesEqual(const MythVideoFrame* A, const MythVideoFrame* B)
+{
+    uint count = MythVideoFrame::GetNumPlanes(A->m_type);
+    for (uint plane = 0; plane < count; ++plane)
+    {
+        int width  = MythVideoFrame::GetPitchForPlane(A->m_type, A->m_width, plane);
+        int height = MythVideoFrame::GetHeightForPlane(A->m_type, A->m_height, plane);
+        const uint8_t* a = A->m_buffer + A->m_offsets[plane];
+        const uint8_t* b = B->m_buffer + B->m_offsets[plane];
+        for (int row = 0; row < height; ++row)
+        {
+            if (memcmp(a, b, static_cast<size_t>(width)) != 0)
+                return false;
+            a += A->m_pitches[plane];
+            b += B->m_pitches[plane];
+        }
+    }
+    return true;
+}
+
+/*! \brief Byte for byte comparison of every plane for every software format.
+ *
+ * Sizes are chosen to exercise both the plain memcpy path and the streaming
+ * (non-temporal) path for large planes, with and without row padding.
+*/
+void TestCopyFrames::TestCopyAllFormats()
+{
+    static const std::vector<std::pair<int,int>> s_sizes =
+        { { 720, 576 }, { 1918, 1080 }, { 3840, 2160 } };
+    static const std::array<int, 3> s_alignments { 0, 64, 128 };
+
+    for (auto type : s_softwareFormats)
+    {
+        for (const auto & size : s_sizes)
+        {
+            for (auto alignment : s_alignments)
+            {
+                size_t bufsize = MythVideoFrame::GetBufferSize(type, size.first, size.second, alignment);
+                MythVideoFrame from(type, MythVideoFrame::GetAlignedBuffer(bufsize), bufsize,
+                                    size.first, size.second, nullptr, alignment);
+                FillAllRandom(&from);
+                for (auto toalignment : s_alignments)
+                {
+                    size_t tosize = MythVideoFrame::GetBufferSize(type, size.first, size.second, toalignment);
+                    MythVideoFrame to(type, MythVideoFrame::GetAlignedBuffer(tosize), tosize,
+                                      size.first, size.second, nullptr, toalignment);
+                    QVERIFY2(to.CopyFrame(&from), qPrintable(MythVideoFrame::FormatDescription(type)));
+                    QVERIFY2(PlanesEqual(&from, &to),
+                             qPrintable(QString("%1@%2x%3 Alignment %4->%5")
+                                        .arg(MythVideoFrame::FormatDescription(type))
+                                        .arg(size.first).arg(size.second)
+                                        .arg(alignment).arg(toalignment)));
+                }
+            }
+        }
+    }
+}
+
+void TestCopyFrames::TestCopyBenchmark_data()
+{
+    QTest::addColumn<int>("Type");
+    QTest::addColumn<int>("Width");
+    QTest::addColumn<int>("Height");
+    for (auto type : s_softwareFormats)
+    {
+        QByteArray name = MythVideoFrame::FormatDescription(type).toLatin1();
+        QTest::newRow(QByteArray(name + "@1080p").constData()) << static_cast<int>(type) << 1920 << 1080;
+        QTest::newRow(QByteArray(name + "@2160p").constData()) << static_cast<int>(type) << 3840 << 2160;
+    }
+}
+
+/// \brief Frame copy throughput for each software format.
+void TestCopyFrames::TestCopyBenchmark()
+{
+    QFETCH(int, Type);
+    QFETCH(int, Width);
+    QFETCH(int, Height);
+    auto type = static_cast<VideoFrameType>(Type);
+    MythVideoFrame from(type, Width, Height);
+    MythVideoFrame to(type, Width, Height);
+    FillAllRandom(&from);
+    QBENCHMARK
+    {
+        to.CopyFrame(&from);
+    }
+    QVERIFY(PlanesEqual(&from, &to));
+}
+
 QTEST_APPLESS_MAIN(TestCopyFrames)
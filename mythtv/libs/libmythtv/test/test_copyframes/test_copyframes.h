@@ -31,4 +31,7 @@ class TestCopyFrames : public QObject
     static void TestInvalidSizes();
     static void TestInvalidBuffers();
     static void TestCopy();
+    static void TestCopyAllFormats();
+    static void TestCopyBenchmark_data();
+    static void TestCopyBenchmark();
 };
@@ -1038,6 +1038,7 @@ void TV::InitFromDB()
     kv["BrowseChannelGroup"]       = "0";
     kv["ChannelGroupDefault"]      = "-1";
     kv["ChannelGroupRememberLast"] = "0";
+    kv["LiveTVPreTune"]            = "0";
 
     kv["VbiFormat"]                = "";
     kv["DecodeVBIFormat"]          = "";
@@ -1079,6 +1080,7 @@ void TV::InitFromDB()
     m_dbUseChannelGroups   = (kv["BrowseChannelGroup"].toInt() != 0);
     m_dbRememberLastChannelGroup = (kv["ChannelGroupRememberLast"].toInt() != 0);
     m_channelGroupId       = kv["ChannelGroupDefault"].toInt();
+    m_dbPreTune            = (kv["LiveTVPreTune"].toInt() != 0);
 
     QString beVBI          = kv["VbiFormat"];
     QString feVBI          = kv["DecodeVBIFormat"];
@@ -2087,11 +2089,16 @@ void TV::HandleStateChange()
                 m_lockTimer.start();
                 m_lockTimerOn = true;
             }
+
+            if (m_dbPreTune && !m_preTuneTimerId)
+                m_preTuneTimerId = StartTimer(kPreTuneCheckFrequency, __LINE__);
         }
     }
     else if (TRANSITION(kState_WatchingLiveTV, kState_None))
     {
         SET_NEXT();
+        KillTimer(m_preTuneTimerId);
+        m_preTuneTimerId = 0;
         MythMainWindow::RestoreScreensaver();
         StopStuff(true, true, true);
     }
@@ -2405,6 +2412,8 @@ void TV::timerEvent(QTimerEvent *Event)
         HandleSpeedChangeTimerEvent();
     else if (timer_id == m_saveLastPlayPosTimerId)
         HandleSaveLastPlayPosEvent();
+    else if (timer_id == m_preTuneTimerId)
+        HandlePreTuneTimerEvent();
     else
         handled = false;
 
@@ -5558,6 +5567,7 @@ void TV::SwitchInputs(uint ChanID, QString ChanNum, uint InputID)
         m_playerContext.m_recorder->StopLiveTV();
         m_playerContext.SetPlayer(nullptr);
         m_player = nullptr;
+        m_playerContext.m_changeTrace.Mark("stop");
 
         // now restart stuff
         m_playerContext.m_lastSignalUIInfo.clear();
@@ -5571,6 +5581,7 @@ void TV::SwitchInputs(uint ChanID, QString ChanNum, uint InputID)
         if (ChanNum.isEmpty() && InputID)
             ChanNum = CardUtil::GetStartingChannel(InputID);
         m_playerContext.m_recorder->SpawnLiveTV(m_playerContext.m_tvchain->GetID(), false, ChanNum);
+        m_playerContext.m_changeTrace.Mark("spawn");
 
         if (!m_playerContext.ReloadTVChain())
         {
@@ -5599,8 +5610,10 @@ void TV::SwitchInputs(uint ChanID, QString ChanNum, uint InputID)
         bool ok = false;
         if (m_playerContext.m_playingInfo && StartRecorder())
         {
+            m_playerContext.m_changeTrace.Mark("recorder");
             if (CreatePlayer(m_playerContext.GetState(), muted))
             {
+                m_playerContext.m_changeTrace.Mark("player");
                 ScheduleStateChange();
                 ok = true;
                 m_playerContext.PushPreviousChannel();
@@ -5869,6 +5882,9 @@ bool TV::CommitQueuedInput()
 
 void TV::ChangeChannel(ChannelChangeDirection Direction)
 {
+    if (SwitchToPreTunedInput(Direction))
+        return;
+
     if (m_dbUseChannelGroups || (Direction == CHANNEL_DIRECTION_FAVORITE))
     {
         uint old_chanid = 0;
@@ -5917,8 +5933,11 @@ void TV::ChangeChannel(ChannelChangeDirection Direction)
     if (m_playerContext.m_prevChan.empty())
         m_playerContext.PushPreviousChannel();
 
+    m_playerContext.m_changeTrace.Start(QString("direction %1").arg(static_cast<int>(Direction)));
+
     emit PauseAudioUntilReady();
     PauseLiveTV();
+    m_playerContext.m_changeTrace.Mark("pause");
 
     m_playerContext.LockDeletePlayer(__FILE__, __LINE__);
     if (m_player)
@@ -5929,6 +5948,7 @@ void TV::ChangeChannel(ChannelChangeDirection Direction)
     m_playerContext.UnlockDeletePlayer(__FILE__, __LINE__);
 
     m_playerContext.m_recorder->ChangeChannel(Direction);
+    m_playerContext.m_changeTrace.Mark("request");
     ClearInputQueues(false);
 
     emit ResetAudio();
@@ -5939,6 +5959,62 @@ void TV::ChangeChannel(ChannelChangeDirection Direction)
         UpdateOSDInput();
 }
 
+/**
+ * \brief Changes channel by switching LiveTV to an input that the backend
+ *        has already tuned to the next channel in this direction.
+ *
+ * This goes through SwitchInputs(), which replaces the player and recorder.
+ * The switch is traced as a "pre-tuned" channel change, so that its time to
+ * the first frame can be compared with that of plain channel changes on the
+ * status page and in the channel change logs.
+ *
+ * \return true if LiveTV was switched
+ */
+bool TV::SwitchToPreTunedInput(ChannelChangeDirection Direction)
+{
+    if (!m_preTuneChanId || !m_playerContext.m_recorder)
+        return false;
+
+    m_playerContext.LockPlayingInfo(__FILE__, __LINE__);
+    uint old_chanid = m_playerContext.m_playingInfo ?
+        m_playerContext.m_playingInfo->GetChanID() : 0;
+    m_playerContext.UnlockPlayingInfo(__FILE__, __LINE__);
+
+    uint chanid  = m_preTuneNext.value(Direction, 0);
+    uint inputid = m_preTunedInputs.value(chanid, 0);
+    if (old_chanid != m_preTuneChanId || !inputid ||
+        inputid == m_playerContext.GetCardID())
+        return false;
+
+    LOG(VB_CHANNEL, LOG_INFO, LOC +
+        QString("Switching to input %1, pre-tuned to channel %2")
+        .arg(inputid).arg(chanid));
+
+    // The pre-tunes were made for the channel we are leaving
+    m_preTuneChanId = 0;
+    m_preTuneNext.clear();
+    m_preTunedInputs.clear();
+
+    // Save the current channel if this is the first time
+    if (m_playerContext.m_prevChan.empty())
+        m_playerContext.PushPreviousChannel();
+
+    m_playerContext.m_changeTrace.Start(QString::number(chanid), "pre-tuned");
+    SwitchInputs(chanid, "", inputid);
+
+    // The new player shows the end of the chain, finish the trace there
+    if (m_player && m_playerContext.m_tvchain)
+    {
+        m_playerContext.m_changeTrace.SetID(m_playerContext.m_tvchain->GetID(),
+                                            m_playerContext.m_tvchain->GetCurPos());
+    }
+    else
+    {
+        m_playerContext.m_changeTrace.Cancel();
+    }
+    return true;
+}
+
 static uint get_chanid(const PlayerContext *ctx,
                        uint cardid, const QString &channum)
 {
@@ -6080,8 +6156,11 @@ void TV::ChangeChannel(uint Chanid, const QString &Channum)
     if (m_playerContext.m_prevChan.empty())
         m_playerContext.PushPreviousChannel();
 
+    m_playerContext.m_changeTrace.Start(channum);
+
     emit PauseAudioUntilReady();
     PauseLiveTV();
+    m_playerContext.m_changeTrace.Mark("pause");
 
     m_playerContext.LockDeletePlayer(__FILE__, __LINE__);
     if (m_player)
@@ -6092,6 +6171,7 @@ void TV::ChangeChannel(uint Chanid, const QString &Channum)
     m_playerContext.UnlockDeletePlayer(__FILE__, __LINE__);
 
     m_playerContext.m_recorder->SetChannel(channum);
+    m_playerContext.m_changeTrace.Mark("request");
 
     emit ResetAudio();
 
@@ -7429,6 +7509,9 @@ void TV::customEvent(QEvent *Event)
         }
     }
 
+    if (message.startsWith("PRE_TUNED"))
+        HandlePreTuned(tokens, me->ExtraDataList());
+
     if (message.startsWith("START_EPG"))
     {
         int editType = tokens[1].toInt();
@@ -9985,6 +10068,160 @@ void TV::HandleSaveLastPlayPosEvent()
     m_saveLastPlayPosTimerId = StartTimer(kSaveLastPlayPosTimeout, __LINE__);
 }
 
+/**
+ * \brief Asks the backend to pre-tune the channels next to the one being
+ *        watched in LiveTV, once channel changes have settled.
+ *
+ * The neighbours come from the channel group in use, or otherwise from the
+ * recorder's own channel order. The request is renewed periodically, as the
+ * backend lets pre-tuned inputs go when they are not asked for.
+ *
+ * The backend calls are made in a background thread, which reports the
+ * pre-tuned inputs with a PRE_TUNED event, so that they never hold up the UI
+ * or the player lock.
+ */
+void TV::HandlePreTuneTimerEvent()
+{
+    // Helper class to look up the neighbours and pre-tune them. It uses its
+    // own connection to the recorder, as LiveTV may stop before it is done.
+    class PreTuner : public QRunnable
+    {
+      public:
+        PreTuner(int recordernum, uint chanid, QMap<int, uint> next)
+          : m_recorderNum(recordernum),
+            m_chanId(chanid),
+            m_next(std::move(next)) {}
+
+        void run() override
+        {
+            QMap<uint, uint> inputs;
+            QList<uint> chanids;
+            RemoteEncoder *recorder = RemoteGetExistingRecorder(m_recorderNum);
+            if (recorder && recorder->IsValidRecorder())
+            {
+                if (m_next.empty())
+                {
+                    const std::array<std::pair<BrowseDirection, ChannelChangeDirection>,2>
+                        dirs {{ { BROWSE_UP,   CHANNEL_DIRECTION_UP   },
+                                { BROWSE_DOWN, CHANNEL_DIRECTION_DOWN } }};
+                    for (const auto & [browse, dir] : dirs)
+                    {
+                        QString title, subtitle, desc, category, starttime, endtime;
+                        QString callsign, iconpath, channum, next_chanid, seriesid, programid;
+                        recorder->GetNextProgram(
+                            browse, title, subtitle, desc, category, starttime, endtime,
+                            callsign, iconpath, channum, next_chanid, seriesid, programid);
+                        m_next[dir] = next_chanid.toUInt();
+                    }
+                }
+
+                for (uint next : qAsConst(m_next))
+                {
+                    if (next && next != m_chanId)
+                        chanids.push_back(next);
+                }
+                inputs = recorder->PreTune(chanids);
+            }
+            delete recorder;
+
+            QStringList extra;
+            extra << QString::number(m_next.value(CHANNEL_DIRECTION_UP, 0))
+                  << QString::number(m_next.value(CHANNEL_DIRECTION_DOWN, 0));
+            for (auto it = inputs.cbegin(); it != inputs.cend(); ++it)
+                extra << QString::number(it.key()) << QString::number(*it);
+            gCoreContext->dispatch(
+                MythEvent(QString("PRE_TUNED %1 %2 %3").arg(m_recorderNum)
+                          .arg(m_chanId).arg(chanids.size()), extra));
+        }
+
+      private:
+        const int       m_recorderNum;
+        const uint      m_chanId;
+        QMap<int, uint> m_next;
+    };
+
+    // One request at a time, the next check follows its reply
+    if (m_preTuneBusy)
+        return;
+
+    GetPlayerReadLock();
+    if (!StateIsLiveTV(GetState()) || !m_playerContext.m_recorder ||
+        m_playerContext.m_pseudoLiveTVState != kPseudoNormalLiveTV)
+    {
+        ReturnPlayerLock();
+        return;
+    }
+
+    m_playerContext.LockPlayingInfo(__FILE__, __LINE__);
+    uint chanid = m_playerContext.m_playingInfo ?
+        m_playerContext.m_playingInfo->GetChanID() : 0;
+    m_playerContext.UnlockPlayingInfo(__FILE__, __LINE__);
+    int recordernum = m_playerContext.m_recorder->GetRecorderNumber();
+    ReturnPlayerLock();
+
+    // Wait for the viewer to stay on a channel for a full check
+    bool settled = (chanid == m_preTuneSeenChanId);
+    m_preTuneSeenChanId = chanid;
+    if (!chanid || !settled ||
+        (chanid == m_preTuneChanId && m_preTuneAge.isRunning() &&
+         m_preTuneAge.elapsed() < kPreTuneRenewTimeout))
+    {
+        return;
+    }
+
+    QMap<int, uint> next;
+    {
+        QMutexLocker locker(&m_channelGroupLock);
+        if (m_dbUseChannelGroups && m_channelGroupId > -1)
+        {
+            for (auto dir : { CHANNEL_DIRECTION_UP, CHANNEL_DIRECTION_DOWN })
+            {
+                next[dir] = ChannelUtil::GetNextChannel(
+                    m_channelGroupChannelList, chanid, 0, 0, dir);
+            }
+        }
+    }
+
+    m_preTuneBusy = true;
+    MThreadPool::globalInstance()->start(
+        new PreTuner(recordernum, chanid, next), "PreTuner");
+}
+
+/**
+ * \brief Takes the inputs pre-tuned by HandlePreTuneTimerEvent().
+ *
+ * The reply is dropped if LiveTV has moved to another recorder meanwhile.
+ * One for a channel that is no longer being watched is kept only until
+ * SwitchToPreTunedInput() sees that the channel has changed.
+ */
+void TV::HandlePreTuned(const QStringList &Tokens, const QStringList &Extra)
+{
+    m_preTuneBusy = false;
+    if (Tokens.size() < 4 || Extra.size() < 2)
+        return;
+
+    GetPlayerReadLock();
+    bool match = m_playerContext.m_recorder &&
+        (m_playerContext.m_recorder->GetRecorderNumber() == Tokens[1].toInt());
+    ReturnPlayerLock();
+    if (!match)
+        return;
+
+    uint chanid = Tokens[2].toUInt();
+    m_preTuneNext.clear();
+    m_preTuneNext[CHANNEL_DIRECTION_UP]   = Extra[0].toUInt();
+    m_preTuneNext[CHANNEL_DIRECTION_DOWN] = Extra[1].toUInt();
+    m_preTunedInputs.clear();
+    for (int i = 2; i + 1 < Extra.size(); i += 2)
+        m_preTunedInputs[Extra[i].toUInt()] = Extra[i + 1].toUInt();
+    m_preTuneChanId = chanid;
+    m_preTuneAge.start();
+
+    LOG(VB_CHANNEL, LOG_INFO, LOC +
+        QString("%1 of %2 neighbours of channel %3 pre-tuned")
+        .arg(m_preTunedInputs.size()).arg(Tokens[3]).arg(chanid));
+}
+
 void TV::SetLastProgram(const ProgramInfo* ProgInfo)
 {
     QMutexLocker locker(&m_lastProgramLock);
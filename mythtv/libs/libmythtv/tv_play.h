@@ -250,6 +250,8 @@ class MTV_PUBLIC TV : public TVPlaybackState, public MythTVMenuItemDisplayer, pu
     bool HandleLCDTimerEvent();
     void HandleLCDVolumeTimerEvent();
     void HandleSaveLastPlayPosEvent();
+    void HandlePreTuneTimerEvent();
+    void HandlePreTuned(const QStringList &Tokens, const QStringList &Extra);
 
     // Commands used by frontend UI screens (PlaybackBox, GuideGrid etc)
     void EditSchedule(int EditType = kScheduleProgramGuide);
@@ -320,6 +322,7 @@ class MTV_PUBLIC TV : public TVPlaybackState, public MythTVMenuItemDisplayer, pu
     void ToggleChannelFavorite(const QString &ChangroupName) const;
     void ChangeChannel(ChannelChangeDirection Direction);
     void ChangeChannel(uint Chanid, const QString& Channum);
+    bool SwitchToPreTunedInput(ChannelChangeDirection Direction);
 
     void ShowPreviousChannel();
     void PopPreviousChannel(bool ImmediateChange);
@@ -521,6 +524,7 @@ class MTV_PUBLIC TV : public TVPlaybackState, public MythTVMenuItemDisplayer, pu
     bool              m_dbBrowseAllTuners {false};
     bool              m_dbUseChannelGroups {false};
     bool              m_dbRememberLastChannelGroup {false};
+    bool              m_dbPreTune {false};
     ChannelGroupList  m_dbChannelGroups;
 
     bool              m_smartForward {false};
@@ -663,6 +667,19 @@ class MTV_PUBLIC TV : public TVPlaybackState, public MythTVMenuItemDisplayer, pu
     volatile int        m_channelGroupId {-1};
     ChannelInfoList     m_channelGroupChannelList;
 
+    // LiveTV pre-tuning stuff
+    /// Channel whose neighbours are pre-tuned
+    uint                m_preTuneChanId {0};
+    /// Channel seen at the previous check, to wait for channel changes to settle
+    uint                m_preTuneSeenChanId {0};
+    /// Neighbouring channels, by channel change direction
+    QMap<int, uint>     m_preTuneNext;
+    /// Pre-tuned inputs, by channel ID
+    QMap<uint, uint>    m_preTunedInputs;
+    MythTimer           m_preTuneAge;
+    /// A pre-tune request is running in the background
+    bool                m_preTuneBusy {false};
+
     // Network Control stuff
     MythDeque<QString> m_networkControlCommands;
 
@@ -682,6 +699,7 @@ class MTV_PUBLIC TV : public TVPlaybackState, public MythTVMenuItemDisplayer, pu
     mutable volatile int m_exitPlayerTimerId       {0};
     volatile int         m_saveLastPlayPosTimerId  {0};
     volatile int         m_signalMonitorTimerId    {0};
+    volatile int         m_preTuneTimerId          {0};
 
     // Various tracks
     // XXX This ignores kTrackTypeTextSubtitle which is greater than
@@ -754,6 +772,8 @@ class MTV_PUBLIC TV : public TVPlaybackState, public MythTVMenuItemDisplayer, pu
     static inline const std::chrono::milliseconds kErrorRecoveryCheckFrequency  = 250ms;
     static inline const std::chrono::milliseconds kEndOfRecPromptCheckFrequency = 250ms;
     static inline const std::chrono::milliseconds kSaveLastPlayPosTimeout       = 30s;
+    static inline const std::chrono::milliseconds kPreTuneCheckFrequency        = 2s;
+    static inline const std::chrono::milliseconds kPreTuneRenewTimeout          = 2min;
 #ifdef USING_VALGRIND
     static inline const std::chrono::milliseconds kEndOfPlaybackFirstCheckTimer = 1min;
 #else
@@ -53,6 +53,7 @@ static bool is_dishnet_eit(uint inputid);
 static int init_jobs(const RecordingInfo *rec, RecordingProfile &profile,
                      bool on_host, bool transcode_bfr_comm, bool on_line_comm);
 static void apply_broken_dvb_driver_crc_hack(ChannelBase* /*c*/, MPEGStreamData* /*s*/);
+static bool has_rotor(ChannelBase* /*c*/);
 static std::chrono::seconds eit_start_rand(uint inputId, std::chrono::seconds eitTransportTimeout);
 
 /** \class TVRec
@@ -155,6 +156,7 @@ bool TVRec::Init(void)
     if (m_eitTransportTimeout < 6s)
         m_eitTransportTimeout = 6s;
     m_eitCrawlIdleStart = gCoreContext->GetDurSetting<std::chrono::seconds>("EITCrawIdleStart", 60s);
+    m_preTuneHold = gCoreContext->GetDurSetting<std::chrono::minutes>("LiveTVPreTuneHold", 3min);
     m_audioSampleRateDB = gCoreContext->GetNumSetting("AudioSampleRate");
     m_overRecordSecNrml = gCoreContext->GetDurSetting<std::chrono::seconds>("RecordOverTime");
     m_overRecordSecCat  = gCoreContext->GetDurSetting<std::chrono::minutes>("CategoryOverTime");
@@ -1471,6 +1473,16 @@ void TVRec::run(void)
             }
         }
 
+        // Release a pre-tuned input that is no longer wanted
+        if (!m_preTuneChannel.isEmpty() && m_tuningRequests.empty() &&
+            MythDate::current() > m_preTuneExpire)
+        {
+            LOG(VB_CHANNEL, LOG_INFO, LOC +
+                QString("Pre-tuning of %1 expired").arg(m_preTuneChannel));
+            m_preTuneChannel.clear();
+            m_tuningRequests.enqueue(TuningRequest(kFlagKillRec));
+        }
+
         // We should be no more than a few thousand milliseconds,
         // as the end recording code does not have a trigger...
         // NOTE: If you change anything here, make sure that
@@ -1586,6 +1598,15 @@ void TVRec::HandlePendingRecordings(void)
         m_tuningRequests.enqueue(TuningRequest(kFlagNoRec));
     }
 
+    // Give up a pre-tuned channel, the tuner may be needed
+    if (!m_preTuneChannel.isEmpty())
+    {
+        LOG(VB_CHANNEL, LOG_INFO,
+            LOC + "Releasing pre-tuned input for pending recording.");
+        m_preTuneChannel.clear();
+        m_tuningRequests.enqueue(TuningRequest(kFlagKillRec));
+    }
+
     // If we have a pending recording and AskAllowRecording
     // or DoNotAskAllowRecording is set and the frontend is
     // ready send an ASK_RECORDING query to frontend.
@@ -1840,6 +1861,22 @@ static bool ApplyCachedPids(DTVSignalMonitor *dtvMon, const DTVChannel* channel)
     return vctpid_cached;
 }
 
+/**
+ *  \brief Starts with the tables last seen on the channel's multiplex.
+ *
+ *   Not done when a rotor may have to move, as tables received before it
+ *   is in position could belong to another satellite.
+ */
+static void PrimeCachedTables(ChannelBase *channel, MPEGStreamData *sd)
+{
+    if (has_rotor(channel))
+        return;
+
+    uint mplexid = ChannelUtil::GetMplexID(channel->GetSourceID(),
+                                           channel->GetChannelName());
+    sd->PrimeTables((32767 == mplexid) ? 0 : mplexid);
+}
+
 /**
  *  \brief Tells DTVSignalMonitor what channel to look for.
  *
@@ -1954,6 +1991,8 @@ bool TVRec::SetupDTVSignalMonitor(bool EITscan)
             sm->IgnoreEncrypted(true);
         }
 
+        PrimeCachedTables(m_channel, sd);
+
         LOG(VB_RECORD, LOG_INFO, LOC +
             "Successfully set up DVB table monitoring.");
         return true;
@@ -1991,6 +2030,8 @@ bool TVRec::SetupDTVSignalMonitor(bool EITscan)
             sm->IgnoreEncrypted(true);
         }
 
+        PrimeCachedTables(m_channel, sd);
+
         LOG(VB_RECORD, LOG_INFO, LOC +
             "Successfully set up MPEG table monitoring.");
         return true;
@@ -2170,6 +2211,26 @@ DTVSignalMonitor *TVRec::GetDTVSignalMonitor(void)
     return dynamic_cast<DTVSignalMonitor*>(m_signalMonitor);
 }
 
+/** \brief Notes the progress of a LiveTV channel change
+ *
+ *   This is called by the signal monitor thread at the signal monitor update
+ *   rate, so the times of the PAT and PMT matches are only that accurate.
+ */
+void TVRec::StatusSignalLock(const SignalMonitorValue &val)
+{
+    if (!m_changeTrace.IsRunning())
+        return;
+
+    if (val.IsGood())
+        m_changeTrace.Mark("signal_lock");
+    if (!m_signalMonitor)
+        return;
+    if (m_signalMonitor->HasFlags(SignalMonitor::kDTVSigMon_PATMatch))
+        m_changeTrace.Mark("pat");
+    if (m_signalMonitor->HasFlags(SignalMonitor::kDTVSigMon_PMTMatch))
+        m_changeTrace.Mark("pmt");
+}
+
 /** \fn TVRec::ShouldSwitchToAnotherInput(QString)
  *  \brief Checks if named channel exists on current tuner, or
  *         another tuner.
@@ -3105,16 +3166,19 @@ void TVRec::SetChannel(const QString& name, uint requestType)
     // Clear the RingBuffer reset flag, in case we wait for a reset below
     ClearFlags(kFlagRingBufferReady, __FILE__, __LINE__);
 
-    // Clear out any EITScan channel change requests
+    // Clear out any EITScan and pre-tune channel change requests
     auto it = m_tuningRequests.begin();
     while (it != m_tuningRequests.end())
     {
-        if ((*it).m_flags & kFlagEITScan)
+        if ((*it).m_flags & (kFlagEITScan|kFlagPreTune))
             it = m_tuningRequests.erase(it);
         else
             ++it;
     }
 
+    if (m_tvChain)
+        m_changeTrace.Start(name);
+
     // Actually add the tuning request to the queue, and
     // then wait for it to start tuning
     m_tuningRequests.enqueue(TuningRequest(requestType, name));
@@ -3162,6 +3226,88 @@ bool TVRec::QueueEITChannelChange(const QString &name)
     return ok;
 }
 
+/** \brief Tunes this idle input ahead of a likely LiveTV channel change.
+ *
+ *   The input stays tuned, with its signal and table monitoring running,
+ *   until the "LiveTVPreTuneHold" time has passed without the request being
+ *   renewed or until any other tuning request arrives. It is not busy in the
+ *   meantime, so the scheduler and LiveTV can take it over as usual, and
+ *   when LiveTV does start on the pre-tuned channel it keeps the lock and
+ *   the tables already seen, see TuningTakeOverPreTune().
+ *
+ *   Like QueueEITChannelChange() this never blocks; it does nothing when
+ *   the input is in use or a recording is pending.
+ *
+ *  \return true if the input is, or is being, tuned to channum
+ */
+bool TVRec::QueuePreTune(const QString &channum)
+{
+    bool ok = false;
+    if (m_setChannelLock.tryLock())
+    {
+        if (m_stateChangeLock.tryLock())
+        {
+            m_pendingRecLock.lock();
+            bool idle = (m_internalState == kState_None) && !m_changeState &&
+                m_tuningRequests.empty() && m_pendingRecordings.empty();
+            m_pendingRecLock.unlock();
+
+            if (idle && m_channel && !channum.isEmpty())
+            {
+                if (m_preTuneChannel != channum)
+                {
+                    m_tuningRequests.enqueue(TuningRequest(kFlagPreTune, channum));
+                    m_preTuneChannel = channum;
+                }
+                m_preTuneExpire = MythDate::current().addSecs(m_preTuneHold.count());
+
+                // Keep the active EIT scan from retuning the input
+                if (m_eitScanStartTime < m_preTuneExpire)
+                    m_eitScanStartTime = m_preTuneExpire;
+                ok = true;
+            }
+            m_stateChangeLock.unlock();
+        }
+        m_setChannelLock.unlock();
+    }
+
+    LOG(VB_CHANNEL, LOG_INFO, LOC +
+        QString("QueuePreTune(%1) --> %2").arg(channum).arg(ok));
+
+    return ok;
+}
+
+/** \brief Closes the channel of a pre-tuned input.
+ *
+ *   This waits for the event loop to close the channel, so that the tuner
+ *   is free for another input as soon as this returns.
+ *
+ *  \sa QueuePreTune(const QString&)
+ */
+void TVRec::ReleasePreTune(void)
+{
+    QMutexLocker lock(&m_stateChangeLock);
+    if (m_preTuneChannel.isEmpty() || m_internalState != kState_None)
+        return;
+
+    LOG(VB_CHANNEL, LOG_INFO, LOC +
+        QString("Releasing input pre-tuned to %1").arg(m_preTuneChannel));
+    m_preTuneChannel.clear();
+
+    // A queued pre-tune would only open the channel again
+    auto it = m_tuningRequests.begin();
+    while (it != m_tuningRequests.end())
+    {
+        if ((*it).m_flags & kFlagPreTune)
+            it = m_tuningRequests.erase(it);
+        else
+            ++it;
+    }
+
+    m_tuningRequests.enqueue(TuningRequest(kFlagKillRec));
+    WaitForEventThreadSleep();
+}
+
 void TVRec::GetNextProgram(BrowseDirection direction,
                            QString &title,       QString &subtitle,
                            QString &desc,        QString &category,
@@ -3499,6 +3645,8 @@ bool TVRec::TuningOnSameMultiplex(TuningRequest &request)
  */
 void TVRec::HandleTuning(void)
 {
+    MPEGStreamData *streamData = nullptr;
+
     if (!m_tuningRequests.empty())
     {
         TuningRequest request = m_tuningRequests.front();
@@ -3509,18 +3657,25 @@ void TVRec::HandleTuning(void)
         request.m_channel = TuningGetChanNum(request, input);
         request.m_input   = input;
 
-        if (TuningOnSameMultiplex(request))
-            LOG(VB_CHANNEL, LOG_INFO, LOC + "On same multiplex");
+        // LiveTV on the pre-tuned channel starts on the tuner as it is
+        streamData = TuningTakeOverPreTune(request);
 
-        TuningShutdowns(request);
+        if (!streamData)
+        {
+            if (TuningOnSameMultiplex(request))
+                LOG(VB_CHANNEL, LOG_INFO, LOC + "On same multiplex");
+
+            TuningShutdowns(request);
+        }
 
         // The dequeue isn't safe to do until now because we
         // release the stateChangeLock to teardown a recorder
         m_tuningRequests.dequeue();
 
         // Now we start new stuff
-        if (request.m_flags & (kFlagRecording|kFlagLiveTV|
-                               kFlagEITScan|kFlagAntennaAdjust))
+        if (!streamData &&
+            (request.m_flags & (kFlagRecording|kFlagLiveTV|kFlagEITScan|
+                                kFlagPreTune|kFlagAntennaAdjust)))
         {
             if (!m_recorder)
             {
@@ -3548,7 +3703,6 @@ void TVRec::HandleTuning(void)
         TuningFrequency(m_lastTuningRequest);
     }
 
-    MPEGStreamData *streamData = nullptr;
     if (HasFlags(kFlagWaitingForSignal) && !(streamData = TuningSignalCheck()))
         return;
 
@@ -3562,9 +3716,62 @@ void TVRec::HandleTuning(void)
         // If we got this far it is safe to set a new starting channel...
         if (m_channel)
             m_channel->StoreInputChannels();
+
+        if (m_recorder)
+        {
+            m_changeTrace.Mark("recorder");
+            m_changeTrace.Finish();
+        }
+        else
+        {
+            m_changeTrace.Cancel();
+        }
     }
 }
 
+/**
+ *  \brief Hands a pre-tuned input over to LiveTV on the same channel.
+ *
+ *   An input pre-tuned by QueuePreTune() is already locked, with its
+ *   tables collected by the signal monitor. When LiveTV starts on that
+ *   channel, the channel is not closed and retuned; the monitor's stream
+ *   data goes straight to the new recorder, as TuningSignalCheck() does
+ *   once a lock is found.
+ *
+ *  \return the stream data for the recorder, or nullptr if the request
+ *          has to be tuned as usual
+ */
+MPEGStreamData *TVRec::TuningTakeOverPreTune(const TuningRequest &request)
+{
+    if (!(request.m_flags & kFlagLiveTV) || m_preTuneChannel.isEmpty() ||
+        request.m_channel != m_preTuneChannel || m_recorder ||
+        !m_channel || !m_channel->IsOpen() ||
+        m_channel->GetChannelName() != m_preTuneChannel ||
+        HasFlags(kFlagWaitingForSignal | kFlagEITScannerRunning) ||
+        !HasFlags(kFlagSignalMonitorRunning) ||
+        !GetDTVSignalMonitor() || !m_signalMonitor->IsAllGood())
+    {
+        return nullptr;
+    }
+
+    MPEGStreamData *streamData = GetDTVSignalMonitor()->GetStreamData();
+    if (!streamData)
+        return nullptr;
+
+    LOG(VB_CHANNEL, LOG_INFO, LOC +
+        QString("Taking over input pre-tuned to %1").arg(m_preTuneChannel));
+    m_preTuneChannel.clear();
+
+    TeardownSignalMonitor();
+    ClearFlags(kFlagSignalMonitorRunning | kFlagPendingActions,
+               __FILE__, __LINE__);
+    SetFlags(kFlagNeedToStartRecorder, __FILE__, __LINE__);
+    m_changeTrace.Mark("tune");
+    m_changeTrace.Mark("tables");
+
+    return streamData;
+}
+
 /** \fn TVRec::TuningShutdowns(const TuningRequest&)
  *  \brief This shuts down anything that needs to be shut down
  *         before handling the passed in tuning request.
@@ -3586,6 +3793,10 @@ void TVRec::TuningShutdowns(const TuningRequest &request)
     if (m_scanner && !request.IsOnSameMultiplex())
         m_scanner->StopPassiveScan();
 
+    // Any other request ends the pre-tuning of this input
+    if (!(request.m_flags & kFlagPreTune))
+        m_preTuneChannel.clear();
+
     if (HasFlags(kFlagSignalMonitorRunning))
     {
         MPEGStreamData *sd = nullptr;
@@ -3606,7 +3817,7 @@ void TVRec::TuningShutdowns(const TuningRequest &request)
 
     // At this point any waits are canceled.
 
-    if (request.m_flags & kFlagNoRec)
+    if (request.m_flags & (kFlagNoRec|kFlagPreTune))
     {
         if (HasFlags(kFlagDummyRecorderRunning))
         {
@@ -3662,6 +3873,8 @@ void TVRec::TuningFrequency(const TuningRequest &request)
 {
     LOG(VB_GENERAL, LOG_INFO, LOC + "TuningFrequency");
 
+    m_changeTrace.Mark("pause");
+
     DTVChannel *dtvchan = GetDTVChannel();
     if (dtvchan)
     {
@@ -3886,9 +4099,14 @@ void TVRec::TuningFrequency(const TuningRequest &request)
         // if we had problems starting the signal monitor,
         // we don't want to start the recorder...
         if (error)
+        {
+            m_changeTrace.Cancel();
             return;
+        }
     }
 
+    m_changeTrace.Mark("tune");
+
     // Request a recorder, if the command is a recording command
     ClearFlags(kFlagNeedToStartRecorder, __FILE__, __LINE__);
     if (request.m_flags & kFlagRec && !antadj)
@@ -3919,6 +4137,7 @@ MPEGStreamData *TVRec::TuningSignalCheck(void)
     if (m_signalMonitor->IsAllGood())
     {
         LOG(VB_RECORD, LOG_INFO, LOC + "TuningSignalCheck: Good signal");
+        m_changeTrace.Mark("tables");
         if (m_curRecording && (current_time > m_startRecordingDeadline))
         {
             newRecStatus = RecStatus::Failing;
@@ -3957,11 +4176,16 @@ MPEGStreamData *TVRec::TuningSignalCheck(void)
 
         ClearFlags(kFlagNeedToStartRecorder, __FILE__, __LINE__);
         newRecStatus = RecStatus::Failed;
+        m_changeTrace.Cancel();
 
         if (m_scanner && HasFlags(kFlagEITScannerRunning))
         {
             m_tuningRequests.enqueue(TuningRequest(kFlagNoRec));
         }
+        else if (!m_preTuneChannel.isEmpty())
+        {
+            m_tuningRequests.enqueue(TuningRequest(kFlagKillRec));
+        }
     }
     else if (m_curRecording && !m_reachedPreFail && current_time > m_preFailDeadline)
     {
@@ -4038,7 +4262,8 @@ MPEGStreamData *TVRec::TuningSignalCheck(void)
     if (GetDTVSignalMonitor())
         streamData = GetDTVSignalMonitor()->GetStreamData();
 
-    if (!HasFlags(kFlagEITScannerRunning))
+    // A pre-tuned input keeps monitoring, so its tables stay current
+    if (!HasFlags(kFlagEITScannerRunning) && m_preTuneChannel.isEmpty())
     {
         // shut down signal monitoring
         TeardownSignalMonitor();
@@ -4477,6 +4702,8 @@ QString TVRec::FlagToString(uint f)
         if (kFlagAntennaAdjust & f)
             msg += "AntennaAdjust,";
     }
+    if (kFlagPreTune & f)
+        msg += "PreTune,";
     if ((kFlagPendingActions & f) == kFlagPendingActions)
         msg += "PENDINGACTIONS,";
     else
@@ -4670,6 +4897,7 @@ bool TVRec::CreateLiveTVRingBuffer(const QString & channum)
     bool discont = (m_tvChain->TotalSize() > 0);
     m_tvChain->AppendNewProgram(pginfo, m_channel->GetChannelName(),
                                 m_channel->GetInputName(), discont);
+    m_changeTrace.SetID(m_tvChain->GetID(), m_tvChain->TotalSize() - 1);
 
     if (m_curRecording)
     {
@@ -4721,6 +4949,7 @@ bool TVRec::SwitchLiveTVRingBuffer(const QString & channum,
         pginfo->ApplyRecordRecGroupChange(RecordingInfo::kLiveTVRecGroup);
     m_tvChain->AppendNewProgram(pginfo, m_channel->GetChannelName(),
                                 m_channel->GetInputName(), discont);
+    m_changeTrace.SetID(m_tvChain->GetID(), m_tvChain->TotalSize() - 1);
 
     if (set_rec && m_recorder)
     {
@@ -4852,8 +5081,14 @@ static void apply_broken_dvb_driver_crc_hack(ChannelBase *c, MPEGStreamData *s)
     if (dvb != nullptr)
         s->SetIgnoreCRC(dvb->HasCRCBug());
 }
+static bool has_rotor(ChannelBase *c)
+{
+    auto * dvb = dynamic_cast<DVBChannel*>(c);
+    return (dvb != nullptr) && (dvb->GetRotor() != nullptr);
+}
 #else
 static void apply_broken_dvb_driver_crc_hack(ChannelBase*, MPEGStreamData*) {}
+static bool has_rotor(ChannelBase*) { return false; }
 #endif // USING_DVB
 
 /* vim: set expandtab tabstop=4 shiftwidth=4: */
@@ -28,6 +28,7 @@
 #include "recordinginfo.h"
 #include "tv.h"
 #include "signalmonitorlistener.h"
+#include "channelchangetrace.h"
 #include "mythtvexp.h"                  // for MTV_PUBLIC
 #include "programtypes.h"               // for RecStatus, RecStatus::Type, etc
 #include "videoouttypes.h"              // for PictureAttribute
@@ -210,6 +211,8 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
         { SetChannel(QString("NextChannel %1").arg((int)dir)); }
     void SetChannel(const QString& name, uint requestType = kFlagDetect);
     bool QueueEITChannelChange(const QString &name);
+    bool QueuePreTune(const QString &channum);
+    void ReleasePreTune(void);
 
     std::chrono::milliseconds SetSignalMonitoringRate(std::chrono::milliseconds rate, int notifyFrontend = 1);
     int  GetPictureAttribute(PictureAttribute attr);
@@ -251,7 +254,7 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
 
     void AllGood(void) override { WakeEventLoop(); } // SignalMonitorListener
     void StatusChannelTuned(const SignalMonitorValue &/*val*/) override { } // SignalMonitorListener
-    void StatusSignalLock(const SignalMonitorValue &/*val*/) override { } // SignalMonitorListener
+    void StatusSignalLock(const SignalMonitorValue &val) override; // SignalMonitorListener
     void StatusSignalStrength(const SignalMonitorValue &/*val*/) override { } // SignalMonitorListener
 
   protected:
@@ -302,6 +305,7 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     void TuningRestartRecorder(void);
     QString TuningGetChanNum(const TuningRequest &request, QString &input) const;
     bool TuningOnSameMultiplex(TuningRequest &request);
+    MPEGStreamData *TuningTakeOverPreTune(const TuningRequest &request);
 
     void HandleStateChange(void);
     void ChangeState(TVState nextState);
@@ -364,6 +368,8 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     bool               m_runJobOnHostOnly         {false};
     std::chrono::seconds m_eitCrawlIdleStart      {1min};
     std::chrono::seconds m_eitTransportTimeout    {5min};
+    /// How long an idle input stays pre-tuned unless the request is renewed
+    std::chrono::seconds m_preTuneHold            {3min};
     int                m_audioSampleRateDB        {0};
     std::chrono::seconds m_overRecordSecNrml      {0s};
     std::chrono::seconds m_overRecordSecCat       {0s};
@@ -398,6 +404,8 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     TuningQueue        m_tuningRequests;
     TuningRequest      m_lastTuningRequest        {0};
     QDateTime          m_eitScanStartTime;
+    QString            m_preTuneChannel;
+    QDateTime          m_preTuneExpire;
     mutable QMutex     m_triggerEventLoopLock;
     QWaitCondition     m_triggerEventLoopWait;
     bool               m_triggerEventLoopSignal   {false};
@@ -426,6 +434,7 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
 
     // LiveTV file chain
     LiveTVChain       *m_tvChain                  {nullptr};
+    ChannelChangeTrace m_changeTrace              {"backend"};
 
     // RingBuffer info
     MythMediaBuffer   *m_buffer                   {nullptr};
@@ -466,6 +475,8 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
 
     static const uint kFlagNoRec                = 0x0000F000;
     static const uint kFlagKillRingBuffer       = 0x00010000;
+    /// final result desired is an idle input tuned ahead for LiveTV
+    static const uint kFlagPreTune              = 0x00020000;
 
     // Waiting stuff
     static const uint kFlagWaitingForRecPause   = 0x00100000;
@@ -937,12 +937,28 @@ void VideoBuffers::ClearAfterSeek(void)
     DoDiscard(discards);
 }
 
+/*! \brief Sets the number of extra frames a software decoder may run ahead
+ *
+ * The extra frames are only added to FMT_YV12 buffers, as hardware decoders
+ * buffer internally, and take effect the next time the buffers are created.
+ * Unlike the other parameters, this survives Reset() so that it also applies
+ * when DiscardAndRecreate() is used for a stream change.
+*/
+void VideoBuffers::SetDecodeAhead(uint Frames)
+{
+    QMutexLocker locker(&m_globalLock);
+    m_decodeAhead = Frames;
+}
+
 bool VideoBuffers::CreateBuffers(VideoFrameType Type, const VideoFrameTypes* RenderFormats, QSize Size,
                                  uint NeedFree, uint NeedprebufferNormal,
                                  uint NeedPrebufferSmall, int MaxReferenceFrames)
 {
     m_renderFormats = RenderFormats;
-    Init(GetNumBuffers(Type, MaxReferenceFrames), NeedFree, NeedprebufferNormal, NeedPrebufferSmall);
+    uint count = GetNumBuffers(Type, MaxReferenceFrames);
+    if (Type == FMT_YV12)
+        count += m_decodeAhead;
+    Init(count, NeedFree, NeedprebufferNormal, NeedPrebufferSmall);
     return CreateBuffers(Type, Size.width(), Size.height(), m_renderFormats);
 }
 
@@ -55,6 +55,7 @@ class MTV_PUBLIC VideoBuffers
     bool CreateBuffers(VideoFrameType Type, int Width, int Height, const VideoFrameTypes* RenderFormats);
     static bool ReinitBuffer(MythVideoFrame *Frame, VideoFrameType Type, MythCodecID CodecID, int Width, int Height);
     void SetDeinterlacing(MythDeintType Single, MythDeintType Double, MythCodecID CodecID);
+    void SetDecodeAhead(uint Frames);
 
     void Reset(void);
     void DiscardFrames(bool NextFrameIsKeyFrame);
@@ -115,6 +116,7 @@ class MTV_PUBLIC VideoBuffers
     frame_vector_t       m_buffers;
     const VideoFrameTypes* m_renderFormats { nullptr };
 
+    uint                 m_decodeAhead               { 0 };
     uint                 m_needFreeFrames            { 0 };
     uint                 m_needPrebufferFrames       { 0 };
     uint                 m_needPrebufferFramesNormal { 0 };
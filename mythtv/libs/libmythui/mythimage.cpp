@@ -6,6 +6,7 @@
 #include <iostream>
 
 // QT headers
+#include <QBuffer>
 #include <QImageReader>
 #include <QNetworkReply>
 #include <QPainter>
@@ -293,7 +294,51 @@ bool MythImage::Load(MythImageReader *reader)
     return false;
 }
 
-bool MythImage::Load(const QString &filename)
+/**
+ * \brief Decodes an image, downscaling it to fit \p size while decoding
+ *
+ * Decoders such as JPEG can skip most of the work for a smaller image, and
+ * the full size image is never held in memory.
+ */
+static QImage *ReadImage(QImageReader &reader, QSize size, bool preserveAspect)
+{
+    if (size.width() > 0 && size.height() > 0)
+    {
+        QSize original = reader.size();
+        if (original.isValid() &&
+            (original.width() > size.width() || original.height() > size.height()))
+        {
+            reader.setScaledSize(original.scaled(size, preserveAspect ?
+                Qt::KeepAspectRatio : Qt::IgnoreAspectRatio));
+        }
+    }
+
+    auto *im = new QImage();
+    if (!reader.read(im))
+    {
+        delete im;
+        return nullptr;
+    }
+    return im;
+}
+
+static QImage *ReadImage(QByteArray &data, QSize size, bool preserveAspect)
+{
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    QImageReader reader(&buffer);
+    return ReadImage(reader, size, preserveAspect);
+}
+
+/**
+ * \brief Loads an image from a local, myth:// or internet URL
+ * \param filename The image to load
+ * \param size     If valid, the image is decoded at no more than this size,
+ *                 which is much faster for large images shown small
+ * \param preserveAspect Keep the aspect ratio of the image when decoding it
+ *                 at \p size
+ */
+bool MythImage::Load(const QString &filename, QSize size, bool preserveAspect)
 {
     if (filename.isEmpty())
         return false;
@@ -321,10 +366,7 @@ bool MythImage::Load(const QString &filename)
             delete rf;
 
             if (ret)
-            {
-                im = new QImage();
-                im->loadFromData(data);
-            }
+                im = ReadImage(data, size, preserveAspect);
         }
 #if 0
         else
@@ -340,17 +382,17 @@ bool MythImage::Load(const QString &filename)
     {
         QByteArray data;
         if (GetMythDownloadManager()->download(filename, &data))
-        {
-            im = new QImage();
-            im->loadFromData(data);
-        }
+            im = ReadImage(data, size, preserveAspect);
     }
     else
     {
         QString path = filename;
         if (path.startsWith('/') ||
             GetMythUI()->FindThemeFile(path))
-            im = new QImage(path);
+        {
+            QImageReader reader(path);
+            im = ReadImage(reader, size, preserveAspect);
+        }
     }
 
     if (im && im->isNull())
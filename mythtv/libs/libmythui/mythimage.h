@@ -58,7 +58,7 @@ class MUI_PUBLIC MythImage : public QImage, public ReferenceCounter
     void Assign(const QPixmap &pix);
 
     bool Load(MythImageReader *reader);
-    bool Load(const QString &filename);
+    bool Load(const QString &filename, QSize size = QSize(), bool preserveAspect = false);
 
     void Orientation(int orientation);
     void Resize(QSize newSize, bool preserveAspect = false);
@@ -1,5 +1,6 @@
 #include "mythuibuttonlist.h"
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
 
@@ -8,6 +9,7 @@
 #include <QDomDocument>
 #include <QKeyEvent>
 #include <QRegularExpression>
+#include <QSet>
 
 // libmyth headers
 #include "mythlogging.h"
@@ -65,6 +67,7 @@ void MythUIButtonList::Const(void)
 MythUIButtonList::~MythUIButtonList()
 {
     m_buttonToItem.clear();
+    m_loadedItems.clear();
     m_clearing = true;
 
     while (!m_itemList.isEmpty())
@@ -76,7 +79,7 @@ void MythUIButtonList::Select()
     MythUIButtonListItem *item = GetItemCurrent();
 
     if (item)
-        emit itemSelected(item);
+        ItemSelected(item);
 
     SetActive(true);
 }
@@ -114,6 +117,7 @@ void MythUIButtonList::SetActive(bool active)
 void MythUIButtonList::Reset()
 {
     m_buttonToItem.clear();
+    m_loadedItems.clear();
 
     if (m_itemList.isEmpty())
         return;
@@ -1421,6 +1425,9 @@ void MythUIButtonList::CalculateArrowStates()
     else
         DistributeButtons();
 
+    if (m_prefetch >= 0)
+        LoadAroundCurrent();
+
     updateLCD();
 
     m_needsUpdate = false;
@@ -1453,7 +1460,65 @@ void MythUIButtonList::CalculateArrowStates()
 void MythUIButtonList::ItemVisible(MythUIButtonListItem *item)
 {
     if (item)
+    {
+        if (m_prefetch >= 0)
+            LoadItem(item);
         emit itemVisible(item);
+    }
+}
+
+void MythUIButtonList::ItemSelected(MythUIButtonListItem *item)
+{
+    if (item && m_prefetch >= 0)
+        LoadItem(item);
+    emit itemSelected(item);
+}
+
+/// \brief Has an item filled in by the itemLoaded handler, if it is not already
+void MythUIButtonList::LoadItem(MythUIButtonListItem *item)
+{
+    if (item->m_loaded)
+        return;
+
+    item->m_loaded = true;
+    m_loadedItems.append(item);
+    emit itemLoaded(item);
+}
+
+/*!
+ * \brief Loads the items that are visible or within the prefetch margin of the
+ *        visible ones, and releases the others once too many are loaded
+ */
+void MythUIButtonList::LoadAroundCurrent(void)
+{
+    if (m_itemCount == 0)
+        return;
+
+    // The visible items are all within a page of the selected one, whatever
+    // the layout
+    int page  = std::max(m_itemsVisible, 1);
+    int first = std::max(m_selPosition - page - m_prefetch, 0);
+    int last  = std::min(m_selPosition + page + m_prefetch + 1, m_itemCount);
+
+    for (int i = first; i < last; ++i)
+        LoadItem(m_itemList[i]);
+
+    if (m_loadedItems.size() <= 2 * (last - first))
+        return;
+
+    QSet<MythUIButtonListItem*> window;
+    for (int i = first; i < last; ++i)
+        window.insert(m_itemList[i]);
+
+    QList<MythUIButtonListItem*> loaded;
+    for (auto *item : qAsConst(m_loadedItems))
+    {
+        if (window.contains(item))
+            loaded.append(item);
+        else
+            item->Release();
+    }
+    m_loadedItems = loaded;
 }
 
 void MythUIButtonList::InsertItem(MythUIButtonListItem *item, int listPosition)
@@ -1527,13 +1592,14 @@ void MythUIButtonList::RemoveItem(MythUIButtonListItem *item)
 
     m_itemList.removeAt(curIndex);
     --m_itemCount;
+    m_loadedItems.removeOne(item);
 
     Update();
 
     if (m_selPosition < m_itemCount)
-        emit itemSelected(m_itemList.at(m_selPosition));
+        ItemSelected(m_itemList.at(m_selPosition));
     else
-        emit itemSelected(nullptr);
+        ItemSelected(nullptr);
 
     if (IsEmpty())
         emit DependChanged(true);
@@ -1584,7 +1650,7 @@ void MythUIButtonList::SetItemCurrent(int current, int topPosition)
 
     Update();
 
-    emit itemSelected(GetItemCurrent());
+    ItemSelected(GetItemCurrent());
 }
 
 MythUIButtonListItem *MythUIButtonList::GetItemCurrent() const
@@ -2057,7 +2123,7 @@ bool MythUIButtonList::MoveUp(MovementUnit unit, uint amount)
     if (pos != m_selPosition)
     {
         Update();
-        emit itemSelected(GetItemCurrent());
+        ItemSelected(GetItemCurrent());
     }
     else
         return false;
@@ -2271,7 +2337,7 @@ bool MythUIButtonList::MoveDown(MovementUnit unit, uint amount)
     {
         m_keepSelAtBottom = true;
         Update();
-        emit itemSelected(GetItemCurrent());
+        ItemSelected(GetItemCurrent());
     }
     else
         return false;
@@ -2753,6 +2819,10 @@ void MythUIButtonList::customEvent(QEvent *event)
 
 void MythUIButtonList::LoadInBackground(int start, int pageSize)
 {
+    // Items are loaded as they are needed instead
+    if (m_prefetch >= 0)
+        return;
+
     m_nextItemLoaded = start;
     QCoreApplication::
         postEvent(this, new NextButtonListPageEvent(start, pageSize));
@@ -2765,6 +2835,28 @@ int MythUIButtonList::StopLoad(void)
     return m_nextItemLoaded;
 }
 
+/*!
+ * \brief Only keep the items near the visible ones filled in
+ *
+ * Rather than filling in every item up front, or in the background with
+ * LoadInBackground(), items only get their text, images and states from the
+ * itemLoaded signal once they come within \p prefetch items of the visible
+ * ones, or are selected or searched. Items far from the visible ones are
+ * emptied again, so a list of thousands of items only holds the display
+ * properties of a few pages at a time.
+ *
+ * The itemLoaded handler must set all of an item's display properties from its
+ * data, as an item may be loaded any number of times. Items need to be created
+ * with their data, and should not have text set other than by the handler.
+ *
+ * \param prefetch Number of items to load either side of the visible ones
+ */
+void MythUIButtonList::SetLoadOnDemand(int prefetch)
+{
+    StopLoad();
+    m_prefetch = std::max(prefetch, 0);
+}
+
 QPoint MythUIButtonList::GetButtonPosition(int column, int row) const
 {
     int x = m_contentsRect.x() +
@@ -3174,7 +3266,10 @@ bool MythUIButtonList::DoFind(bool doMove, bool searchForward)
 
     while (true)
     {
-        found = GetItemAt(currPos)->FindText(m_searchStr, m_searchFields, m_searchStartsWith);
+        MythUIButtonListItem *item = GetItemAt(currPos);
+        if (m_prefetch >= 0)
+            LoadItem(item);
+        found = item->FindText(m_searchStr, m_searchFields, m_searchStartsWith);
 
         if (found)
         {
@@ -3246,6 +3341,21 @@ MythUIButtonListItem::MythUIButtonListItem(MythUIButtonList *lbtype,
         m_parent->InsertItem(this, listPosition);
 }
 
+/// \brief Drops the display properties set when the item was loaded
+void MythUIButtonListItem::Release(void)
+{
+    for (auto *image : qAsConst(m_images))
+    {
+        if (image)
+            image->DecrRef();
+    }
+    m_images.clear();
+    m_strings.clear();
+    m_imageFilenames.clear();
+    m_states.clear();
+    m_loaded = false;
+}
+
 MythUIButtonListItem::~MythUIButtonListItem()
 {
     if (m_parent)
@@ -118,6 +118,8 @@ class MUI_PUBLIC MythUIButtonListItem
     virtual void SetToRealButton(MythUIStateType *button, bool selected);
 
   protected:
+    void Release(void);
+
     MythUIButtonList *m_parent      {nullptr};
     QString         m_text;
     QString         m_fontState;
@@ -129,6 +131,7 @@ class MUI_PUBLIC MythUIButtonListItem
     bool            m_showArrow     {false};
     bool            m_isVisible     {false};
     bool            m_enabled       {true};
+    bool            m_loaded        {false};
 
     QMap<QString, TextProperties> m_strings;
     QMap<QString, MythImage*> m_images;
@@ -219,6 +222,7 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
 
     void LoadInBackground(int start = 0, int pageSize = 20);
     int  StopLoad(void);
+    void SetLoadOnDemand(int prefetch = 20);
 
   public slots:
     void Select();
@@ -269,6 +273,9 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
     void CalculateArrowStates(void);
     void SetScrollBarPosition(void);
     void ItemVisible(MythUIButtonListItem *item);
+    void ItemSelected(MythUIButtonListItem *item);
+    void LoadItem(MythUIButtonListItem *item);
+    void LoadAroundCurrent(void);
 
     void SetActive(bool active);
 
@@ -346,6 +353,8 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
 
     QList<MythUIButtonListItem*> m_itemList;
     int m_nextItemLoaded              {0};
+    int m_prefetch                    {-1};
+    QList<MythUIButtonListItem*> m_loadedItems;
 
     bool m_drawFromBottom             {false};
 
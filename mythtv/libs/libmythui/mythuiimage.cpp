@@ -274,10 +274,17 @@ class ImageLoader
             image = painter->GetFormatImage();
             bool ok = false;
 
+            // Decode straight to the size the image will be shown at, unless
+            // it is first reshaped by a reflection or rotation
+            QSize decodeSize;
+            if (bResize && w > 0 && h > 0 &&
+                !imProps.m_isReflected && !imProps.m_isOriented)
+                decodeSize = QSize(w, h);
+
             if (imageReader)
                 ok = image->Load(imageReader);
             else
-                ok = image->Load(filename);
+                ok = image->Load(filename, decodeSize, imProps.m_preserveAspect);
 
             if (!ok)
             {
@@ -496,6 +503,16 @@ class ImageLoadThread : public QRunnable
         bool aborted = false;
         QString filename =  m_imageProperties.m_filename;
 
+        // Skip images that are no longer wanted, such as those of the buttons
+        // of a list that has since been scrolled on to other items
+        if (!m_parent->IsCurrentFile(m_basefile))
+        {
+            auto *le = new ImageLoadEvent(m_parent, nullptr, m_basefile,
+                                          filename, m_number, true);
+            QCoreApplication::postEvent(m_parent, le);
+            return;
+        }
+
         // NOTE Do NOT use MythImageReader::supportsAnimation here, it defeats
         // the point of caching remote images
         if (ImageLoader::SupportsAnimation(filename))
@@ -611,6 +628,15 @@ MythUIImage::~MythUIImage()
     delete d;
 }
 
+/**
+ *  \brief Whether \p basefile is still the file to be shown, from any thread
+ */
+bool MythUIImage::IsCurrentFile(const QString &basefile)
+{
+    QReadLocker updateLocker(&d->m_updateLock);
+    return m_imageProperties.m_filename == basefile;
+}
+
 /**
  *  \brief Remove all images from the widget
  */
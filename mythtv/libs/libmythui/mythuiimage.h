@@ -164,6 +164,8 @@ class MUI_PUBLIC MythUIImage : public MythUIType
 
     void FindRandomImage(void);
 
+    bool IsCurrentFile(const QString &basefile);
+
     QString m_filename;
     QString m_origFilename;
 
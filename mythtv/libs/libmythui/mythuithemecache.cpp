@@ -21,6 +21,9 @@
 
 #define LOC QString("UICache: ")
 
+// Image lookups between logging the cache statistics
+static constexpr int kStatsInterval { 1000 };
+
 MythUIThemeCache::MythUIThemeCache()
   : m_imageThreadPool(new MThreadPool("MythUIHelper"))
 {
@@ -282,11 +285,13 @@ MythImage* MythUIThemeCache::LoadCacheImage(QString File, const QString& Label,
             m_cacheTrack[Label] + kImageCacheTimeout > now)
         {
             m_imageCache[Label]->IncrRef();
+            CountLookup(cacheMode, m_imageCache[Label]);
             return m_imageCache[Label];
         }
     }
 
     MythImage *ret = nullptr;
+    bool fromDisk = false;
 
     // Check Memory Cache
     ret = GetImageFromCache(Label);
@@ -304,7 +309,10 @@ MythImage* MythUIThemeCache::LoadCacheImage(QString File, const QString& Label,
         // If the file isn't in the disk cache, then we don't want to bother
         // checking the last modified times of the original
         if (!cacheFileInfo.exists())
+        {
+            CountLookup(cacheMode, nullptr);
             return nullptr;
+        }
 
         // Now compare the time on the source versus our cached copy
         QDateTime srcLastModified;
@@ -331,7 +339,10 @@ MythImage* MythUIThemeCache::LoadCacheImage(QString File, const QString& Label,
         else
         {
             if (!GetMythUI()->FindThemeFile(File))
+            {
+                CountLookup(cacheMode, nullptr);
                 return nullptr;
+            }
 
             QFileInfo original(File);
 
@@ -349,6 +360,7 @@ MythImage* MythUIThemeCache::LoadCacheImage(QString File, const QString& Label,
             // it from there instead
             if (!ret && (cacheMode == kCacheNormal))
             {
+                fromDisk = true;
 
                 if (Painter)
                 {
@@ -383,9 +395,42 @@ MythImage* MythUIThemeCache::LoadCacheImage(QString File, const QString& Label,
         }
     }
 
+    CountLookup(cacheMode, ret, fromDisk);
     return ret;
 }
 
+/**
+ * \brief Updates the lookup statistics, logging them every kStatsInterval lookups
+ */
+void MythUIThemeCache::CountLookup(ImageCacheMode CacheMode, MythImage* Image, bool FromDisk)
+{
+    // Misses when ignoring the disk cache are only checks before loading in
+    // the background, the load itself looks the image up again.
+    if (!Image && (CacheMode & kCacheIgnoreDisk))
+        return;
+
+    if (Image && FromDisk)
+        m_diskHits.fetchAndAddRelaxed(1);
+    else if (Image)
+        m_memoryHits.fetchAndAddRelaxed(1);
+
+    int lookups = m_lookups.fetchAndAddRelaxed(1) + 1;
+    if (lookups % kStatsInterval != 0)
+        return;
+
+    int memory = m_memoryHits.fetchAndAddRelaxed(0);
+    int disk   = m_diskHits.fetchAndAddRelaxed(0);
+    LOG(VB_GUI, LOG_INFO, LOC +
+        QString("%1 lookups: %2% memory hits, %3% disk hits, %4% misses. "
+                "%5 evictions, %6 of %7 KB used")
+        .arg(lookups)
+        .arg(memory * 100 / lookups).arg(disk * 100 / lookups)
+        .arg((lookups - memory - disk) * 100 / lookups)
+        .arg(m_evictions.fetchAndAddRelaxed(0))
+        .arg(m_cacheSize.fetchAndAddRelaxed(0) / 1024)
+        .arg(m_maxCacheSize.fetchAndAddRelaxed(0) / 1024));
+}
+
 MythImage* MythUIThemeCache::GetImageFromCache(const QString& URL)
 {
     QMutexLocker locker(&m_cacheLock);
@@ -471,6 +516,7 @@ MythImage *MythUIThemeCache::CacheImage(const QString& URL, MythImage* Image, bo
             m_imageCache[oldestKey]->DecrRef();
             m_imageCache.remove(oldestKey);
             m_cacheTrack.remove(oldestKey);
+            m_evictions.fetchAndAddRelaxed(1);
         }
         else
         {
@@ -49,6 +49,7 @@ class MUI_PUBLIC MythUIThemeCache
     void        ClearOldImageCache();
     void        RemoveCacheDir(const QString& Dir);
     static void PruneCacheDir(const QString& Dir);
+    void        CountLookup(ImageCacheMode CacheMode, MythImage* Image, bool FromDisk = false);
 
     QMap<QString, MythImage *> m_imageCache;
     QMap<QString, SystemTime> m_cacheTrack;
@@ -64,6 +65,11 @@ class MUI_PUBLIC MythUIThemeCache
     QAtomicInteger<qint64> m_cacheSize    { 0 };
     QAtomicInteger<qint64> m_maxCacheSize { 30 * 1024 * 1024 };
 #endif
+    // Lookup statistics
+    QAtomicInt m_lookups                  { 0 };
+    QAtomicInt m_memoryHits               { 0 };
+    QAtomicInt m_diskHits                 { 0 };
+    QAtomicInt m_evictions                { 0 };
     QString m_themecachedir;
     QSize   m_cacheScreenSize;
     MThreadPool* m_imageThreadPool        { nullptr };
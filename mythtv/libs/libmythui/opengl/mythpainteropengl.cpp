@@ -1,15 +1,73 @@
 // Config header generated in base directory by configure
 #include "config.h"
 
+// Std
+#include <algorithm>
+
 // Qt
 #include <QCoreApplication>
 #include <QPainter>
 
 // MythTV
+#include "mythcorecontext.h"
 #include "mythmainwindow.h"
 #include "mythrenderopengl.h"
 #include "mythpainteropengl.h"
 
+// Images up to this size are packed into shared atlas textures
+static constexpr int kAtlasSize      { 1024 };
+static constexpr int kAtlasMaxWidth  { 512 };
+static constexpr int kAtlasMaxHeight { 256 };
+// Images drawn from one atlas with a single draw call
+static constexpr int kMaxBatchImages { 256 };
+// Frames averaged over for the statistics logged with -v gpu
+static constexpr int kStatsFrames    { 300 };
+
+/*! \brief Find space for an image
+ * \param Size     Size of the image, including any padding
+ * \param Position Set to the top left of the space found
+ * \return true if there was space
+*/
+bool MythGLAtlas::Allocate(QSize Size, QPoint &Position)
+{
+    const QSize total = m_texture->m_size;
+    if (Size.width() > total.width() || Size.height() > total.height())
+        return false;
+
+    // Use the shortest shelf the image fits on
+    Shelf *best = nullptr;
+    for (auto & shelf : m_shelves)
+    {
+        if ((Size.height() <= shelf.m_height) && (shelf.m_width + Size.width() <= total.width()) &&
+            (!best || shelf.m_height < best->m_height))
+        {
+            best = &shelf;
+        }
+    }
+
+    // Start a new shelf if there is none, or if the image would waste over half of it
+    int top = m_shelves.empty() ? 0 : m_shelves.back().m_top + m_shelves.back().m_height;
+    if ((!best || (Size.height() * 2 < best->m_height)) && (top + Size.height() <= total.height()))
+    {
+        m_shelves.push_back({ top, Size.height(), 0 });
+        best = &m_shelves.back();
+    }
+
+    if (!best)
+        return false;
+
+    Position = QPoint(best->m_width, best->m_top);
+    best->m_width += Size.width();
+    return true;
+}
+
+void MythGLAtlas::Reset(void)
+{
+    m_shelves.clear();
+    m_liveImages = 0;
+    m_liveArea = 0;
+}
+
 MythOpenGLPainter::MythOpenGLPainter(MythRenderOpenGL* Render, MythMainWindow* Parent)
   : MythPainterGPU(Parent),
     m_render(Render)
@@ -40,6 +98,7 @@ void MythOpenGLPainter::FreeResources(void)
     OpenGLLocker locker(m_render);
     ClearCache();
     DeleteTextures();
+    DeleteAtlases();
     if (m_mappedBufferPoolReady)
     {
         for (auto & buf : m_mappedBufferPool)
@@ -64,11 +123,34 @@ void MythOpenGLPainter::DeleteTextures(void)
     {
         MythGLTexture *texture = m_textureDeleteList.front();
         m_hardwareCacheSize -= MythRenderOpenGL::GetTextureDataSize(texture);
+        auto entry = m_atlasEntries.find(texture);
+        if (entry != m_atlasEntries.end())
+        {
+            // The space is reclaimed once the whole atlas is unused
+            entry->m_atlas->m_liveImages--;
+            entry->m_atlas->m_liveArea -= (entry->m_rect.width() + 2) * (entry->m_rect.height() + 2);
+            m_atlasEntries.erase(entry);
+        }
         m_render->DeleteTexture(texture);
         m_textureDeleteList.pop_front();
     }
 }
 
+void MythOpenGLPainter::DeleteAtlases(void)
+{
+    m_batchVertices.clear();
+    m_batchAtlas = nullptr;
+    m_atlasEntries.clear();
+    for (auto * atlas : m_atlases)
+    {
+        m_render->DeleteTexture(atlas->m_texture);
+        delete atlas;
+    }
+    m_atlases.clear();
+    delete m_batchBuffer;
+    m_batchBuffer = nullptr;
+}
+
 void MythOpenGLPainter::ClearCache(void)
 {
     LOG(VB_GENERAL, LOG_INFO, "Clearing OpenGL painter cache.");
@@ -116,11 +198,24 @@ void MythOpenGLPainter::Begin(QPaintDevice *Parent)
         float hdscreens = (static_cast<float>(m_lastSize.width() + 1) * m_lastSize.height()) / s_onehd;
         int cpu = qMax(static_cast<int>(hdscreens * s_basesize), s_basesize);
         int gpu = cpu * 3 / 2;
+        // An explicit budget (in MB) overrides the one scaled to the resolution
+        int budget = gCoreContext->GetNumSetting("UIPainterMaxCacheHW", 0);
+        if (budget > 0)
+            gpu = budget;
         SetMaximumCacheSizes(gpu, cpu);
+
+        // Up to a quarter of the budget may be set aside for atlases
+        int atlassize = std::min(kAtlasSize, m_render->GetMaxTextureSize());
+        int atlasbytes = MythRenderOpenGL::GetBufferSize(QSize(atlassize, atlassize),
+                                                         QOpenGLTexture::RGBA, QOpenGLTexture::UInt8);
+        m_maxAtlases = std::max(1, m_maxHardwareCacheSize / 4 / atlasbytes);
     }
 
     if (VERBOSE_LEVEL_CHECK(VB_GPU, LOG_INFO))
+    {
         m_render->logDebugMarker("PAINTER_FRAME_START");
+        m_frameTimer.start();
+    }
 
     DeleteTextures();
     m_render->makeCurrent();
@@ -151,6 +246,9 @@ void MythOpenGLPainter::End(void)
         return;
     }
 
+    FlushBatch();
+    LogFrameStats();
+
     if (VERBOSE_LEVEL_CHECK(VB_GPU, LOG_INFO))
         m_render->logDebugMarker("PAINTER_FRAME_END");
 
@@ -184,7 +282,7 @@ MythGLTexture* MythOpenGLPainter::GetTextureFromCache(MythImage *Image)
     Image->SetChanged(false);
 
     int count = 0;
-    MythGLTexture* texture = nullptr;
+    MythGLTexture* texture = CreateAtlasEntry(Image);
     while (texture == nullptr)
     {
         texture = m_render->CreateTextureFromQImage(Image);
@@ -213,6 +311,8 @@ MythGLTexture* MythOpenGLPainter::GetTextureFromCache(MythImage *Image)
     }
 
     CheckFormatImage(Image);
+    m_statsUploads++;
+    m_statsUploadBytes += MythRenderOpenGL::GetTextureDataSize(texture);
     m_hardwareCacheSize += MythRenderOpenGL::GetTextureDataSize(texture);
     m_imageToTextureMap[Image] = texture;
     m_imageExpireList.push_back(Image);
@@ -228,6 +328,217 @@ MythGLTexture* MythOpenGLPainter::GetTextureFromCache(MythImage *Image)
     return texture;
 }
 
+/*! \brief Upload a small image into an atlas
+ *
+ * \return The cache entry for the image, or nullptr if it is too large or no
+ * atlas has space for it.
+*/
+MythGLTexture* MythOpenGLPainter::CreateAtlasEntry(MythImage *Image)
+{
+    if ((m_maxAtlases < 1) || Image->isNull() ||
+        (Image->width() > kAtlasMaxWidth) || (Image->height() > kAtlasMaxHeight))
+    {
+        return nullptr;
+    }
+
+    // Each image is surrounded by a copy of its edge pixels, so that filtering
+    // does not pick up its neighbours in the atlas
+    QSize padded = Image->size() + QSize(2, 2);
+    MythGLAtlas *atlas = nullptr;
+    QPoint position;
+    if (!AllocateFromAtlas(padded, atlas, position))
+        return nullptr;
+
+    QImage source = Image->convertToFormat(QImage::Format_RGBA8888);
+    QImage image(padded, QImage::Format_RGBA8888);
+    int width = source.width();
+    for (int y = 0; y < padded.height(); ++y)
+    {
+        int line = std::min(std::max(y - 1, 0), source.height() - 1);
+        const auto *in = reinterpret_cast<const uint32_t*>(source.constScanLine(line));
+        auto *out = reinterpret_cast<uint32_t*>(image.scanLine(y));
+        out[0] = in[0];
+        std::copy(in, in + width, out + 1);
+        out[width + 1] = in[width - 1];
+    }
+    m_render->UpdateTextureFromQImage(atlas->m_texture, position, image);
+
+    // The entry shares the atlas texture, which it does not own
+    auto *texture = new MythGLTexture(atlas->m_texture->m_texture->textureId());
+    texture->m_size       = Image->size();
+    texture->m_totalSize  = Image->size();
+    texture->m_bufferSize = MythRenderOpenGL::GetBufferSize(padded, QOpenGLTexture::RGBA,
+                                                            QOpenGLTexture::UInt8);
+    texture->m_crop       = true;
+    atlas->m_liveImages++;
+    atlas->m_liveArea += padded.width() * padded.height();
+    m_atlasEntries.insert(texture, { atlas, QRect(position + QPoint(1, 1), Image->size()) });
+    return texture;
+}
+
+bool MythOpenGLPainter::AllocateFromAtlas(QSize Size, MythGLAtlas *&Atlas, QPoint &Position)
+{
+    // Reuse atlases whose images have all been released, after drawing
+    // anything still waiting to be drawn from them
+    for (auto * atlas : m_atlases)
+    {
+        if ((atlas->m_liveImages == 0) && atlas->IsUsed())
+        {
+            if (atlas == m_batchAtlas)
+                FlushBatch();
+            atlas->Reset();
+        }
+    }
+
+    for (auto * atlas : m_atlases)
+    {
+        if (atlas->Allocate(Size, Position))
+        {
+            Atlas = atlas;
+            return true;
+        }
+    }
+
+    if (static_cast<int>(m_atlases.size()) < m_maxAtlases)
+    {
+        int size = std::min(kAtlasSize, m_render->GetMaxTextureSize());
+        MythGLTexture *texture = m_render->CreateAtlasTexture(QSize(size, size));
+        if (!texture)
+        {
+            m_maxAtlases = static_cast<int>(m_atlases.size());
+            return false;
+        }
+        Atlas = new MythGLAtlas(texture);
+        m_atlases.push_back(Atlas);
+        LOG(VB_GPU, LOG_INFO, QString("Created painter atlas %1 of %2 (%3x%3)")
+            .arg(m_atlases.size()).arg(m_maxAtlases).arg(size));
+        return Atlas->Allocate(Size, Position);
+    }
+
+    // Every atlas is full. If one is mostly space from released images, evict
+    // its remaining images (they are uploaded again when next drawn) and reuse it.
+    auto emptiest = std::min_element(m_atlases.cbegin(), m_atlases.cend(),
+        [](const MythGLAtlas *First, const MythGLAtlas *Second)
+        { return First->m_liveArea < Second->m_liveArea; });
+    if (emptiest == m_atlases.cend())
+        return false;
+    Atlas = *emptiest;
+    QSize total = Atlas->m_texture->m_size;
+    if (Atlas->m_liveArea > (total.width() * total.height()) / 2)
+        return false;
+
+    if (Atlas == m_batchAtlas)
+        FlushBatch();
+    QList<MythImage*> evict;
+    for (auto it = m_imageToTextureMap.cbegin(); it != m_imageToTextureMap.cend(); ++it)
+    {
+        auto entry = m_atlasEntries.constFind(it.value());
+        if ((entry != m_atlasEntries.cend()) && (entry->m_atlas == Atlas))
+            evict.append(it.key());
+    }
+    for (auto * image : qAsConst(evict))
+        DeleteFormatImagePriv(image);
+    DeleteTextures();
+    LOG(VB_GPU, LOG_DEBUG, QString("Recycling painter atlas - evicted %1 images")
+        .arg(evict.size()));
+
+    if (Atlas->m_liveImages != 0)
+        return false;
+    Atlas->Reset();
+    return Atlas->Allocate(Size, Position);
+}
+
+/*! \brief Queue an image held in an atlas to be drawn
+ *
+ * Consecutive images from the same atlas are drawn together by FlushBatch.
+*/
+void MythOpenGLPainter::DrawAtlasImage(MythGLTexture *Texture, const QRect Dest,
+                                       const QRect Source, int Alpha, qreal Scale)
+{
+    AtlasEntry entry = m_atlasEntries.value(Texture);
+    if ((entry.m_atlas != m_batchAtlas) ||
+        (m_batchVertices.size() >= kMaxBatchImages * 6 * MythRenderOpenGL::kBatchVertexFloats))
+    {
+        FlushBatch();
+        m_batchAtlas = entry.m_atlas;
+    }
+
+    // As MythRenderOpenGL::UpdateTextureVertices, but confined to the image
+    QRect source = Source.intersected(QRect(QPoint(0, 0), Texture->m_size));
+    if (source.isEmpty())
+        return;
+
+    QSize size = entry.m_atlas->m_texture->m_size;
+    auto width  = static_cast<float>(size.width());
+    auto height = static_cast<float>(size.height());
+    float left   = (entry.m_rect.left() + source.left()) / width;
+    float right  = (entry.m_rect.left() + source.left() + source.width()) / width;
+    float top    = (entry.m_rect.top() + source.top()) / height;
+    float bottom = (entry.m_rect.top() + source.top() + source.height()) / height;
+
+    auto x1 = static_cast<float>(Dest.left());
+    auto y1 = static_cast<float>(Dest.top());
+    auto x2 = static_cast<float>(Dest.left() + std::min(static_cast<int>(source.width() * Scale), Dest.width()));
+    auto y2 = static_cast<float>(Dest.top() + std::min(static_cast<int>(source.height() * Scale), Dest.height()));
+    float alpha = Alpha / 255.0F;
+
+    m_batchVertices.insert(m_batchVertices.end(), {
+        x1, y1, left,  top,    1.0F, 1.0F, 1.0F, alpha,
+        x1, y2, left,  bottom, 1.0F, 1.0F, 1.0F, alpha,
+        x2, y1, right, top,    1.0F, 1.0F, 1.0F, alpha,
+        x2, y1, right, top,    1.0F, 1.0F, 1.0F, alpha,
+        x1, y2, left,  bottom, 1.0F, 1.0F, 1.0F, alpha,
+        x2, y2, right, bottom, 1.0F, 1.0F, 1.0F, alpha });
+    m_statsBatched++;
+}
+
+/// \brief Draw any images queued by DrawAtlasImage
+void MythOpenGLPainter::FlushBatch(void)
+{
+    if (m_batchAtlas && !m_batchVertices.empty())
+    {
+        if (!m_batchBuffer)
+        {
+            m_batchBuffer = m_render->CreateVBO(static_cast<int>(kMaxBatchImages * 6 *
+                MythRenderOpenGL::kBatchVertexFloats * sizeof(GLfloat)));
+        }
+        m_render->DrawBitmapBatch(m_batchAtlas->m_texture, nullptr, m_batchBuffer, m_batchVertices);
+        m_statsDraws++;
+    }
+    m_batchVertices.clear();
+    m_batchAtlas = nullptr;
+}
+
+/// \brief Log the average painting time and texture activity every few seconds
+void MythOpenGLPainter::LogFrameStats(void)
+{
+    if (m_frameTimer.isValid())
+    {
+        m_statsTime += m_frameTimer.nsecsElapsed();
+        m_frameTimer.invalidate();
+        if (++m_statsFrames < kStatsFrames)
+            return;
+
+        const int64_t kOneMeg = 1024 * 1024;
+        LOG(VB_GPU, LOG_INFO, QString("Painter: %1ms/frame, %2 draws/frame, "
+                                      "%3 atlas images/frame, %4 uploads (%5KB) in %6 frames, "
+                                      "cache %7/%8MB, %9 atlases")
+            .arg(m_statsTime / 1000000.0 / m_statsFrames, 0, 'f', 2)
+            .arg(static_cast<double>(m_statsDraws) / m_statsFrames, 0, 'f', 1)
+            .arg(static_cast<double>(m_statsBatched) / m_statsFrames, 0, 'f', 1)
+            .arg(m_statsUploads).arg(m_statsUploadBytes / 1024).arg(m_statsFrames)
+            .arg(m_hardwareCacheSize / kOneMeg).arg(m_maxHardwareCacheSize / kOneMeg)
+            .arg(m_atlases.size()));
+    }
+
+    m_statsTime = 0;
+    m_statsFrames = 0;
+    m_statsDraws = 0;
+    m_statsBatched = 0;
+    m_statsUploads = 0;
+    m_statsUploadBytes = 0;
+}
+
 #ifdef Q_OS_MACOS
 #define DEST dest
 #else
@@ -252,6 +563,14 @@ void MythOpenGLPainter::DrawImage(const QRect Dest, MythImage *Image,
         // Drawing an image multiple times with the same VBO will stall most GPUs as
         // the VBO is re-mapped whilst still in use. Use a pooled VBO instead.
         MythGLTexture *texture = GetTextureFromCache(Image);
+        if (texture && m_atlasEntries.contains(texture))
+        {
+            DrawAtlasImage(texture, DEST, Source, Alpha, pixelratio);
+            return;
+        }
+
+        FlushBatch();
+        m_statsDraws++;
         if (texture && m_mappedTextures.contains(texture))
         {
             QOpenGLBuffer *vbo = texture->m_vbo;
@@ -286,6 +605,8 @@ void MythOpenGLPainter::DrawRect(const QRect Area, const QBrush &FillBrush,
     if ((FillBrush.style() == Qt::SolidPattern ||
          FillBrush.style() == Qt::NoBrush) && m_render && !m_usingHighDPI)
     {
+        FlushBatch();
+        m_statsDraws++;
         m_render->DrawRect(nullptr, Area, FillBrush, LinePen, Alpha);
         return;
     }
@@ -299,6 +620,8 @@ void MythOpenGLPainter::DrawRoundRect(const QRect Area, int CornerRadius,
     if ((FillBrush.style() == Qt::SolidPattern ||
          FillBrush.style() == Qt::NoBrush) && m_render && !m_usingHighDPI)
     {
+        FlushBatch();
+        m_statsDraws++;
         m_render->DrawRoundRect(nullptr, Area, CornerRadius, FillBrush,
                                   LinePen, Alpha);
         return;
@@ -320,11 +643,17 @@ void MythOpenGLPainter::DeleteFormatImagePriv(MythImage *Image)
 void MythOpenGLPainter::PushTransformation(const UIEffects &Fx, QPointF Center)
 {
     if (m_render)
+    {
+        FlushBatch();
         m_render->PushTransformation(Fx, Center);
+    }
 }
 
 void MythOpenGLPainter::PopTransformation(void)
 {
     if (m_render)
+    {
+        FlushBatch();
         m_render->PopTransformation();
+    }
 }
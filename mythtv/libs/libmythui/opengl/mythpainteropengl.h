@@ -2,6 +2,8 @@
 #define MYTHPAINTER_OPENGL_H_
 
 // Qt
+#include <QElapsedTimer>
+#include <QHash>
 #include <QMutex>
 #include <QQueue>
 
@@ -11,6 +13,7 @@
 
 // Std
 #include <list>
+#include <vector>
 
 class MythMainWindow;
 class MythGLTexture;
@@ -20,6 +23,33 @@ class QOpenGLFramebufferObject;
 
 #define MAX_BUFFER_POOL 70
 
+/*! \brief A texture that many small images are packed into
+ *
+ * Space is allocated on shelves - rows as tall as the first image placed on
+ * them - and is only reclaimed once every image in the atlas has been released.
+*/
+class MythGLAtlas
+{
+  public:
+    explicit MythGLAtlas(MythGLTexture *Texture) : m_texture(Texture) {}
+    bool  Allocate(QSize Size, QPoint &Position);
+    void  Reset(void);
+    bool  IsUsed(void) const { return !m_shelves.empty(); }
+
+    MythGLTexture *m_texture { nullptr };
+    int   m_liveImages       { 0 };
+    int   m_liveArea         { 0 };
+
+  private:
+    struct Shelf
+    {
+        int m_top    { 0 };
+        int m_height { 0 };
+        int m_width  { 0 };
+    };
+    std::vector<Shelf> m_shelves;
+};
+
 class MUI_PUBLIC MythOpenGLPainter : public MythPainterGPU
 {
     Q_OBJECT
@@ -48,6 +78,12 @@ class MUI_PUBLIC MythOpenGLPainter : public MythPainterGPU
   protected:
     void  ClearCache(void);
     MythGLTexture* GetTextureFromCache(MythImage *Image);
+    MythGLTexture* CreateAtlasEntry(MythImage *Image);
+    bool  AllocateFromAtlas(QSize Size, MythGLAtlas *&Atlas, QPoint &Position);
+    void  DeleteAtlases(void);
+    void  DrawAtlasImage(MythGLTexture *Texture, QRect Dest, QRect Source, int Alpha, qreal Scale);
+    void  FlushBatch(void);
+    void  LogFrameStats(void);
 
     MythImage* GetFormatImagePriv(void) override { return new MythImage(this); }
     void  DeleteFormatImagePriv(MythImage *Image) override;
@@ -64,6 +100,27 @@ class MUI_PUBLIC MythOpenGLPainter : public MythPainterGPU
     std::array<QOpenGLBuffer*,MAX_BUFFER_POOL> m_mappedBufferPool { nullptr };
     size_t                     m_mappedBufferPoolIdx { 0 };
     bool                       m_mappedBufferPoolReady { false };
+
+    struct AtlasEntry
+    {
+        MythGLAtlas *m_atlas { nullptr };
+        QRect        m_rect;
+    };
+    std::vector<MythGLAtlas*>  m_atlases;
+    int                        m_maxAtlases   { 0 };
+    QHash<MythGLTexture*,AtlasEntry> m_atlasEntries;
+    MythGLAtlas*               m_batchAtlas   { nullptr };
+    std::vector<float>         m_batchVertices;
+    QOpenGLBuffer*             m_batchBuffer  { nullptr };
+
+    // Frame statistics, logged with -v gpu
+    QElapsedTimer              m_frameTimer;
+    int64_t                    m_statsTime    { 0 };
+    int                        m_statsFrames  { 0 };
+    int                        m_statsDraws   { 0 };
+    int                        m_statsBatched { 0 };
+    int                        m_statsUploads { 0 };
+    int64_t                    m_statsUploadBytes { 0 };
 };
 
 #endif
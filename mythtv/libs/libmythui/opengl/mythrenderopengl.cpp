@@ -37,6 +37,8 @@ using std::min;
 static const GLuint kVertexOffset  = 0;
 static const GLuint kTextureOffset = 8 * sizeof(GLfloat);
 const GLuint MythRenderOpenGL::kVertexSize = 16 * sizeof(GLfloat);
+// Position, texture coordinate and color
+const GLuint MythRenderOpenGL::kBatchVertexFloats = VERTEX_SIZE + TEXTURE_SIZE + 4;
 
 #define MAX_VERTEX_CACHE 500
 
@@ -652,6 +654,52 @@ MythGLTexture* MythRenderOpenGL::CreateTextureFromQImage(QImage *Image)
     return result;
 }
 
+/*! \brief Create an empty texture for packing many small images into
+ *
+ * Images are added with UpdateTextureFromQImage. The texture has no VBO, it is
+ * drawn with DrawBitmapBatch.
+*/
+MythGLTexture* MythRenderOpenGL::CreateAtlasTexture(QSize Size)
+{
+    OpenGLLocker locker(this);
+    auto *texture = new QOpenGLTexture(QOpenGLTexture::Target2D);
+    texture->setSize(Size.width(), Size.height());
+    texture->setFormat(QOpenGLTexture::RGBA8_UNorm);
+    texture->allocateStorage(QOpenGLTexture::RGBA, QOpenGLTexture::UInt8);
+    if (!texture->textureId() || !texture->isStorageAllocated())
+    {
+        LOG(VB_GENERAL, LOG_INFO, LOC + "Failed to create atlas texture");
+        delete texture;
+        return nullptr;
+    }
+    texture->setMinMagFilters(QOpenGLTexture::Linear, QOpenGLTexture::Linear);
+    texture->setWrapMode(QOpenGLTexture::ClampToEdge);
+    auto *result = new MythGLTexture(texture);
+    result->m_texture     = texture;
+    result->m_pixelFormat = QOpenGLTexture::RGBA;
+    result->m_pixelType   = QOpenGLTexture::UInt8;
+    result->m_bufferSize  = GetBufferSize(Size, QOpenGLTexture::RGBA, QOpenGLTexture::UInt8);
+    result->m_size        = Size;
+    result->m_totalSize   = Size;
+    return result;
+}
+
+/// \brief Upload an image into part of an existing texture
+void MythRenderOpenGL::UpdateTextureFromQImage(MythGLTexture *Texture, QPoint Position,
+                                               const QImage &Image)
+{
+    if (!Texture || !Texture->m_texture || Image.isNull())
+        return;
+
+    // N.B. Format per qopengltexture.cpp, rows are always 4 byte aligned
+    QImage image = Image.convertToFormat(QImage::Format_RGBA8888);
+    makeCurrent();
+    Texture->m_texture->bind();
+    glTexSubImage2D(GL_TEXTURE_2D, 0, Position.x(), Position.y(), image.width(),
+                    image.height(), GL_RGBA, GL_UNSIGNED_BYTE, image.constBits());
+    doneCurrent();
+}
+
 QSize MythRenderOpenGL::GetTextureSize(const QSize Size, bool Normalised)
 {
     if (((m_features & NPOTTextures) != 0U) || !Normalised)
@@ -862,6 +910,49 @@ void MythRenderOpenGL::DrawBitmap(MythGLTexture *Texture, QOpenGLFramebufferObje
     doneCurrent();
 }
 
+/*! \brief Draw many quads from one texture with a single draw call
+ *
+ * Vertices hold kBatchVertexFloats values each - position, texture coordinate
+ * and color - with two triangles (6 vertices) per quad.
+*/
+void MythRenderOpenGL::DrawBitmapBatch(MythGLTexture *Texture, QOpenGLFramebufferObject *Target,
+                                       QOpenGLBuffer *Buffer, const std::vector<GLfloat> &Vertices)
+{
+    if (!Texture || !Texture->m_texture || !Buffer || Vertices.empty())
+        return;
+
+    makeCurrent();
+
+    QOpenGLShaderProgram *program = m_defaultPrograms[kShaderDefault];
+    BindFramebuffer(Target);
+    SetShaderProjection(program);
+
+    program->setUniformValue("s_texture0", 0);
+    ActiveTexture(GL_TEXTURE0);
+    Texture->m_texture->bind();
+
+    // Reallocating the buffer each time avoids waiting on the previous batch
+    Buffer->bind();
+    Buffer->allocate(Vertices.data(), static_cast<int>(Vertices.size() * sizeof(GLfloat)));
+
+    const GLsizei stride = kBatchVertexFloats * sizeof(GLfloat);
+    glEnableVertexAttribArray(VERTEX_INDEX);
+    glEnableVertexAttribArray(TEXTURE_INDEX);
+    glEnableVertexAttribArray(COLOR_INDEX);
+    glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, stride, 0);
+    glVertexAttribPointerI(TEXTURE_INDEX, TEXTURE_SIZE, GL_FLOAT, GL_FALSE, stride,
+                           VERTEX_SIZE * sizeof(GLfloat));
+    glVertexAttribPointerI(COLOR_INDEX, 4, GL_FLOAT, GL_FALSE, stride,
+                           (VERTEX_SIZE + TEXTURE_SIZE) * sizeof(GLfloat));
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(Vertices.size() / kBatchVertexFloats));
+    // The other draw calls use a constant color
+    glDisableVertexAttribArray(COLOR_INDEX);
+    glDisableVertexAttribArray(TEXTURE_INDEX);
+    glDisableVertexAttribArray(VERTEX_INDEX);
+    QOpenGLBuffer::release(QOpenGLBuffer::VertexBuffer);
+    doneCurrent();
+}
+
 void MythRenderOpenGL::DrawBitmap(std::vector<MythGLTexture *> &Textures,
                                   QOpenGLFramebufferObject *Target,
                                   const QRect Source, const QRect Destination,
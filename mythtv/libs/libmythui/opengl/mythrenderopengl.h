@@ -130,9 +130,12 @@ class MUI_PUBLIC MythRenderOpenGL : public QOpenGLContext, public QOpenGLFunctio
     uint64_t GetSwapCount();
 
     static const GLuint kVertexSize;
+    static const GLuint kBatchVertexFloats;
     QOpenGLBuffer* CreateVBO(int Size, bool Release = true);
 
     MythGLTexture* CreateTextureFromQImage(QImage *Image);
+    MythGLTexture* CreateAtlasTexture(QSize Size);
+    void  UpdateTextureFromQImage(MythGLTexture *Texture, QPoint Position, const QImage &Image);
     QSize GetTextureSize(QSize Size, bool Normalised);
     static int GetTextureDataSize(MythGLTexture *Texture);
     void  SetTextureFilters(MythGLTexture *Texture, QOpenGLTexture::Filter Filter,
@@ -161,6 +164,8 @@ class MUI_PUBLIC MythRenderOpenGL : public QOpenGLContext, public QOpenGLFunctio
                      QOpenGLFramebufferObject *Target,
                      QRect Source, QRect Destination,
                      QOpenGLShaderProgram *Program, int Rotation);
+    void  DrawBitmapBatch(MythGLTexture *Texture, QOpenGLFramebufferObject *Target,
+                          QOpenGLBuffer *Buffer, const std::vector<GLfloat> &Vertices);
     void  DrawRect(QOpenGLFramebufferObject *Target,
                    QRect Area, const QBrush &FillBrush,
                    const QPen &LinePen, int Alpha);
@@ -6,8 +6,16 @@
 #include <typeinfo>
 
 // QT headers
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QDomDocument>
+#include <QHash>
+#include <QMutex>
+#include <QSaveFile>
 #include <QString>
 #include <QBrush>
 #include <QLinearGradient>
@@ -17,6 +25,7 @@
 #include "mythconfig.h"
 
 // libmyth headers
+#include "mythdirs.h"
 #include "mythlogging.h"
 
 // Mythui headers
@@ -348,6 +357,248 @@ QString XMLParseBase::parseText(QDomElement &element)
 static MythUIType *globalObjectStore = nullptr;
 static QStringList loadedBaseFiles;
 
+// Theme files are kept parsed, as screens are opened again and again and
+// several screens share a file. The parsed files are also saved to the cache
+// dir, so that later runs rebuild them without parsing the XML. Elements
+// rebuilt from the cache have no line numbers, but a theme file that has been
+// edited is always parsed again.
+struct ParsedThemeFile
+{
+    QDateTime    m_modified;
+    qint64       m_size     { 0 };
+    QDomDocument m_doc;
+};
+static QMutex                          themeDocumentsLock;
+static QHash<QString, ParsedThemeFile> themeDocuments;
+
+static constexpr quint32 kThemeCacheMagic   { 0x4D545843 }; // "MTXC"
+static constexpr quint32 kThemeCacheVersion { 1 };
+
+enum ThemeCacheNode : quint8
+{
+    kThemeCacheEnd = 0,
+    kThemeCacheElement,
+    kThemeCacheText,
+    kThemeCacheCDATA,
+    kThemeCacheComment,
+};
+
+static QString ThemeCacheFile(const QString &filename)
+{
+    QByteArray hash = QCryptographicHash::hash(filename.toUtf8(),
+                                               QCryptographicHash::Md5);
+    return QString("%1/themexml/%2.bin")
+        .arg(GetCacheDir(), QString::fromLatin1(hash.toHex()));
+}
+
+/// Writes the children of a node, ending with kThemeCacheEnd
+static void WriteThemeNodes(QDataStream &stream, const QDomNode &parent)
+{
+    for (QDomNode n = parent.firstChild(); !n.isNull(); n = n.nextSibling())
+    {
+        if (n.isElement())
+        {
+            QDomElement element = n.toElement();
+            QDomNamedNodeMap attributes = element.attributes();
+            stream << quint8(kThemeCacheElement) << element.tagName()
+                   << quint32(attributes.count());
+            for (int i = 0; i < attributes.count(); ++i)
+            {
+                QDomAttr attribute = attributes.item(i).toAttr();
+                stream << attribute.name() << attribute.value();
+            }
+            WriteThemeNodes(stream, n);
+        }
+        else if (n.isCDATASection())
+        {
+            stream << quint8(kThemeCacheCDATA) << n.toCDATASection().data();
+        }
+        else if (n.isText())
+        {
+            stream << quint8(kThemeCacheText) << n.toText().data();
+        }
+        else if (n.isComment())
+        {
+            stream << quint8(kThemeCacheComment) << n.toComment().data();
+        }
+    }
+    stream << quint8(kThemeCacheEnd);
+}
+
+/// Reads the children of a node written by WriteThemeNodes()
+static bool ReadThemeNodes(QDataStream &stream, QDomDocument &doc,
+                           QDomNode parent)
+{
+    while (true)
+    {
+        quint8 type = kThemeCacheEnd;
+        stream >> type;
+        if (stream.status() != QDataStream::Ok)
+            return false;
+        if (type == kThemeCacheEnd)
+            return true;
+
+        QString data;
+        stream >> data;
+        if (type == kThemeCacheElement)
+        {
+            QDomElement element = doc.createElement(data);
+            quint32 count = 0;
+            stream >> count;
+            for (quint32 i = 0; i < count; ++i)
+            {
+                QString name;
+                QString value;
+                stream >> name >> value;
+                element.setAttribute(name, value);
+            }
+            parent.appendChild(element);
+            if (!ReadThemeNodes(stream, doc, element))
+                return false;
+        }
+        else if (type == kThemeCacheText)
+        {
+            parent.appendChild(doc.createTextNode(data));
+        }
+        else if (type == kThemeCacheCDATA)
+        {
+            parent.appendChild(doc.createCDATASection(data));
+        }
+        else if (type == kThemeCacheComment)
+        {
+            parent.appendChild(doc.createComment(data));
+        }
+        else
+        {
+            return false;
+        }
+    }
+}
+
+/*!
+ \brief Rebuilds a theme file from the cache dir
+ \return bool False if there is no cached copy of this version of the file
+*/
+static bool LoadCachedThemeDocument(const QString &filename,
+                                    const QFileInfo &fi, QDomDocument &doc)
+{
+    QFile f(ThemeCacheFile(filename));
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&f);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString source;
+    qint64  modified = 0;
+    qint64  size = 0;
+    stream >> magic >> version >> source >> modified >> size;
+    if (stream.status() != QDataStream::Ok || magic != kThemeCacheMagic ||
+        version != kThemeCacheVersion || source != filename ||
+        modified != fi.lastModified().toMSecsSinceEpoch() || size != fi.size())
+    {
+        return false;
+    }
+
+    doc = QDomDocument();
+    if (!ReadThemeNodes(stream, doc, doc) || doc.documentElement().isNull())
+    {
+        LOG(VB_GUI, LOG_WARNING, LOC +
+            QString("Ignoring damaged cache of theme file %1").arg(filename));
+        doc = QDomDocument();
+        return false;
+    }
+    return true;
+}
+
+/// \brief Saves a parsed theme file to the cache dir
+static void SaveCachedThemeDocument(const QString &filename,
+                                    const QFileInfo &fi, const QDomDocument &doc)
+{
+    QString cachefile = ThemeCacheFile(filename);
+    QDir().mkpath(QFileInfo(cachefile).path());
+
+    QSaveFile f(cachefile);
+    if (!f.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream stream(&f);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << kThemeCacheMagic << kThemeCacheVersion << filename
+           << qint64(fi.lastModified().toMSecsSinceEpoch()) << qint64(fi.size());
+    WriteThemeNodes(stream, doc);
+
+    if (stream.status() != QDataStream::Ok || !f.commit())
+    {
+        LOG(VB_GUI, LOG_WARNING, LOC +
+            QString("Failed to cache theme file %1").arg(filename));
+    }
+}
+
+/*!
+ \brief Gets the parsed contents of a theme file
+ \details The file is only reparsed when its modification time or size has
+ changed since it was last parsed, in this run or, through the cache dir,
+ in an earlier one.
+ \param filename Theme file
+ \param[out] doc The parsed file
+ \return bool False if the file does not exist or is not valid XML
+*/
+static bool LoadThemeDocument(const QString &filename, QDomDocument &doc)
+{
+    QFileInfo fi(filename);
+    if (!fi.exists())
+        return false;
+
+    QMutexLocker locker(&themeDocumentsLock);
+
+    auto it = themeDocuments.constFind(filename);
+    if (it != themeDocuments.constEnd() &&
+        it->m_modified == fi.lastModified() && it->m_size == fi.size())
+    {
+        doc = it->m_doc;
+        return true;
+    }
+
+    if (LoadCachedThemeDocument(filename, fi, doc))
+    {
+        LOG(VB_GUI, LOG_DEBUG, LOC +
+            QString("Loaded cached theme file %1").arg(filename));
+        themeDocuments.insert(filename, { fi.lastModified(), fi.size(), doc });
+        return true;
+    }
+
+    QFile f(filename);
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+
+    QString errorMsg;
+    int errorLine = 0;
+    int errorColumn = 0;
+
+    doc = QDomDocument();
+    if (!doc.setContent(&f, false, &errorMsg, &errorLine, &errorColumn))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Location: '%1' @ %2 column: %3"
+                    "\n\t\t\tError: %4")
+                .arg(qPrintable(filename)).arg(errorLine).arg(errorColumn)
+                .arg(qPrintable(errorMsg)));
+        f.close();
+        themeDocuments.remove(filename);
+        return false;
+    }
+
+    f.close();
+
+    LOG(VB_GUI, LOG_DEBUG, LOC + QString("Parsed theme file %1").arg(filename));
+    themeDocuments.insert(filename, { fi.lastModified(), fi.size(), doc });
+    SaveCachedThemeDocument(filename, fi, doc);
+    return true;
+}
+
 MythUIType *XMLParseBase::GetGlobalObjectStore(void)
 {
     if (!globalObjectStore)
@@ -363,6 +614,10 @@ void XMLParseBase::ClearGlobalObjectStore(void)
 
     // clear any loaded base xml files which will force a reload the next time they are used
     loadedBaseFiles.clear();
+
+    // and drop the parsed files of the old theme
+    QMutexLocker locker(&themeDocumentsLock);
+    themeDocuments.clear();
 }
 
 void XMLParseBase::ParseChildren(const QString &filename,
@@ -645,28 +900,9 @@ bool XMLParseBase::WindowExists(const QString &xmlfile,
     for (const auto & dir : qAsConst(searchpath))
     {
         QString themefile = dir + xmlfile;
-        QFile f(themefile);
-
-        if (!f.open(QIODevice::ReadOnly))
-            continue;
-
         QDomDocument doc;
-        QString errorMsg;
-        int errorLine = 0;
-        int errorColumn = 0;
-
-        if (!doc.setContent(&f, false, &errorMsg, &errorLine, &errorColumn))
-        {
-            LOG(VB_GENERAL, LOG_ERR, LOC +
-                QString("Location: '%1' @ %2 column: %3"
-                        "\n\t\t\tError: %4")
-                    .arg(qPrintable(themefile)).arg(errorLine).arg(errorColumn)
-                    .arg(qPrintable(errorMsg)));
-            f.close();
+        if (!LoadThemeDocument(themefile, doc))
             continue;
-        }
-
-        f.close();
 
         QDomElement docElem = doc.documentElement();
         QDomNode n = docElem.firstChild();
@@ -723,27 +959,8 @@ bool XMLParseBase::doLoad(const QString &windowname,
                           bool showWarnings)
 {
     QDomDocument doc;
-    QFile f(filename);
-
-    if (!f.open(QIODevice::ReadOnly))
-        return false;
-
-    QString errorMsg;
-    int errorLine = 0;
-    int errorColumn = 0;
-
-    if (!doc.setContent(&f, false, &errorMsg, &errorLine, &errorColumn))
-    {
-        LOG(VB_GENERAL, LOG_ERR, LOC +
-            QString("Location: '%1' @ %2 column: %3"
-                    "\n\t\t\tError: %4")
-                .arg(qPrintable(filename)).arg(errorLine).arg(errorColumn)
-                .arg(qPrintable(errorMsg)));
-        f.close();
+    if (!LoadThemeDocument(filename, doc))
         return false;
-    }
-
-    f.close();
 
     QDomElement docElem = doc.documentElement();
     QDomNode n = docElem.firstChild();
@@ -681,6 +681,41 @@ void EncoderLink::CancelNextRecording(bool cancel)
     }
 }
 
+/**
+ *  \brief Tells an idle TVRec to tune ahead of a likely LiveTV channel change.
+ *  \return true if the input accepted the channel
+ *  \sa TVRec::QueuePreTune(const QString&)
+ */
+bool EncoderLink::PreTune(const QString &channum)
+{
+    if (m_local)
+        return m_tv->QueuePreTune(channum);
+
+    if (HasSockAndIncrRef())
+    {
+        ReferenceLocker rlocker(m_sock);
+        return m_sock->PreTune(m_inputid, channum);
+    }
+
+    return false;
+}
+
+/**
+ *  \brief Tells TVRec to close a channel tuned by PreTune(), and waits
+ *         until it is closed.
+ *  \sa TVRec::ReleasePreTune()
+ */
+void EncoderLink::ReleasePreTune(void)
+{
+    if (m_local)
+        m_tv->ReleasePreTune();
+    else if (HasSockAndIncrRef())
+    {
+        ReferenceLocker rlocker(m_sock);
+        m_sock->ReleasePreTune(m_inputid);
+    }
+}
+
 /** \fn EncoderLink::SpawnLiveTV(LiveTVChain*, bool, QString)
  *  \brief Tells TVRec to Spawn a "Live TV" recorder.
  *         <b>This only works on local recorders.</b>
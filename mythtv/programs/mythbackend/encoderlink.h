@@ -101,6 +101,8 @@ class EncoderLink
     void FrontendReady(void);
     void CancelNextRecording(bool cancel);
     bool WouldConflict(const ProgramInfo *rec);
+    bool PreTune(const QString &channum);
+    void ReleasePreTune(void);
 
     bool IsReallyRecording(void);
     ProgramInfo *GetRecording(void);
@@ -0,0 +1,67 @@
+// Qt headers
+#include <QRegularExpression>
+
+// MythTV headers
+#include "hlsserver.h"
+#include "HLS/hlssegmenter.h"
+#include "mythlogging.h"
+
+#define LOC QString("HLSServer: ")
+
+HLSServer::HLSServer() : HttpServerExtension("HLSServer", QString())
+{
+    m_nSupportedMethods = (RequestTypeGet | RequestTypeHead);
+}
+
+QStringList HLSServer::GetBasePaths()
+{
+    return QStringList("/HLS");
+}
+
+bool HLSServer::ProcessRequest(HTTPRequest *pRequest)
+{
+    if (!pRequest || pRequest->m_sBaseUrl != "/HLS")
+        return false;
+
+    static const QRegularExpression kPlaylistRE { R"(^(\d+)\.m3u8$)" };
+    static const QRegularExpression kSegmentRE { R"(^(\d+)_(\d+)\.ts$)" };
+
+    QRegularExpressionMatch playlist = kPlaylistRE.match(pRequest->m_sMethod);
+    QRegularExpressionMatch segment = kSegmentRE.match(pRequest->m_sMethod);
+
+    if (!playlist.hasMatch() && !segment.hasMatch())
+        return false;
+
+    int streamid = (playlist.hasMatch() ? playlist : segment)
+        .captured(1).toInt();
+    auto segmenter = HLSSegmenter::Get(streamid);
+
+    QByteArray data;
+    if (segmenter && playlist.hasMatch())
+    {
+        data = segmenter->GetPlaylist();
+        pRequest->m_sResponseTypeText = "application/x-mpegurl";
+        pRequest->m_mapRespHeaders[ "Cache-Control" ] =
+            "no-cache=\"Ext\", max-age = 0";
+    }
+    else if (segmenter)
+    {
+        data = segmenter->GetSegment(segment.captured(2).toUInt());
+        pRequest->m_sResponseTypeText = "video/mp2t";
+    }
+
+    if (data.isEmpty())
+    {
+        LOG(VB_UPNP, LOG_ERR, LOC +
+            QString("Unable to serve %1").arg(pRequest->m_sMethod));
+        pRequest->m_eResponseType   = ResponseTypeHTML;
+        pRequest->m_nResponseStatus = 404;
+        pRequest->m_response.write( pRequest->GetResponsePage() );
+        return true;
+    }
+
+    pRequest->m_eResponseType = ResponseTypeOther;
+    pRequest->m_response.write(data);
+
+    return true;
+}
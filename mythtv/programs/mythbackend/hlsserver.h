@@ -0,0 +1,25 @@
+// -*- Mode: c++ -*-
+
+#ifndef HLSSERVER_H
+#define HLSSERVER_H
+
+#include "httpserver.h"
+
+/**
+ * \brief Serves the playlists and segments of transmuxed HTTP Live Streams
+ *
+ * Handles /HLS/<streamid>.m3u8 and /HLS/<streamid>_<segment>.ts, the
+ * segments come from the stream's HLSSegmenter rather than from disk.
+ */
+class HLSServer : public HttpServerExtension
+{
+  public:
+    HLSServer();
+    ~HLSServer() override = default;
+
+    QStringList GetBasePaths() override; // HttpServerExtension
+
+    bool ProcessRequest(HTTPRequest *pRequest) override; // HttpServerExtension
+};
+
+#endif // HLSSERVER_H
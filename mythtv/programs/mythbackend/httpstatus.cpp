@@ -37,6 +37,7 @@
 #include "scheduler.h"
 #include "mainserver.h"
 #include "cardutil.h"
+#include "channelchangetrace.h"
 #include "mythmiscutil.h"
 #include "mythsystemlegacy.h"
 #include "exitcodes.h"
@@ -564,6 +565,38 @@ void HttpStatus::FillStatusXML( QDomDocument *pDoc )
         guide.setAttribute("guideDays", qdtNow.daysTo(GuideDataThrough));
     }
 
+    // Add channel change latencies
+
+    QList<ChannelChangeTrace::PhaseStats> phases = ChannelChangeTrace::GetStats();
+    if (!phases.isEmpty())
+    {
+        QDomElement changes = pDoc->createElement("ChannelChanges");
+        root.appendChild(changes);
+
+        for (const auto & stats : qAsConst(phases))
+        {
+            QDomElement phase = pDoc->createElement("Phase");
+            changes.appendChild(phase);
+            phase.setAttribute("name" , stats.m_name);
+            phase.setAttribute("count", stats.m_count);
+            phase.setAttribute("mean" , static_cast<qlonglong>(
+                                   stats.m_total.count() / stats.m_count));
+            phase.setAttribute("max"  , static_cast<qlonglong>(stats.m_max.count()));
+
+            for (size_t i = 0; i < stats.m_buckets.size(); i++)
+            {
+                QDomElement bucket = pDoc->createElement("Bucket");
+                phase.appendChild(bucket);
+                if (i < ChannelChangeTrace::kBucketLimits.size())
+                {
+                    bucket.setAttribute("max", static_cast<qlonglong>(
+                                            ChannelChangeTrace::kBucketLimits[i].count()));
+                }
+                bucket.setAttribute("count", stats.m_buckets[i]);
+            }
+        }
+    }
+
     // Add Miscellaneous information
 
     QString info_script = gCoreContext->GetSetting("MiscStatusScript");
@@ -699,6 +732,13 @@ void HttpStatus::PrintStatus( QTextStream &os, QDomDocument *pDoc )
     if (!node.isNull())
         PrintMachineInfo( os, node.toElement());
 
+    // Channel change latencies ----------------
+
+    node = docElem.namedItem( "ChannelChanges" );
+
+    if (!node.isNull())
+        PrintChannelChanges( os, node.toElement());
+
     // Miscellaneous information ---------------
 
     node = docElem.namedItem( "Miscellaneous" );
@@ -1455,6 +1495,55 @@ int HttpStatus::PrintMachineInfo( QTextStream &os, const QDomElement& info )
     return( 1 );
 }
 
+int HttpStatus::PrintChannelChanges( QTextStream &os, const QDomElement& changes )
+{
+    QDomNodeList phases = changes.elementsByTagName("Phase");
+    int nNumPhases = phases.count();
+    if (nNumPhases < 1)
+        return( 0 );
+
+    os << "  <div class=\"content\">\r\n"
+       << "    <h2 class=\"status\">Channel Change Latency</h2>\r\n"
+       << "    <table>\r\n"
+       << "      <tr><th>Phase</th><th>Count</th><th>Mean</th><th>Max</th>";
+
+    // Header from the bucket limits of the first phase
+    QDomNodeList buckets = phases.item(0).toElement().elementsByTagName("Bucket");
+    for (int i = 0; i < buckets.count(); i++)
+    {
+        QString max = buckets.item(i).toElement().attribute("max");
+        os << "<th>" << (max.isEmpty() ? QString("longer") : "&le; " + max + " ms")
+           << "</th>";
+    }
+    os << "</tr>\r\n";
+
+    for (int i = 0; i < nNumPhases; i++)
+    {
+        QDomElement e = phases.item(i).toElement();
+        if (e.isNull())
+            continue;
+
+        os << "      <tr><td>" << e.attribute("name") << "</td>"
+           << "<td>" << e.attribute("count") << "</td>"
+           << "<td>" << e.attribute("mean") << " ms</td>"
+           << "<td>" << e.attribute("max") << " ms</td>";
+
+        buckets = e.elementsByTagName("Bucket");
+        for (int j = 0; j < buckets.count(); j++)
+            os << "<td>" << buckets.item(j).toElement().attribute("count") << "</td>";
+        os << "</tr>\r\n";
+    }
+
+    os << "    </table>\r\n"
+       << "  </div>\r\n\r\n";
+
+    return nNumPhases;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 int HttpStatus::PrintMiscellaneousInfo( QTextStream &os, const QDomElement& info )
 {
     if (info.isNull())
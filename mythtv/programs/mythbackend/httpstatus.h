@@ -67,6 +67,7 @@ class HttpStatus : public HttpServerExtension
         static int     PrintBackends     ( QTextStream &os, const QDomElement& backends );
         static int     PrintJobQueue     ( QTextStream &os, const QDomElement& jobs );
         static int     PrintMachineInfo  ( QTextStream &os, const QDomElement& info );
+        static int     PrintChannelChanges( QTextStream &os, const QDomElement& changes );
         static int     PrintMiscellaneousInfo ( QTextStream &os, const QDomElement& info );
 
         static void    FillProgramInfo   ( QDomDocument *pDoc,
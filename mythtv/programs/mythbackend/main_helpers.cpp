@@ -55,6 +55,8 @@
 #include "signalhandling.h"
 #include "hardwareprofile.h"
 #include "eitcache.h"
+#include "mediawatcher.h"
+#include "imagemanager.h"
 
 #include "mediaserver.h"
 #include "httpstatus.h"
@@ -65,6 +67,7 @@
 #define LOC_ERR  QString("MythBackend, Error: ")
 
 static MainServer *mainServer = nullptr;
+static QList<MediaWatcher *> mediaWatchers;
 
 bool setupTVs(bool ismaster, bool &error)
 {
@@ -255,6 +258,9 @@ void cleanup(void)
     delete sysEventHandler;
     sysEventHandler = nullptr;
 
+    while (!mediaWatchers.isEmpty())
+        delete mediaWatchers.takeFirst();
+
     delete housekeeping;
     housekeeping = nullptr;
 
@@ -749,6 +755,19 @@ int run_backend(MythBackendCommandLineParser &cmdline)
     be_sd_notify("STATUS=Check all storage groups");
     StorageGroup::CheckAllStorageGroupDirs();
 
+    // Journal changes to the media libraries scanned on this host so that
+    // rescans only need to visit the changed directories
+    if (gCoreContext->GetBoolSetting("MediaLibraryWatcher", true))
+    {
+        QString host = gCoreContext->GetHostName();
+        QStringList musicDirs;
+        if (StorageGroup::FindDirs("Music", host, &musicDirs))
+            mediaWatchers << new MediaWatcher("Music", musicDirs);
+        QStringList imageDirs = StorageGroup(IMAGE_STORAGE_GROUP, host, false).GetDirList();
+        if (!imageDirs.isEmpty())
+            mediaWatchers << new MediaWatcher("Gallery", imageDirs);
+    }
+
     be_sd_notify("STATUS=Sending \"master started\" message");
     if (gCoreContext->IsMasterBackend())
         gCoreContext->SendSystemEvent("MASTER_STARTED");
@@ -78,6 +78,8 @@
 #include "musicmetadata.h"
 #include "imagemanager.h"
 #include "cardutil.h"
+#include "channelutil.h"
+#include "channelchangetrace.h"
 #include "tv_rec.h"
 
 // mythbackend headers
@@ -542,6 +544,13 @@ void MainServer::ProcessRequestWork(MythSocket *sock)
         else
             HandleQueryRecordings(tokens[1], pbs);
     }
+    else if (command == "QUERY_RECORDING_CHANGES")
+    {
+        if (tokens.size() != 3)
+            SendErrorResponse(pbs, "Bad QUERY_RECORDING_CHANGES query");
+        else
+            HandleQueryRecordingChanges(tokens[1], tokens[2].toULongLong(), pbs);
+    }
     else if (command == "QUERY_RECORDING")
     {
         HandleQueryRecording(tokens, pbs);
@@ -1505,6 +1514,12 @@ void MainServer::customEvent(QEvent *e)
         if (me->Message().startsWith("LOCAL_"))
             return;
 
+        if (me->Message() == "CHANNEL_CHANGE_TRACE")
+        {
+            ChannelChangeTrace::AddSamples(me->ExtraDataList());
+            return;
+        }
+
         if (me->Message() == "CREATE_THUMBNAILS")
             ImageManagerBe::getInstance()->HandleCreateThumbnails(me->ExtraDataList());
 
@@ -1570,6 +1585,8 @@ void MainServer::customEvent(QEvent *e)
                 broadcast.push_back(me->Message());
                 broadcast += me->ExtraDataList();
             }
+
+            m_recordingCatalog.HandleEvent(broadcast[1], broadcast.mid(2));
         }
     }
 
@@ -1667,9 +1684,10 @@ void MainServer::customEvent(QEvent *e)
 
 /**
  * \addtogroup myth_network_protocol
- * \par        MYTH_PROTO_VERSION \e version \e token
+ * \par        MYTH_PROTO_VERSION \e version \e token [\e capability ...]
  * Checks that \e version and \e token match the backend's version.
- * If it matches, the stringlist of "ACCEPT" \e "version" is returned.
+ * If it matches, the stringlist of "ACCEPT" \e "version" is returned,
+ * followed by the optional capabilities enabled for this connection.
  * If it does not, "REJECT" \e "version" is returned,
  * and the socket is closed (for this client)
  */
@@ -1712,7 +1730,12 @@ void MainServer::HandleVersion(MythSocket *socket, const QStringList &slist)
         return;
     }
 
-    retlist << "ACCEPT" << MYTH_PROTO_VERSION;
+    QStringList capabilities;
+    if (slist.mid(3).contains(MYTH_PROTO_BINARY_PROGINFO))
+        capabilities << MYTH_PROTO_BINARY_PROGINFO;
+    socket->SetCapabilities(capabilities);
+
+    retlist << "ACCEPT" << MYTH_PROTO_VERSION << capabilities;
     socket->WriteStringList(retlist);
 }
 
@@ -2159,7 +2182,8 @@ void MainServer::SendResponse(MythSocket *socket, QStringList &commands)
  * The \e type parameter can be either "Recording", "Unsorted", "Ascending",
  * or "Descending".
  * Returns programinfo (title, subtitle, description, category, chanid,
- * channum, callsign, channel.name, fileURL, \e et \e cetera)
+ * channum, callsign, channel.name, fileURL, \e et \e cetera), in binary
+ * records if the connection enabled MYTH_PROTO_BINARY_PROGINFO.
  */
 void MainServer::HandleQueryRecordings(const QString& type, PlaybackSock *pbs)
 {
@@ -2193,93 +2217,202 @@ void MainServer::HandleQueryRecordings(const QString& type, PlaybackSock *pbs)
 
     QStringList outputlist(QString::number(destination.size()));
     QMap<QString, int> backendPortMap;
-    int port = gCoreContext->GetBackendServerPort();
-    QString host = gCoreContext->GetHostName();
+    bool binary = pbssock->HasCapability(MYTH_PROTO_BINARY_PROGINFO);
+    QByteArray records;
 
     for (auto* proginfo : destination)
     {
-        PlaybackSock *slave = nullptr;
+        FillRecordingPathname(proginfo, playbackhost, backendPortMap);
+        if (binary)
+            proginfo->ToBinary(records);
+        else
+            proginfo->ToStringList(outputlist);
+    }
+
+    if (binary)
+        outputlist << MYTH_PROTO_BINARY_PROGINFO
+                   << QString::fromLatin1(records.toBase64());
+
+    SendResponse(pbssock, outputlist);
+}
+
+/**
+ * \brief Sets the URL and file size that a client plays a recording with
+ * \param backendPortMap Cache of the backend ports, shared by the calls
+ *                       for one reply
+ */
+void MainServer::FillRecordingPathname(ProgramInfo *proginfo,
+                                       const QString &playbackhost,
+                                       QMap<QString, int> &backendPortMap)
+{
+    int port = gCoreContext->GetBackendServerPort();
+    QString host = gCoreContext->GetHostName();
+
+    PlaybackSock *slave = nullptr;
 
-        if (proginfo->GetHostname() != gCoreContext->GetHostName())
-            slave = GetSlaveByHostname(proginfo->GetHostname());
+    if (proginfo->GetHostname() != gCoreContext->GetHostName())
+        slave = GetSlaveByHostname(proginfo->GetHostname());
 
-        if ((proginfo->GetHostname() == gCoreContext->GetHostName()) ||
-            (!slave && m_masterBackendOverride))
+    if ((proginfo->GetHostname() == gCoreContext->GetHostName()) ||
+        (!slave && m_masterBackendOverride))
+    {
+        proginfo->SetPathname(MythCoreContext::GenMythURL(host,port,
+                                                          proginfo->GetBasename()));
+        if (!proginfo->GetFilesize())
         {
-            proginfo->SetPathname(MythCoreContext::GenMythURL(host,port,
-                                                              proginfo->GetBasename()));
-            if (!proginfo->GetFilesize())
+            QString tmpURL = GetPlaybackURL(proginfo);
+            if (tmpURL.startsWith('/'))
             {
-                QString tmpURL = GetPlaybackURL(proginfo);
-                if (tmpURL.startsWith('/'))
+                QFile checkFile(tmpURL);
+                if (!tmpURL.isEmpty() && checkFile.exists())
                 {
-                    QFile checkFile(tmpURL);
-                    if (!tmpURL.isEmpty() && checkFile.exists())
+                    proginfo->SetFilesize(checkFile.size());
+                    if (proginfo->GetRecordingEndTime() <
+                        MythDate::current())
                     {
-                        proginfo->SetFilesize(checkFile.size());
-                        if (proginfo->GetRecordingEndTime() <
-                            MythDate::current())
-                        {
-                            proginfo->SaveFilesize(proginfo->GetFilesize());
-                        }
+                        proginfo->SaveFilesize(proginfo->GetFilesize());
                     }
                 }
             }
         }
-        else if (!slave)
+    }
+    else if (!slave)
+    {
+        proginfo->SetPathname(GetPlaybackURL(proginfo));
+        if (proginfo->GetPathname().isEmpty())
         {
-            proginfo->SetPathname(GetPlaybackURL(proginfo));
-            if (proginfo->GetPathname().isEmpty())
-            {
-                LOG(VB_GENERAL, LOG_ERR, LOC +
-                    QString("HandleQueryRecordings() "
-                            "Couldn't find backend for:\n\t\t\t%1")
-                        .arg(proginfo->toString(ProgramInfo::kTitleSubtitle)));
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("FillRecordingPathname() "
+                        "Couldn't find backend for:\n\t\t\t%1")
+                    .arg(proginfo->toString(ProgramInfo::kTitleSubtitle)));
 
-                proginfo->SetFilesize(0);
-                proginfo->SetPathname("file not found");
-            }
+            proginfo->SetFilesize(0);
+            proginfo->SetPathname("file not found");
         }
-        else
+    }
+    else
+    {
+        if (!proginfo->GetFilesize())
         {
-            if (!proginfo->GetFilesize())
+            if (!slave->FillProgramInfo(*proginfo, playbackhost))
             {
-                if (!slave->FillProgramInfo(*proginfo, playbackhost))
-                {
-                    LOG(VB_GENERAL, LOG_ERR, LOC +
-                        "MainServer::HandleQueryRecordings()"
-                        "\n\t\t\tCould not fill program info "
-                        "from backend");
-                }
-                else
-                {
-                    if (proginfo->GetRecordingEndTime() <
-                        MythDate::current())
-                    {
-                        proginfo->SaveFilesize(proginfo->GetFilesize());
-                    }
-                }
+                LOG(VB_GENERAL, LOG_ERR, LOC +
+                    "MainServer::FillRecordingPathname()"
+                    "\n\t\t\tCould not fill program info "
+                    "from backend");
             }
             else
             {
-                ProgramInfo *p      = proginfo;
-                QString hostname    = p->GetHostname();
+                if (proginfo->GetRecordingEndTime() <
+                    MythDate::current())
+                {
+                    proginfo->SaveFilesize(proginfo->GetFilesize());
+                }
+            }
+        }
+        else
+        {
+            ProgramInfo *p      = proginfo;
+            QString hostname    = p->GetHostname();
 
-                if (!backendPortMap.contains(hostname))
-                    backendPortMap[hostname] = gCoreContext->GetBackendServerPort(hostname);
+            if (!backendPortMap.contains(hostname))
+                backendPortMap[hostname] = gCoreContext->GetBackendServerPort(hostname);
 
-                p->SetPathname(MythCoreContext::GenMythURL(hostname,
-                                                           backendPortMap[hostname],
-                                                           p->GetBasename()));
-            }
+            p->SetPathname(MythCoreContext::GenMythURL(hostname,
+                                                       backendPortMap[hostname],
+                                                       p->GetBasename()));
         }
+    }
 
-        if (slave)
-            slave->DecrRef();
+    if (slave)
+        slave->DecrRef();
+}
+
+/**
+ * \addtogroup myth_network_protocol
+ * \par        QUERY_RECORDING_CHANGES \e generation \e version
+ * Returns the generation and version of the backend's list of recordings,
+ * followed by "RESET" when the client has to reload the list with
+ * QUERY_RECORDINGS, or by "DELTA", the number of recordings deleted since
+ * \e version, their recordedids, the number of recordings added or updated
+ * since \e version and their programinfos.
+ */
+void MainServer::HandleQueryRecordingChanges(const QString &generation,
+                                             uint64_t version,
+                                             PlaybackSock *pbs)
+{
+    MythSocket *pbssock = pbs->getSocket();
+    QString playbackhost = pbs->getHostname();
+
+    // The version is read before the changes, so a change made in between
+    // is sent again on the next query rather than missed
+    QStringList outputlist(m_recordingCatalog.GetGeneration());
+    outputlist << QString::number(m_recordingCatalog.GetVersion());
 
-        proginfo->ToStringList(outputlist);
+    QList<uint> changed;
+    QList<uint> deleted;
+    if (!m_recordingCatalog.GetChanges(generation, version, changed, deleted))
+    {
+        outputlist << "RESET";
+        SendResponse(pbssock, outputlist);
+        return;
+    }
+
+    QStringList programs;
+    QMap<QString, int> backendPortMap;
+    bool binary = pbssock->HasCapability(MYTH_PROTO_BINARY_PROGINFO);
+    QByteArray records;
+    uint numchanged = 0;
+    QDateTime rectime = MythDate::current().addSecs(
+        -gCoreContext->GetNumSetting("RecordOverTime"));
+    QMap<QString,uint32_t> inUseMap;
+    QMap<QString,bool> isJobRunning;
+    if (!changed.isEmpty())
+    {
+        inUseMap = ProgramInfo::QueryInUseMap();
+        isJobRunning = ProgramInfo::QueryJobsRunning(JOB_COMMFLAG);
+    }
+    for (uint recordedid : qAsConst(changed))
+    {
+        ProgramInfo proginfo(recordedid);
+        if (!proginfo.GetChanID())
+        {
+            // Deleted since it changed
+            deleted.append(recordedid);
+            continue;
+        }
+
+        // Same flags as ProgramInfo::LoadFromRecorded() sets for the full list
+        QString key = proginfo.MakeUniqueKey();
+        uint32_t flags = proginfo.GetProgramFlags() | inUseMap.value(key, 0);
+        if (((flags & FL_COMMPROCESSING) != 0U) && !isJobRunning.contains(key))
+            flags &= ~FL_COMMPROCESSING;
+        flags &= ~FL_EDITING;
+        if ((flags & (FL_REALLYEDITING | FL_COMMPROCESSING)) != 0U)
+            flags |= FL_EDITING;
+        proginfo.SetProgramFlags(flags);
+
+        if (m_sched && proginfo.GetRecordingEndTime() > rectime)
+            proginfo.SetRecordingStatus(m_sched->GetRecStatus(proginfo));
+
+        FillRecordingPathname(&proginfo, playbackhost, backendPortMap);
+        if (binary)
+            proginfo.ToBinary(records);
+        else
+            proginfo.ToStringList(programs);
+        numchanged++;
     }
 
+    outputlist << "DELTA" << QString::number(deleted.size());
+    for (uint recordedid : qAsConst(deleted))
+        outputlist << QString::number(recordedid);
+    outputlist << QString::number(numchanged);
+    if (binary)
+        outputlist << MYTH_PROTO_BINARY_PROGINFO
+                   << QString::fromLatin1(records.toBase64());
+    else
+        outputlist += programs;
+
     SendResponse(pbssock, outputlist);
 }
 
@@ -4383,17 +4516,27 @@ static bool comp_livetvorder(const InputInfo &a, const InputInfo &b)
     return a.m_inputId < b.m_inputId;
 }
 
-void MainServer::HandleGetFreeInputInfo(PlaybackSock *pbs,
-                                        uint excluded_input)
+/**
+ *  \brief Finds the inputs that are free for LiveTV, in livetvorder.
+ *
+ *   A free input that shares an input group with a busy input on the same
+ *   video source is restricted to the channel and multiplex of the busy
+ *   input, which is returned in its m_chanId and m_mplexId. One that shares
+ *   a group with a busy input on another source is not free.
+ *
+ *  \param excluded_input Input that counts as free even when it is busy
+ *  \param freeinputs     The free inputs
+ *  \param groupids       The input groups of each connected input
+ */
+void MainServer::GetFreeInputs(uint excluded_input,
+                               vector<InputInfo> &freeinputs,
+                               QMap<uint, QSet<uint> > &groupids)
 {
     LOG(VB_CHANNEL, LOG_INFO,
         LOC + QString("Excluding input %1")
         .arg(excluded_input));
 
-    MythSocket *pbssock = pbs->getSocket();
     vector<InputInfo> busyinputs;
-    vector<InputInfo> freeinputs;
-    QMap<uint, QSet<uint> > groupids;
 
     // Lopp over each encoder and divide the inputs into busy and free
     // lists.
@@ -4471,8 +4614,19 @@ void MainServer::HandleGetFreeInputInfo(PlaybackSock *pbs,
         }
     }
 
-    // Return the results in livetvorder.
     stable_sort(freeinputs.begin(), freeinputs.end(), comp_livetvorder);
+}
+
+void MainServer::HandleGetFreeInputInfo(PlaybackSock *pbs,
+                                        uint excluded_input)
+{
+    MythSocket *pbssock = pbs->getSocket();
+    vector<InputInfo> freeinputs;
+    QMap<uint, QSet<uint> > groupids;
+
+    GetFreeInputs(excluded_input, freeinputs, groupids);
+
+    // Return the results in livetvorder.
     QStringList strlist;
     for (auto & input : freeinputs)
     {
@@ -4489,6 +4643,171 @@ void MainServer::HandleGetFreeInputInfo(PlaybackSock *pbs,
     SendResponse(pbssock, strlist);
 }
 
+/**
+ *  \brief Tunes idle inputs to the channels a LiveTV viewer is likely to
+ *         change to next.
+ *
+ *   Only inputs that are free and unrestricted, as GetFreeInputs() sees
+ *   them, are used, and never two that share an input group, so a
+ *   pre-tuned input does not hold a tuner another input needs. Pre-tunes
+ *   made for this LiveTV input that are no longer wanted are released.
+ *
+ *  \param liveinput The input the viewer is watching LiveTV on
+ *  \param chanids   The channels to pre-tune, in order of preference
+ *  \return Pairs of channel ID and the input pre-tuned to it
+ */
+QStringList MainServer::PreTuneNeighbours(uint liveinput,
+                                          const QStringList &chanids)
+{
+    QStringList ret;
+    if (!m_ismaster || !gCoreContext->GetBoolSetting("LiveTVPreTune", false))
+        return ret;
+
+    vector<InputInfo> freeinputs;
+    QMap<uint, QSet<uint> > groupids;
+    GetFreeInputs(0, freeinputs, groupids);
+
+    QMutexLocker locker(&m_preTuneLock);
+
+    auto is_free = [&freeinputs](uint inputid)
+    {
+        return std::any_of(freeinputs.cbegin(), freeinputs.cend(),
+                           [inputid](const InputInfo &info)
+                           { return info.m_inputId == inputid &&
+                                    !info.m_chanId; });
+    };
+
+    QList<uint> wanted;
+    for (const auto & chanid : qAsConst(chanids))
+    {
+        if (chanid.toUInt() && !wanted.contains(chanid.toUInt()))
+            wanted.push_back(chanid.toUInt());
+    }
+
+    // Keep the pre-tunes that are still wanted, release the others
+    auto it = m_preTunes.begin();
+    while (it != m_preTunes.end())
+    {
+        if (it->m_liveInput != liveinput)
+        {
+            ++it;
+            continue;
+        }
+
+        TVRec::s_inputsLock.lockForRead();
+        EncoderLink *enc = m_encoderList->value(it.key());
+        TVRec::s_inputsLock.unlock();
+
+        QString channum = ChannelUtil::GetChanNum(it->m_chanId);
+        if (enc && wanted.contains(it->m_chanId) && is_free(it.key()) &&
+            enc->PreTune(channum))
+        {
+            ret << QString::number(it->m_chanId) << QString::number(it.key());
+            wanted.removeAll(it->m_chanId);
+            ++it;
+            continue;
+        }
+
+        if (enc)
+            enc->ReleasePreTune();
+        it = m_preTunes.erase(it);
+    }
+
+    for (uint chanid : qAsConst(wanted))
+    {
+        uint sourceid = ChannelUtil::GetSourceIDForChannel(chanid);
+        QString channum = ChannelUtil::GetChanNum(chanid);
+
+        for (auto & info : freeinputs)
+        {
+            if (info.m_chanId || info.m_sourceId != sourceid ||
+                info.m_inputId == liveinput ||
+                m_preTunes.contains(info.m_inputId))
+                continue;
+
+            bool conflict = false;
+            for (auto pit = m_preTunes.cbegin();
+                 pit != m_preTunes.cend() && !conflict; ++pit)
+            {
+                conflict = !(groupids[pit.key()] & groupids[info.m_inputId])
+                    .isEmpty();
+            }
+            if (conflict)
+                continue;
+
+            TVRec::s_inputsLock.lockForRead();
+            EncoderLink *enc = m_encoderList->value(info.m_inputId);
+            TVRec::s_inputsLock.unlock();
+
+            if (!enc || !enc->PreTune(channum))
+                continue;
+
+            LOG(VB_CHANNEL, LOG_INFO, LOC +
+                QString("Input %1 pre-tuned to %2 for LiveTV on input %3")
+                .arg(info.m_inputId).arg(channum).arg(liveinput));
+            m_preTunes[info.m_inputId] = { liveinput, chanid };
+            ret << QString::number(chanid) << QString::number(info.m_inputId);
+            break;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ *  \brief Updates the pre-tuned inputs when LiveTV starts or stops.
+ *
+ *   Pre-tunes made for a stopped LiveTV input are forgotten rather than
+ *   released, as the viewer may be switching to one of them; inputs that
+ *   are not used expire by themselves. When LiveTV starts on an input, any
+ *   pre-tuned input that shares one of its input groups is released. This
+ *   waits for the releases to finish, so the tuner is free when LiveTV
+ *   spawns.
+ *
+ *  \param inputid The LiveTV input
+ *  \param started true if LiveTV is starting on the input
+ */
+void MainServer::UpdatePreTunes(uint inputid, bool started)
+{
+    QMutexLocker locker(&m_preTuneLock);
+    if (m_preTunes.empty())
+        return;
+
+    m_preTunes.remove(inputid);
+
+    QList<uint> conflicting;
+    if (started)
+    {
+        for (uint other : CardUtil::GetConflictingInputs(inputid))
+        {
+            if (m_preTunes.contains(other))
+                conflicting.push_back(other);
+        }
+    }
+
+    auto it = m_preTunes.begin();
+    while (it != m_preTunes.end())
+    {
+        if (conflicting.contains(it.key()))
+        {
+            TVRec::s_inputsLock.lockForRead();
+            EncoderLink *enc = m_encoderList->value(it.key());
+            TVRec::s_inputsLock.unlock();
+            if (enc)
+                enc->ReleasePreTune();
+            it = m_preTunes.erase(it);
+        }
+        else if (!started && it->m_liveInput == inputid)
+        {
+            it = m_preTunes.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
 static QString cleanup(const QString &str)
 {
     if (str == " ")
@@ -4664,6 +4983,7 @@ void MainServer::HandleRecorderQuery(QStringList &slist, QStringList &commands,
 
         chain->SetHostSocket(pbssock);
 
+        UpdatePreTunes(enc->GetInputID(), true);
         enc->SpawnLiveTV(chain, slist[3].toInt() != 0, slist[4]);
         retlist << "OK";
     }
@@ -4671,6 +4991,7 @@ void MainServer::HandleRecorderQuery(QStringList &slist, QStringList &commands,
     {
         QString chainid = enc->GetChainID();
         enc->StopLiveTV();
+        UpdatePreTunes(enc->GetInputID(), false);
 
         LiveTVChain *chain = GetExistingChain(chainid);
         if (chain)
@@ -4731,6 +5052,12 @@ void MainServer::HandleRecorderQuery(QStringList &slist, QStringList &commands,
         enc->SetChannel(name);
         retlist << "OK";
     }
+    else if (command == "PRE_TUNE")
+    {
+        retlist = PreTuneNeighbours(enc->GetInputID(), slist.mid(2));
+        if (retlist.empty())
+            retlist << "OK";
+    }
     else if (command == "SET_SIGNAL_MONITORING_RATE")
     {
         auto rate = std::chrono::milliseconds(slist[2].toInt());
@@ -5029,6 +5356,15 @@ void MainServer::HandleRemoteEncoder(QStringList &slist, QStringList &commands,
         enc->CancelNextRecording(cancel);
         retlist << "OK";
     }
+    else if (command == "PRE_TUNE" && (slist.size() >= 3))
+    {
+        retlist << QString::number((int)enc->PreTune(slist[2]));
+    }
+    else if (command == "RELEASE_PRE_TUNE")
+    {
+        enc->ReleasePreTune();
+        retlist << "OK";
+    }
     else if (command == "STOP_RECORDING")
     {
         enc->StopRecording();
@@ -12,6 +12,7 @@
 #include <QMutex>
 #include <QHash>
 #include <QMap>
+#include <QSet>
 
 // MythTV headers
 #include "tv.h"
@@ -26,6 +27,7 @@
 #include "mythsocket.h"
 #include "mythdeque.h"
 #include "mythdownloadmanager.h"
+#include "recordingcatalog.h"
 
 #ifdef DeleteFile
 #undef DeleteFile
@@ -177,6 +179,10 @@ class MainServer : public QObject, public MythSocketCBs
     bool HandleDeleteFile(const QString& filename, const QString& storagegroup,
                           PlaybackSock *pbs = nullptr);
     void HandleQueryRecordings(const QString& type, PlaybackSock *pbs);
+    void HandleQueryRecordingChanges(const QString &generation, uint64_t version,
+                                     PlaybackSock *pbs);
+    void FillRecordingPathname(ProgramInfo *proginfo, const QString &playbackhost,
+                               QMap<QString, int> &backendPortMap);
     void HandleQueryRecording(QStringList &slist, PlaybackSock *pbs);
     void HandleStopRecording(QStringList &slist, PlaybackSock *pbs);
     void DoHandleStopRecording(RecordingInfo &recinfo, PlaybackSock *pbs);
@@ -208,7 +214,11 @@ class MainServer : public QObject, public MythSocketCBs
     void HandleGetExpiringRecordings(PlaybackSock *pbs);
     void HandleSGGetFileList(QStringList &sList, PlaybackSock *pbs);
     void HandleSGFileQuery(QStringList &sList, PlaybackSock *pbs);
+    void GetFreeInputs(uint excluded_input, vector<InputInfo> &freeinputs,
+                       QMap<uint, QSet<uint> > &groupids);
     void HandleGetFreeInputInfo(PlaybackSock *pbs, uint excluded_input);
+    QStringList PreTuneNeighbours(uint liveinput, const QStringList &chanids);
+    void UpdatePreTunes(uint inputid, bool started);
     void HandleGetNextFreeRecorder(QStringList &slist, PlaybackSock *pbs);
     void HandleGetFreeRecorder(PlaybackSock *pbs);
     void HandleGetFreeRecorderCount(PlaybackSock *pbs);
@@ -313,6 +323,15 @@ class MainServer : public QObject, public MythSocketCBs
 
     QMap<int, EncoderLink *> *m_encoderList  {nullptr};
 
+    // Idle inputs pre-tuned for LiveTV, by input ID
+    struct PreTuneInfo
+    {
+        uint m_liveInput; ///< input the LiveTV viewer is watching
+        uint m_chanId;    ///< channel the idle input is tuned to
+    };
+    QMap<uint, PreTuneInfo> m_preTunes;
+    QMutex                  m_preTuneLock;
+
     MythServer            *m_mythserver      {nullptr};
     MetadataFactory       *m_metadatafactory {nullptr};
 
@@ -362,6 +381,8 @@ class MainServer : public QObject, public MythSocketCBs
     QMutex                     m_downloadURLsLock;
     QMap<QString, QString>     m_downloadURLs;
 
+    RecordingCatalog           m_recordingCatalog;
+
     int m_exitCode                           {GENERIC_EXIT_OK};
 
     using RequestedBy = QHash<QString,QString>;
@@ -528,6 +528,30 @@ void PlaybackSock::CancelNextRecording(int capturecardnum, bool cancel)
     SendReceiveStringList(strlist);
 }
 
+bool PlaybackSock::PreTune(int capturecardnum, const QString &channum)
+{
+    QStringList strlist(QString("QUERY_REMOTEENCODER %1")
+                        .arg(capturecardnum));
+
+    strlist << "PRE_TUNE";
+    strlist << channum;
+
+    if (SendReceiveStringList(strlist, 1))
+        return strlist[0].toInt() != 0;
+
+    return false;
+}
+
+void PlaybackSock::ReleasePreTune(int capturecardnum)
+{
+    QStringList strlist(QString("QUERY_REMOTEENCODER %1")
+                        .arg(capturecardnum));
+
+    strlist << "RELEASE_PRE_TUNE";
+
+    SendReceiveStringList(strlist);
+}
+
 QStringList PlaybackSock::ForwardRequest(const QStringList &slist)
 {
     QStringList strlist = slist;
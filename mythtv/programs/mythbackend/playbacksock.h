@@ -100,6 +100,8 @@ class PlaybackSock : public ReferenceCounter
     std::chrono::milliseconds SetSignalMonitoringRate(int capturecardnum, std::chrono::milliseconds rate, int notifyFrontend);
     void SetNextLiveTVDir(int capturecardnum, const QString& dir);
     void CancelNextRecording(int capturecardnum, bool cancel);
+    bool PreTune(int capturecardnum, const QString &channum);
+    void ReleasePreTune(int capturecardnum);
 
     QStringList ForwardRequest(const QStringList &slist);
 
@@ -0,0 +1,122 @@
+// -*- Mode: c++ -*-
+
+// Qt headers
+#include <QDateTime>
+#include <QHash>
+
+// MythTV headers
+#include "mythlogging.h"
+#include "programinfo.h"
+#include "recordingcatalog.h"
+
+#define LOC QString("RecCatalog: ")
+
+// Number of changes kept, older clients reload the whole list
+static constexpr size_t kMaxLogEntries { 2000 };
+
+RecordingCatalog::RecordingCatalog()
+  : m_generation(QString::number(QDateTime::currentMSecsSinceEpoch()))
+{
+}
+
+/*!
+ * \brief Logs a RECORDING_LIST_CHANGE event
+ * \param message The event message, other messages are ignored
+ * \param extra   The event's extra data, the ProgramInfo of an UPDATE
+ */
+void RecordingCatalog::HandleEvent(const QString &message,
+                                   const QStringList &extra)
+{
+    if (!message.startsWith("RECORDING_LIST_CHANGE"))
+        return;
+
+    QStringList tokens = message.simplified().split(" ");
+    if (tokens.size() >= 2 && tokens[1] == "UPDATE")
+    {
+        ProgramInfo evinfo(extra);
+        if (evinfo.GetRecordingID())
+        {
+            Add(evinfo.GetRecordingID(), kChanged);
+            return;
+        }
+    }
+    else if (tokens.size() >= 3 && (tokens[1] == "ADD" || tokens[1] == "DELETE"))
+    {
+        uint recordedid = tokens[2].toUInt();
+        if (recordedid)
+        {
+            Add(recordedid, (tokens[1] == "ADD") ? kChanged : kDeleted);
+            return;
+        }
+    }
+
+    Reset();
+}
+
+uint64_t RecordingCatalog::GetVersion(void) const
+{
+    QMutexLocker locker(&m_lock);
+    return m_version;
+}
+
+/*!
+ * \brief Gets the recordings that changed after a version
+ * \param generation Generation the version belongs to
+ * \param since      Version of the client's list
+ * \param changed    Filled with the recordings added or updated since
+ * \param deleted    Filled with the recordings deleted since
+ * \return false if the client has to reload the whole list instead
+ */
+bool RecordingCatalog::GetChanges(const QString &generation, uint64_t since,
+                                  QList<uint> &changed,
+                                  QList<uint> &deleted) const
+{
+    changed.clear();
+    deleted.clear();
+
+    QMutexLocker locker(&m_lock);
+    if (generation != m_generation || since < m_resetVersion ||
+        since > m_version)
+    {
+        return false;
+    }
+
+    // Only the last change to each recording matters
+    QHash<uint, Change> last;
+    for (const auto & entry : m_log)
+    {
+        if (entry.m_version > since)
+            last[entry.m_recordedid] = entry.m_change;
+    }
+    locker.unlock();
+
+    for (auto it = last.cbegin(); it != last.cend(); ++it)
+    {
+        if (*it == kDeleted)
+            deleted.append(it.key());
+        else
+            changed.append(it.key());
+    }
+    return true;
+}
+
+void RecordingCatalog::Add(uint recordedid, Change change)
+{
+    QMutexLocker locker(&m_lock);
+    m_log.push_back({ ++m_version, recordedid, change });
+    while (m_log.size() > kMaxLogEntries)
+    {
+        m_resetVersion = m_log.front().m_version;
+        m_log.pop_front();
+    }
+}
+
+/// \brief Forces all clients to reload the whole list
+void RecordingCatalog::Reset(void)
+{
+    QMutexLocker locker(&m_lock);
+    m_resetVersion = ++m_version;
+    m_log.clear();
+    LOG(VB_GENERAL, LOG_DEBUG, LOC +
+        QString("Full reload needed from version %1").arg(m_version));
+}
@@ -0,0 +1,61 @@
+// -*- Mode: c++ -*-
+#ifndef RECORDINGCATALOG_H
+#define RECORDINGCATALOG_H
+
+// C++ headers
+#include <cstdint>
+#include <deque>
+
+// Qt headers
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+/*!
+ * \brief Versioned log of the changes to the list of recordings
+ *
+ * Every RECORDING_LIST_CHANGE event that the backend broadcasts bumps the
+ * catalog version and is logged against the recording it concerns. Clients
+ * that remember the version of their cached list can then ask for just the
+ * recordings that changed since, instead of reloading the whole list.
+ *
+ * An event that does not name a recording, or a version that is older than
+ * the log or from another run of the backend, means that the client has to
+ * reload the whole list.
+ */
+class RecordingCatalog
+{
+  public:
+    RecordingCatalog();
+
+    void HandleEvent(const QString &message, const QStringList &extra);
+
+    QString  GetGeneration(void) const { return m_generation; }
+    uint64_t GetVersion(void) const;
+    bool     GetChanges(const QString &generation, uint64_t since,
+                        QList<uint> &changed, QList<uint> &deleted) const;
+
+  private:
+    enum Change { kChanged, kDeleted };
+
+    struct Entry
+    {
+        uint64_t m_version;
+        uint     m_recordedid;
+        Change   m_change;
+    };
+
+    void Add(uint recordedid, Change change);
+    void Reset(void);
+
+    mutable QMutex    m_lock;
+    /// Identifies this run of the backend, versions restart with it
+    QString           m_generation;
+    uint64_t          m_version      {0};
+    /// Clients at an older version than this must reload the whole list
+    uint64_t          m_resetVersion {0};
+    std::deque<Entry> m_log;
+};
+
+#endif // RECORDINGCATALOG_H
@@ -0,0 +1,9 @@
+include (../../../settings.pro)
+
+TEMPLATE = subdirs
+
+SUBDIRS += $$files(test_*)
+
+unittest.target = test
+unittest.commands = ../../scripts/unittests.sh
+unix:QMAKE_EXTRA_TARGETS += unittest
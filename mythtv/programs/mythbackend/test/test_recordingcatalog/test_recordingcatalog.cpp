@@ -0,0 +1,3 @@
+#include "test_recordingcatalog.h"
+
+QTEST_APPLESS_MAIN(TestRecordingCatalog)
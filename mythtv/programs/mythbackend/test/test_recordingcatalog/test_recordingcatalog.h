@@ -0,0 +1,161 @@
+/*
+ *  Class TestRecordingCatalog
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <algorithm>
+#include <QtTest/QtTest>
+
+#include "programinfo.h"
+#include "recordingcatalog.h"
+
+class TestRecordingCatalog : public QObject
+{
+    Q_OBJECT
+
+    static QList<uint> sorted(QList<uint> list)
+    {
+        std::sort(list.begin(), list.end());
+        return list;
+    }
+
+  private slots:
+    static void empty_test(void)
+    {
+        RecordingCatalog catalog;
+        QList<uint> changed;
+        QList<uint> deleted;
+
+        QVERIFY(!catalog.GetGeneration().isEmpty());
+        QCOMPARE(catalog.GetVersion(), static_cast<uint64_t>(0));
+        QVERIFY(catalog.GetChanges(catalog.GetGeneration(), 0,
+                                   changed, deleted));
+        QVERIFY(changed.isEmpty());
+        QVERIFY(deleted.isEmpty());
+    }
+
+    static void changes_test(void)
+    {
+        RecordingCatalog catalog;
+        QString generation = catalog.GetGeneration();
+        QList<uint> changed;
+        QList<uint> deleted;
+
+        ProgramInfo updated;
+        updated.SetRecordingID(5);
+        QStringList extra;
+        updated.ToStringList(extra);
+
+        catalog.HandleEvent("RECORDING_LIST_CHANGE ADD 5", QStringList());
+        catalog.HandleEvent("RECORDING_LIST_CHANGE ADD 6", QStringList());
+        catalog.HandleEvent("RECORDING_LIST_CHANGE UPDATE", extra);
+        catalog.HandleEvent("RECORDING_LIST_CHANGE DELETE 6", QStringList());
+        QCOMPARE(catalog.GetVersion(), static_cast<uint64_t>(4));
+
+        // Other events are not logged
+        catalog.HandleEvent("SCHEDULE_CHANGE", QStringList());
+        QCOMPARE(catalog.GetVersion(), static_cast<uint64_t>(4));
+
+        // Only the last change to a recording is reported
+        QVERIFY(catalog.GetChanges(generation, 0, changed, deleted));
+        QCOMPARE(changed, QList<uint>({5}));
+        QCOMPARE(deleted, QList<uint>({6}));
+
+        QVERIFY(catalog.GetChanges(generation, 3, changed, deleted));
+        QVERIFY(changed.isEmpty());
+        QCOMPARE(deleted, QList<uint>({6}));
+
+        QVERIFY(catalog.GetChanges(generation, 4, changed, deleted));
+        QVERIFY(changed.isEmpty());
+        QVERIFY(deleted.isEmpty());
+    }
+
+    static void generation_test(void)
+    {
+        RecordingCatalog catalog;
+        QList<uint> changed;
+        QList<uint> deleted;
+
+        catalog.HandleEvent("RECORDING_LIST_CHANGE ADD 1", QStringList());
+
+        // A version from another run of the backend
+        QVERIFY(!catalog.GetChanges(catalog.GetGeneration() + "0", 0,
+                                    changed, deleted));
+        QVERIFY(!catalog.GetChanges("", 1, changed, deleted));
+
+        // A version this run has not reached yet
+        QVERIFY(!catalog.GetChanges(catalog.GetGeneration(), 2,
+                                    changed, deleted));
+    }
+
+    static void reset_test(void)
+    {
+        RecordingCatalog catalog;
+        QString generation = catalog.GetGeneration();
+        QList<uint> changed;
+        QList<uint> deleted;
+
+        catalog.HandleEvent("RECORDING_LIST_CHANGE ADD 1", QStringList());
+        catalog.HandleEvent("RECORDING_LIST_CHANGE ADD 2", QStringList());
+
+        // An event that names no recording
+        catalog.HandleEvent("RECORDING_LIST_CHANGE", QStringList());
+        QCOMPARE(catalog.GetVersion(), static_cast<uint64_t>(3));
+        QVERIFY(!catalog.GetChanges(generation, 0, changed, deleted));
+        QVERIFY(!catalog.GetChanges(generation, 2, changed, deleted));
+        QVERIFY(catalog.GetChanges(generation, 3, changed, deleted));
+        QVERIFY(changed.isEmpty());
+
+        // An update without a recording id
+        catalog.HandleEvent("RECORDING_LIST_CHANGE UPDATE", QStringList());
+        QVERIFY(!catalog.GetChanges(generation, 3, changed, deleted));
+
+        catalog.HandleEvent("RECORDING_LIST_CHANGE ADD 3", QStringList());
+        QVERIFY(catalog.GetChanges(generation, 4, changed, deleted));
+        QCOMPARE(changed, QList<uint>({3}));
+    }
+
+    static void wrap_test(void)
+    {
+        RecordingCatalog catalog;
+        QString generation = catalog.GetGeneration();
+        QList<uint> changed;
+        QList<uint> deleted;
+
+        // The log holds the last 2000 changes
+        for (uint id = 1; id <= 2000; ++id)
+        {
+            catalog.HandleEvent(QString("RECORDING_LIST_CHANGE ADD %1").arg(id),
+                                QStringList());
+        }
+        QVERIFY(catalog.GetChanges(generation, 0, changed, deleted));
+        QCOMPARE(changed.size(), 2000);
+
+        // One more and a client that has seen none of them falls behind
+        catalog.HandleEvent("RECORDING_LIST_CHANGE DELETE 2001", QStringList());
+        QCOMPARE(catalog.GetVersion(), static_cast<uint64_t>(2001));
+        QVERIFY(!catalog.GetChanges(generation, 0, changed, deleted));
+
+        QVERIFY(catalog.GetChanges(generation, 1, changed, deleted));
+        QCOMPARE(changed.size(), 1999);
+        QCOMPARE(sorted(changed).first(), 2U);
+        QCOMPARE(deleted, QList<uint>({2001}));
+
+        QVERIFY(catalog.GetChanges(generation, 2000, changed, deleted));
+        QVERIFY(changed.isEmpty());
+        QCOMPARE(deleted, QList<uint>({2001}));
+    }
+};
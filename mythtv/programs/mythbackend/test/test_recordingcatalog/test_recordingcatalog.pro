@@ -0,0 +1,44 @@
+include ( ../../../../settings.pro )
+include ( ../../../../test.pro )
+
+QT += xml sql network testlib
+
+TEMPLATE = app
+TARGET = test_recordingcatalog
+DEPENDPATH += . ../..
+INCLUDEPATH += . ../.. ../../../../libs/libmyth ../../../../libs/libmythbase
+INCLUDEPATH += ../../../.. ../../../../external/FFmpeg
+
+LIBS += -L../../../../libs/libmythbase -lmythbase-$$LIBVERSION
+LIBS += -L../../../../libs/libmythui -lmythui-$$LIBVERSION
+LIBS += -L../../../../libs/libmythupnp -lmythupnp-$$LIBVERSION
+LIBS += -L../../../../libs/libmythservicecontracts -lmythservicecontracts-$$LIBVERSION
+LIBS += -L../../../../external/FFmpeg/libavcodec -lmythavcodec
+LIBS += -L../../../../external/FFmpeg/libavformat -lmythavformat
+LIBS += -L../../../../external/FFmpeg/libavutil -lmythavutil
+LIBS += -L../../../../external/FFmpeg/libswresample -lmythswresample
+LIBS += -L../../../../libs/libmyth -lmyth-$$LIBVERSION
+
+QMAKE_LFLAGS += -Wl,$$_RPATH_$(PWD)/../../../../external/FFmpeg/libavcodec
+QMAKE_LFLAGS += -Wl,$$_RPATH_$(PWD)/../../../../external/FFmpeg/libavformat
+QMAKE_LFLAGS += -Wl,$$_RPATH_$(PWD)/../../../../external/FFmpeg/libavutil
+QMAKE_LFLAGS += -Wl,$$_RPATH_$(PWD)/../../../../external/FFmpeg/libswresample
+QMAKE_LFLAGS += -Wl,$$_RPATH_$(PWD)/../../../../libs/libmythbase
+QMAKE_LFLAGS += -Wl,$$_RPATH_$(PWD)/../../../../libs/libmythui
+QMAKE_LFLAGS += -Wl,$$_RPATH_$(PWD)/../../../../libs/libmythupnp
+QMAKE_LFLAGS += -Wl,$$_RPATH_$(PWD)/../../../../libs/libmythservicecontracts
+QMAKE_LFLAGS += -Wl,$$_RPATH_$(PWD)/../../../../libs/libmyth
+
+# Input
+HEADERS += test_recordingcatalog.h
+HEADERS += ../../recordingcatalog.h
+SOURCES += test_recordingcatalog.cpp
+SOURCES += ../../recordingcatalog.cpp
+
+QMAKE_CLEAN += $(TARGET) $(TARGETA) $(TARGETD) $(TARGET0) $(TARGET1) $(TARGET2)
+QMAKE_CLEAN += ; ( cd $(OBJECTS_DIR) && rm -f *.gcov *.gcda *.gcno )
+
+LIBS += $$EXTRA_LIBS $$LATE_LIBS
+
+# Fix runtime linking on Ubuntu 17.10.
+linux:QMAKE_LFLAGS += -Wl,--disable-new-dtags
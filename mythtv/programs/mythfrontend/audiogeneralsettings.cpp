@@ -161,6 +161,8 @@ AudioConfigSettings::AudioConfigSettings()
 
     advancedSettings->addChild(HBRPassthrough());
 
+    advancedSettings->addChild(AudioUpmixBlockSize());
+
     advancedSettings->addChild(m_mpcm = MPCM());
 
     addChild(m_audioTest = new AudioTest());
@@ -477,6 +479,25 @@ HostComboBoxSetting *AudioConfigSettings::AudioUpmixType()
     return gc;
 }
 
+HostComboBoxSetting *AudioConfigSettings::AudioUpmixBlockSize()
+{
+    auto *gc = new HostComboBoxSetting("AudioUpmixBlockSize", false);
+
+    gc->setLabel(tr("Upmix Latency"));
+
+    gc->addSelection(tr("Normal", "Upmix Latency"), "8192", true);  // default
+    gc->addSelection(tr("Low", "Upmix Latency"), "4096");
+    gc->addSelection(tr("Lowest", "Upmix Latency"), "2048");
+
+    gc->setHelpText(tr("Set the block size used by the Good and Best quality "
+                       "upmixers. Smaller blocks reduce the audio latency "
+                       "and the processing needed per block, at the cost of "
+                       "less precise placement of sounds. (default is "
+                       "Normal)"));
+
+    return gc;
+}
+
 HostCheckBoxSetting *AudioConfigSettings::AC3PassThrough()
 {
     auto *gc = new HostCheckBoxSetting("AC3PassThru");
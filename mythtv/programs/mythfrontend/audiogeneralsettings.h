@@ -65,6 +65,7 @@ class AudioConfigSettings : public GroupSetting
     static HostComboBoxSetting *MaxAudioChannels();
     static HostCheckBoxSetting *AudioUpmix();
     static HostComboBoxSetting *AudioUpmixType();
+    static HostComboBoxSetting *AudioUpmixBlockSize();
     static HostCheckBoxSetting *AC3PassThrough();
     static HostCheckBoxSetting *DTSPassThrough();
     static HostCheckBoxSetting *EAC3PassThrough();
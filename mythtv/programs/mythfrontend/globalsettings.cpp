@@ -697,6 +697,7 @@ PlaybackProfileItemConfig::PlaybackProfileItemConfig(
     m_decoder      = new TransMythUIComboBoxSetting();
     m_maxCpus      = new TransMythUISpinBoxSetting(1, HAVE_THREADS ? VIDEO_MAX_CPUS : 1, 1, 1);
     m_skipLoop     = new TransMythUICheckBoxSetting();
+    m_decodeAhead  = new TransMythUISpinBoxSetting(0, VIDEO_MAX_AHEAD, 1, 1);
     m_vidRend      = new TransMythUIComboBoxSetting();
     m_upscaler     = new TransMythUIComboBoxSetting();
     m_singleDeint  = new TransMythUIComboBoxSetting();
@@ -738,6 +739,7 @@ PlaybackProfileItemConfig::PlaybackProfileItemConfig(
     m_decoder->setLabel(tr("Decoder"));
     m_maxCpus->setLabel(tr("Max CPUs"));
     m_skipLoop->setLabel(tr("Deblocking filter"));
+    m_decodeAhead->setLabel(tr("Decode ahead"));
     m_vidRend->setLabel(tr("Video renderer"));
     m_upscaler->setLabel(tr("Video scaler"));
     auto scalers = MythVideoProfile::GetUpscalers();
@@ -801,6 +803,11 @@ PlaybackProfileItemConfig::PlaybackProfileItemConfig(
         tr("Disabling will significantly reduce the load on the CPU for software decoding of "
            "H.264 and HEVC material but may significantly reduce video quality."));
 
+    m_decodeAhead->setHelpText(
+        tr("Number of extra frames that software decoding may run ahead of the "
+           "display. When non-zero, frame or slice threading is also chosen "
+           "automatically from the measured decode times. Set to 0 to disable."));
+
     m_upscaler->setHelpText(tr(
             "The default scaler provides good quality in the majority of situations. "
             "Higher quality scalers may offer some benefit when scaling very low "
@@ -813,6 +820,7 @@ PlaybackProfileItemConfig::PlaybackProfileItemConfig(
     addChild(m_decoder);
     addChild(m_maxCpus);
     addChild(m_skipLoop);
+    addChild(m_decodeAhead);
     addChild(m_vidRend);
     addChild(m_upscaler);
 
@@ -897,6 +905,7 @@ void PlaybackProfileItemConfig::Load(void)
     QString pdecoder  = m_item.Get(PREF_DEC);
     QString pmax_cpus = m_item.Get(PREF_CPUS);
     QString pskiploop = m_item.Get(PREF_LOOP);
+    QString pahead    = m_item.Get(PREF_AHEAD);
     QString prenderer = m_item.Get(PREF_RENDER);
     QString psingledeint = m_item.Get(PREF_DEINT1X);
     QString pdoubledeint = m_item.Get(PREF_DEINT2X);
@@ -925,6 +934,7 @@ void PlaybackProfileItemConfig::Load(void)
         m_maxCpus->setValue(pmax_cpus.toInt());
 
     m_skipLoop->setValue((!pskiploop.isEmpty()) ? (pskiploop.toInt() > 0) : true);
+    m_decodeAhead->setValue(pahead.toInt());
     m_upscaler->setValue(upscale);
 
     if (!prenderer.isEmpty())
@@ -947,6 +957,7 @@ void PlaybackProfileItemConfig::Save(void)
     m_item.Set(PREF_DEC,     m_decoder->getValue());
     m_item.Set(PREF_CPUS,    m_maxCpus->getValue());
     m_item.Set(PREF_LOOP,   (m_skipLoop->boolValue()) ? "1" : "0");
+    m_item.Set(PREF_AHEAD,   m_decodeAhead->getValue());
     m_item.Set(PREF_RENDER,  m_vidRend->getValue());
     m_item.Set(PREF_DEINT1X, GetQuality(m_singleDeint, m_singleShader, m_singleDriver));
     m_item.Set(PREF_DEINT2X, GetQuality(m_doubleDeint, m_doubleShader, m_doubleDriver));
@@ -2622,6 +2633,21 @@ static HostSpinBoxSetting *GUIFontZoom()
     return gs;
 }
 
+static HostSpinBoxSetting *UIImageCacheSize()
+{
+    auto *gs = new HostSpinBoxSetting("UIImageCacheSize", 10, 1000, 10, 10);
+
+    gs->setLabel(AppearanceSettings::tr("Image cache size (MB)"));
+
+    gs->setValue(30);
+
+    gs->setHelpText(AppearanceSettings::tr
+                    ("Memory used to keep decoded theme images, posters and "
+                     "fanart. Raise it if browsing artwork is slow. "
+                     "mythfrontend needs restart for this to take effect."));
+    return gs;
+}
+
 
 static HostComboBoxSetting *MythDateFormatCB()
 {
@@ -4653,6 +4679,7 @@ AppearanceSettings::AppearanceSettings()
     }
     screen->addChild(StartupScreenDelay());
     screen->addChild(GUIFontZoom());
+    screen->addChild(UIImageCacheSize());
 #ifdef USING_AIRPLAY
     screen->addChild(AirPlayFullScreen());
 #endif
@@ -238,6 +238,7 @@ class PlaybackProfileItemConfig : public GroupSetting
     TransMythUIComboBoxSetting *m_decoder      {nullptr};
     TransMythUISpinBoxSetting  *m_maxCpus      {nullptr};
     TransMythUICheckBoxSetting *m_skipLoop     {nullptr};
+    TransMythUISpinBoxSetting  *m_decodeAhead  {nullptr};
     TransMythUIComboBoxSetting *m_vidRend      {nullptr};
     TransMythUIComboBoxSetting *m_upscaler     {nullptr};
     TransMythUIComboBoxSetting *m_singleDeint  {nullptr};
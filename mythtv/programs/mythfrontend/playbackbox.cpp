@@ -537,6 +537,9 @@ bool PlaybackBox::Create()
             this, &PlaybackBox::ItemVisible);
     connect(m_recordingList, &MythUIButtonList::itemLoaded,
             this, &PlaybackBox::ItemLoaded);
+    // Only fill in the recordings near the visible ones, groups can have
+    // thousands of them
+    m_recordingList->SetLoadOnDemand();
 
     // connect up timers...
     connect(m_artTimer[kArtworkFanart],   &QTimer::timeout, this, &PlaybackBox::fanartLoad);
@@ -1492,7 +1495,6 @@ void PlaybackBox::updateRecList(MythUIButtonListItem *sel_item)
 
         new PlaybackBoxListItem(this, m_recordingList, prog);
     }
-    m_recordingList->LoadInBackground();
 
     if (m_noRecordingsText)
     {
@@ -120,6 +120,8 @@ bool ProgLister::Create()
     connect(m_progList, &MythUIButtonList::itemLoaded,
             this,       &ProgLister::HandleVisible);
 
+    m_progList->SetLoadOnDemand();
+
     if (m_type == plPreviouslyRecorded)
     {
         connect(m_progList, &MythUIButtonList::itemClicked,
@@ -1553,7 +1555,6 @@ void ProgLister::UpdateButtonList(void)
 {
     for (auto *it : m_itemList)
         new MythUIButtonListItem(m_progList, "", QVariant::fromValue(it));
-    m_progList->LoadInBackground();
 
     if (m_positionText)
     {
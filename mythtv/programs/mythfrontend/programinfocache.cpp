@@ -51,6 +51,7 @@ ProgramInfoCache::~ProgramInfoCache()
         m_loadWait.wait(&m_lock);
 
     Clear();
+    ClearChanges();
     free_vec(m_nextCache);
 }
 
@@ -66,21 +67,52 @@ void ProgramInfoCache::ScheduleLoad(const bool updateUI)
     }
 }
 
+/** \brief Loads the recordings that changed since the last load.
+ *
+ *  The whole list is only loaded the first time, after the backend has
+ *  restarted or when it has lost track of the changes since the last load.
+ */
 void ProgramInfoCache::Load(const bool updateUI)
 {
     QMutexLocker locker(&m_lock);
     m_loadIsQueued = false;
+    QString  generation = m_generation;
+    uint64_t version    = m_version;
 
     locker.unlock();
     /**/
+    vector<ProgramInfo*> changed;
+    vector<uint> deleted;
+    vector<ProgramInfo*> *tmp = nullptr;
+    bool isDelta =
+        RemoteGetRecordingChanges(generation, version, changed, deleted);
     // Get an unsorted list (sort = 0) from RemoteGetRecordedList
     // we sort the list later anyway.
-    vector<ProgramInfo*> *tmp = RemoteGetRecordedList(0);
+    if (!isDelta)
+        tmp = RemoteGetRecordedList(0);
     /**/
     locker.relock();
 
-    free_vec(m_nextCache);
-    m_nextCache = tmp;
+    if (generation == m_generation && version < m_version)
+    {
+        // Overtaken by a more recent load
+        for (auto *pginfo : changed)
+            delete pginfo;
+        free_vec(tmp);
+    }
+    else if (isDelta)
+    {
+        m_version = version;
+        MergeChanges(changed, deleted);
+    }
+    else
+    {
+        m_generation = tmp ? generation : QString();
+        m_version    = version;
+        ClearChanges();
+        free_vec(m_nextCache);
+        m_nextCache = tmp;
+    }
 
     if (updateUI)
         QCoreApplication::postEvent(
@@ -90,6 +122,87 @@ void ProgramInfoCache::Load(const bool updateUI)
     m_loadWait.wakeAll();
 }
 
+/// Adds loaded changes to the pending ones, m_lock must be held.
+void ProgramInfoCache::MergeChanges(vector<ProgramInfo*> &changed,
+                                    const vector<uint> &deleted)
+{
+    auto pending = [this](uint recordingID)
+    {
+        return std::find_if(m_nextChanged.begin(), m_nextChanged.end(),
+                            [recordingID](const ProgramInfo *pginfo)
+                            { return pginfo->GetRecordingID() == recordingID; });
+    };
+
+    for (uint recordingID : deleted)
+    {
+        auto it = pending(recordingID);
+        if (it != m_nextChanged.end())
+        {
+            delete *it;
+            m_nextChanged.erase(it);
+        }
+        m_nextDeleted.push_back(recordingID);
+    }
+
+    for (auto *pginfo : changed)
+    {
+        auto it = pending(pginfo->GetRecordingID());
+        if (it != m_nextChanged.end())
+        {
+            delete *it;
+            *it = pginfo;
+        }
+        else
+        {
+            m_nextChanged.push_back(pginfo);
+        }
+    }
+    changed.clear();
+}
+
+/// Applies the pending changes to the cache, m_lock must be held.
+void ProgramInfoCache::ApplyChanges(void)
+{
+    for (uint recordingID : m_nextDeleted)
+    {
+        Cache::iterator it = m_cache.find(recordingID);
+        if (it != m_cache.end())
+        {
+            delete *it;
+            m_cache.erase(it);
+        }
+    }
+    m_nextDeleted.clear();
+
+    for (auto *pginfo : m_nextChanged)
+    {
+        Cache::iterator it = m_cache.find(pginfo->GetRecordingID());
+        if (it != m_cache.end())
+        {
+            (*it)->clone(*pginfo, true);
+            delete pginfo;
+        }
+        else if (pginfo->GetChanID())
+        {
+            m_cache[pginfo->GetRecordingID()] = pginfo;
+        }
+        else
+        {
+            delete pginfo;
+        }
+    }
+    m_nextChanged.clear();
+}
+
+/// Discards the pending changes, m_lock must be held.
+void ProgramInfoCache::ClearChanges(void)
+{
+    for (auto *pginfo : m_nextChanged)
+        delete pginfo;
+    m_nextChanged.clear();
+    m_nextDeleted.clear();
+}
+
 bool ProgramInfoCache::IsLoadInProgress(void) const
 {
     QMutexLocker locker(&m_lock);
@@ -105,9 +218,9 @@ void ProgramInfoCache::WaitForLoadToComplete(void) const
 
 /** \brief Refreshed the cache.
  *
- *  If a new list has been loaded this fills the cache with that list
- *  if not, this simply removes list items marked for deletion from the
- *  the list.
+ *  If a new list has been loaded this fills the cache with that list,
+ *  then applies the changes loaded since and removes list items marked
+ *  for deletion from the list.
  *
  *  \note This must only be called from the UI thread.
  *  \note All references to the ProgramInfo pointers should be cleared
@@ -128,8 +241,8 @@ void ProgramInfoCache::Refresh(void)
         }
         delete m_nextCache;
         m_nextCache = nullptr;
-        return;
     }
+    ApplyChanges();
     locker.unlock();
 
     Cache::iterator it = m_cache.begin();
@@ -12,6 +12,7 @@
 #include <QDateTime>
 #include <QMutex>
 #include <QHash>
+#include <QString>
 
 class ProgramInfoLoader;
 class ProgramInfo;
@@ -43,6 +44,10 @@ class ProgramInfoCache
 
   private:
     void Load(bool updateUI = true);
+    void MergeChanges(std::vector<ProgramInfo*> &changed,
+                      const std::vector<uint> &deleted);
+    void ApplyChanges(void);
+    void ClearChanges(void);
     void Clear(void);
 
   private:
@@ -56,6 +61,12 @@ class ProgramInfoCache
     mutable QMutex          m_lock;
     Cache                   m_cache;
     std::vector<ProgramInfo*> *m_nextCache      {nullptr};
+    /// Changes loaded since m_nextCache, or since the cache if there is none
+    std::vector<ProgramInfo*>  m_nextChanged;
+    std::vector<uint>          m_nextDeleted;
+    /// Version of the backend's recording list that the loads have reached
+    QString                 m_generation;
+    uint64_t                m_version           {0};
     QObject                *m_listener          {nullptr};
     bool                    m_loadIsQueued      {false};
     uint                    m_loadsInProgress   {0};
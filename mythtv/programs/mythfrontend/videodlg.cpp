@@ -1033,6 +1033,12 @@ bool VideoDialog::Create()
                 this, &VideoDialog::handleSelect);
         connect(m_videoButtonList, &MythUIButtonList::itemSelected,
                 this, &VideoDialog::UpdateText);
+        connect(m_videoButtonList, &MythUIButtonList::itemLoaded,
+                this, &VideoDialog::UpdateItem);
+
+        // Artwork lookups are slow, so only do them for the videos near the
+        // visible ones
+        m_videoButtonList->SetLoadOnDemand();
     }
 
     return true;
@@ -1201,8 +1207,6 @@ void VideoDialog::loadData()
 
                 item->SetData(QVariant::fromValue(child));
 
-                UpdateItem(item);
-
                 if (child == selectedNode)
                     m_videoButtonList->SetItemCurrent(item);
             }
@@ -18,6 +18,7 @@ macx: QMAKE_CFLAGS -= -O3 -O2 -O1 -Os
 # Input
 SOURCES += main.cpp transcode.cpp mpeg2fix.cpp
 SOURCES += audioreencodebuffer.cpp cutter.cpp videodecodebuffer.cpp
+SOURCES += videoscalebuffer.cpp
 SOURCES += commandlineparser.cpp
 SOURCES += external/replex/element.cpp external/replex/mpg_common.cpp
 SOURCES += external/replex/multiplex.cpp external/replex/pes.cpp
@@ -26,6 +27,7 @@ SOURCES += mythtranscodeplayer.cpp
 
 HEADERS += mpeg2fix.h transcodedefs.h commandlineparser.h
 HEADERS += audioreencodebuffer.h cutter.h videodecodebuffer.h
+HEADERS += videoscalebuffer.h
 HEADERS += external/replex/element.h external/replex/mpg_common.h
 HEADERS += external/replex/multiplex.h external/replex/pes.h
 HEADERS += external/replex/ringbuffer.h external/replex/ts.h
@@ -33,6 +33,7 @@
 #include "HLS/httplivestream.h"
 
 #include "videodecodebuffer.h"
+#include "videoscalebuffer.h"
 #include "cutter.h"
 #include "audioreencodebuffer.h"
 
@@ -46,6 +47,27 @@ extern "C" {
 
 #define LOC QString("Transcode: ")
 
+/*! \brief Describe the throughput of each transcode stage.
+ *
+ * Each rate is the number of frames divided by the time that stage was
+ * actually busy, i.e. the rate the stage could sustain on its own. The lowest
+ * figure identifies the bottleneck.
+*/
+static QString StageStatus(long Decoded, std::chrono::microseconds Decode,
+                           long Scaled, std::chrono::microseconds Scale,
+                           long Encoded, std::chrono::microseconds Encode)
+{
+    auto rate = [](long Count, std::chrono::microseconds Time)
+    {
+        if (Time <= 0us)
+            return QString("-");
+        return QString::number(Count * 1000000.0 / Time.count(), 'f', 1);
+    };
+
+    return QObject::tr("Stages (fps): decode %1, scale %2, encode %3")
+        .arg(rate(Decoded, Decode), rate(Scaled, Scale), rate(Encoded, Encode));
+}
+
 Transcode::Transcode(ProgramInfo *pginfo) :
     m_proginfo(pginfo),
     m_recProfile(new RecordingProfile("Transcoders"))
@@ -1026,6 +1048,25 @@ int Transcode::TranscodeFile(const QString &inputname,
         new VideoDecodeBuffer(player, videoOutput, honorCutList);
     MThreadPool::globalInstance()->start(videoBuffer, "VideoDecodeBuffer");
 
+    // Scale on a thread of its own between decoding and encoding. When copying
+    // audio, frames the player writes out unchanged are never scaled, so that
+    // path keeps scaling the frames it re-encodes in this loop.
+    VideoScaleBuffer *scaleBuffer = nullptr;
+    if (rescale && (m_fifow || !copyaudio))
+    {
+        scaleBuffer = new VideoScaleBuffer(videoBuffer, frame, m_fifow == nullptr);
+        MThreadPool::globalInstance()->start(scaleBuffer, "VideoScaleBuffer");
+    }
+
+    // The scale thread may be waiting on the decoder, so stop it first
+    auto stopBuffers = [&]()
+    {
+        if (scaleBuffer)
+            scaleBuffer->stop();
+        if (videoBuffer)
+            videoBuffer->stop();
+    };
+
     QElapsedTimer flagTime;
     flagTime.start();
 
@@ -1035,6 +1076,35 @@ int Transcode::TranscodeFile(const QString &inputname,
     bool stopSignalled = false;
     MythVideoFrame *lastDecode = nullptr;
 
+    // Per stage timings, covering only the codec work of each stage. Decode
+    // and scale times come from their threads; scaling done in this loop and
+    // the encoder and muxer calls are timed here.
+    std::chrono::microseconds scaleTime = 0us;
+    std::chrono::microseconds encodeTime = 0us;
+    long scaledFrames = 0;
+    long encodedFrames = 0;
+    auto stageStatus = [&]()
+    {
+        long decoded = 0;
+        std::chrono::microseconds decodeTime = 0us;
+        std::chrono::microseconds waitTime = 0us;
+        videoBuffer->GetStats(decoded, decodeTime, waitTime);
+        long scaled = scaledFrames;
+        std::chrono::microseconds scaledTime = scaleTime;
+        if (scaleBuffer)
+        {
+            long stagescaled = 0;
+            std::chrono::microseconds stagetime = 0us;
+            scaleBuffer->GetStats(stagescaled, stagetime, waitTime);
+            scaled += stagescaled;
+            scaledTime += stagetime;
+        }
+        LOG(VB_GENERAL, LOG_DEBUG, QString("Waited %1ms for decoded frames")
+            .arg(std::chrono::duration_cast<std::chrono::milliseconds>(waitTime).count()));
+        return StageStatus(decoded, decodeTime, scaled, scaledTime,
+                           encodedFrames, encodeTime);
+    };
+
     if (hls)
     {
         hls->UpdateStatus(kHLSStatusRunning);
@@ -1042,7 +1112,8 @@ int Transcode::TranscodeFile(const QString &inputname,
     }
 
     while ((!stopSignalled) &&
-           (lastDecode = videoBuffer->GetFrame(did_ff, is_key)))
+           (lastDecode = scaleBuffer ? scaleBuffer->GetFrame(did_ff, is_key, frame)
+                                     : videoBuffer->GetFrame(did_ff, is_key)))
     {
         if (first_loop)
         {
@@ -1064,17 +1135,23 @@ int Transcode::TranscodeFile(const QString &inputname,
 
         if (m_fifow)
         {
-            MythAVUtil::FillAVFrame(&imageIn, lastDecode);
-            MythAVUtil::FillAVFrame(&imageOut, &frame);
-
-            scontext = sws_getCachedContext(scontext,
-                           lastDecode->m_width, lastDecode->m_height, MythAVUtil::FrameTypeToPixelFormat(lastDecode->m_type),
-                           frame.m_width, frame.m_height, MythAVUtil::FrameTypeToPixelFormat(frame.m_type),
-                           SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
-            // Typically, wee aren't rescaling per say, we're just correcting the stride set by the decoder.
-            // However, it allows to properly handle recordings that see their resolution change half-way.
-            sws_scale(scontext, imageIn.data, imageIn.linesize, 0,
-                      lastDecode->m_height, imageOut.data, imageOut.linesize);
+            if (!scaleBuffer)
+            {
+                auto scalestart = nowAsDuration<std::chrono::microseconds>();
+                MythAVUtil::FillAVFrame(&imageIn, lastDecode);
+                MythAVUtil::FillAVFrame(&imageOut, &frame);
+
+                scontext = sws_getCachedContext(scontext,
+                               lastDecode->m_width, lastDecode->m_height, MythAVUtil::FrameTypeToPixelFormat(lastDecode->m_type),
+                               frame.m_width, frame.m_height, MythAVUtil::FrameTypeToPixelFormat(frame.m_type),
+                               SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
+                // Typically, wee aren't rescaling per say, we're just correcting the stride set by the decoder.
+                // However, it allows to properly handle recordings that see their resolution change half-way.
+                sws_scale(scontext, imageIn.data, imageIn.linesize, 0,
+                          lastDecode->m_height, imageOut.data, imageOut.linesize);
+                scaleTime += nowAsDuration<std::chrono::microseconds>() - scalestart;
+                scaledFrames++;
+            }
 
             totalAudio += arb->GetSamples(frame.m_timecode);
             std::chrono::milliseconds audbufTime = millisecondsFromFloat(totalAudio / rateTimeConv);
@@ -1190,8 +1267,7 @@ int Transcode::TranscodeFile(const QString &inputname,
 
                 unlink(outputname.toLocal8Bit().constData());
                 SetPlayerContext(nullptr);
-                if (videoBuffer)
-                    videoBuffer->stop();
+                stopBuffers();
                 if (hls)
                 {
                     hls->UpdateStatus(kHLSStatusErrored);
@@ -1264,8 +1340,9 @@ int Transcode::TranscodeFile(const QString &inputname,
                   writekeyframe = true;
                 }
 
-                if (rescale)
+                if (rescale && !scaleBuffer)
                 {
+                    auto scalestart = nowAsDuration<std::chrono::microseconds>();
                     MythAVUtil::FillAVFrame(&imageIn, lastDecode);
                     MythAVUtil::FillAVFrame(&imageOut, &frame);
 
@@ -1278,9 +1355,14 @@ int Transcode::TranscodeFile(const QString &inputname,
                     sws_scale(scontext, imageIn.data, imageIn.linesize, 0,
                               lastDecode->m_height - bottomBand,
                               imageOut.data, imageOut.linesize);
+                    scaleTime += nowAsDuration<std::chrono::microseconds>() - scalestart;
+                    scaledFrames++;
                 }
 
+                auto encodestart = nowAsDuration<std::chrono::microseconds>();
                 m_nvr->WriteVideo(rescale ? &frame : lastDecode, true, writekeyframe);
+                encodeTime += nowAsDuration<std::chrono::microseconds>() - encodestart;
+                encodedFrames++;
             }
             player->GetCC608Reader()->FlushTxtBuffers();
 #else
@@ -1322,8 +1404,9 @@ int Transcode::TranscodeFile(const QString &inputname,
                         .arg(newWidth).arg(newHeight));
             }
 
-            if (rescale)
+            if (rescale && !scaleBuffer)
             {
+                auto scalestart = nowAsDuration<std::chrono::microseconds>();
                 MythAVUtil::FillAVFrame(&imageIn, lastDecode);
                 MythAVUtil::FillAVFrame(&imageOut, &frame);
 
@@ -1336,6 +1419,8 @@ int Transcode::TranscodeFile(const QString &inputname,
                 sws_scale(scontext, imageIn.data, imageIn.linesize, 0,
                           lastDecode->m_height - bottomBand,
                           imageOut.data, imageOut.linesize);
+                scaleTime += nowAsDuration<std::chrono::microseconds>() - scalestart;
+                scaledFrames++;
             }
 
             // audio is fully decoded, so we need to reencode it
@@ -1343,6 +1428,7 @@ int Transcode::TranscodeFile(const QString &inputname,
             while ((ab = arb->GetData(lastWrittenTime)) != nullptr)
             {
                 auto *buf = (unsigned char *)ab->data();
+                auto encodestart = nowAsDuration<std::chrono::microseconds>();
                 if (m_avfMode)
                 {
                     if (did_ff != 1)
@@ -1365,6 +1451,7 @@ int Transcode::TranscodeFile(const QString &inputname,
 
                         ++audioFrame;
                     }
+                    encodeTime += nowAsDuration<std::chrono::microseconds>() - encodestart;
                 }
 #if CONFIG_LIBMP3LAME
                 else
@@ -1372,14 +1459,14 @@ int Transcode::TranscodeFile(const QString &inputname,
                     m_nvr->SetOption("audioframesize", ab->size());
                     m_nvr->WriteAudio(buf, audioFrame++,
                                       (ab->m_time - timecodeOffset));
+                    encodeTime += nowAsDuration<std::chrono::microseconds>() - encodestart;
                     if (m_nvr->IsErrored())
                     {
                         LOG(VB_GENERAL, LOG_ERR,
                             "Transcode: Encountered irrecoverable error in "
                             "NVR::WriteAudio");
                         SetPlayerContext(nullptr);
-                        if (videoBuffer)
-                            videoBuffer->stop();
+                        stopBuffers();
                         delete ab;
                         return REENCODE_ERROR;
                     }
@@ -1426,7 +1513,11 @@ int Transcode::TranscodeFile(const QString &inputname,
                         hlsSegmentFrames = 0;
                     }
 
-                    if (avfw->WriteVideoFrame(rescale ? &frame : lastDecode) > 0)
+                    auto encodestart = nowAsDuration<std::chrono::microseconds>();
+                    int written = avfw->WriteVideoFrame(rescale ? &frame : lastDecode);
+                    encodeTime += nowAsDuration<std::chrono::microseconds>() - encodestart;
+                    encodedFrames++;
+                    if (written > 0)
                     {
                         lastWrittenTime = frame.m_timecode + timecodeOffset;
                         if (hls)
@@ -1438,10 +1529,13 @@ int Transcode::TranscodeFile(const QString &inputname,
 #if CONFIG_LIBMP3LAME
             else
             {
+                auto encodestart = nowAsDuration<std::chrono::microseconds>();
                 if (forceKeyFrames)
                     m_nvr->WriteVideo(rescale ? &frame : lastDecode, true, true);
                 else
                     m_nvr->WriteVideo(rescale ? &frame : lastDecode);
+                encodeTime += nowAsDuration<std::chrono::microseconds>() - encodestart;
+                encodedFrames++;
                 lastWrittenTime = frame.m_timecode + timecodeOffset;
             }
 #endif
@@ -1474,8 +1568,7 @@ int Transcode::TranscodeFile(const QString &inputname,
 
                 unlink(outputname.toLocal8Bit().constData());
                 SetPlayerContext(nullptr);
-                if (videoBuffer)
-                    videoBuffer->stop();
+                stopBuffers();
                 return REENCODE_CUTLIST_CHANGE;
             }
 
@@ -1488,8 +1581,7 @@ int Transcode::TranscodeFile(const QString &inputname,
 
                     unlink(outputname.toLocal8Bit().constData());
                     SetPlayerContext(nullptr);
-                    if (videoBuffer)
-                        videoBuffer->stop();
+                    stopBuffers();
                     if (hls)
                     {
                         hls->UpdateStatus(kHLSStatusStopped);
@@ -1509,19 +1601,20 @@ int Transcode::TranscodeFile(const QString &inputname,
                 if (hls)
                     hls->UpdatePercentComplete(percentage);
 
+                QString stages = stageStatus();
+
                 if (jobID >= 0)
                 {
                     JobQueue::ChangeJobComment(jobID,
                               QObject::tr("%1% Completed @ %2 fps.")
-                                          .arg(percentage).arg(flagFPS));
+                                          .arg(percentage).arg(flagFPS) + " " + stages);
                 }
                 else
                 {
                     LOG(VB_GENERAL, LOG_INFO,
-                        QString("mythtranscode: %1% Completed @ %2 fps.")
-                            .arg(percentage).arg(flagFPS));
+                        QString("mythtranscode: %1% Completed @ %2 fps. %3")
+                            .arg(percentage).arg(flagFPS).arg(stages));
                 }
-
             }
             curtime = MythDate::current().addSecs(20);
         }
@@ -1532,6 +1625,9 @@ int Transcode::TranscodeFile(const QString &inputname,
         player->DiscardVideoFrame(lastDecode);
     }
 
+    LOG(VB_GENERAL, LOG_INFO, QString("Transcoded %1 frames. %2")
+        .arg(curFrameNum).arg(stageStatus()));
+
     sws_freeContext(scontext);
 
     if (!m_fifow)
@@ -1577,8 +1673,7 @@ int Transcode::TranscodeFile(const QString &inputname,
         }
     }
 
-    if (videoBuffer)
-        videoBuffer->stop();
+    stopBuffers();
 
     SetPlayerContext(nullptr);
 
@@ -45,11 +45,15 @@ void VideoDecodeBuffer::run()
             frameinfo.didFF = 0;
             frameinfo.isKey = false;
 
+            auto start = nowAsDuration<std::chrono::microseconds>();
             if (m_player->TranscodeGetNextFrame(frameinfo.didFF, frameinfo.isKey, m_honorCutlist))
             {
                 frameinfo.frame = m_videoOutput->GetLastDecodedFrame();
+                auto decodetime = nowAsDuration<std::chrono::microseconds>() - start;
                 locker.relock();
                 m_frameList.append(frameinfo);
+                m_decodeTime += decodetime;
+                m_decodedFrames++;
             }
             else if (m_player->GetEof() != kEofStateNone)
             {
@@ -79,7 +83,10 @@ MythVideoFrame *VideoDecodeBuffer::GetFrame(int &DidFF, bool &Key)
         if (m_eof)
             return nullptr;
 
+        // Time spent here is time the rest of the pipeline is starved by decode
+        auto start = nowAsDuration<std::chrono::microseconds>();
         m_frameWaitCond.wait(locker.mutex());
+        m_waitTime += nowAsDuration<std::chrono::microseconds>() - start;
         if (m_frameList.isEmpty())
             return nullptr;
     }
@@ -92,5 +99,20 @@ MythVideoFrame *VideoDecodeBuffer::GetFrame(int &DidFF, bool &Key)
     return tfInfo.frame;
 }
 
+/*! \brief Return decode stage statistics.
+ *
+ * \param Frames     The number of frames decoded so far.
+ * \param DecodeTime The total time spent decoding those frames.
+ * \param WaitTime   The total time the consumer has spent waiting for a decoded frame.
+*/
+void VideoDecodeBuffer::GetStats(long &Frames, std::chrono::microseconds &DecodeTime,
+                                 std::chrono::microseconds &WaitTime) const
+{
+    QMutexLocker locker(&m_queueLock);
+    Frames     = m_decodedFrames;
+    DecodeTime = m_decodeTime;
+    WaitTime   = m_waitTime;
+}
+
 /* vim: set expandtab tabstop=4 shiftwidth=4: */
 
@@ -23,6 +23,8 @@ class VideoDecodeBuffer : public QRunnable
     void       stop     ();
     void       run      () override;
     MythVideoFrame *GetFrame(int &DidFF, bool &Key);
+    void       GetStats (long &Frames, std::chrono::microseconds &DecodeTime,
+                         std::chrono::microseconds &WaitTime) const;
 
   private:
     struct DecodedFrameInfo
@@ -42,6 +44,9 @@ class VideoDecodeBuffer : public QRunnable
     bool                    m_eof         { false };
     QList<DecodedFrameInfo> m_frameList;
     QWaitCondition          m_frameWaitCond;
+    long                    m_decodedFrames { 0 };
+    std::chrono::microseconds m_decodeTime  { 0us };
+    std::chrono::microseconds m_waitTime    { 0us };
 };
 
 #endif
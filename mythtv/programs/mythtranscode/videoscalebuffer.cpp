@@ -0,0 +1,173 @@
+// MythTV
+#include "videoscalebuffer.h"
+#include "videodecodebuffer.h"
+#include "mythavutil.h"
+
+// FFmpeg
+extern "C" {
+#include "libswscale/swscale.h"
+}
+
+// Std
+#include <chrono>
+#include <thread>
+
+/*! \class VideoScaleBuffer
+ * \brief Scales decoded frames to the output size on its own thread.
+ *
+ * This is the stage between VideoDecodeBuffer and the encoder. It takes
+ * decoded frames from the decode queue and scales each into one of Size
+ * buffers laid out exactly like the Output frame. The number of buffers
+ * bounds the queue, so decode, scale and encode can each run a few frames
+ * ahead of the next stage and no further.
+ *
+ * The decoded frame is handed on with the scaled picture so the consumer
+ * still sees its metadata, and must release it as before.
+*/
+VideoScaleBuffer::VideoScaleBuffer(VideoDecodeBuffer* Source, const MythVideoFrame& Output,
+                                   bool CropPadding, int Size)
+  : m_source(Source), m_cropPadding(CropPadding)
+{
+    for (int i = 0; i < Size; ++i)
+    {
+        uint8_t* buffer = MythVideoFrame::GetAlignedBuffer(Output.m_bufferSize);
+        if (!buffer)
+            break;
+        auto *frame = new MythVideoFrame(Output.m_type, buffer, Output.m_bufferSize,
+                                         Output.m_width, Output.m_height);
+        frame->m_pitches = Output.m_pitches;
+        frame->m_offsets = Output.m_offsets;
+        m_freeFrames.append(frame);
+    }
+}
+
+VideoScaleBuffer::~VideoScaleBuffer()
+{
+    stop();
+    for (auto & info : m_frameList)
+        m_freeFrames.append(info.scaled);
+    m_frameList.clear();
+    qDeleteAll(m_freeFrames);
+    m_freeFrames.clear();
+    sws_freeContext(m_swsContext);
+}
+
+/*! \brief Stop the scale thread.
+ *
+ * This must be called before the source VideoDecodeBuffer is stopped, as the
+ * scale thread may be waiting on it for a decoded frame.
+*/
+void VideoScaleBuffer::stop()
+{
+    m_runThread = false;
+    m_frameWaitCond.wakeAll();
+    while (m_isRunning)
+        std::this_thread::sleep_for(50ms);
+}
+
+void VideoScaleBuffer::run()
+{
+    m_isRunning = true;
+    while (m_runThread)
+    {
+        QMutexLocker locker(&m_queueLock);
+
+        if (!m_freeFrames.isEmpty() && !m_eof)
+        {
+            MythVideoFrame *scaled = m_freeFrames.takeFirst();
+            locker.unlock();
+
+            ScaledFrameInfo frameinfo {};
+            frameinfo.frame  = m_source->GetFrame(frameinfo.didFF, frameinfo.isKey);
+            frameinfo.scaled = scaled;
+
+            if (!frameinfo.frame)
+            {
+                locker.relock();
+                m_freeFrames.append(scaled);
+                m_eof = true;
+                m_frameWaitCond.wakeAll();
+                continue;
+            }
+
+            MythVideoFrame *decoded = frameinfo.frame;
+            auto start = nowAsDuration<std::chrono::microseconds>();
+            AVFrame imageIn;
+            AVFrame imageOut;
+            MythAVUtil::FillAVFrame(&imageIn, decoded);
+            MythAVUtil::FillAVFrame(&imageOut, scaled);
+
+            // 1080 line video is coded as 1088 lines; drop the padding unless
+            // the consumer (the fifo writer) expects it.
+            int bottomBand = (m_cropPadding && decoded->m_height == 1088) ? 8 : 0;
+            m_swsContext = sws_getCachedContext(m_swsContext,
+                               decoded->m_width, decoded->m_height, MythAVUtil::FrameTypeToPixelFormat(decoded->m_type),
+                               scaled->m_width, scaled->m_height, MythAVUtil::FrameTypeToPixelFormat(scaled->m_type),
+                               SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
+            sws_scale(m_swsContext, imageIn.data, imageIn.linesize, 0,
+                      decoded->m_height - bottomBand, imageOut.data, imageOut.linesize);
+            auto scaletime = nowAsDuration<std::chrono::microseconds>() - start;
+
+            locker.relock();
+            m_frameList.append(frameinfo);
+            m_scaleTime += scaletime;
+            m_scaledFrames++;
+            m_frameWaitCond.wakeAll();
+        }
+        else
+        {
+            m_frameWaitCond.wait(locker.mutex());
+        }
+    }
+    m_isRunning = false;
+}
+
+/*! \brief Return the next decoded frame, with its scaled picture in Output.
+ *
+ * The scaled picture is handed over by exchanging buffers with Output, whose
+ * previous buffer goes back to the pool. Output must be the frame this buffer
+ * was created from.
+*/
+MythVideoFrame *VideoScaleBuffer::GetFrame(int &DidFF, bool &Key, MythVideoFrame &Output)
+{
+    QMutexLocker locker(&m_queueLock);
+
+    if (m_frameList.isEmpty())
+    {
+        if (m_eof)
+            return nullptr;
+
+        // Time spent here is time the encoder is starved by decode and scale
+        auto start = nowAsDuration<std::chrono::microseconds>();
+        m_frameWaitCond.wait(locker.mutex());
+        m_waitTime += nowAsDuration<std::chrono::microseconds>() - start;
+        if (m_frameList.isEmpty())
+            return nullptr;
+    }
+
+    ScaledFrameInfo tfInfo = m_frameList.takeFirst();
+    std::swap(Output.m_buffer, tfInfo.scaled->m_buffer);
+    m_freeFrames.append(tfInfo.scaled);
+    locker.unlock();
+    m_frameWaitCond.wakeAll();
+    DidFF = tfInfo.didFF;
+    Key = tfInfo.isKey;
+    return tfInfo.frame;
+}
+
+/*! \brief Return scale stage statistics.
+ *
+ * \param Frames    The number of frames scaled so far.
+ * \param ScaleTime The total time spent scaling those frames.
+ * \param WaitTime  The total time the consumer has spent waiting for a scaled frame.
+*/
+void VideoScaleBuffer::GetStats(long &Frames, std::chrono::microseconds &ScaleTime,
+                                std::chrono::microseconds &WaitTime) const
+{
+    QMutexLocker locker(&m_queueLock);
+    Frames    = m_scaledFrames;
+    ScaleTime = m_scaleTime;
+    WaitTime  = m_waitTime;
+}
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
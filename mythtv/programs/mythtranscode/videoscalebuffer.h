@@ -0,0 +1,54 @@
+#ifndef VIDEOSCALEBUFFER_H
+#define VIDEOSCALEBUFFER_H
+
+// Qt
+#include <QList>
+#include <QWaitCondition>
+#include <QMutex>
+#include <QRunnable>
+
+// MythTV
+#include "mythframe.h"
+
+struct SwsContext;
+class VideoDecodeBuffer;
+
+class VideoScaleBuffer : public QRunnable
+{
+  public:
+    VideoScaleBuffer(VideoDecodeBuffer* Source, const MythVideoFrame& Output,
+                     bool CropPadding, int Size = 3);
+    ~VideoScaleBuffer() override;
+
+    void       stop     ();
+    void       run      () override;
+    MythVideoFrame *GetFrame(int &DidFF, bool &Key, MythVideoFrame &Output);
+    void       GetStats (long &Frames, std::chrono::microseconds &ScaleTime,
+                         std::chrono::microseconds &WaitTime) const;
+
+  private:
+    struct ScaledFrameInfo
+    {
+        MythVideoFrame *frame;
+        MythVideoFrame *scaled;
+        int         didFF;
+        bool        isKey;
+    };
+
+    VideoDecodeBuffer* const m_source     { nullptr };
+    bool const              m_cropPadding;
+    SwsContext*             m_swsContext  { nullptr };
+    bool volatile           m_runThread   { true  };
+    bool volatile           m_isRunning   { false };
+    QMutex mutable          m_queueLock; // Guards the following...
+    bool                    m_eof         { false };
+    QList<MythVideoFrame*>  m_freeFrames;
+    QList<ScaledFrameInfo>  m_frameList;
+    QWaitCondition          m_frameWaitCond;
+    long                    m_scaledFrames { 0 };
+    std::chrono::microseconds m_scaleTime   { 0us };
+    std::chrono::microseconds m_waitTime    { 0us };
+};
+
+#endif
+
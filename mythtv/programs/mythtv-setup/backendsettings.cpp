@@ -286,6 +286,29 @@ static GlobalCheckBoxSetting *DeletesFollowLinks()
     return gc;
 };
 
+static GlobalCheckBoxSetting *LiveTVPreTune()
+{
+    auto *gc = new GlobalCheckBoxSetting("LiveTVPreTune");
+    gc->setLabel(QObject::tr("Pre-tune idle inputs for LiveTV"));
+    gc->setValue(false);
+    gc->setHelpText(QObject::tr("If enabled, idle inputs are tuned to the "
+                    "channels above and below the one being watched in "
+                    "LiveTV, so that changing to them is faster. The inputs "
+                    "remain available for recordings."));
+    return gc;
+};
+
+static GlobalSpinBoxSetting *LiveTVPreTuneHold()
+{
+    auto *gc = new GlobalSpinBoxSetting("LiveTVPreTuneHold", 3, 30, 1);
+    gc->setLabel(QObject::tr("Pre-tune hold time (mins)"));
+    gc->setValue(3);
+    gc->setHelpText(QObject::tr("How long an input stays pre-tuned after "
+                    "the frontend last asked for it. EIT scanning on the "
+                    "input waits for the pre-tuning to end."));
+    return gc;
+};
+
 static GlobalSpinBoxSetting *HDRingbufferSize()
 {
     auto *bs = new GlobalSpinBoxSetting(
@@ -939,6 +962,8 @@ BackendSettings::BackendSettings()
     group2->addChild(MiscStatusScript());
     group2->addChild(DisableAutomaticBackup());
     group2->addChild(DisableFirewireReset());
+    group2->addChild(LiveTVPreTune());
+    group2->addChild(LiveTVPreTuneHold());
     addChild(group2);
 
     auto* group2a1 = new GroupSetting();